@@ -9,6 +9,7 @@
 #include <Audio/MusicComponent.hpp>
 
 #include <Core/ResourceManager.hpp>
+#include <Core/Root.hpp>
 #include <Utils/Logger.hpp>
 
 #include <SFML/Audio/Listener.hpp>
@@ -40,6 +41,9 @@ void MusicComponent::onDisable() {
 }
 
 void MusicComponent::onUpdate(double time_diff) {
+    if(Root::getInstance().isHeadless())
+        return;
+
     if(mFadeFlag) {
         auto* resmgr = ResourceManager::get();
         if(mElapsedTime >= mFadeTime) {
@@ -69,6 +73,9 @@ const QString MusicComponent::getMusicFileName() const {
 }
 
 void MusicComponent::setVolume(float volume) {
+    if(Root::getInstance().isHeadless())
+        return;
+
     if(ResourceManager::get()->getMusicFile(mMusicFileName)->getVolume() != volume) {
         ResourceManager::get()->getMusicFile(mMusicFileName)->setVolume(volume);
         emit volumeChanged(volume);
@@ -83,15 +90,21 @@ void MusicComponent::setMasterVolume(float volume) {
 }
 
 void MusicComponent::_loadMusic() {
+    if(Root::getInstance().isHeadless())
+        return; // a dedicated server has no audio
+
     if(mMusicFileName == "") {
-        Logger::get().error("MusicComponent [" + mName + "]: Needs a music file.");
+        Logger::get().error("MusicComponent [" + getName() + "]: Needs a music file.");
     }
     if(!ResourceManager::get()->addMusicFile(mMusicFileName)) {
-        Logger::get().error("MusicComponent [" + mName + "]: Wasn't able to load music file [" + mMusicFileName + "].");
+        Logger::get().error("MusicComponent [" + getName() + "]: Wasn't able to load music file [" + mMusicFileName + "].");
     }
 }
 
 void MusicComponent::playMusic() {
+    if(Root::getInstance().isHeadless())
+        return;
+
     if(ResourceManager::get()->getMusicFile(mMusicFileName)->getStatus() != sf::Music::Playing) {
         // play music if possible
         ResourceManager::get()->getMusicFile(mMusicFileName)->play();
@@ -100,6 +113,9 @@ void MusicComponent::playMusic() {
 }
 
 void MusicComponent::stopMusic() {
+    if(Root::getInstance().isHeadless())
+        return;
+
     if(ResourceManager::get()->getMusicFile(mMusicFileName)->getStatus() != sf::Music::Stopped) {
         // stop music if possible
         ResourceManager::get()->getMusicFile(mMusicFileName)->stop();
@@ -108,6 +124,9 @@ void MusicComponent::stopMusic() {
 }
 
 void MusicComponent::pauseMusic() {
+    if(Root::getInstance().isHeadless())
+        return;
+
     if(ResourceManager::get()->getMusicFile(mMusicFileName)->getStatus() != sf::Music::Paused) {
         // pause music if possible
         ResourceManager::get()->getMusicFile(mMusicFileName)->pause();
@@ -116,6 +135,9 @@ void MusicComponent::pauseMusic() {
 }
 
 void MusicComponent::fade(double time, float target_volume) {
+    if(Root::getInstance().isHeadless())
+        return;
+
     mFadeFlag = true;
     if(time > 0.0)
         mFadeTime = time;
@@ -9,6 +9,7 @@
 #include <Audio/SoundComponent.hpp>
 
 #include <Core/ResourceManager.hpp>
+#include <Core/Root.hpp>
 #include <Scene/Node.hpp>
 #include <Utils/Logger.hpp>
 
@@ -27,9 +28,23 @@ void SoundComponent::onInitialize() {}
 void SoundComponent::onDeinitialize() {}
 
 void SoundComponent::onUpdate(double time_diff) {
-    mSound.setPosition(mNode->getPosition(Node::SCENE).x,
-                       mNode->getPosition(Node::SCENE).y,
-                       mNode->getPosition(Node::SCENE).z);
+    onTransformChanged();
+}
+
+uint32_t SoundComponent::getReadAccess() const {
+    return OWN_TRANSFORM;
+}
+
+uint32_t SoundComponent::getWriteAccess() const {
+    return ENGINE;
+}
+
+void SoundComponent::onTransformChanged() {
+    if(Root::getInstance().isHeadless())
+        return;
+
+    Ogre::Vector3 position = mNode->getPosition(Node::SCENE);
+    mSound.setPosition(position.x, position.y, position.z);
 }
 
 void SoundComponent::onSerialize(IOPacket& packet) {
@@ -54,8 +69,8 @@ sf::Sound& SoundComponent::getSound() {
 
 void SoundComponent::playSound() {
     if(mSound.getStatus() != sf::Sound::Playing) {
-        // play sound if possible and enabled
-        if(isEnabled())
+        // play sound if possible and enabled, a dedicated server has no audio
+        if(isEnabled() && !Root::getInstance().isHeadless())
             mSound.play();
         emit soundPlayed();
     }
@@ -78,11 +93,14 @@ void SoundComponent::stopSound() {
 }
 
 void SoundComponent::_loadSound() {
+    if(Root::getInstance().isHeadless())
+        return;
+
     if(mSoundFileName == "") {
-        Logger::get().error("SoundComponent [" + mName + "]: Needs a sound file.");
+        Logger::get().error("SoundComponent [" + getName() + "]: Needs a sound file.");
     }
     if(!ResourceManager::get()->addSoundBuffer(mSoundFileName)) {
-        Logger::get().error("SoundComponent [" + mName + "]: Wasn't able to load sound file [" + mSoundFileName + "].");
+        Logger::get().error("SoundComponent [" + getName() + "]: Wasn't able to load sound file [" + mSoundFileName + "].");
     } else {
         mSound.setBuffer(*ResourceManager::get()->getSoundBuffer(mSoundFileName));
     }
@@ -40,6 +40,9 @@ public:
     void onInitialize();
     void onDeinitialize();
     void onUpdate(double time_diff);
+    uint32_t getReadAccess() const;
+    uint32_t getWriteAccess() const;
+    void onTransformChanged();
     void onSerialize(IOPacket& packet);
 
     /**
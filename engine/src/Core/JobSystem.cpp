@@ -0,0 +1,331 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Core/JobSystem.hpp>
+
+#include <Core/Root.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/Profiler.hpp>
+#include <Utils/Utils.hpp>
+
+#include <QMutexLocker>
+
+namespace dt {
+
+JobCounter::JobCounter()
+    : mCount(0) {}
+
+bool JobCounter::isDone() const {
+    return mCount == 0;
+}
+
+int32_t JobCounter::getCount() const {
+    return mCount;
+}
+
+////////////////////////////////////////////////////////////////
+
+JobSystem::Worker::Worker(JobSystem* job_system, uint32_t index)
+    : mJobSystem(job_system),
+      mIndex(index) {}
+
+void JobSystem::Worker::run() {
+    mJobSystem->_workerLoop(mIndex);
+}
+
+////////////////////////////////////////////////////////////////
+
+JobSystem::JobSystem()
+    : mRequestedWorkerCount(0),
+      mWorkerCount(0),
+      mMainThread(nullptr),
+      mNextQueue(0),
+      mQueuedJobs(0),
+      mSleepingWorkers(0),
+      mWaitingThreads(0),
+      mStolenJobs(0),
+      mIsStopping(false),
+      mQueuedMainThreadJobs(0) {}
+
+void JobSystem::initialize() {
+    mMainThread = QThread::currentThread();
+    mIsStopping = false;
+
+    // the main thread runs jobs as well while it waits for them
+    mWorkerCount = mRequestedWorkerCount;
+    if(mWorkerCount == 0)
+        mWorkerCount = std::max(QThread::idealThreadCount() - 1, 1);
+
+    for(uint32_t i = 0; i < mWorkerCount; ++i) {
+        mWorkers.push_back(new Worker(this, i));
+    }
+    for(auto iter = mWorkers.begin(); iter != mWorkers.end(); ++iter) {
+        (*iter)->start();
+    }
+    Logger::get().info("Started " + Utils::toString(mWorkerCount) + " job workers.");
+}
+
+void JobSystem::deinitialize() {
+    runMainThreadJobs();
+
+    {
+        QMutexLocker lock(&mSleepMutex);
+        mIsStopping = true;
+        mWakeCondition.wakeAll();
+    }
+    // the workers run the jobs left in their queues before they stop
+    for(auto iter = mWorkers.begin(); iter != mWorkers.end(); ++iter) {
+        (*iter)->wait();
+        delete *iter;
+    }
+    mWorkers.clear();
+    mWorkerCount = 0;
+    mQueuedJobs = 0;
+}
+
+JobSystem* JobSystem::get() {
+    return Root::getInstance().getJobSystem();
+}
+
+void JobSystem::setWorkerCount(uint32_t count) {
+    if(mWorkerCount > 0) {
+        Logger::get().error("Cannot change the number of job workers after they have been started.");
+        return;
+    }
+    mRequestedWorkerCount = count;
+}
+
+uint32_t JobSystem::getWorkerCount() const {
+    return mWorkerCount;
+}
+
+void JobSystem::run(const std::function<void()>& job, JobCounter* counter) {
+    if(counter != nullptr)
+        ++counter->mCount;
+
+    Job scheduled = {job, counter};
+    if(mWorkers.empty()) {
+        // not initialized, run it right away
+        _execute(scheduled);
+        return;
+    }
+    _schedule(scheduled);
+}
+
+void JobSystem::runAfter(JobCounter* dependency, const std::function<void()>& job, JobCounter* counter) {
+    if(counter != nullptr)
+        ++counter->mCount;
+
+    {
+        QMutexLocker lock(&dependency->mMutex);
+        if(dependency->mCount != 0) {
+            dependency->mContinuations.push_back(std::make_pair(job, counter));
+            return;
+        }
+    }
+    // already done, the counter has been counted up above
+    Job scheduled = {job, counter};
+    if(mWorkers.empty())
+        _execute(scheduled);
+    else
+        _schedule(scheduled);
+}
+
+void JobSystem::runOnMainThread(const std::function<void()>& job, JobCounter* counter) {
+    if(counter != nullptr)
+        ++counter->mCount;
+
+    {
+        QMutexLocker lock(&mMainThreadMutex);
+        Job scheduled = {job, counter};
+        mMainThreadJobs.push_back(scheduled);
+        ++mQueuedMainThreadJobs;
+    }
+    _wakeWaitingThreads();
+}
+
+uint32_t JobSystem::runMainThreadJobs() {
+    if(!isMainThread())
+        return 0;
+
+    uint32_t count = 0;
+    while(true) {
+        Job job;
+        {
+            QMutexLocker lock(&mMainThreadMutex);
+            if(mMainThreadJobs.empty())
+                break;
+            job = mMainThreadJobs.front();
+            mMainThreadJobs.pop_front();
+            --mQueuedMainThreadJobs;
+        }
+        _execute(job);
+        ++count;
+    }
+    return count;
+}
+
+void JobSystem::wait(JobCounter* counter, bool run_main_thread_jobs) {
+    int32_t worker_index = getWorkerIndex();
+    bool runs_main_thread_jobs = run_main_thread_jobs && isMainThread();
+
+    while(counter->mCount != 0) {
+        Job job;
+        if(_takeJob(worker_index, job)) {
+            _execute(job);
+            continue;
+        }
+        if(runs_main_thread_jobs && runMainThreadJobs() > 0)
+            continue;
+
+        // The remaining jobs are running on other threads. Like a worker, count as waiting before checking
+        // again, so either we see the change or the thread making it sees us.
+        QMutexLocker lock(&mSleepMutex);
+        ++mWaitingThreads;
+        while(counter->mCount != 0 && mQueuedJobs <= 0 && !(runs_main_thread_jobs && mQueuedMainThreadJobs > 0)) {
+            mWaitCondition.wait(&mSleepMutex);
+        }
+        --mWaitingThreads;
+    }
+    // the last job may still hold the lock, the counter must not be destroyed before it is released
+    QMutexLocker lock(&counter->mMutex);
+}
+
+bool JobSystem::isMainThread() const {
+    return QThread::currentThread() == mMainThread;
+}
+
+int32_t JobSystem::getWorkerIndex() const {
+    QThread* thread = QThread::currentThread();
+    for(uint32_t i = 0; i < mWorkers.size(); ++i) {
+        if(mWorkers[i] == thread)
+            return i;
+    }
+    return -1;
+}
+
+uint64_t JobSystem::getStolenJobCount() const {
+    return mStolenJobs;
+}
+
+void JobSystem::_schedule(const Job& job) {
+    // a worker queues its own jobs, keeping them on the same core; other threads spread theirs
+    int32_t worker_index = getWorkerIndex();
+    uint32_t queue = worker_index >= 0 ? worker_index : mNextQueue++ % mWorkers.size();
+    {
+        QMutexLocker lock(&mWorkers[queue]->mMutex);
+        mWorkers[queue]->mJobs.push_back(job);
+    }
+    ++mQueuedJobs;
+
+    // a worker counts itself as sleeping before it checks for jobs, so either it sees the job or we see it
+    if(mSleepingWorkers > 0) {
+        QMutexLocker lock(&mSleepMutex);
+        mWakeCondition.wakeOne();
+    }
+    _wakeWaitingThreads();
+}
+
+bool JobSystem::_takeJob(int32_t worker_index, Job& job) {
+    if(mQueuedJobs <= 0)
+        return false;
+
+    // the newest job of the own queue is the one most likely still in the cache
+    if(worker_index >= 0) {
+        Worker* worker = mWorkers[worker_index];
+        QMutexLocker lock(&worker->mMutex);
+        if(!worker->mJobs.empty()) {
+            job = worker->mJobs.back();
+            worker->mJobs.pop_back();
+            --mQueuedJobs;
+            return true;
+        }
+    }
+
+    // steal the oldest job of another queue, starting with the next one to spread the thieves
+    uint32_t count = mWorkers.size();
+    uint32_t start = worker_index >= 0 ? worker_index + 1 : 0;
+    for(uint32_t i = 0; i < count; ++i) {
+        Worker* victim = mWorkers[(start + i) % count];
+        if(static_cast<int32_t>((start + i) % count) == worker_index)
+            continue;
+
+        QMutexLocker lock(&victim->mMutex);
+        if(!victim->mJobs.empty()) {
+            job = victim->mJobs.front();
+            victim->mJobs.pop_front();
+            --mQueuedJobs;
+            ++mStolenJobs;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::_execute(Job& job) {
+    job.mFunction();
+    if(job.mCounter != nullptr)
+        _finish(job.mCounter);
+}
+
+void JobSystem::_finish(JobCounter* counter) {
+    // while other jobs are left, nobody can be done waiting
+    int32_t count = counter->mCount;
+    while(count > 1) {
+        if(counter->mCount.compare_exchange_weak(count, count - 1))
+            return;
+    }
+
+    std::vector<std::pair<std::function<void()>, JobCounter*> > continuations;
+    {
+        // the lock orders the last decrement with runAfter() checking the count, and with wait() returning
+        QMutexLocker lock(&counter->mMutex);
+        if(--counter->mCount != 0)
+            return;
+        continuations.swap(counter->mContinuations);
+    }
+    // the counter may be gone once the lock is released, only the JobSystem is touched from here on
+    _wakeWaitingThreads();
+
+    for(auto iter = continuations.begin(); iter != continuations.end(); ++iter) {
+        Job scheduled = {iter->first, iter->second};
+        if(mWorkers.empty())
+            _execute(scheduled);
+        else
+            _schedule(scheduled);
+    }
+}
+
+void JobSystem::_wakeWaitingThreads() {
+    if(mWaitingThreads > 0) {
+        QMutexLocker lock(&mSleepMutex);
+        mWaitCondition.wakeAll();
+    }
+}
+
+void JobSystem::_workerLoop(uint32_t worker_index) {
+    Profiler::setThreadName("Worker " + Utils::toString(worker_index));
+
+    while(true) {
+        Job job;
+        if(_takeJob(worker_index, job)) {
+            _execute(job);
+            continue;
+        }
+
+        QMutexLocker lock(&mSleepMutex);
+        ++mSleepingWorkers;
+        while(mQueuedJobs <= 0 && !mIsStopping) {
+            mWakeCondition.wait(&mSleepMutex);
+        }
+        --mSleepingWorkers;
+        if(mIsStopping && mQueuedJobs <= 0)
+            return;
+    }
+}
+
+}
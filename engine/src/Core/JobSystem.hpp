@@ -0,0 +1,284 @@
+
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_CORE_JOBSYSTEM
+#define DUCTTAPE_ENGINE_CORE_JOBSYSTEM
+
+#include <Config.hpp>
+
+#include <Core/Manager.hpp>
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace dt {
+
+/**
+  * Counts the unfinished jobs it has been passed to. Waiting for a counter waits for all of its jobs, and
+  * jobs can be scheduled to run once a counter reaches zero.
+  * @see JobSystem
+  */
+class DUCTTAPE_API JobCounter {
+
+    Q_DISABLE_COPY(JobCounter)
+
+public:
+    /**
+      * Default constructor.
+      */
+    JobCounter();
+
+    /**
+      * Returns whether all jobs of the counter are done.
+      * @returns Whether the counter is zero.
+      */
+    bool isDone() const;
+
+    /**
+      * Returns the number of unfinished jobs.
+      * @returns The number of jobs.
+      */
+    int32_t getCount() const;
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int32_t> mCount;                        //!< The number of unfinished jobs.
+    QMutex mMutex;                                      //!< Guards mContinuations.
+    std::vector<std::pair<std::function<void()>, JobCounter*> > mContinuations;  //!< The jobs to run once the count is zero.
+};
+
+/**
+  * A scheduler that runs jobs on a set of worker threads shared by the whole engine. Every worker has its
+  * own queue, idle workers steal jobs from the others. A thread waiting for a JobCounter runs jobs itself
+  * meanwhile, so jobs may wait for the jobs they started, and sleeps while there are none to take. Jobs that
+  * have to run on the main thread are queued separately and run by the Game every frame, or while the main
+  * thread waits.
+  * Long blocking work like reading files should not be run as a job, it keeps a worker from the frame.
+  */
+class DUCTTAPE_API JobSystem : public Manager {
+    Q_OBJECT
+public:
+    /**
+      * Default constructor.
+      */
+    JobSystem();
+
+    /**
+      * Starts the workers.
+      */
+    void initialize();
+
+    /**
+      * Runs the remaining jobs and stops the workers.
+      */
+    void deinitialize();
+
+    /**
+      * Returns a pointer to the Manager instance.
+      * @returns A pointer to the Manager instance.
+      */
+    static JobSystem* get();
+
+    /**
+      * Sets the number of worker threads. Call it before the engine is initialized.
+      * @param count The number of workers, or 0 for one less than the number of logical cores, so the
+      * workers and the main thread occupy one core each. The default is 0.
+      */
+    void setWorkerCount(uint32_t count);
+
+    /**
+      * Returns the number of worker threads.
+      * @returns The number of workers, or 0 if the JobSystem has not been initialized.
+      */
+    uint32_t getWorkerCount() const;
+
+    /**
+      * Schedules a job on a worker.
+      * @param job The job.
+      * @param counter The counter to count the job with, or nullptr.
+      */
+    void run(const std::function<void()>& job, JobCounter* counter = nullptr);
+
+    /**
+      * Schedules a job once all jobs of another counter are done.
+      * @param dependency The counter to wait for. It must stay alive until the job has been scheduled.
+      * @param job The job.
+      * @param counter The counter to count the job with, or nullptr. It counts the job already while it waits.
+      */
+    void runAfter(JobCounter* dependency, const std::function<void()>& job, JobCounter* counter = nullptr);
+
+    /**
+      * Schedules a job on the main thread, e.g. to create Ogre objects or to emit signals to the Scene.
+      * @param job The job.
+      * @param counter The counter to count the job with, or nullptr. Do not wait for it on a worker while
+      * the main thread is waiting for that worker.
+      */
+    void runOnMainThread(const std::function<void()>& job, JobCounter* counter = nullptr);
+
+    /**
+      * Runs the jobs queued for the main thread. Does nothing if called from another thread.
+      * @returns The number of jobs run.
+      */
+    uint32_t runMainThreadJobs();
+
+    /**
+      * Waits until all jobs of a counter are done, running other jobs meanwhile.
+      * @param counter The counter.
+      * @param run_main_thread_jobs Whether the main thread runs the jobs queued for it while it waits. Pass false
+      * while the jobs waited for work on data the main thread jobs may touch, e.g. the simulation of a frame.
+      */
+    void wait(JobCounter* counter, bool run_main_thread_jobs = true);
+
+    /**
+      * Calls a function for every index of a range, split into batches run as jobs. Returns when all
+      * batches are done. The calling thread takes part.
+      * @param begin The first index.
+      * @param end The index after the last one.
+      * @param batch_size The number of indices per job, or 0 for about four jobs per thread.
+      * @param function The function, called with each index.
+      * @param run_main_thread_jobs Whether the main thread runs the jobs queued for it while it waits for the
+      * batches. Off by default, as the batches usually work on data the main thread jobs may touch.
+      */
+    template <typename Function>
+    void parallelFor(uint32_t begin, uint32_t end, uint32_t batch_size, Function function,
+                     bool run_main_thread_jobs = false) {
+        if(begin >= end)
+            return;
+        if(batch_size == 0) {
+            uint32_t jobs = 4 * (mWorkerCount + 1);
+            batch_size = (end - begin + jobs - 1) / jobs;
+        }
+
+        JobCounter counter;
+        // the calling thread takes the first batch
+        for(uint32_t first = begin + batch_size; first < end; first += batch_size) {
+            uint32_t last = std::min(first + batch_size, end);
+            run([first, last, &function] {
+                for(uint32_t i = first; i < last; ++i) {
+                    function(i);
+                }
+            }, &counter);
+        }
+        for(uint32_t i = begin; i < std::min(begin + batch_size, end); ++i) {
+            function(i);
+        }
+        wait(&counter, run_main_thread_jobs);
+    }
+
+    /**
+      * Returns whether the calling thread is the main thread.
+      * @returns Whether it is the thread the JobSystem has been initialized on.
+      */
+    bool isMainThread() const;
+
+    /**
+      * Returns the index of the worker the caller runs on.
+      * @returns The index, or -1 if the caller is not a worker.
+      */
+    int32_t getWorkerIndex() const;
+
+    /**
+      * Returns the number of jobs that have been stolen from another worker's queue.
+      * @returns The number of stolen jobs.
+      */
+    uint64_t getStolenJobCount() const;
+
+private:
+    /**
+      * A scheduled job and its counter.
+      */
+    struct Job {
+        std::function<void()> mFunction;    //!< The job.
+        JobCounter* mCounter;               //!< The counter of the job, or nullptr.
+    };
+
+    /**
+      * A worker thread and its queue.
+      */
+    class Worker : public QThread {
+    public:
+        Worker(JobSystem* job_system, uint32_t index);
+
+        QMutex mMutex;                  //!< Guards mJobs.
+        std::deque<Job> mJobs;          //!< The queue. The worker takes from the back, thieves from the front.
+
+    protected:
+        void run();
+
+    private:
+        JobSystem* mJobSystem;          //!< The JobSystem.
+        uint32_t mIndex;                //!< The index of the worker.
+    };
+
+    /**
+      * Private method. Puts a job into a queue and wakes a sleeping worker.
+      * @param job The job.
+      */
+    void _schedule(const Job& job);
+
+    /**
+      * Private method. Takes a job from a worker's own queue, or steals one from another worker.
+      * @param worker_index The index of the worker, or -1 for a thread that is not a worker.
+      * @param job The job taken.
+      * @returns Whether a job has been taken.
+      */
+    bool _takeJob(int32_t worker_index, Job& job);
+
+    /**
+      * Private method. Runs a job and counts it as done.
+      * @param job The job.
+      */
+    void _execute(Job& job);
+
+    /**
+      * Private method. Counts a job of a counter as done, and schedules the jobs waiting for it.
+      * @param counter The counter.
+      */
+    void _finish(JobCounter* counter);
+
+    /**
+      * Private method. Wakes the threads sleeping in wait(), e.g. because a job has been queued or a counter is done.
+      */
+    void _wakeWaitingThreads();
+
+    /**
+      * Private method. The loop of a worker thread.
+      * @param worker_index The index of the worker.
+      */
+    void _workerLoop(uint32_t worker_index);
+
+    uint32_t mRequestedWorkerCount;         //!< The number of workers set, or 0.
+    uint32_t mWorkerCount;                  //!< The number of running workers.
+    std::vector<Worker*> mWorkers;          //!< The workers.
+    QThread* mMainThread;                   //!< The thread the JobSystem has been initialized on.
+    std::atomic<uint32_t> mNextQueue;       //!< The queue the next job from outside the workers goes to.
+    std::atomic<int32_t> mQueuedJobs;       //!< The number of jobs in the worker queues.
+    std::atomic<int32_t> mSleepingWorkers;  //!< The number of workers waiting for a job.
+    std::atomic<int32_t> mWaitingThreads;   //!< The number of threads sleeping in wait().
+    std::atomic<uint64_t> mStolenJobs;      //!< The number of jobs stolen from another worker's queue.
+    std::atomic<bool> mIsStopping;          //!< Whether the workers shall stop.
+    QMutex mSleepMutex;                     //!< Guards the sleeping of the workers.
+    QWaitCondition mWakeCondition;          //!< Wakes a sleeping worker.
+    QWaitCondition mWaitCondition;          //!< Wakes the threads sleeping in wait() to check their counters.
+    QMutex mMainThreadMutex;                //!< Guards mMainThreadJobs.
+    std::deque<Job> mMainThreadJobs;        //!< The jobs for the main thread.
+    std::atomic<int32_t> mQueuedMainThreadJobs; //!< The number of jobs in mMainThreadJobs.
+};
+
+}
+
+#endif
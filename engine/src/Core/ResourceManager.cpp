@@ -36,6 +36,9 @@ ResourceManager* ResourceManager::get() {
 }
 
 void ResourceManager::addResourceLocation(const QString path, const QString type, bool recursive) {
+    if(Root::getInstance().isHeadless())
+        return;
+
     QFile file(findFile(path).absoluteFilePath());
 
     // Does the path exist?
@@ -58,6 +58,7 @@ public:
       * @param path Path of the resource, relative to the data directory. Depending on \a type this is either a directory or a single file.
       * @param type Can either be \c FileSystem for a directory in the filesystem sys or \c Zip for a zip file containing the resources.
       * @param recursive A flag to set when resources should be searched recursively.
+      * Does nothing on a dedicated server, as there are no Ogre resources to load.
       * @todo Perhaps merge the other resource methods into this.
       */
     void addResourceLocation(const QString path, const QString type, bool recursive = false);
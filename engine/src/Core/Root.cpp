@@ -9,6 +9,7 @@
 #include <Core/Root.hpp>
 
 #include <Utils/LogManager.hpp>
+#include <Core/JobSystem.hpp>
 #include <Core/ResourceManager.hpp>
 #include <Input/InputManager.hpp>
 #include <Graphics/DisplayManager.hpp>
@@ -18,6 +19,8 @@
 #include <Physics/PhysicsManager.hpp>
 #include <Graphics/TerrainManager.hpp>
 #include <Logic/ScriptManager.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/Utils.hpp>
 
 namespace dt {
 
@@ -27,7 +30,11 @@ QString Root::_VERSION = DUCTTAPE_VERSION;
 // the creation and deletion of these managers.
 Root::Root()
     : mCoreApplication(nullptr),
+      mProfile(CLIENT),
+      mStartupTime(0),
+      mStartupMemory(0),
       mLogManager(new LogManager()),
+      mJobSystem(new JobSystem()),
       mResourceManager(new ResourceManager()),
       mInputManager(new InputManager()),
       mDisplayManager(new DisplayManager()),
@@ -48,6 +55,7 @@ Root::~Root() {
     delete mDisplayManager;
     delete mInputManager;
     delete mResourceManager;
+    delete mJobSystem;
     delete mLogManager;
 }
 
@@ -56,7 +64,9 @@ Root& Root::getInstance() {
     return instance;
 }
 
-void Root::initialize(int argc, char** argv) {
+void Root::initialize(int argc, char** argv, Profile profile) {
+    mProfile = profile;
+
     if(qApp){
         mCoreApplication = qApp;
     } else {
@@ -68,26 +78,39 @@ void Root::initialize(int argc, char** argv) {
     mSfClock.restart();
 
     mLogManager->initialize();
+    mJobSystem->initialize();
     mResourceManager->initialize();
-    mDisplayManager->initialize();
-    // Do not initialize the InputManager.
-    // The display manager does this when the window is created.
+    if(mProfile == CLIENT) {
+        mDisplayManager->initialize();
+        // Do not initialize the InputManager.
+        // The display manager does this when the window is created.
+    }
     mNetworkManager->initialize();
     mStateManager->initialize();
     mPhysicsManager->initialize();
-    mTerrainManager->initialize();
+    if(mProfile == CLIENT)
+        mTerrainManager->initialize();
     mScriptManager->initialize();
+
+    mStartupTime = mSfClock.getElapsedTime().asSeconds();
+    mStartupMemory = Utils::residentMemory();
+    Logger::get().info(QString(mProfile == CLIENT ? "Client" : "Dedicated server") + " started in "
+                       + Utils::toString(mStartupTime * 1000) + " ms, resident memory "
+                       + Utils::toString(mStartupMemory / 1024) + " KiB.");
 }
 
 void Root::deinitialize() {
     mScriptManager->deinitialize();
-    mTerrainManager->deinitialize();
+    if(mProfile == CLIENT)
+        mTerrainManager->deinitialize();
     mPhysicsManager->deinitialize();
     mStateManager->deinitialize();
     mNetworkManager->deinitialize();
     // Do not deinitialize the InputManager (see above).
-    mDisplayManager->deinitialize();
+    if(mProfile == CLIENT)
+        mDisplayManager->deinitialize();
     mResourceManager->deinitialize();
+    mJobSystem->deinitialize();
     mLogManager->deinitialize();
 
     Serializer::deinitialize();
@@ -98,10 +121,30 @@ double Root::getTimeSinceInitialize() const {
     return mSfClock.getElapsedTime().asSeconds();
 }
 
+Root::Profile Root::getProfile() const {
+    return mProfile;
+}
+
+bool Root::isHeadless() const {
+    return mProfile == DEDICATED_SERVER;
+}
+
+double Root::getStartupTime() const {
+    return mStartupTime;
+}
+
+uint64_t Root::getStartupMemory() const {
+    return mStartupMemory;
+}
+
 LogManager* Root::getLogManager() {
     return mLogManager;
 }
 
+JobSystem* Root::getJobSystem() {
+    return mJobSystem;
+}
+
 StateManager* Root::getStateManager() {
     return mStateManager;
 }
@@ -41,9 +41,12 @@
 
 #include <QCoreApplication>
 
+#include <cstdint>
+
 namespace dt {
 
 class LogManager;
+class JobSystem;
 class ResourceManager;
 class InputManager;
 class DisplayManager;
@@ -66,6 +69,16 @@ class DUCTTAPE_API Root {
 public:
     static QString _VERSION;  //!< Metadata: engine version number (Format: "0.0.0")
 
+    /**
+      * The set of managers the engine runs with.
+      */
+    enum Profile {
+        CLIENT,             //!< Everything: display, input, GUI, audio, physics, networking and scripting.
+        DEDICATED_SERVER    //!< No display, input, GUI or audio. Scenes have no Ogre::SceneManager, the presentation
+                            //!< components (meshes, cameras, lights, billboards, particles, texts, sounds, music)
+                            //!< do nothing and their getters for Ogre objects return nullptr.
+    };
+
     /**
       * Destructor. All instances are deleted here.
       */
@@ -78,9 +91,12 @@ public:
     static Root& getInstance();
 
     /**
-      * Initializes all managers.
+      * Initializes all managers of a profile. Logs the startup time and the resident memory afterwards.
+      * @param argc Command line param count.
+      * @param argv Command line params.
+      * @param profile The profile.
       */
-    void initialize(int argc, char** argv);
+    void initialize(int argc, char** argv, Profile profile = CLIENT);
 
     /**
       * Deinitializes all managers.
@@ -93,12 +109,42 @@ public:
       */
     double getTimeSinceInitialize() const;
 
+    /**
+      * Returns the profile the engine has been initialized with.
+      * @returns The profile.
+      */
+    Profile getProfile() const;
+
+    /**
+      * Returns whether the engine runs without display, input, GUI and audio.
+      * @returns Whether the profile is DEDICATED_SERVER.
+      */
+    bool isHeadless() const;
+
+    /**
+      * Returns how long the last call of initialize() took.
+      * @returns The time in seconds.
+      */
+    double getStartupTime() const;
+
+    /**
+      * Returns the resident memory of the process right after the last call of initialize().
+      * @returns The resident memory in bytes, or 0 if it cannot be read on this platform.
+      */
+    uint64_t getStartupMemory() const;
+
     /**
       * Returns the LogManager.
       * @returns the LogManager
       */
     LogManager* getLogManager();
 
+    /**
+      * Returns the JobSystem.
+      * @returns the JobSystem
+      */
+    JobSystem* getJobSystem();
+
     /**
       * Returns the StateManager.
       * @returns the StateManager
@@ -155,8 +201,12 @@ private:
 
     sf::Clock mSfClock;                 //!< Clock for keeping time since Initialize() was called.
     QCoreApplication* mCoreApplication; //!< Pointer to the Qt Core Application (required for QScriptEngine and command line parameter parsing).
+    Profile mProfile;                   //!< The profile the engine has been initialized with.
+    double mStartupTime;                //!< The time the last call of initialize() took, in seconds.
+    uint64_t mStartupMemory;            //!< The resident memory after the last call of initialize(), in bytes.
 
     LogManager* mLogManager;            //!< Pointer to the LogManager.
+    JobSystem* mJobSystem;              //!< Pointer to the JobSystem.
     ResourceManager* mResourceManager;  //!< Pointer to the ResourceManager.
     InputManager* mInputManager;        //!< Pointer to the InputManager.
     DisplayManager* mDisplayManager;    //!< Pointer to the DisplayManager.
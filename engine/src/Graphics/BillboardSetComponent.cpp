@@ -8,6 +8,7 @@
 
 #include <Graphics/BillboardSetComponent.hpp>
 
+#include <Graphics/DisplayManager.hpp>
 #include <Scene/Node.hpp>
 #include <Scene/Scene.hpp>
 #include <Utils/Utils.hpp>
@@ -18,6 +19,8 @@
 #include <OgreRectangle.h>
 #include <OgrePass.h>
 
+#include <QMutexLocker>
+
 #include <cstdint>
 
 namespace dt {
@@ -32,10 +35,14 @@ BillboardSetComponent::BillboardSetComponent(const QString name, uint32_t pool_s
     mTextureUnitState(nullptr) {}
 
 void BillboardSetComponent::onInitialize() {
-    mBillboardSet = getNode()->getScene()->getSceneManager()
-                    ->createBillboardSet(Utils::toStdString(mName), mPoolSize);
+    Ogre::SceneManager* scene_mgr = getNode()->getScene()->getSceneManager();
+    if(scene_mgr == nullptr)
+        return; // dedicated server
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    mBillboardSet = scene_mgr->createBillboardSet(Utils::toStdString(getName()), mPoolSize);
 
-    std::string material_name = Utils::toStdString(mName) + "_material";
+    std::string material_name = Utils::toStdString(getName()) + "_material";
     mMaterialPtr = Ogre::MaterialManager::getSingleton()
                                     .create(material_name, "General", true);
     mBillboardSet->setMaterial(mMaterialPtr);
@@ -53,35 +60,47 @@ void BillboardSetComponent::onInitialize() {
     pass->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA); // Allow transparency from alpha channel.
     mMaterialPtr->setLightingEnabled(false);   // Disable lighting.
 
-    mSceneNode = getNode()->getScene()->getSceneManager()->getRootSceneNode()
-                 ->createChildSceneNode(Utils::toStdString(mName) + "_node");
+    mSceneNode = scene_mgr->getRootSceneNode()->createChildSceneNode(Utils::toStdString(getName()) + "_node");
     mSceneNode->attachObject(mBillboardSet);
 }
 
 void BillboardSetComponent::onDeinitialize() {
     Ogre::SceneManager* scene_mgr = getNode()->getScene()->getSceneManager();
+    if(scene_mgr == nullptr)
+        return;
 
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     if(mBillboardSet != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mBillboardSet);
         scene_mgr->destroyBillboardSet(mBillboardSet);
     }
     
     if(mSceneNode != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mSceneNode);
         scene_mgr->destroySceneNode(mSceneNode);
     }
 }
 
 void BillboardSetComponent::onEnable() {
-    mBillboardSet->setVisible(true);
+    if(mBillboardSet != nullptr)
+        DisplayManager::get()->setVisible(mBillboardSet, true);
 }
 
 void BillboardSetComponent::onDisable() {
-    mBillboardSet->setVisible(false);
+    if(mBillboardSet != nullptr)
+        DisplayManager::get()->setVisible(mBillboardSet, false);
 }
 
 void BillboardSetComponent::onUpdate(double time_diff) {
-    mSceneNode->setPosition(getNode()->getPosition(Node::SCENE));
-    mSceneNode->setOrientation(getNode()->getRotation(Node::SCENE));
-    mSceneNode->setScale(getNode()->getScale(Node::SCENE));
+    onTransformChanged();
+}
+
+void BillboardSetComponent::onTransformChanged() {
+    if(mSceneNode == nullptr)
+        return;
+
+    DisplayManager::get()->setTransform(mSceneNode, getNode()->getPosition(Node::SCENE),
+                                        getNode()->getRotation(Node::SCENE), getNode()->getScale(Node::SCENE));
 }
 
 Ogre::BillboardSet* BillboardSetComponent::getOgreBillboardSet() const {
@@ -89,15 +108,22 @@ Ogre::BillboardSet* BillboardSetComponent::getOgreBillboardSet() const {
 }
 
 void BillboardSetComponent::setTextureFromFile(const QString file) {
+    if(mTextureUnitState == nullptr)
+        return;
+
     Ogre::TextureManager::getSingleton().load(Utils::toStdString(file), "General");
     mTextureUnitState->setTextureName(Utils::toStdString(file));
 }
 
 void BillboardSetComponent::setFaceCamera() {
-    mBillboardSet->setBillboardType(Ogre::BBT_POINT);
+    if(mBillboardSet != nullptr)
+        mBillboardSet->setBillboardType(Ogre::BBT_POINT);
 }
 
 void BillboardSetComponent::setOrientedCommon(const Ogre::Vector3& common_vector) {
+    if(mBillboardSet == nullptr)
+        return;
+
     mBillboardSet->setBillboardType(Ogre::BBT_ORIENTED_COMMON);
     mBillboardSet->setCommonDirection(common_vector);
 }
@@ -107,16 +133,23 @@ void BillboardSetComponent::setOrientedCommon(float x, float y, float z) {
 }
 
 void BillboardSetComponent::setOrientedSelf() {
-    mBillboardSet->setBillboardType(Ogre::BBT_ORIENTED_SELF);
+    if(mBillboardSet != nullptr)
+        mBillboardSet->setBillboardType(Ogre::BBT_ORIENTED_SELF);
 }
 
 void BillboardSetComponent::setPerpendicularCommon(const Ogre::Vector3& common_vector, const Ogre::Vector3& up_vector) {
+    if(mBillboardSet == nullptr)
+        return;
+
     mBillboardSet->setBillboardType(Ogre::BBT_PERPENDICULAR_COMMON);
     mBillboardSet->setCommonDirection(common_vector);
     mBillboardSet->setCommonUpVector(up_vector);
 }
 
 void BillboardSetComponent::setPerpendicularSelf(const Ogre::Vector3& up_vector) {
+    if(mBillboardSet == nullptr)
+        return;
+
     mBillboardSet->setBillboardType(Ogre::BBT_PERPENDICULAR_SELF);
     mBillboardSet->setCommonUpVector(up_vector);
 }
@@ -126,7 +159,8 @@ void BillboardSetComponent::setPerpendicularSelf(float x, float y, float z) {
 }
 
 void BillboardSetComponent::setDepthCheckEnabled(bool enabled) {
-    mMaterialPtr->setDepthCheckEnabled(enabled);
+    if(mBillboardSet != nullptr)
+        mMaterialPtr->setDepthCheckEnabled(enabled);
 }
 
 }
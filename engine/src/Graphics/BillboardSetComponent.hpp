@@ -46,6 +46,7 @@ public:
     void onEnable();
     void onDisable();
     void onUpdate(double time_diff);
+    void onTransformChanged();
 
     /**
       * Get the ogre BillboardSet.
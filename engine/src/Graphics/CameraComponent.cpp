@@ -15,16 +15,25 @@
 
 #include <OgreSceneManager.h>
 
+#include <QMutexLocker>
+
 namespace dt {
 
 CameraComponent::CameraComponent(const QString name)
-   : Component(name) {}
+   : Component(name),
+     mCamera(nullptr),
+     mViewport(nullptr) {}
 
 void CameraComponent::onInitialize() {
     // create the ogre context if not present
     DisplayManager::get()->createOgreRoot();
 
-    mCamera = getNode()->getScene()->getSceneManager()->createCamera("camera-" + dt::Utils::toStdString(mName));
+    Ogre::SceneManager* scene_mgr = getNode()->getScene()->getSceneManager();
+    if(scene_mgr == nullptr)
+        return; // dedicated server
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    mCamera = scene_mgr->createCamera("camera-" + dt::Utils::toStdString(getName()));
     mCamera->setNearClipDistance(0.1);
 
     mZOrder = DisplayManager::get()->getNextZOrder();
@@ -37,32 +46,55 @@ void CameraComponent::onInitialize() {
 }
 
 void CameraComponent::onDeinitialize() {
+    if(mCamera == nullptr)
+        return;
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     // reset the main camera if we were the main camera
     if(DisplayManager::get()->getMainCamera() == this)
         DisplayManager::get()->setMainCamera(nullptr);
 
+    DisplayManager::get()->forgetRenderObject(mCamera);
     mCamera->getSceneManager()->destroyCamera(mCamera);
     DisplayManager::get()->getRenderWindow()->removeViewport(mZOrder);
 }
 
 void CameraComponent::onEnable() {
-    mCamera->setVisible(true);
+    if(mCamera != nullptr)
+        DisplayManager::get()->setVisible(mCamera, true);
 }
 
 void CameraComponent::onDisable() {
-    mCamera->setVisible(false);
+    if(mCamera != nullptr)
+        DisplayManager::get()->setVisible(mCamera, false);
 }
 
 void CameraComponent::onUpdate(double time_diff) {
-    mCamera->setPosition(mNode->getPosition(Node::SCENE));
-    mCamera->setOrientation(mNode->getRotation(Node::SCENE));
+    onTransformChanged();
+}
+
+void CameraComponent::onTransformChanged() {
+    if(mCamera == nullptr)
+        return;
+
+    DisplayManager::get()->setCameraTransform(mCamera, mNode->getPosition(Node::SCENE), mNode->getRotation(Node::SCENE));
 }
 
 Ogre::Ray CameraComponent::getCameraToViewportRay(float x, float y) {
+    if(mCamera == nullptr)
+        return Ogre::Ray();
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     return mCamera->getCameraToViewportRay(x, y);
 }
 
 void CameraComponent::lookAt(Ogre::Vector3 target_point) {
+    if(mCamera == nullptr)
+        return;
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    // the camera may not have been moved to the node yet when its transform is in a snapshot
+    mCamera->setPosition(mNode->getPosition(Node::SCENE));
     mCamera->lookAt(target_point);
     mNode->setRotation(Ogre::Quaternion(mCamera->getOrientation()));
 }
@@ -72,7 +104,10 @@ void CameraComponent::lookAt(float x, float y, float z) {
 }
 
 void CameraComponent::setupViewport(float left, float top, float width, float height) {
-    mViewport->setDimensions(left, top, width, height);
+    if(mViewport != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mViewport->setDimensions(left, top, width, height);
+    }
 }
 
 Ogre::Camera* CameraComponent::getCamera() {
@@ -41,6 +41,7 @@ public:
     void onEnable();
     void onDisable();
     void onUpdate(double time_diff);
+    void onTransformChanged();
     Ogre::Ray getCameraToViewportRay(float x, float y);
     void lookAt(Ogre::Vector3 target_point);
     void lookAt(float x, float y, float z);
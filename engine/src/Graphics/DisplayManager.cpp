@@ -12,6 +12,9 @@
 #include <Utils/LogManager.hpp>
 #include <Input/InputManager.hpp>
 
+#include <OgreAnimationState.h>
+#include <OgreParticleSystem.h>
+
 #include <SFML/Window/VideoMode.hpp>
 
 namespace dt {
@@ -22,7 +25,10 @@ DisplayManager::DisplayManager()
       mOgreRenderParams(nullptr),
       mNextZOrder(0),
       mWindowSize(Ogre::Vector2(1024, 768)),
-      mFullscreen(false) {}
+      mFullscreen(false),
+      mIsPipelined(false),
+      mRecordingSnapshot(0),
+      mRenderMutex(QMutex::Recursive) {}
 
 DisplayManager::~DisplayManager() {}
 
@@ -66,13 +72,107 @@ void DisplayManager::setFullscreen(bool fullscreen, bool adjust_resolution) {
 }
 
 void DisplayManager::render() {
+    QMutexLocker lock(&mRenderMutex);
+    if(mIsPipelined)
+        getPublishedSnapshot()->apply();
+
     if(mOgreRoot != nullptr && mOgreRoot->isInitialised()) {
         mOgreRoot->renderOneFrame();
         Ogre::WindowEventUtilities::messagePump();
     }
 }
 
+void DisplayManager::setPipelined(bool pipelined) {
+    if(pipelined == mIsPipelined)
+        return;
+
+    // leaving pipelined mode, nothing recorded may be lost
+    if(!pipelined) {
+        QMutexLocker lock(&mRenderMutex);
+        getPublishedSnapshot()->apply();
+        getRecordingSnapshot()->apply();
+    }
+    mIsPipelined = pipelined;
+}
+
+bool DisplayManager::isPipelined() const {
+    return mIsPipelined;
+}
+
+void DisplayManager::publishSnapshot() {
+    if(!mIsPipelined)
+        return;
+
+    QMutexLocker lock(&mRenderMutex);
+    // the previous frame has not been rendered, keep what it changed
+    if(getPublishedSnapshot()->getSize() != 0 || getPublishedSnapshot()->hasListener()) {
+        getPublishedSnapshot()->apply();
+    }
+    mRecordingSnapshot = 1 - mRecordingSnapshot;
+}
+
+RenderSnapshot* DisplayManager::getRecordingSnapshot() {
+    return mIsPipelined ? &mSnapshots[mRecordingSnapshot] : nullptr;
+}
+
+RenderSnapshot* DisplayManager::getPublishedSnapshot() {
+    return mIsPipelined ? &mSnapshots[1 - mRecordingSnapshot] : nullptr;
+}
+
+QMutex* DisplayManager::getRenderMutex() {
+    return &mRenderMutex;
+}
+
+void DisplayManager::setTransform(Ogre::SceneNode* scene_node, const Ogre::Vector3& position,
+                                  const Ogre::Quaternion& rotation, const Ogre::Vector3& scale) {
+    if(mIsPipelined) {
+        mSnapshots[mRecordingSnapshot].setTransform(scene_node, position, rotation, scale);
+    } else {
+        scene_node->setPosition(position);
+        scene_node->setOrientation(rotation);
+        scene_node->setScale(scale);
+    }
+}
+
+void DisplayManager::setCameraTransform(Ogre::Camera* camera, const Ogre::Vector3& position, const Ogre::Quaternion& rotation) {
+    if(mIsPipelined) {
+        mSnapshots[mRecordingSnapshot].setCameraTransform(camera, position, rotation);
+    } else {
+        camera->setPosition(position);
+        camera->setOrientation(rotation);
+    }
+}
+
+void DisplayManager::setVisible(Ogre::MovableObject* object, bool visible) {
+    if(mIsPipelined)
+        mSnapshots[mRecordingSnapshot].setVisible(object, visible);
+    else
+        object->setVisible(visible);
+}
+
+void DisplayManager::setAnimationTime(Ogre::AnimationState* animation, float time_position) {
+    if(mIsPipelined)
+        mSnapshots[mRecordingSnapshot].setAnimationTime(animation, time_position);
+    else
+        animation->setTimePosition(time_position);
+}
+
+void DisplayManager::setEmitting(Ogre::ParticleSystem* particle_system, bool emitting) {
+    if(mIsPipelined)
+        mSnapshots[mRecordingSnapshot].setEmitting(particle_system, emitting);
+    else
+        particle_system->setEmitting(emitting);
+}
+
+void DisplayManager::forgetRenderObject(const void* object) {
+    mSnapshots[0].forget(object);
+    mSnapshots[1].forget(object);
+}
+
 Ogre::SceneManager* DisplayManager::getSceneManager(const QString scene) {
+    if(Root::getInstance().isHeadless())
+        return nullptr;
+
     if(mSceneManagers.count(scene) == 0) {
         _createWindow(); // TODO check if window already present
 
@@ -144,7 +244,7 @@ void DisplayManager::_destroyWindow() {
 }
 
 void DisplayManager::createOgreRoot() {
-    if(mOgreRoot == nullptr) {
+    if(mOgreRoot == nullptr && !Root::getInstance().isHeadless()) {
         _createWindow();
     }
 }
@@ -13,6 +13,7 @@
 
 #include <Core/Manager.hpp>
 #include <Graphics/CameraComponent.hpp>
+#include <Graphics/RenderSnapshot.hpp>
 #include <Graphics/Viewport.hpp>
 #include <Gui/GuiManager.hpp>
 
@@ -21,6 +22,7 @@
 #include <OgreSceneManager.h>
 #include <OgreRoot.h>
 
+#include <QMutex>
 #include <QString>
 
 #include <map>
@@ -53,14 +55,101 @@ public:
     static DisplayManager* get();
 
     /**
-      * Renders the current frame.
+      * Renders the current frame. When rendering is pipelined, the published RenderSnapshot is applied first.
       */
     void render();
 
+    /**
+      * Sets whether the simulation runs on another thread than the rendering. The simulation then records the
+      * transforms, visibility, animation times, particle emitters and audio listener into a RenderSnapshot
+      * instead of changing the Ogre objects, and the snapshot is applied when the frame is rendered. Every
+      * other change to Ogre objects made by the simulation has to hold the render mutex.
+      * @param pipelined Whether rendering is pipelined. Default: false.
+      * @see Game::setPipelinedRendering(bool pipelined)
+      */
+    void setPipelined(bool pipelined);
+
+    /**
+      * Returns whether rendering is pipelined.
+      * @returns Whether rendering is pipelined.
+      */
+    bool isPipelined() const;
+
+    /**
+      * Makes the snapshot the simulation recorded the one to be rendered next, and gives the simulation an
+      * empty one. Must only be called while the simulation is not running.
+      */
+    void publishSnapshot();
+
+    /**
+      * Returns the snapshot the simulation records into.
+      * @returns The snapshot, or nullptr if rendering is not pipelined.
+      */
+    RenderSnapshot* getRecordingSnapshot();
+
+    /**
+      * Returns the snapshot that will be applied by the next render().
+      * @returns The snapshot, or nullptr if rendering is not pipelined.
+      */
+    RenderSnapshot* getPublishedSnapshot();
+
+    /**
+      * Returns the mutex that is held while a frame is rendered. It is recursive.
+      * @returns The render mutex.
+      */
+    QMutex* getRenderMutex();
+
+    /**
+      * Sets the world transform of a scene node, or records it if rendering is pipelined.
+      * @param scene_node The scene node.
+      * @param position The position.
+      * @param rotation The orientation.
+      * @param scale The scale.
+      */
+    void setTransform(Ogre::SceneNode* scene_node, const Ogre::Vector3& position,
+                      const Ogre::Quaternion& rotation, const Ogre::Vector3& scale);
+
+    /**
+      * Sets the world transform of a camera, or records it if rendering is pipelined.
+      * @param camera The camera.
+      * @param position The position.
+      * @param rotation The orientation.
+      */
+    void setCameraTransform(Ogre::Camera* camera, const Ogre::Vector3& position, const Ogre::Quaternion& rotation);
+
+    /**
+      * Sets the visibility of a movable object, or records it if rendering is pipelined.
+      * @param object The movable object.
+      * @param visible Whether it is visible.
+      */
+    void setVisible(Ogre::MovableObject* object, bool visible);
+
+    /**
+      * Sets the time position of an animation, or records it if rendering is pipelined.
+      * @param animation The animation state.
+      * @param time_position The time position, in seconds.
+      */
+    void setAnimationTime(Ogre::AnimationState* animation, float time_position);
+
+    /**
+      * Sets whether a particle system emits, or records it if rendering is pipelined.
+      * @param particle_system The particle system.
+      * @param emitting Whether it emits.
+      */
+    void setEmitting(Ogre::ParticleSystem* particle_system, bool emitting);
+
+    /**
+      * Removes an Ogre object from both snapshots. Has to be called with the render mutex held, before the
+      * object is destroyed.
+      * @param object The Ogre object.
+      */
+    void forgetRenderObject(const void* object);
+
     /**
       * Returns the Ogre::SceneManager for a scene. Creates a new SceneManager if none exists for that scene.
       * @param scene The name of the scene.
-      * @returns A pointer to the Ogre::SceneManager.
+      * @returns A pointer to the Ogre::SceneManager, or nullptr on a dedicated server.
+      * @see Root::DEDICATED_SERVER
       */
     Ogre::SceneManager* getSceneManager(const QString scene);
 
@@ -71,7 +160,7 @@ public:
     void setRenderWindowParams(Ogre::NameValuePairList* params);
 
     /**
-      * Initializes the Ogre Render System.
+      * Initializes the Ogre Render System. Does nothing on a dedicated server.
       */
     void createOgreRoot();
 
@@ -141,6 +230,11 @@ private:
 
     GuiManager mGuiManager;     //!< The GuiManager.
 
+    bool mIsPipelined;                  //!< Whether rendering is pipelined.
+    RenderSnapshot mSnapshots[2];       //!< The snapshot being recorded and the one to be rendered.
+    uint32_t mRecordingSnapshot;        //!< The index of the snapshot being recorded.
+    QMutex mRenderMutex;                //!< Held while a frame is rendered.
+
     int mNextZOrder;            //!< The z-order for the next viewport to be created.
     Ogre::Vector2 mWindowSize;  //!< The size of the window, in pixels (integer).
     bool mFullscreen;           //!< Whether the window should be fullscreen.
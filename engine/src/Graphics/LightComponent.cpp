@@ -8,12 +8,15 @@
 
 #include <Graphics/LightComponent.hpp>
 
+#include <Graphics/DisplayManager.hpp>
 #include <Scene/Node.hpp>
 #include <Scene/Scene.hpp>
 #include <Utils/Utils.hpp>
 
 #include <OgreSceneManager.h>
 
+#include <QMutexLocker>
+
 namespace dt {
 
 LightComponent::LightComponent(const QString name)
@@ -23,7 +26,12 @@ LightComponent::LightComponent(const QString name)
       mCastShadows(true) {}
 
 void LightComponent::onInitialize() {
-    mLight = getNode()->getScene()->getSceneManager()->createLight(Utils::toStdString(mName));
+    Ogre::SceneManager* scene_mgr = getNode()->getScene()->getSceneManager();
+    if(scene_mgr == nullptr)
+        return; // dedicated server
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    mLight = scene_mgr->createLight(Utils::toStdString(getName()));
 
     // Set the point light as the default light type
     mLight->setType(Ogre::Light::LT_POINT);
@@ -33,38 +41,63 @@ void LightComponent::onInitialize() {
     mLight->setSpecularColour(1.0, 1.0, 1.0);
     mLight->setDirection(Ogre::Vector3(0,0,1));
 
-    mSceneNode = getNode()->getScene()->getSceneManager()->getRootSceneNode()->
-                                        createChildSceneNode(Utils::toStdString(mName) + "-node");
+    mSceneNode = scene_mgr->getRootSceneNode()->createChildSceneNode(Utils::toStdString(getName()) + "-node");
     mSceneNode->attachObject(mLight);
 }
 
 void LightComponent::onDeinitialize() {
     Ogre::SceneManager* scene_mgr = getNode()->getScene()->getSceneManager();
+    if(scene_mgr == nullptr)
+        return;
 
-    if(mLight != nullptr)
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    if(mLight != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mLight);
         scene_mgr->destroyLight(mLight);
+    }
 
-    if(mSceneNode != nullptr)
+    if(mSceneNode != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mSceneNode);
         scene_mgr->destroySceneNode(mSceneNode);
+    }
 }
 
 void LightComponent::onEnable() {
-    mLight->setVisible(true);
+    if(mLight != nullptr)
+        DisplayManager::get()->setVisible(mLight, true);
 }
 
 void LightComponent::onDisable() {
-    mLight->setVisible(false);
+    if(mLight != nullptr)
+        DisplayManager::get()->setVisible(mLight, false);
 }
 
 void LightComponent::onUpdate(double time_diff) {
-    mSceneNode->setPosition(getNode()->getPosition(Node::SCENE));
-    mSceneNode->setOrientation(getNode()->getRotation(Node::SCENE));
-    mSceneNode->setScale(getNode()->getScale(Node::SCENE));
+    onTransformChanged();
+}
+
+uint32_t LightComponent::getReadAccess() const {
+    return OWN_TRANSFORM;
+}
+
+uint32_t LightComponent::getWriteAccess() const {
+    return ENGINE;
+}
+
+void LightComponent::onTransformChanged() {
+    if(mSceneNode == nullptr)
+        return;
+
+    DisplayManager::get()->setTransform(mSceneNode, getNode()->getPosition(Node::SCENE),
+                                        getNode()->getRotation(Node::SCENE), getNode()->getScale(Node::SCENE));
 }
 
 void LightComponent::setColor(const Ogre::ColourValue color) {
-    mLight->setDiffuseColour(color);
-    mLight->setSpecularColour(color);
+    if(mLight != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mLight->setDiffuseColour(color);
+        mLight->setSpecularColour(color);
+    }
     emit colorChanged(color);
 }
 
@@ -79,6 +112,7 @@ Ogre::Light* LightComponent::getOgreLight() const {
 void LightComponent::setCastShadows(bool cast_shadows) {
     mCastShadows = cast_shadows;
     if(mLight != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mLight->setCastShadows(mCastShadows);
     }
 }
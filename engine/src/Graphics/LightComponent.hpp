@@ -42,6 +42,9 @@ public:
     void onEnable();
     void onDisable();
     void onUpdate(double time_diff);
+    uint32_t getReadAccess() const;
+    uint32_t getWriteAccess() const;
+    void onTransformChanged();
 
     /**
       * Get the ogre light object.
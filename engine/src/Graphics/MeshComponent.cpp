@@ -8,12 +8,17 @@
 
 #include <Graphics/MeshComponent.hpp>
 
+#include <Graphics/DisplayManager.hpp>
 #include <Scene/Node.hpp>
 #include <Scene/Scene.hpp>
 #include <Utils/Utils.hpp>
 
 #include <OgreSceneManager.h>
 
+#include <QMutexLocker>
+
+#include <cmath>
+
 namespace dt {
 
 MeshComponent::MeshComponent(const QString mesh_handle, const QString material_name, const QString name)
@@ -21,12 +26,18 @@ MeshComponent::MeshComponent(const QString mesh_handle, const QString material_n
       mSceneNode(nullptr),
       mEntity(nullptr),
       mAnimationState(nullptr),
+      mAnimationTime(0),
+      mIsAnimationPlaying(false),
       mLoopAnimation(false),
-      mCastShadows(true) {
-    mMeshHandle = mesh_handle;
-    mMaterialName = material_name;
+      mIsBaked(false) {
+    MeshData& data = mData.edit();
+    data.mMeshHandle = mesh_handle;
+    data.mMaterialName = material_name;
 }
 
+MeshComponent::MeshData::MeshData()
+    : mCastShadows(true) {}
+
 void MeshComponent::onInitialize() {
     _loadMesh();
 }
@@ -36,39 +47,112 @@ void MeshComponent::onDeinitialize() {
 }
 
 void MeshComponent::onEnable() {
-    mEntity->setVisible(true);
+    if(mEntity == nullptr)
+        return; // dedicated server
+
+    if(mIsBaked)
+        getNode()->getScene()->_addStaticMesh(this);
+    else
+        DisplayManager::get()->setVisible(mEntity, true);
 }
 
 void MeshComponent::onDisable() {
-    mEntity->setVisible(false);
+    if(mEntity == nullptr)
+        return;
+
+    if(mIsBaked)
+        getNode()->getScene()->_removeStaticMesh(this);
+    else
+        DisplayManager::get()->setVisible(mEntity, false);
 }
 
 void MeshComponent::onUpdate(double time_diff) {
+    if(getNode()->hasTransformChanged())
+        onTransformChanged();
+
+    if(mAnimationState != nullptr && mIsAnimationPlaying) {
+        // the time is kept here, the animation state may be read by the render thread
+        mAnimationTime += time_diff;
+        float length = mAnimationState->getLength();
+        if(mLoopAnimation && length > 0)
+            mAnimationTime = std::fmod(mAnimationTime, length);
+        else if(mAnimationTime > length)
+            mAnimationTime = length;
+        DisplayManager::get()->setAnimationTime(mAnimationState, mAnimationTime);
+    }
+}
+
+uint32_t MeshComponent::getReadAccess() const {
+    return OWN_TRANSFORM;
+}
+
+uint32_t MeshComponent::getWriteAccess() const {
+    return ENGINE;
+}
+
+void MeshComponent::onTransformChanged() {
+    if(mSceneNode == nullptr)
+        return;
+
     // set position, rotation and scale of the node
-    mSceneNode->setPosition(getNode()->getPosition(Node::SCENE));
-    mSceneNode->setOrientation(getNode()->getRotation(Node::SCENE));
-    mSceneNode->setScale(getNode()->getScale(Node::SCENE));
+    DisplayManager::get()->setTransform(mSceneNode, getNode()->getPosition(Node::SCENE),
+                                        getNode()->getRotation(Node::SCENE), getNode()->getScale(Node::SCENE));
+}
+
+void MeshComponent::onBake() {
+    mIsBaked = true;
+    if(mEntity == nullptr)
+        return;
+
+    DisplayManager::get()->setVisible(mEntity, false);
+    if(isEnabled())
+        getNode()->getScene()->_addStaticMesh(this);
+}
+
+void MeshComponent::onUnbake() {
+    mIsBaked = false;
+    if(mEntity == nullptr)
+        return;
 
-    if(mAnimationState != nullptr && mAnimationState->getEnabled()) {
-        mAnimationState->addTime(time_diff);
+    if(isEnabled()) {
+        getNode()->getScene()->_removeStaticMesh(this);
+        DisplayManager::get()->setVisible(mEntity, true);
     }
+    onTransformChanged();
 }
 
 void MeshComponent::onSerialize(IOPacket& packet) {
-    packet.stream(mMeshHandle, "mesh");
-    packet.stream(mMaterialName, "material");
+    QString mesh_handle = mData->mMeshHandle;
+    QString material_name = mData->mMaterialName;
+    packet.stream(mesh_handle, "mesh");
+    packet.stream(material_name, "material");
+
+    if(packet.getDirection() == IOPacket::DESERIALIZE) {
+        MeshData& data = mData.edit();
+        data.mMeshHandle = mesh_handle;
+        data.mMaterialName = material_name;
+    }
+}
+
+Component* MeshComponent::clone() {
+    MeshComponent* component = new MeshComponent("", "", getName());
+    component->mData = mData;
+    return component;
 }
 
 void MeshComponent::setMeshHandle(const QString mesh_handle) {
-    if(mesh_handle != mMeshHandle && isInitialized()) {
+    if(mesh_handle == mData->mMeshHandle)
+        return;
+
+    mData.edit().mMeshHandle = mesh_handle;
+    if(isInitialized()) {
         // we got a new mesh; load it
         _loadMesh();
     }
-    mMeshHandle = mesh_handle;
 }
 
 const QString MeshComponent::getMeshHandle() const {
-    return mMeshHandle;
+    return mData->mMeshHandle;
 }
 
 std::vector<QString> MeshComponent::getAvailableAnimations() {
@@ -87,6 +171,11 @@ std::vector<QString> MeshComponent::getAvailableAnimations() {
 
 void MeshComponent::setAnimation(const QString animation_state) {
     if(mEntity != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        if(mAnimationState != nullptr)
+            DisplayManager::get()->forgetRenderObject(mAnimationState);
+        mAnimationTime = 0;
+        mIsAnimationPlaying = false;
         mAnimationState = mEntity->getAnimationState(Utils::toStdString(animation_state));
         mAnimationState->setLoop(mLoopAnimation);
     } else {
@@ -95,7 +184,9 @@ void MeshComponent::setAnimation(const QString animation_state) {
 }
 
 void MeshComponent::playAnimation() {
-    if(mAnimationState != nullptr && mAnimationState->getEnabled() != true) {
+    if(mAnimationState != nullptr && !mIsAnimationPlaying) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mIsAnimationPlaying = true;
         mAnimationState->setEnabled(true);
         emit animationPlayed();
     } else {
@@ -104,9 +195,12 @@ void MeshComponent::playAnimation() {
 }
 
 void MeshComponent::stopAnimation() {
-    if(mAnimationState != nullptr && mAnimationState->getEnabled() != false) {
+    if(mAnimationState != nullptr && mIsAnimationPlaying) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mIsAnimationPlaying = false;
+        mAnimationTime = 0;
         mAnimationState->setEnabled(false);
-        mAnimationState->setTimePosition(0);
+        DisplayManager::get()->setAnimationTime(mAnimationState, 0);
         emit animationStopped();
     } else {
         Logger::get().error("Cannot stop animation of component " + getName() + ": No animation set.");
@@ -114,7 +208,9 @@ void MeshComponent::stopAnimation() {
 }
 
 void MeshComponent::pauseAnimation() {
-    if(mAnimationState != nullptr && mAnimationState->getEnabled() != false) {
+    if(mAnimationState != nullptr && mIsAnimationPlaying) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mIsAnimationPlaying = false;
         mAnimationState->setEnabled(false);
         emit animationPaused();
     } else {
@@ -125,6 +221,7 @@ void MeshComponent::pauseAnimation() {
 void MeshComponent::setLoopAnimation(bool loop_animation) {
     mLoopAnimation = loop_animation;
     if(mAnimationState != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mAnimationState->setLoop(mLoopAnimation);
     }
 }
@@ -134,8 +231,11 @@ bool MeshComponent::getLoopAnimation() {
 }
 
 void MeshComponent::setMaterialName(const QString material_name) {
-    mMaterialName = material_name;
-    if(mEntity != nullptr && mMaterialName != "") {
+    // only write when changed, to keep sharing the configuration with the other clones
+    if(material_name != mData->mMaterialName)
+        mData.edit().mMaterialName = material_name;
+    if(mEntity != nullptr && material_name != "") {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mEntity->setMaterialName(Utils::toStdString(material_name));
     }
 }
@@ -149,42 +249,74 @@ Ogre::Entity* MeshComponent::getOgreEntity() const {
 }
 
 void MeshComponent::setCastShadows(bool cast_shadows) {
-    mCastShadows = cast_shadows;
+    if(cast_shadows != mData->mCastShadows)
+        mData.edit().mCastShadows = cast_shadows;
     if(mEntity != nullptr) {
-        mEntity->setCastShadows(mCastShadows);
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mEntity->setCastShadows(cast_shadows);
     }
 }
 
 bool MeshComponent::getCastShadows() const {
-    return mCastShadows;
+    return mData->mCastShadows;
 }
 
 void MeshComponent::_loadMesh() {
     // destroy existing mesh and scene node
     _destroyMesh();
 
-    if(mMeshHandle == "") {
-        Logger::get().error("MeshComponent ["+ mName + "]: Needs a mesh handle.");
+    if(mData->mMeshHandle == "") {
+        Logger::get().error("MeshComponent ["+ getName() + "]: Needs a mesh handle.");
     }
 
     Ogre::SceneManager* scene_mgr = getNode()->getScene()->getSceneManager();
+    if(scene_mgr == nullptr)
+        return; // dedicated server
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     std::string nodename = Utils::toStdString(getNode()->getName());
-    mEntity = scene_mgr->createEntity(nodename + "-mesh-entity-" + Utils::toStdString(mName),
-                                                             Utils::toStdString(mMeshHandle));
-    setMaterialName(mMaterialName);
-    mSceneNode = scene_mgr->getRootSceneNode()->createChildSceneNode(nodename + "-mesh-scenenode-" + Utils::toStdString(mName));
+    mEntity = scene_mgr->createEntity(nodename + "-mesh-entity-" + Utils::toStdString(getName()),
+                                                             Utils::toStdString(mData->mMeshHandle));
+    setMaterialName(mData->mMaterialName);
+    mSceneNode = scene_mgr->getRootSceneNode()->createChildSceneNode(nodename + "-mesh-scenenode-" + Utils::toStdString(getName()));
     mSceneNode->attachObject(mEntity);
-    setCastShadows(mCastShadows);
+    setCastShadows(mData->mCastShadows);
+    // later frames only synchronize it when the node moves
+    onTransformChanged();
+
+    if(mIsBaked) {
+        // the static geometry still holds a copy of the old mesh
+        DisplayManager::get()->setVisible(mEntity, false);
+        if(isEnabled()) {
+            getNode()->getScene()->_removeStaticMesh(this);
+            getNode()->getScene()->_addStaticMesh(this);
+        }
+    }
 }
 
 void MeshComponent::_destroyMesh() {
     Ogre::SceneManager* scene_mgr = getNode()->getScene()->getSceneManager();
+    if(scene_mgr == nullptr)
+        return;
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    if(mAnimationState != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mAnimationState);
+        mAnimationState = nullptr;
+        mIsAnimationPlaying = false;
+    }
 
-    if(mEntity != nullptr)
+    if(mEntity != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mEntity);
         scene_mgr->destroyEntity(mEntity);
+        mEntity = nullptr;
+    }
 
-    if(mSceneNode != nullptr)
+    if(mSceneNode != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mSceneNode);
         scene_mgr->destroySceneNode(mSceneNode);
+        mSceneNode = nullptr;
+    }
 }
 
 }
@@ -12,6 +12,7 @@
 #include <Config.hpp>
 
 #include <Scene/Component.hpp>
+#include <Utils/CopyOnWrite.hpp>
 
 #include <OgreAnimationState.h>
 #include <OgreEntity.h>
@@ -48,7 +49,22 @@ public:
     void onEnable();
     void onDisable();
     void onUpdate(double time_diff);
+    uint32_t getReadAccess() const;
+    uint32_t getWriteAccess() const;
+    void onTransformChanged();
+
+    /**
+      * Hides the entity and merges the mesh into the static geometry of the Scene.
+      * @see Scene::getStaticGeometry()
+      */
+    void onBake();
+
+    /**
+      * Removes the mesh from the static geometry and shows the entity again.
+      */
+    void onUnbake();
     void onSerialize(IOPacket &packet);
+    Component* clone();
 
     /**
       * Sets the handle the mesh is being loaded from.
@@ -102,7 +118,7 @@ public:
 
     /**
       * Gets the Ogre::Entity;
-      * @returns The Ogre::Entity representing this mesh.
+      * @returns The Ogre::Entity representing this mesh, or nullptr on a dedicated server.
       */
     Ogre::Entity* getOgreEntity() const;
 
@@ -140,6 +156,17 @@ signals:
     void animationPaused();
 
 private:
+    /**
+      * The configuration of a MeshComponent, shared with its clones.
+      */
+    struct MeshData {
+        MeshData();
+
+        QString mMeshHandle;    //!< The handle of the mesh.
+        QString mMaterialName;  //!< The name of the material to apply to the mesh.
+        bool mCastShadows;      //!< Whether the mesh should cast shadows.
+    };
+
     /**
       * Private method. Loads the mesh handle.
       */
@@ -154,11 +181,12 @@ private:
     Ogre::Entity* mEntity;          //!< The actual mesh.
 
     Ogre::AnimationState* mAnimationState;  //!< The current animation state.
+    float mAnimationTime;           //!< The time position of the current animation.
+    bool mIsAnimationPlaying;       //!< Whether the current animation is playing.
     bool mLoopAnimation;            //!< Whether the animation shall be looped.
+    bool mIsBaked;                  //!< Whether the mesh is part of the static geometry instead of the entity.
 
-    QString mMeshHandle;        //!< The handle of the mesh.
-    QString mMaterialName;      //!< The name of the material to apply to the mesh.
-    bool mCastShadows;              //!< Whether the mesh should cast shadows.
+    CopyOnWrite<MeshData> mData;    //!< The mesh handle, material and shadow setting.
 };
 
 }
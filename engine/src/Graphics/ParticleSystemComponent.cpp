@@ -8,6 +8,7 @@
 
 #include <Graphics/ParticleSystemComponent.hpp>
 
+#include <Graphics/DisplayManager.hpp>
 #include <Scene/Node.hpp>
 #include <Scene/Scene.hpp>
 #include <Utils/Utils.hpp>
@@ -15,6 +16,8 @@
 #include <OgreParticleAffector.h>
 #include <OgreSceneManager.h>
 
+#include <QMutexLocker>
+
 namespace dt {
 
 ParticleSystemComponent::ParticleSystemComponent(const QString name)
@@ -25,7 +28,8 @@ ParticleSystemComponent::ParticleSystemComponent(const QString name)
 
 void ParticleSystemComponent::setParticleCountLimit(uint32_t limit) {
     mParticleCountLimit = limit;
-    if(isInitialized()) {
+    if(isInitialized() && mParticleSystem != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mParticleSystem->setParticleQuota(mParticleCountLimit);
     }
 }
@@ -37,6 +41,7 @@ uint32_t ParticleSystemComponent::getParticleCountLimit() const {
 void ParticleSystemComponent::setMaterialName(const QString material_name) {
     mMaterialName = material_name;
     if(isInitialized() && mParticleSystem != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mParticleSystem->setMaterialName(Utils::toStdString(mMaterialName));
     }
 }
@@ -46,6 +51,10 @@ const QString ParticleSystemComponent::getMaterialName() const {
 }
 
 Ogre::ParticleEmitter* ParticleSystemComponent::addEmitter(const QString name, const QString type) {
+    if(mParticleSystem == nullptr)
+        return nullptr; // dedicated server
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     Ogre::ParticleEmitter* e = mParticleSystem->addEmitter(Utils::toStdString(type));
     mParticleEmitters[name] = e;
     return e;
@@ -58,6 +67,10 @@ Ogre::ParticleEmitter* ParticleSystemComponent::getEmitter(const QString name) {
 }
 
 Ogre::ParticleAffector* ParticleSystemComponent::addAffector(const QString name, const QString type) {
+    if(mParticleSystem == nullptr)
+        return nullptr; // dedicated server
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     Ogre::ParticleAffector* a = mParticleSystem->addAffector(Utils::toStdString(type));
     mParticleAffectors[name] = a;
     return a;
@@ -71,15 +84,17 @@ Ogre::ParticleAffector* ParticleSystemComponent::getAffector(const QString name)
 
 Ogre::ParticleAffector* ParticleSystemComponent::addScalerAffector(const QString name, float rate) {
     Ogre::ParticleAffector* a = addAffector(name, "Scaler");
-    a->setParameter("rate", Utils::toStdString(Utils::toString(rate)));
+    if(a != nullptr)
+        a->setParameter("rate", Utils::toStdString(Utils::toString(rate)));
     return a;
 }
 
 Ogre::ParticleAffector* ParticleSystemComponent::addLinearForceAffector(const QString name, Ogre::Vector3 force) {
     Ogre::ParticleAffector* a = addAffector(name, "LinearForce");
-    a->setParameter("force_vector", Utils::toStdString(Utils::toString(force.x)) + " " + \
-                    Utils::toStdString(Utils::toString(force.y)) + " " + \
-                    Utils::toStdString(Utils::toString(force.z)));
+    if(a != nullptr)
+        a->setParameter("force_vector", Utils::toStdString(Utils::toString(force.x)) + " " + \
+                        Utils::toStdString(Utils::toString(force.y)) + " " + \
+                        Utils::toStdString(Utils::toString(force.z)));
     return a;
 }
 
@@ -93,40 +108,55 @@ Ogre::ParticleSystem* ParticleSystemComponent::getOgreParticleSystem() {
 void ParticleSystemComponent::onInitialize() {
     if(mNode != nullptr) {
         Ogre::SceneManager* scene_mgr = mNode->getScene()->getSceneManager();
-        mSceneNode = scene_mgr->getRootSceneNode()->createChildSceneNode(Utils::toStdString(mName) + "-node");
-        mParticleSystem = scene_mgr->createParticleSystem(Utils::toStdString(mName) + "-system", mParticleCountLimit);
+        if(scene_mgr == nullptr)
+            return; // dedicated server
+
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mSceneNode = scene_mgr->getRootSceneNode()->createChildSceneNode(Utils::toStdString(getName()) + "-node");
+        mParticleSystem = scene_mgr->createParticleSystem(Utils::toStdString(getName()) + "-system", mParticleCountLimit);
         if(mMaterialName != "")
             mParticleSystem->setMaterialName(Utils::toStdString(mMaterialName));
         mSceneNode->attachObject(mParticleSystem);
         mParticleSystem->setDefaultDimensions(1, 1);
     } else {
-        Logger::get().warning("Cannot create ParticleSystemComponent " + mName + ": not attached to a Node.");
+        Logger::get().warning("Cannot create ParticleSystemComponent " + getName() + ": not attached to a Node.");
     }
 }
 
 void ParticleSystemComponent::onDeinitialize() {
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     if(mNode != nullptr && mParticleSystem != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mParticleSystem);
         mNode->getScene()->getSceneManager()->destroyParticleSystem(mParticleSystem);
         mParticleSystem = nullptr;
     }
     if(mNode != nullptr && mSceneNode != nullptr) {
+        DisplayManager::get()->forgetRenderObject(mSceneNode);
         mNode->getScene()->getSceneManager()->destroySceneNode(mSceneNode);
         mSceneNode = nullptr;
     }
 }
 
 void ParticleSystemComponent::onEnable() {
-    mParticleSystem->setEmitting(true);
+    if(mParticleSystem != nullptr)
+        DisplayManager::get()->setEmitting(mParticleSystem, true);
 }
 
 void ParticleSystemComponent::onDisable() {
-    mParticleSystem->setEmitting(false);
+    if(mParticleSystem != nullptr)
+        DisplayManager::get()->setEmitting(mParticleSystem, false);
 }
 
 void ParticleSystemComponent::onUpdate(double time_diff) {
-    mSceneNode->setPosition(mNode->getPosition(Node::SCENE));
-    mSceneNode->setOrientation(mNode->getRotation(Node::SCENE));
-    mSceneNode->setScale(mNode->getScale(Node::SCENE));
+    onTransformChanged();
+}
+
+void ParticleSystemComponent::onTransformChanged() {
+    if(mSceneNode == nullptr)
+        return;
+
+    DisplayManager::get()->setTransform(mSceneNode, mNode->getPosition(Node::SCENE),
+                                        mNode->getRotation(Node::SCENE), mNode->getScale(Node::SCENE));
 }
 
 }
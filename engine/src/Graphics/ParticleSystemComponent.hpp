@@ -69,7 +69,7 @@ public:
       * @param name The name for the new emitter.
       * @param type The type of the Ogre emitter.
       * @see http://www.ogre3d.org/docs/manual/manual_36.html#SEC208
-      * @returns The newly created particle emitter.
+      * @returns The newly created particle emitter, or nullptr on a dedicated server.
       */
     Ogre::ParticleEmitter* addEmitter(const QString name, const QString type = "Point");
 
@@ -85,7 +85,7 @@ public:
       * @param name The name for the new affector.
       * @param type The type of the Ogre affector.
       * @see http://www.ogre3d.org/docs/manual/manual_40.html#SEC234
-      * @returns The newly created particle affector.
+      * @returns The newly created particle affector, or nullptr on a dedicated server.
       */
     Ogre::ParticleAffector* addAffector(const QString name, const QString type);
 
@@ -104,7 +104,7 @@ public:
       * @see Ogre::ParticleAffector* addAffector(const QString name, const QString type);
       * @param name The name for the new affector.
       * @param rate The scaling rate per second.
-      * @returns The newly created particle affector.
+      * @returns The newly created particle affector, or nullptr on a dedicated server.
       */
     Ogre::ParticleAffector* addScalerAffector(const QString name, float rate);
 
@@ -114,7 +114,7 @@ public:
       * @see Ogre::ParticleAffector* addAffector(const QString name, const QString type);
       * @param name The name for the new affector.
       * @param force The force vector to apply to all particles.
-      * @returns The newly created particle affector.
+      * @returns The newly created particle affector, or nullptr on a dedicated server.
       */
     Ogre::ParticleAffector* addLinearForceAffector(const QString name, Ogre::Vector3 force);
 
@@ -129,6 +129,7 @@ public:
     void onEnable();
     void onDisable();
     void onUpdate(double time_diff);
+    void onTransformChanged();
 
 private:
     Ogre::SceneNode* mSceneNode;                //!< The Ogre::SceneNode this particle system is attached to.
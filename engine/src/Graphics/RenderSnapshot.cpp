@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Graphics/RenderSnapshot.hpp>
+
+#include <OgreAnimationState.h>
+#include <OgreCamera.h>
+#include <OgreMovableObject.h>
+#include <OgreParticleSystem.h>
+#include <OgreSceneNode.h>
+
+#include <SFML/Audio/Listener.hpp>
+
+namespace dt {
+
+RenderSnapshot::RenderSnapshot()
+    : mHasListener(false) {}
+
+void RenderSnapshot::setTransform(Ogre::SceneNode* scene_node, const Ogre::Vector3& position,
+                                  const Ogre::Quaternion& rotation, const Ogre::Vector3& scale) {
+    Entry& entry = _getEntry(scene_node, TRANSFORM);
+    entry.mPosition = position;
+    entry.mRotation = rotation;
+    entry.mScale = scale;
+}
+
+void RenderSnapshot::setCameraTransform(Ogre::Camera* camera, const Ogre::Vector3& position, const Ogre::Quaternion& rotation) {
+    Entry& entry = _getEntry(camera, CAMERA_TRANSFORM);
+    entry.mPosition = position;
+    entry.mRotation = rotation;
+}
+
+void RenderSnapshot::setVisible(Ogre::MovableObject* object, bool visible) {
+    _getEntry(object, VISIBILITY).mValue = visible ? 1.f : 0.f;
+}
+
+void RenderSnapshot::setAnimationTime(Ogre::AnimationState* animation, float time_position) {
+    _getEntry(animation, ANIMATION_TIME).mValue = time_position;
+}
+
+void RenderSnapshot::setEmitting(Ogre::ParticleSystem* particle_system, bool emitting) {
+    _getEntry(particle_system, EMITTING).mValue = emitting ? 1.f : 0.f;
+}
+
+void RenderSnapshot::setListener(const Ogre::Vector3& position, const Ogre::Vector3& direction) {
+    mHasListener = true;
+    mListenerPosition = position;
+    mListenerDirection = direction;
+}
+
+void RenderSnapshot::forget(const void* object) {
+    for(uint32_t type = 0; type < ENTRY_TYPE_COUNT; ++type) {
+        auto iter = mIndices.find(reinterpret_cast<uintptr_t>(object) | type);
+        if(iter == mIndices.end())
+            continue;
+
+        // move the last entry into the gap
+        uint32_t index = iter->second;
+        mIndices.erase(iter);
+        if(index != mEntries.size() - 1) {
+            Entry& last = mEntries.back();
+            mIndices[reinterpret_cast<uintptr_t>(last.mObject) | last.mType] = index;
+            mEntries[index] = last;
+        }
+        mEntries.pop_back();
+    }
+}
+
+void RenderSnapshot::apply() {
+    for(auto iter = mEntries.begin(); iter != mEntries.end(); ++iter) {
+        switch(iter->mType) {
+        case TRANSFORM: {
+            Ogre::SceneNode* scene_node = static_cast<Ogre::SceneNode*>(iter->mObject);
+            scene_node->setPosition(iter->mPosition);
+            scene_node->setOrientation(iter->mRotation);
+            scene_node->setScale(iter->mScale);
+            break;
+        }
+        case CAMERA_TRANSFORM: {
+            Ogre::Camera* camera = static_cast<Ogre::Camera*>(iter->mObject);
+            camera->setPosition(iter->mPosition);
+            camera->setOrientation(iter->mRotation);
+            break;
+        }
+        case VISIBILITY:
+            static_cast<Ogre::MovableObject*>(iter->mObject)->setVisible(iter->mValue != 0.f);
+            break;
+        case ANIMATION_TIME:
+            static_cast<Ogre::AnimationState*>(iter->mObject)->setTimePosition(iter->mValue);
+            break;
+        case EMITTING:
+            static_cast<Ogre::ParticleSystem*>(iter->mObject)->setEmitting(iter->mValue != 0.f);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if(mHasListener) {
+        sf::Listener::setPosition(mListenerPosition.x, mListenerPosition.y, mListenerPosition.z);
+        sf::Listener::setDirection(mListenerDirection.x, mListenerDirection.y, mListenerDirection.z);
+    }
+
+    clear();
+}
+
+void RenderSnapshot::clear() {
+    mEntries.clear();
+    mIndices.clear();
+    mHasListener = false;
+}
+
+uint32_t RenderSnapshot::getSize() const {
+    return mEntries.size();
+}
+
+bool RenderSnapshot::hasListener() const {
+    return mHasListener;
+}
+
+RenderSnapshot::Entry& RenderSnapshot::_getEntry(void* object, EntryType type) {
+    // Ogre objects are at least 8 byte aligned, which leaves the low bits for the type
+    uintptr_t key = reinterpret_cast<uintptr_t>(object) | type;
+    auto iter = mIndices.find(key);
+    if(iter != mIndices.end())
+        return mEntries[iter->second];
+
+    mIndices[key] = mEntries.size();
+    mEntries.push_back(Entry());
+    Entry& entry = mEntries.back();
+    entry.mType = type;
+    entry.mObject = object;
+    entry.mValue = 0.f;
+    return entry;
+}
+
+}
@@ -0,0 +1,168 @@
+
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_GRAPHICS_RENDERSNAPSHOT
+#define DUCTTAPE_ENGINE_GRAPHICS_RENDERSNAPSHOT
+
+#include <Config.hpp>
+
+#include <OgreQuaternion.h>
+#include <OgreVector3.h>
+
+#include <QtGlobal>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Ogre {
+class AnimationState;
+class Camera;
+class MovableObject;
+class ParticleSystem;
+class SceneNode;
+}
+
+namespace dt {
+
+/**
+  * The render state one simulation frame produced: the world transforms, visibility, animation times and
+  * particle emitters of the Ogre objects, and the audio listener. The simulation records into one snapshot
+  * while the previous one is applied to Ogre and rendered. Only the last value per object and property is
+  * kept, so simulating several steps per frame does not grow the snapshot.
+  * @see DisplayManager::setPipelined(bool pipelined)
+  */
+class DUCTTAPE_API RenderSnapshot {
+
+    Q_DISABLE_COPY(RenderSnapshot)
+
+public:
+    /**
+      * Default constructor.
+      */
+    RenderSnapshot();
+
+    /**
+      * Records the world transform of a scene node.
+      * @param scene_node The scene node.
+      * @param position The position.
+      * @param rotation The orientation.
+      * @param scale The scale.
+      */
+    void setTransform(Ogre::SceneNode* scene_node, const Ogre::Vector3& position,
+                      const Ogre::Quaternion& rotation, const Ogre::Vector3& scale);
+
+    /**
+      * Records the world transform of a camera.
+      * @param camera The camera.
+      * @param position The position.
+      * @param rotation The orientation.
+      */
+    void setCameraTransform(Ogre::Camera* camera, const Ogre::Vector3& position, const Ogre::Quaternion& rotation);
+
+    /**
+      * Records the visibility of a movable object.
+      * @param object The entity, light, camera or billboard set.
+      * @param visible Whether it is visible.
+      */
+    void setVisible(Ogre::MovableObject* object, bool visible);
+
+    /**
+      * Records the time position of an animation.
+      * @param animation The animation state.
+      * @param time_position The time position, in seconds.
+      */
+    void setAnimationTime(Ogre::AnimationState* animation, float time_position);
+
+    /**
+      * Records whether a particle system emits new particles.
+      * @param particle_system The particle system.
+      * @param emitting Whether it emits.
+      */
+    void setEmitting(Ogre::ParticleSystem* particle_system, bool emitting);
+
+    /**
+      * Records the position and direction of the audio listener.
+      * @param position The position.
+      * @param direction The direction the listener faces.
+      */
+    void setListener(const Ogre::Vector3& position, const Ogre::Vector3& direction);
+
+    /**
+      * Removes everything recorded for an object. Has to be called before the object is destroyed.
+      * @param object The Ogre object.
+      */
+    void forget(const void* object);
+
+    /**
+      * Applies the recorded state to Ogre and to the audio listener, then clears the snapshot.
+      */
+    void apply();
+
+    /**
+      * Discards the recorded state.
+      */
+    void clear();
+
+    /**
+      * Returns the number of recorded object properties.
+      * @returns The number of entries.
+      */
+    uint32_t getSize() const;
+
+    /**
+      * Returns whether the snapshot records the audio listener.
+      * @returns Whether the listener has been set.
+      */
+    bool hasListener() const;
+
+private:
+    /**
+      * The kinds of recorded properties. They are stored in the low bits of the (aligned) object pointer
+      * to form the key of an entry.
+      */
+    enum EntryType {
+        TRANSFORM,
+        CAMERA_TRANSFORM,
+        VISIBILITY,
+        ANIMATION_TIME,
+        EMITTING,
+        ENTRY_TYPE_COUNT
+    };
+
+    /**
+      * One recorded property of an Ogre object.
+      */
+    struct Entry {
+        EntryType mType;                //!< The kind of property.
+        void* mObject;                  //!< The Ogre object.
+        Ogre::Vector3 mPosition;        //!< The position of a transform.
+        Ogre::Quaternion mRotation;     //!< The orientation of a transform.
+        Ogre::Vector3 mScale;           //!< The scale of a transform.
+        float mValue;                   //!< The time position, visibility or emitting flag.
+    };
+
+    /**
+      * Private method. Returns the entry of an object property, adding it if it has not been recorded yet.
+      * @param object The Ogre object.
+      * @param type The kind of property.
+      * @returns The entry.
+      */
+    Entry& _getEntry(void* object, EntryType type);
+
+    std::vector<Entry> mEntries;                        //!< The recorded properties, in recording order.
+    std::unordered_map<uintptr_t, uint32_t> mIndices;   //!< The index in mEntries, by object and property.
+
+    bool mHasListener;                  //!< Whether the listener has been recorded.
+    Ogre::Vector3 mListenerPosition;    //!< The position of the listener.
+    Ogre::Vector3 mListenerDirection;   //!< The direction of the listener.
+};
+
+}
+
+#endif
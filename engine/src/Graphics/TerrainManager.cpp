@@ -9,6 +9,7 @@
 #include <Graphics/TerrainManager.hpp>
 
 #include <Core/Root.hpp>
+#include <Utils/Logger.hpp>
 #include <Utils/Utils.hpp>
 
 #include <SFML/Window/VideoMode.hpp>
@@ -101,6 +102,11 @@ void TerrainManager::addTextureLayer(const std::vector<QString>& texture_names,
 }
 
 bool TerrainManager::import(const std::vector<QString>& files) {
+    if(Root::getInstance().isHeadless()) {
+        Logger::get().error("Cannot import a terrain on a dedicated server.");
+        return false;
+    }
+
     // If we have to less files return false
     if(files.size() < (mCountX*mCountY))
         return false;
@@ -117,7 +123,12 @@ bool TerrainManager::import(const std::vector<QString>& files) {
     return true;
 }
 
-bool TerrainManager::load(const QString prefix, const QString suffix) {
+bool TerrainManager::load(const QString prefix, const QString suffix, bool synchronous) {
+    if(Root::getInstance().isHeadless()) {
+        Logger::get().error("Cannot load a terrain on a dedicated server.");
+        return false;
+    }
+
     _createTerrain();
     mTerrainGroup->setFilenameConvention(dt::Utils::toStdString(prefix), dt::Utils::toStdString(suffix));
     for(long x = 0; x < mCountX; x++) {
@@ -127,7 +138,7 @@ bool TerrainManager::load(const QString prefix, const QString suffix) {
     }
 
     mImported = false;
-    refresh();
+    refresh(synchronous);
     return true;
 }
 
@@ -137,8 +148,9 @@ void TerrainManager::save(const QString prefix, const QString suffix) {
     mTerrainGroup->saveAllTerrains(true);
 }
 
-void TerrainManager::refresh() {
-    mTerrainGroup->loadAllTerrains(true);
+void TerrainManager::refresh(bool synchronous) {
+    synchronous = synchronous || mImported;
+    mTerrainGroup->loadAllTerrains(synchronous);
 
     if(mImported) {
         Ogre::TerrainGroup::TerrainIterator it = mTerrainGroup->getTerrainIterator();
@@ -149,7 +161,9 @@ void TerrainManager::refresh() {
         }
     }
 
-    mTerrainGroup->freeTemporaryResources();
+    // the terrains still loading in the background need the temporary resources
+    if(synchronous)
+        mTerrainGroup->freeTemporaryResources();
 }
 
 void TerrainManager::_createTerrain() {
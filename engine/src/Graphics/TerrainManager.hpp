@@ -122,9 +122,11 @@ public:
       * (<prefix><index><suffix>)
       * @param prefix the filenames prefix
       * @param suffix the filenames suffix
+      * @param synchronous Whether to wait until all terrains are loaded. Otherwise they are loaded
+      * in the background and appear over the next frames, so large terrains do not stall the game.
       * @returns true on success, false otherwise.
       */
-    bool load(const QString prefix, const QString suffix);
+    bool load(const QString prefix, const QString suffix, bool synchronous = true);
 
     /**
       * Saves the terrain to disk using the file-prefix and suffix
@@ -136,8 +138,10 @@ public:
 
     /**
       * Refreshes the terrain/Applys all changes.
+      * @param synchronous Whether to wait until all terrains are loaded. Imported terrains are always loaded synchronously,
+      * as their blendmaps are generated afterwards.
       */
-    void refresh();
+    void refresh(bool synchronous = true);
 
 private:
     /**
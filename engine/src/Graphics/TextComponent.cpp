@@ -8,6 +8,7 @@
 
 #include <Graphics/TextComponent.hpp>
 
+#include <Core/Root.hpp>
 #include <Graphics/DisplayManager.hpp>
 #include <Scene/Node.hpp>
 #include <Utils/Utils.hpp>
@@ -17,6 +18,8 @@
 #include <OgreOverlayContainer.h>
 #include <OgreOverlayManager.h>
 
+#include <QMutexLocker>
+
 namespace dt {
 
 TextComponent::TextComponent(const QString text, const QString name)
@@ -34,8 +37,12 @@ TextComponent::TextComponent(const QString text, const QString name)
       mPadding(Ogre::Vector2(10,4)) {}
 
 void TextComponent::onInitialize() {
+    if(Root::getInstance().isHeadless())
+        return; // there are no overlays on a dedicated server
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     // overlay
-    QString oname = getNode()->getName() + "-" + mName;
+    QString oname = getNode()->getName() + "-" + getName();
     mOverlay = Ogre::OverlayManager::getSingleton().create(Utils::toStdString(oname) + "-overlay");
 
     mPanel = static_cast<Ogre::OverlayContainer*>(Ogre::OverlayManager::getSingleton().createOverlayElement("Panel", Utils::toStdString(oname) + "-panel"));
@@ -58,6 +65,10 @@ void TextComponent::onInitialize() {
 }
 
 void TextComponent::onDeinitialize() {
+    if(mOverlay == nullptr)
+        return;
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     Ogre::OverlayManager* mgr = Ogre::OverlayManager::getSingletonPtr();
 
     mPanel->removeChild(mLabel->getName());
@@ -69,14 +80,25 @@ void TextComponent::onDeinitialize() {
 }
 
 void TextComponent::onEnable() {
-    mOverlay->show();
+    if(mOverlay != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mOverlay->show();
+    }
 }
 
 void TextComponent::onDisable() {
-    mOverlay->hide();
+    if(mOverlay != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        mOverlay->hide();
+    }
 }
 
 void TextComponent::onUpdate(double time_diff) {
+    if(mOverlay == nullptr)
+        return;
+
+    // the overlays and the camera are used by the renderer
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
     if(mRefresh && mFont != "") {
         // calculate the text width
         mTextWidth = 0;
@@ -100,7 +122,7 @@ void TextComponent::onUpdate(double time_diff) {
     // set the position
 
     if(DisplayManager::get()->getMainCamera() == nullptr) {
-        Logger::get().error("Cannot get main camera for text component: no main camera set. Disabling text component " + mName + ".");
+        Logger::get().error("Cannot get main camera for text component: no main camera set. Disabling text component " + getName() + ".");
         disable();
         return;
     }
@@ -133,6 +155,7 @@ void TextComponent::onUpdate(double time_diff) {
 void TextComponent::setText(const QString text) {
         mText = text;
         if(mLabel != nullptr) {
+            QMutexLocker lock(DisplayManager::get()->getRenderMutex());
             mLabel->setCaption(Utils::toStdString(mText));
             mRefresh = true;
         }
@@ -146,6 +169,7 @@ const QString TextComponent::getText() const {
 void TextComponent::setFont(const QString fontname) {
     mFont = fontname;
     if(mLabel != nullptr && mFont != "") {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mLabel->setFontName(Utils::toStdString(mFont));
     }
 }
@@ -157,6 +181,7 @@ const QString TextComponent::getFont() const {
 void TextComponent::setColor(Ogre::ColourValue color) {
         mColor = color;
         if(mLabel != nullptr) {
+            QMutexLocker lock(DisplayManager::get()->getRenderMutex());
             mLabel->setColour(mColor);
         }
         emit colorChanged();
@@ -173,6 +198,7 @@ Ogre::ColourValue TextComponent::getColor() const {
 void TextComponent::setFontSize(uint8_t font_size) {
     mFontSize = font_size;
     if(mLabel != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mLabel->setCharHeight(mFontSize);
         mRefresh = true;
     }
@@ -185,6 +211,7 @@ uint8_t TextComponent::getFontSize() const {
 void TextComponent::setBackgroundMaterial(const QString material_name) {
     mBackgroundMaterial = material_name;
     if(mPanel != nullptr && mBackgroundMaterial != "") {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
         mPanel->setMaterialName(Utils::toStdString(mBackgroundMaterial));
     }
 }
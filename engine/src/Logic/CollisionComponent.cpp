@@ -24,21 +24,29 @@ void CollisionComponent::onCheck(const Ogre::Vector3& start, const Ogre::Vector3
     impulse.normalise();
 
     auto id = Utils::autoId();
-    QString name = QString("bullet") + Utils::toString(id);
 
-    std::shared_ptr<Node> bullet = getNode()->getScene()->addChildNode(new Node(QString(id)));
+    // the bullet is spawned at the end of the frame, together with all other structural changes,
+    // by then this component may have been removed
+    Scene* scene = getNode()->getScene();
+    const Handle<Component> handle = getHandle();
+    scene->getCommandBuffer().spawn(scene, new Node(QString(id)), [=](Node::NodeSP bullet) {
+        CollisionComponent* component = static_cast<CollisionComponent*>(handle.get());
+        if(component == nullptr) {
+            bullet->kill();
+            return;
+        }
 
-    bullet->addComponent<MeshComponent>(new MeshComponent(mBulletMeshHandle, "", name));
-    bullet->setPosition(start, Node::SCENE);
-    std::shared_ptr<PhysicsBodyComponent> bullet_body = bullet->addComponent<PhysicsBodyComponent>(new PhysicsBodyComponent(name, "bullet_body"));
-    bullet_body->setMass(1.0);
+        bullet->setPosition(start, Node::SCENE);
+        component->mBulletPrefab->applyTo(bullet.get());
+        std::shared_ptr<PhysicsBodyComponent> bullet_body = bullet->findComponent<PhysicsBodyComponent>("bullet_body");
 
-    if(!QObject::connect(bullet_body.get(), SIGNAL(collided(dt::PhysicsBodyComponent*, dt::PhysicsBodyComponent*)),
-                         this,        SLOT(onHit(dt::PhysicsBodyComponent*, dt::PhysicsBodyComponent*)), Qt::DirectConnection)) {
-            Logger::get().error("Cannot connect the bullet's collided signal with the OnHit slot.");
-    }
+        if(!QObject::connect(bullet_body.get(), SIGNAL(collided(dt::PhysicsBodyComponent*, dt::PhysicsBodyComponent*)),
+                             component,   SLOT(onHit(dt::PhysicsBodyComponent*, dt::PhysicsBodyComponent*)), Qt::DirectConnection)) {
+                Logger::get().error("Cannot connect the bullet's collided signal with the OnHit slot.");
+        }
 
-    bullet_body->applyCentralImpulse(BtOgre::Convert::toBullet(impulse) * mRange);
+        bullet_body->applyCentralImpulse(BtOgre::Convert::toBullet(impulse) * component->mRange);
+    });
 }
 
 void CollisionComponent::onHit(PhysicsBodyComponent* hit, PhysicsBodyComponent* bullet) {
@@ -55,5 +63,10 @@ void CollisionComponent::onInitialize() {
     bullet->setPosition(0, -100, 0, Node::SCENE);
 
     bullet->kill();
+
+    // all bullets are cloned from this template and share their collision shape
+    mBulletPrefab.reset(new Prefab("bullet"));
+    mBulletPrefab->addComponent(new MeshComponent(mBulletMeshHandle, "", "bullet_mesh"));
+    mBulletPrefab->addComponent(new PhysicsBodyComponent("bullet_mesh", "bullet_body", PhysicsBodyComponent::CONVEX, 1.0));
 }
 }
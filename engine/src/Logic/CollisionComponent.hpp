@@ -14,6 +14,7 @@
 #include <Scene/Component.hpp>
 #include <Physics/PhysicsBodyComponent.hpp>
 #include <Logic/InteractionComponent.hpp>
+#include <Scene/Prefab.hpp>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 
@@ -69,6 +70,7 @@ protected slots:
 
 private:
     QString mBulletMeshHandle;                              //!< The handle to the bullet's mesh.
+    Prefab::PrefabSP mBulletPrefab;                         //!< The template for the bullets, which share their collision shape.
 };
 
 }
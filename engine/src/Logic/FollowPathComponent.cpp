@@ -9,6 +9,7 @@
 #include <Logic/FollowPathComponent.hpp>
 
 #include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
 #include <Utils/Math.hpp>
 
 namespace dt {
@@ -54,13 +55,25 @@ void FollowPathComponent::onUpdate(double time_diff) {
             mReversed = !mReversed;
             reset();
         } else {
-            // disable
+            // disable, the signals of a parallel update are emitted on the main thread
             reset();
-            disable();
+            Scene* scene = mNode->getScene();
+            if(scene != nullptr && scene->_isUpdatingInParallel())
+                scene->_disableAfterParallelUpdate(this);
+            else
+                disable();
         }
     }
 }
 
+uint32_t FollowPathComponent::getReadAccess() const {
+    return OWN_TRANSFORM;
+}
+
+uint32_t FollowPathComponent::getWriteAccess() const {
+    return OWN_TRANSFORM;
+}
+
 void FollowPathComponent::addPoint(Ogre::Vector3 point) {
     mPoints.push_back(point);
     if(mPoints.size() == 1) {
@@ -51,6 +51,8 @@ public:
     void onInitialize();
     void onDeinitialize();
     void onUpdate(double time_diff);
+    uint32_t getReadAccess() const;
+    uint32_t getWriteAccess() const;
 
     /**
       * Adds a point to the end of the path.
@@ -71,6 +71,14 @@ namespace dt {
         }
     }
 
+    uint32_t InteractionComponent::getReadAccess() const {
+        return NO_ACCESS;
+    }
+
+    uint32_t InteractionComponent::getWriteAccess() const {
+        return NO_ACCESS;
+    }
+
     bool InteractionComponent::isReady() const {
         return mRemainTime <= 0.0f;
     }
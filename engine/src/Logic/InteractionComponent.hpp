@@ -88,6 +88,8 @@ public:
     void setRemainTime(float remain_time);
 
     void onUpdate(double time_diff);
+    uint32_t getReadAccess() const;
+    uint32_t getWriteAccess() const;
 
     /**
       * Gets whether it's ready to perform the next interaction.
@@ -9,6 +9,7 @@
 #include <Logic/ScriptComponent.hpp>
 #include <Logic/ScriptManager.hpp>
 #include <Utils/Logger.hpp>
+#include <Utils/Profiler.hpp>
 #include <Utils/Utils.hpp>
 
 namespace dt {
@@ -24,6 +25,10 @@ ScriptComponent::ScriptComponent(const QString script_name, const QString name,
     }
 }
 
+Component* ScriptComponent::clone() {
+    return new ScriptComponent(mScriptName, getName(), mIsUpdateEnabled);
+}
+
 void ScriptComponent::onInitialize() {
     if(mValid) {
         // create our QScriptValue, that represents the script object
@@ -66,9 +71,10 @@ QScriptValue ScriptComponent::_callScriptFunction(QString name, QScriptValueList
         return QScriptValue::UndefinedValue;
     }
 
+    DUCTTAPE_PROFILE_ZONE("ScriptComponent::callScriptFunction");
     QScriptValue value = function.call(mScriptObject, params);
     if(!ScriptManager::get()->handleErrors(mScriptName)) {
-        Logger::get().warning("Error while calling script function. Disabling ScriptComponent \"" + mName + "\".");
+        Logger::get().warning("Error while calling script function. Disabling ScriptComponent \"" + getName() + "\".");
         disable();
     }
     return value;
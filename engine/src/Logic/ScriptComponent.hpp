@@ -40,6 +40,7 @@ public:
     void onEnable();
     void onDisable();
     void onUpdate(double time_diff);
+    Component* clone();
 
     /**
       * Gets if update call of the script is enabled or not.
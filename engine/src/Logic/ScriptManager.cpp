@@ -11,6 +11,7 @@
 #include <Core/Root.hpp>
 #include <Gui/GuiManager.hpp>
 #include <Utils/Logger.hpp>
+#include <Utils/Profiler.hpp>
 #include <Utils/Utils.hpp>
 #include <Input/MouseState.hpp>
 #include <Input/KeyboardState.hpp>
@@ -35,14 +36,17 @@ void ScriptManager::initialize() {
     QScriptValue display_manager = mScriptEngine->newQObject(DisplayManager::get());
     mScriptEngine->globalObject().setProperty("DisplayManager", display_manager);
 
-    QScriptValue gui_root = mScriptEngine->newQObject(& GuiManager::get()->getRootWindow());
-    mScriptEngine->globalObject().setProperty("Gui", gui_root);
+    // a dedicated server has no GUI and no input devices
+    if(!Root::getInstance().isHeadless()) {
+        QScriptValue gui_root = mScriptEngine->newQObject(& GuiManager::get()->getRootWindow());
+        mScriptEngine->globalObject().setProperty("Gui", gui_root);
 
-    QScriptValue keyboard = mScriptEngine->newQObject(new KeyboardState());
-    mScriptEngine->globalObject().setProperty("Keyboard", keyboard);
+        QScriptValue keyboard = mScriptEngine->newQObject(new KeyboardState());
+        mScriptEngine->globalObject().setProperty("Keyboard", keyboard);
 
-    QScriptValue mouse = mScriptEngine->newQObject(new MouseState());
-    mScriptEngine->globalObject().setProperty("Mouse", mouse);
+        QScriptValue mouse = mScriptEngine->newQObject(new MouseState());
+        mScriptEngine->globalObject().setProperty("Mouse", mouse);
+    }
 }
 
 void ScriptManager::deinitialize() {}
@@ -189,6 +193,7 @@ QScriptValue ScriptManager::scriptPrintFunction(QScriptContext* context, QScript
 }
 
 bool ScriptManager::_evaluate(QScriptProgram program) {
+    DUCTTAPE_PROFILE_ZONE("ScriptManager::evaluate");
     mLastReturnValue = mScriptEngine->evaluate(program);
     return handleErrors(program.fileName());
 }
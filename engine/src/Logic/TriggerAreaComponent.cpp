@@ -16,12 +16,8 @@ void TriggerAreaComponent::onUpdate(double time_diff) {
         return;
     }
 
-    //// TODO: Update only on node position change
-    btTransform transform;
-    transform.setIdentity();
-    transform.setOrigin(BtOgre::Convert::toBullet(getNode()->getPosition(Node::SCENE)));
-    transform.setRotation(BtOgre::Convert::toBullet(getNode()->getRotation(Node::SCENE)));
-    mObject->setWorldTransform(transform);
+    if(getNode()->hasTransformChanged())
+        onTransformChanged();
 
     for(int32_t i = 0; i < mObject->getNumOverlappingObjects(); ++i)
     {
@@ -30,6 +26,14 @@ void TriggerAreaComponent::onUpdate(double time_diff) {
     }
 }
 
+void TriggerAreaComponent::onTransformChanged() {
+    btTransform transform;
+    transform.setIdentity();
+    transform.setOrigin(BtOgre::Convert::toBullet(getNode()->getPosition(Node::SCENE)));
+    transform.setRotation(BtOgre::Convert::toBullet(getNode()->getRotation(Node::SCENE)));
+    mObject->setWorldTransform(transform);
+}
+
 void TriggerAreaComponent::onInitialize() {
     btTransform transform;
     transform.setIdentity();
@@ -37,6 +37,7 @@ public:
     void onEnable();
     void onDisable();
     void onUpdate(double time_diff);
+    void onTransformChanged();
     
     /**
     * Setter for the area shape
@@ -12,6 +12,8 @@ namespace dt {
 
 TriggerComponent::TriggerComponent(const QString name)
     : Component(name) {
+    // nothing to do per frame
+    setTickInterval(NEVER);
 }
 
 void TriggerComponent::onInitialize() {}
@@ -20,4 +22,12 @@ void TriggerComponent::onDeinitialize() {}
 
 void TriggerComponent::onUpdate(double time_diff) {}
 
+uint32_t TriggerComponent::getReadAccess() const {
+    return NO_ACCESS;
+}
+
+uint32_t TriggerComponent::getWriteAccess() const {
+    return NO_ACCESS;
+}
+
 }
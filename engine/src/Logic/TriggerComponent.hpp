@@ -36,6 +36,8 @@ public:
     void onInitialize();
     void onDeinitialize();
     void onUpdate(double time_diff);
+    uint32_t getReadAccess() const;
+    uint32_t getWriteAccess() const;
 };
 
 }
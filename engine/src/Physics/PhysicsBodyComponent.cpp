@@ -22,9 +22,7 @@ PhysicsBodyComponent::PhysicsBodyComponent(const QString mesh_component_name,
                                            CollisionShapeType collision_shape_type,
                                            btScalar mass)
     : Component(name),
-      mMeshComponentName(mesh_component_name),
       mCollisionShape(nullptr),
-      mCollisionShapeType(collision_shape_type),
       mBody(nullptr),
       mMotionState(nullptr),
       mCentralForce(btVector3(0, 0, 0)),
@@ -32,46 +30,65 @@ PhysicsBodyComponent::PhysicsBodyComponent(const QString mesh_component_name,
       mCollisionMask(0),
       mCollisionGroup(0),
       mCollisionMaskInUse(false),
-      mMass(mass) {}
+      mIsBaked(false) {
+    BodyData& data = mData.edit();
+    data.mMeshComponentName = mesh_component_name;
+    data.mCollisionShapeType = collision_shape_type;
+    data.mMass = mass;
+}
+
+PhysicsBodyComponent::SharedShape::SharedShape()
+    : mCollisionShapeType(CONVEX) {}
+
+PhysicsBodyComponent::BodyData::BodyData()
+    : mCollisionShapeType(CONVEX),
+      mMass(5.0f),
+      mShape(std::make_shared<SharedShape>()) {}
+
+Component* PhysicsBodyComponent::clone() {
+    PhysicsBodyComponent* component = new PhysicsBodyComponent(mData->mMeshComponentName, getName());
+    component->mData = mData;
+    return component;
+}
 
 void PhysicsBodyComponent::onInitialize() {
-    if(! mNode->hasComponent(mMeshComponentName)) {
+    const BodyData& data = mData.get();
+    if(! mNode->hasComponent(data.mMeshComponentName)) {
         Logger::get().error("Node " + mNode->getName() + " has no Component named " +
-                            mMeshComponentName + " which is required to create the" +
-                            " PhysicsBodyComponent " + mName);
+                            data.mMeshComponentName + " which is required to create the" +
+                            " PhysicsBodyComponent " + getName());
         exit(1);
     }
 
-    auto mesh_component = mNode->findComponent<MeshComponent>(mMeshComponentName);
-
-    BtOgre::StaticMeshToShapeConverter converter(mesh_component->getOgreEntity());
-    
-    // TODO: CollisionShapes should likely be stored at a central place.
-    // Perhaps the PhysicsManager is a good place. It would save a lot of memory
-    // for many bodies with the same CollisionShape.
-    if(mCollisionShapeType == BOX) {
-        Ogre::Vector3 size = mesh_component->getOgreEntity()->getBoundingBox().getSize();
-        size /= 2.0;
-        mCollisionShape = new btBoxShape(BtOgre::Convert::toBullet(size));
-        //mCollisionShape = converter.createBox();
-    }
-    else if(mCollisionShapeType == CONVEX)
-        mCollisionShape = converter.createConvex();
-    else if(mCollisionShapeType == SPHERE) {
-        mCollisionShape = new btSphereShape(mesh_component->getOgreEntity()->getBoundingRadius());
+    auto mesh_component = mNode->findComponent<MeshComponent>(data.mMeshComponentName);
+    if(mesh_component->getOgreEntity() == nullptr) {
+        // dedicated server: the empty shape is not cached, so the clones still create theirs once the mesh is loaded
+        Logger::get().error("PhysicsBodyComponent " + getName() + " cannot create its collision shape: the mesh of " +
+                            data.mMeshComponentName + " is not loaded.");
+        mEmptyShape.reset(new btEmptyShape());
+        mCollisionShape = mEmptyShape.get();
+    } else {
+        const SharedShape* shared = data.mShape.get();
+        if(shared->mCollisionShape != nullptr && (shared->mMeshHandle != mesh_component->getMeshHandle()
+                                                  || shared->mCollisionShapeType != data.mCollisionShapeType)) {
+            // this clone has another mesh than the one the shared shape was created from
+            mData.edit().mShape = std::make_shared<SharedShape>();
+        }
+
+        // the clones share the shape, so it is only created from the mesh once
+        SharedShape& shape = *mData->mShape;
+        if(shape.mCollisionShape == nullptr) {
+            shape.mCollisionShape.reset(_createCollisionShape(mesh_component.get(), mData->mCollisionShapeType));
+            shape.mMeshHandle = mesh_component->getMeshHandle();
+            shape.mCollisionShapeType = mData->mCollisionShapeType;
+        }
+        mCollisionShape = shape.mCollisionShape.get();
     }
-    else if(mCollisionShapeType == CYLINDER) {
-        Ogre::Vector3 size = mesh_component->getOgreEntity()->getBoundingBox().getSize();
-        size /= 2.0;
-        mCollisionShape = new btCylinderShape(BtOgre::Convert::toBullet(size));
-    }
-    else if(mCollisionShapeType == TRIMESH)
-        mCollisionShape = converter.createTrimesh();
 
     btVector3 inertia(0, 0, 0);
     //Only the rigidbody's mass doesn't equal to zero is dynamic or some odd phenomenon may appear.
-    if(mMass != 0.0f)
-        mCollisionShape->calculateLocalInertia(mMass, inertia);
+    if(mData->mMass != 0.0f)
+        mCollisionShape->calculateLocalInertia(mData->mMass, inertia);
 
     btDefaultMotionState* state = new btDefaultMotionState(
         btTransform(BtOgre::Convert::toBullet(getNode()->getRotation(Node::SCENE)),
@@ -97,31 +114,81 @@ double PhysicsBodyComponent::GetFriction() const {
 }
 
 void PhysicsBodyComponent::onDeinitialize() {
+    // the removal may still be queued in a batch
+    getNode()->getScene()->getPhysicsWorld()->_applyQueuedChange(mBody);
     delete mBody->getMotionState();
     delete mBody;
-    delete mCollisionShape;
+    mCollisionShape = nullptr;
+    mEmptyShape.reset();
 }
 
 void PhysicsBodyComponent::onEnable() {
+    // before adding it, so Bullet knows whether it is static
+    setMass(mData->mMass);
+
     if(mCollisionMaskInUse) // Special treatment due to Bullet internals
-        getNode()->getScene()->getPhysicsWorld()->getBulletWorld()->addRigidBody(mBody, mCollisionGroup, mCollisionMask);
+        getNode()->getScene()->getPhysicsWorld()->addRigidBody(mBody, mCollisionGroup, mCollisionMask);
     else
-        getNode()->getScene()->getPhysicsWorld()->getBulletWorld()->addRigidBody(mBody);
+        getNode()->getScene()->getPhysicsWorld()->addRigidBody(mBody);
 
-    //Re-sychronize the PhysicsBodyComponent with the node.
-    btDefaultMotionState* state = new btDefaultMotionState(
-        btTransform(BtOgre::Convert::toBullet(getNode()->getRotation(Node::SCENE)),
-        BtOgre::Convert::toBullet(getNode()->getPosition(Node::SCENE))));
+    //Re-sychronize the PhysicsBodyComponent with the node. Setting the motion state again copies its transform into the body.
+    btMotionState* state = mBody->getMotionState();
+    state->setWorldTransform(btTransform(BtOgre::Convert::toBullet(getNode()->getRotation(Node::SCENE)),
+                                         BtOgre::Convert::toBullet(getNode()->getPosition(Node::SCENE))));
     mBody->setMotionState(state);
 
-    setMass(mMass);
-
     //Activate it.
     this->activate();
 }
 
 void PhysicsBodyComponent::onDisable() {
-    getNode()->getScene()->getPhysicsWorld()->getBulletWorld()->removeRigidBody(mBody);
+    getNode()->getScene()->getPhysicsWorld()->removeRigidBody(mBody);
+}
+
+void PhysicsBodyComponent::onBake() {
+    mIsBaked = true;
+    _readdBody();
+}
+
+void PhysicsBodyComponent::onUnbake() {
+    mIsBaked = false;
+    _readdBody();
+}
+
+btCollisionShape* PhysicsBodyComponent::_createCollisionShape(MeshComponent* mesh_component, CollisionShapeType type) {
+    BtOgre::StaticMeshToShapeConverter converter(mesh_component->getOgreEntity());
+
+    btCollisionShape* shape = nullptr;
+    if(type == BOX) {
+        Ogre::Vector3 size = mesh_component->getOgreEntity()->getBoundingBox().getSize();
+        size /= 2.0;
+        shape = new btBoxShape(BtOgre::Convert::toBullet(size));
+        //shape = converter.createBox();
+    }
+    else if(type == CONVEX)
+        shape = converter.createConvex();
+    else if(type == SPHERE) {
+        shape = new btSphereShape(mesh_component->getOgreEntity()->getBoundingRadius());
+    }
+    else if(type == CYLINDER) {
+        Ogre::Vector3 size = mesh_component->getOgreEntity()->getBoundingBox().getSize();
+        size /= 2.0;
+        shape = new btCylinderShape(BtOgre::Convert::toBullet(size));
+    }
+    else if(type == TRIMESH)
+        shape = converter.createTrimesh();
+    return shape;
+}
+
+void PhysicsBodyComponent::_readdBody() {
+    if(!isEnabled())
+        return;
+
+    // the removal must not be cancelled out by the addition in a batch
+    PhysicsWorld::PhysicsWorldSP world = getNode()->getScene()->getPhysicsWorld();
+    world->removeRigidBody(mBody);
+    world->_applyQueuedChange(mBody);
+    onEnable();
 }
 
 void PhysicsBodyComponent::onCollide(PhysicsBodyComponent* other_body) {
@@ -238,10 +305,13 @@ void PhysicsBodyComponent::onUpdate(double time_diff) {
 
 void PhysicsBodyComponent::setMass(btScalar mass) {
     btVector3 inertia(0, 0, 0);
-    if(mass != 0.0f)
-        mCollisionShape->calculateLocalInertia(mass, inertia);
-    mBody->setMassProps(mass, inertia);
-    mMass = mass;
+    // a baked body keeps its mass for when it is unbaked
+    btScalar body_mass = mIsBaked ? 0.0f : mass;
+    if(body_mass != 0.0f)
+        mCollisionShape->calculateLocalInertia(body_mass, inertia);
+    mBody->setMassProps(body_mass, inertia);
+    if(mass != mData->mMass)
+        mData.edit().mMass = mass;
 }
 /*
 void PhysicsBodyComponent::SetCollisionShapeType(CollisionShapeType type) {
@@ -249,6 +319,16 @@ void PhysicsBodyComponent::SetCollisionShapeType(CollisionShapeType type) {
 }
 */
 
+void PhysicsBodyComponent::onSignificanceChanged(SignificanceManager::Level level) {
+    if(mBody == nullptr || mBody->getActivationState() == DISABLE_DEACTIVATION)
+        return;
+
+    if(level == SignificanceManager::DORMANT)
+        mBody->setActivationState(ISLAND_SLEEPING);
+    else if(!mBody->isActive())
+        mBody->activate();
+}
+
 void PhysicsBodyComponent::activate() {
     mBody->activate();
 }
@@ -12,6 +12,7 @@
 #include <Config.hpp>
 
 #include <Scene/Component.hpp>
+#include <Utils/CopyOnWrite.hpp>
 #include <btBulletDynamicsCommon.h>
 #include <btBulletCollisionCommon.h>
 
@@ -24,6 +25,8 @@
 
 namespace dt {
 
+class MeshComponent;
+
 /**
   * A component making the node physical.
   */
@@ -59,6 +62,32 @@ public:
     void onDisable();
     void onUpdate(double time_diff);
 
+    /**
+      * Puts the body to sleep when it becomes DORMANT, until something hits it, and wakes it up
+      * when it becomes more significant again. Bodies that never sleep are not affected.
+      * @param level The new level.
+      */
+    void onSignificanceChanged(SignificanceManager::Level level);
+
+    /**
+      * Turns the body into a static one with a mass of 0, which Bullet neither integrates nor puts into
+      * simulation islands. It still collides and reports collisions.
+      */
+    void onBake();
+
+    /**
+      * Restores the mass of the body.
+      */
+    void onUnbake();
+
+    /**
+      * Creates a PhysicsBodyComponent with the same configuration. The clones of a PhysicsBodyComponent
+      * share their collision shape, which is created from the mesh of the first one that is initialized.
+      * A clone whose mesh or collision shape type differs creates its own shape.
+      * @returns The new component.
+      */
+    Component* clone();
+
     /**
       * Called when the PhysicsBodyComponent collides with another one.
       * @param other_body The pointer to another PhysicsBodyComponent which this PhysicsBodyComponent collided with
@@ -177,9 +206,32 @@ signals:
     void collided(dt::PhysicsBodyComponent* other_body, dt::PhysicsBodyComponent* this_body);
 
 private:
-    QString mMeshComponentName;             //!< The name of the mesh component to create the collision shape from.
-    btCollisionShape* mCollisionShape;      //!< The bullet collision shape.
-    CollisionShapeType mCollisionShapeType; //!< The type of collision shape.
+    /**
+      * A collision shape, shared between a PhysicsBodyComponent and its clones.
+      */
+    struct SharedShape {
+        SharedShape();
+
+        std::unique_ptr<btCollisionShape> mCollisionShape;  //!< The shape, or nullptr until the first body is initialized.
+        QString mMeshHandle;                                //!< The handle of the mesh the shape was created from.
+        CollisionShapeType mCollisionShapeType;             //!< The type the shape was created with.
+    };
+
+    /**
+      * The configuration of a PhysicsBodyComponent, shared with its clones.
+      */
+    struct BodyData {
+        BodyData();
+
+        QString mMeshComponentName;             //!< The name of the mesh component to create the collision shape from.
+        CollisionShapeType mCollisionShapeType; //!< The type of collision shape.
+        btScalar mMass;                         //!< The mass of the body.
+        std::shared_ptr<SharedShape> mShape;    //!< The collision shape created from this configuration.
+    };
+
+    CopyOnWrite<BodyData> mData;            //!< The mesh component name, collision shape type and mass.
+    btCollisionShape* mCollisionShape;      //!< The bullet collision shape, owned by mData or mEmptyShape.
+    std::unique_ptr<btCollisionShape> mEmptyShape;  //!< The shape used while the mesh is not loaded, never shared.
     btRigidBody* mBody;                     //!< The bullet rigid body.
     BtOgre::RigidBodyState* mMotionState;   //!< The motion state of the physics body.
     btVector3 mCentralForce;
@@ -187,7 +239,21 @@ private:
     uint16_t mCollisionMask;
     uint16_t mCollisionGroup;
     bool mCollisionMaskInUse;
-    btScalar mMass;
+    bool mIsBaked;                          //!< Whether the Node is static and the body has no mass.
+
+    /**
+      * Removes the body from the PhysicsWorld and adds it again, if the component is enabled. Bullet
+      * only sorts a body into the static or dynamic ones when it is added.
+      */
+    void _readdBody();
+
+    /**
+      * Private method. Creates a collision shape from the mesh of a MeshComponent.
+      * @param mesh_component The MeshComponent, with its mesh loaded.
+      * @param type The type of the collision shape.
+      * @returns The new collision shape.
+      */
+    static btCollisionShape* _createCollisionShape(MeshComponent* mesh_component, CollisionShapeType type);
 
 };
 
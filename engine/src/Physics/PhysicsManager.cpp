@@ -9,6 +9,10 @@
 #include <Physics/PhysicsManager.hpp>
 
 #include <Core/Root.hpp>
+#include <Graphics/DisplayManager.hpp>
+#include <Utils/Profiler.hpp>
+
+#include <QMutexLocker>
 
 namespace dt {
 
@@ -25,12 +29,31 @@ void PhysicsManager::deinitialize() {
 }
 
 void PhysicsManager::updateFrame(double simulation_frame_time) {
+    DUCTTAPE_PROFILE_ZONE("PhysicsManager::updateFrame");
+
     // step all worlds
     for(auto iter = mWorlds.begin(); iter != mWorlds.end(); ++iter) {
         iter->second->stepSimulation(simulation_frame_time);
     }
 }
 
+void PhysicsManager::drawDebug() {
+    bool needs_draw = false;
+    for(auto iter = mWorlds.begin(); iter != mWorlds.end(); ++iter) {
+        needs_draw = needs_draw || iter->second->_needsDebugDraw();
+    }
+    if(!needs_draw)
+        return;
+
+    DUCTTAPE_PROFILE_ZONE("PhysicsManager::drawDebug");
+    // the debug lines are rendered from the scene graph
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    for(auto iter = mWorlds.begin(); iter != mWorlds.end(); ++iter) {
+        if(iter->second->_needsDebugDraw())
+            iter->second->_drawDebug();
+    }
+}
+
 PhysicsManager* PhysicsManager::get() {
     return Root::getInstance().getPhysicsManager();
 }
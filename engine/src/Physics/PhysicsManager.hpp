@@ -64,6 +64,12 @@ public:
       */
     PhysicsWorld::PhysicsWorldSP getWorld(const QString name);
 
+    /**
+      * Updates the debug drawings of all worlds, locking the render mutex once. Called by the Game once per
+      * frame, after all simulation steps.
+      */
+    void drawDebug();
+
 public slots:
     void updateFrame(double simulation_frame_time);
 
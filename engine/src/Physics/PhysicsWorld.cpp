@@ -10,6 +10,7 @@
 
 #include <Scene/Scene.hpp>
 #include <Utils/Logger.hpp>
+#include <Utils/Profiler.hpp>
 
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
@@ -21,10 +22,12 @@ PhysicsWorld::PhysicsWorld(const QString name, Scene* scene)
     : mDynamicsWorld(nullptr),
       mDebugDrawer(nullptr),
       mShowDebug(false),
+      mHasDebugDrawings(false),
       mScene(scene),
       mGravity(Ogre::Vector3(0, -9.8, 0)),
       mName(name),
-      mIsEnabled(true) {}
+      mIsEnabled(true),
+      mBatchDepth(0) {}
 
 void PhysicsWorld::initialize() {
     Logger::get().info("Initializing phyics world: " + mName);
@@ -43,9 +46,12 @@ void PhysicsWorld::initialize() {
     mDynamicsWorld->setInternalTickCallback(PhysicsWorld::BulletTickCallback, static_cast<void *>(this));
 
     // setup debug drawer
-    mDebugDrawer = new BtOgre::DebugDrawer(mScene->getSceneManager()->getRootSceneNode(), mDynamicsWorld);
-    mDebugDrawer->setDebugMode(mShowDebug);
-    mDynamicsWorld->setDebugDrawer(mDebugDrawer);
+    // a dedicated server has nothing to draw on
+    if(mScene->getSceneManager() != nullptr) {
+        mDebugDrawer = new BtOgre::DebugDrawer(mScene->getSceneManager()->getRootSceneNode(), mDynamicsWorld);
+        mDebugDrawer->setDebugMode(mShowDebug);
+        mDynamicsWorld->setDebugDrawer(mDebugDrawer);
+    }
 
     mDynamicsWorld->getBroadphase()->getOverlappingPairCache()->setInternalGhostPairCallback(new btGhostPairCallback());
 }
@@ -62,8 +68,10 @@ void PhysicsWorld::deinitialize() {
 
 void PhysicsWorld::stepSimulation(double time_diff) {
     if(mIsEnabled) {
-        mDynamicsWorld->stepSimulation(time_diff, 10);
-        mDebugDrawer->step();
+        {
+            DUCTTAPE_PROFILE_ZONE("btDiscreteDynamicsWorld::stepSimulation");
+            mDynamicsWorld->stepSimulation(time_diff, 10);
+        }
     }
 }
 
@@ -130,6 +138,113 @@ bool PhysicsWorld::isEnabled() const {
     return mIsEnabled;
 }
 
+void PhysicsWorld::addRigidBody(btRigidBody* body) {
+    QueuedChange change = {body, true, false, 0, 0};
+    if(mBatchDepth > 0)
+        _queueChange(change);
+    else
+        _applyChange(change);
+}
+
+void PhysicsWorld::addRigidBody(btRigidBody* body, uint16_t group, uint16_t mask) {
+    QueuedChange change = {body, true, true, group, mask};
+    if(mBatchDepth > 0)
+        _queueChange(change);
+    else
+        _applyChange(change);
+}
+
+void PhysicsWorld::removeRigidBody(btRigidBody* body) {
+    QueuedChange change = {body, false, false, 0, 0};
+    if(mBatchDepth > 0)
+        _queueChange(change);
+    else
+        _applyChange(change);
+}
+
+void PhysicsWorld::beginBatch() {
+    ++mBatchDepth;
+}
+
+void PhysicsWorld::endBatch() {
+    if(mBatchDepth == 0 || --mBatchDepth > 0)
+        return;
+
+    bool added = false;
+    for(auto iter = mQueuedChanges.begin(); iter != mQueuedChanges.end(); ++iter) {
+        added |= _applyChange(*iter);
+    }
+    mQueuedChanges.clear();
+    mQueuedIndices.clear();
+
+    // inserting many proxies one by one leaves the tree unbalanced
+    if(added)
+        mBroadphase->optimize();
+}
+
+bool PhysicsWorld::isBatching() const {
+    return mBatchDepth > 0;
+}
+
+void PhysicsWorld::_applyQueuedChange(btRigidBody* body) {
+    auto iter = mQueuedIndices.find(body);
+    if(iter == mQueuedIndices.end())
+        return;
+
+    uint32_t index = iter->second;
+    _applyChange(mQueuedChanges[index]);
+    mQueuedIndices.erase(iter);
+
+    // the last change takes its place
+    if(index != mQueuedChanges.size() - 1) {
+        mQueuedChanges[index] = mQueuedChanges.back();
+        mQueuedIndices[mQueuedChanges[index].mBody] = index;
+    }
+    mQueuedChanges.pop_back();
+}
+
+void PhysicsWorld::_queueChange(const QueuedChange& change) {
+    auto iter = mQueuedIndices.find(change.mBody);
+    if(iter != mQueuedIndices.end()) {
+        mQueuedChanges[iter->second] = change;
+    } else {
+        mQueuedIndices.insert(std::make_pair(change.mBody, mQueuedChanges.size()));
+        mQueuedChanges.push_back(change);
+    }
+}
+
+bool PhysicsWorld::_applyChange(const QueuedChange& change) {
+    btBroadphaseProxy* proxy = change.mBody->getBroadphaseHandle();
+    if(!change.mIsAdded) {
+        if(proxy != nullptr)
+            mDynamicsWorld->removeRigidBody(change.mBody);
+        return false;
+    }
+
+    if(proxy != nullptr) {
+        // already in the world, only a changed filter requires adding it again
+        if(!change.mHasFilter || (static_cast<uint16_t>(proxy->m_collisionFilterGroup) == change.mGroup
+                                  && static_cast<uint16_t>(proxy->m_collisionFilterMask) == change.mMask))
+            return false;
+        mDynamicsWorld->removeRigidBody(change.mBody);
+    }
+
+    if(change.mHasFilter)
+        mDynamicsWorld->addRigidBody(change.mBody, change.mGroup, change.mMask);
+    else
+        mDynamicsWorld->addRigidBody(change.mBody);
+    return true;
+}
+
+bool PhysicsWorld::_needsDebugDraw() const {
+    return mDebugDrawer != nullptr && (mShowDebug || mHasDebugDrawings);
+}
+
+void PhysicsWorld::_drawDebug() {
+    mDebugDrawer->step();
+    mHasDebugDrawings = mShowDebug;
+}
+
 // Callback stuff for Bullet (static)
 void PhysicsWorld::BulletTickCallback(btDynamicsWorld* world, btScalar time_diff) {
     PhysicsWorld* physics_world = static_cast<PhysicsWorld*>(world->getWorldUserInfo());
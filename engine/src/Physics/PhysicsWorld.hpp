@@ -21,6 +21,10 @@
 
 #include <QString>
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 namespace dt {
 
 // forward declaration due to circular dependency
@@ -48,7 +52,7 @@ public:
     void deinitialize();
 
     /**
-      * Steps the simulation.
+      * Steps the simulation. The debug drawings are updated once per frame by the PhysicsManager.
       * @param time_diff The time to step the simulation with.
       */
     void stepSimulation(double time_diff);
@@ -102,6 +106,66 @@ public:
       */
     bool isEnabled() const;
 
+    /**
+      * Adds a rigid body to the Bullet world, or queues it if a batch is open.
+      * @param body The body.
+      */
+    void addRigidBody(btRigidBody* body);
+
+    /**
+      * Adds a rigid body with a collision filter to the Bullet world, or queues it if a batch is open.
+      * @param body The body.
+      * @param group The collision group of the body.
+      * @param mask The collision groups the body collides with.
+      */
+    void addRigidBody(btRigidBody* body, uint16_t group, uint16_t mask);
+
+    /**
+      * Removes a rigid body from the Bullet world, or queues its removal if a batch is open.
+      * @param body The body.
+      */
+    void removeRigidBody(btRigidBody* body);
+
+    /**
+      * Opens a batch of body changes, e.g. to enable or disable a whole level section. Until the batch is closed,
+      * bodies are only queued for adding or removing, and changes that cancel each other out are dropped.
+      * Batches can be nested.
+      * @see endBatch()
+      */
+    void beginBatch();
+
+    /**
+      * Closes a batch of body changes. When the outermost batch is closed, the queued changes are applied
+      * and the broadphase tree is rebuilt once if bodies were added.
+      */
+    void endBatch();
+
+    /**
+      * Returns whether a batch of body changes is open.
+      * @returns Whether a batch is open.
+      */
+    bool isBatching() const;
+
+    /**
+      * Applies the queued change of a body right away, e.g. before it is deleted.
+      * @internal
+      * @param body The body.
+      */
+    void _applyQueuedChange(btRigidBody* body);
+
+    /**
+      * Returns whether the debug drawings have to be updated, i.e. they are shown or have not been cleared yet.
+      * @internal
+      * @returns Whether _drawDebug() has something to do.
+      */
+    bool _needsDebugDraw() const;
+
+    /**
+      * Updates the debug drawings in the scene graph. The caller has to hold the render mutex.
+      * @internal
+      */
+    void _drawDebug();
+
     /**
       * Bullet tick callback.
       * @param world The bullet world that was stepped.
@@ -110,6 +174,30 @@ public:
     static void BulletTickCallback(btDynamicsWorld* world, btScalar time_diff);
 
 private:
+    /**
+      * A body change queued during a batch.
+      */
+    struct QueuedChange {
+        btRigidBody* mBody;     //!< The body.
+        bool mIsAdded;          //!< Whether the body should be in the world after the batch.
+        bool mHasFilter;        //!< Whether the body is added with a collision filter.
+        uint16_t mGroup;        //!< The collision group of the body.
+        uint16_t mMask;         //!< The collision groups the body collides with.
+    };
+
+    /**
+      * Queues a body change, replacing an earlier change of the same body.
+      * @param change The change.
+      */
+    void _queueChange(const QueuedChange& change);
+
+    /**
+      * Adds or removes a body, unless it already is in the requested state.
+      * @param change The change.
+      * @returns Whether the body has been added.
+      */
+    bool _applyChange(const QueuedChange& change);
+
     // bullet stuff
     btDbvtBroadphase* mBroadphase;                              //!< The Bullet broadphase.
     btDefaultCollisionConfiguration* mCollisionConfiguration;   //!< The Bullet collision configuration.
@@ -119,10 +207,14 @@ private:
 
     BtOgre::DebugDrawer* mDebugDrawer;  //!< The debug drawer.
     bool mShowDebug;                    //!< Whether to show debug drawings or not.
+    bool mHasDebugDrawings;             //!< Whether the debug drawer has drawn something that is not cleared yet.
     Scene* mScene;                      //!< The scene associated with this PhysicsWorld.
     Ogre::Vector3 mGravity;             //!< The gravity of this world.
     QString mName;                  //!< The name of this world.
     bool mIsEnabled;                    //!< Whether the world is enabled or not.
+    uint32_t mBatchDepth;               //!< The number of open batches.
+    std::vector<QueuedChange> mQueuedChanges;                   //!< The body changes of the open batch.
+    std::unordered_map<btRigidBody*, uint32_t> mQueuedIndices;  //!< The index in mQueuedChanges of each queued body.
 };
 
 }
@@ -0,0 +1,371 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/AabbTree.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace dt {
+
+namespace {
+
+/**
+  * Returns half the surface area of a box, the cost of visiting it.
+  */
+float area(const Ogre::Vector3& min, const Ogre::Vector3& max) {
+    Ogre::Vector3 size = max - min;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+/**
+  * Returns half the surface area of the union of two boxes.
+  */
+float unionArea(const Ogre::Vector3& min1, const Ogre::Vector3& max1, const Ogre::Vector3& min2, const Ogre::Vector3& max2) {
+    Ogre::Vector3 min = min1;
+    Ogre::Vector3 max = max1;
+    min.makeFloor(min2);
+    max.makeCeil(max2);
+    return area(min, max);
+}
+
+} // anonymous namespace
+
+const int32_t AabbTree::NO_NODE = -1;
+
+AabbTree::AabbTree(float margin)
+    : mMargin(margin),
+      mRoot(NO_NODE),
+      mFreeList(NO_NODE) {}
+
+int32_t AabbTree::getHeight() const {
+    return (mRoot == NO_NODE) ? 0 : mTreeNodes[mRoot].mHeight;
+}
+
+void AabbTree::_insertProxy(uint32_t proxy) {
+    if(proxy >= mProxyLeaves.size())
+        mProxyLeaves.resize(proxy + 1, NO_NODE);
+
+    int32_t leaf = _allocateNode();
+    TreeNode& node = mTreeNodes[leaf];
+    Ogre::Vector3 margin(mMargin, mMargin, mMargin);
+    node.mMin = mPositions[proxy] - margin;
+    node.mMax = mPositions[proxy] + margin;
+    node.mHeight = 0;
+    node.mProxy = proxy;
+    mProxyLeaves[proxy] = leaf;
+
+    _insertLeaf(leaf);
+}
+
+void AabbTree::_removeProxy(uint32_t proxy) {
+    int32_t leaf = mProxyLeaves[proxy];
+    _removeLeaf(leaf);
+    _freeNode(leaf);
+    mProxyLeaves[proxy] = NO_NODE;
+}
+
+void AabbTree::_moveProxy(uint32_t proxy) {
+    int32_t leaf = mProxyLeaves[proxy];
+    const Ogre::Vector3& p = mPositions[proxy];
+    const TreeNode& node = mTreeNodes[leaf];
+    if(p.x >= node.mMin.x && p.x <= node.mMax.x && p.y >= node.mMin.y && p.y <= node.mMax.y
+       && p.z >= node.mMin.z && p.z <= node.mMax.z)
+        return; // still inside the fat box
+
+    _removeLeaf(leaf);
+    Ogre::Vector3 margin(mMargin, mMargin, mMargin);
+    mTreeNodes[leaf].mMin = p - margin;
+    mTreeNodes[leaf].mMax = p + margin;
+    _insertLeaf(leaf);
+}
+
+void AabbTree::_queryBox(const Ogre::Vector3& min, const Ogre::Vector3& max, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_NODE)
+        return;
+
+    mStack.clear();
+    mStack.push_back(mRoot);
+    while(!mStack.empty()) {
+        const TreeNode& node = mTreeNodes[mStack.back()];
+        mStack.pop_back();
+
+        if(node.mMin.x > max.x || node.mMax.x < min.x || node.mMin.y > max.y || node.mMax.y < min.y
+           || node.mMin.z > max.z || node.mMax.z < min.z)
+            continue;
+
+        if(node.mChild1 == NO_NODE) {
+            const Ogre::Vector3& p = mPositions[node.mProxy];
+            if(p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z)
+                result.push_back(node.mProxy);
+        } else {
+            mStack.push_back(node.mChild1);
+            mStack.push_back(node.mChild2);
+        }
+    }
+}
+
+void AabbTree::_queryRadius(const Ogre::Vector3& center, float radius, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_NODE)
+        return;
+
+    float squared_radius = radius * radius;
+    mStack.clear();
+    mStack.push_back(mRoot);
+    while(!mStack.empty()) {
+        const TreeNode& node = mTreeNodes[mStack.back()];
+        mStack.pop_back();
+
+        if(_squaredDistance(center, node.mMin, node.mMax) > squared_radius)
+            continue;
+
+        if(node.mChild1 == NO_NODE) {
+            if(mPositions[node.mProxy].squaredDistance(center) <= squared_radius)
+                result.push_back(node.mProxy);
+        } else {
+            mStack.push_back(node.mChild1);
+            mStack.push_back(node.mChild2);
+        }
+    }
+}
+
+void AabbTree::_queryNearest(const Ogre::Vector3& point, uint32_t count, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_NODE)
+        return;
+
+    // best-first search: visit the tree nodes by distance, stop when the closest one is farther away than the worst result
+    typedef std::pair<float, int32_t> NodeEntry;
+    typedef std::pair<float, uint32_t> ProxyEntry;
+    std::priority_queue<NodeEntry, std::vector<NodeEntry>, std::greater<NodeEntry> > nodes;
+    std::priority_queue<ProxyEntry> best;   // the worst result on top
+
+    nodes.push(NodeEntry(0.f, mRoot));
+    while(!nodes.empty()) {
+        NodeEntry next = nodes.top();
+        nodes.pop();
+        if(best.size() == count && next.first > best.top().first)
+            break;
+
+        const TreeNode& node = mTreeNodes[next.second];
+        if(node.mChild1 == NO_NODE) {
+            float distance = mPositions[node.mProxy].squaredDistance(point);
+            if(best.size() < count) {
+                best.push(ProxyEntry(distance, node.mProxy));
+            } else if(distance < best.top().first) {
+                best.pop();
+                best.push(ProxyEntry(distance, node.mProxy));
+            }
+        } else {
+            const TreeNode& child1 = mTreeNodes[node.mChild1];
+            const TreeNode& child2 = mTreeNodes[node.mChild2];
+            nodes.push(NodeEntry(_squaredDistance(point, child1.mMin, child1.mMax), node.mChild1));
+            nodes.push(NodeEntry(_squaredDistance(point, child2.mMin, child2.mMax), node.mChild2));
+        }
+    }
+
+    uint32_t first = result.size();
+    result.resize(first + best.size());
+    for(uint32_t i = result.size(); i > first; --i) {
+        result[i - 1] = best.top().second;
+        best.pop();
+    }
+}
+
+void AabbTree::_queryVolume(const Ogre::PlaneBoundedVolume& volume, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_NODE)
+        return;
+
+    mStack.clear();
+    mStack.push_back(mRoot);
+    while(!mStack.empty()) {
+        const TreeNode& node = mTreeNodes[mStack.back()];
+        mStack.pop_back();
+
+        if(node.mChild1 == NO_NODE) {
+            if(!_isOutside(volume, mPositions[node.mProxy]))
+                result.push_back(node.mProxy);
+        } else if(!_isOutside(volume, node.mMin, node.mMax)) {
+            mStack.push_back(node.mChild1);
+            mStack.push_back(node.mChild2);
+        }
+    }
+}
+
+int32_t AabbTree::_allocateNode() {
+    int32_t node;
+    if(mFreeList == NO_NODE) {
+        node = mTreeNodes.size();
+        mTreeNodes.push_back(TreeNode());
+    } else {
+        node = mFreeList;
+        mFreeList = mTreeNodes[node].mParent;
+    }
+
+    TreeNode& n = mTreeNodes[node];
+    n.mParent = NO_NODE;
+    n.mChild1 = NO_NODE;
+    n.mChild2 = NO_NODE;
+    n.mHeight = 0;
+    n.mProxy = INVALID_PROXY;
+    return node;
+}
+
+void AabbTree::_freeNode(int32_t node) {
+    mTreeNodes[node].mParent = mFreeList;
+    mTreeNodes[node].mHeight = -1;
+    mFreeList = node;
+}
+
+void AabbTree::_insertLeaf(int32_t leaf) {
+    if(mRoot == NO_NODE) {
+        mRoot = leaf;
+        mTreeNodes[leaf].mParent = NO_NODE;
+        return;
+    }
+
+    // walk down to the sibling that enlarges the tree the least
+    Ogre::Vector3 leaf_min = mTreeNodes[leaf].mMin;
+    Ogre::Vector3 leaf_max = mTreeNodes[leaf].mMax;
+    int32_t sibling = mRoot;
+    while(mTreeNodes[sibling].mChild1 != NO_NODE) {
+        const TreeNode& node = mTreeNodes[sibling];
+        float combined = unionArea(node.mMin, node.mMax, leaf_min, leaf_max);
+
+        // the cost of pairing the leaf with this node, and the cost of going further down
+        float cost = 2 * combined;
+        float inheritance = 2 * (combined - area(node.mMin, node.mMax));
+
+        float child_costs[2];
+        int32_t children[2] = {node.mChild1, node.mChild2};
+        for(uint32_t i = 0; i < 2; ++i) {
+            const TreeNode& child = mTreeNodes[children[i]];
+            child_costs[i] = unionArea(child.mMin, child.mMax, leaf_min, leaf_max) + inheritance;
+            if(child.mChild1 != NO_NODE)
+                child_costs[i] -= area(child.mMin, child.mMax);
+        }
+
+        if(cost < child_costs[0] && cost < child_costs[1])
+            break;
+        sibling = (child_costs[0] < child_costs[1]) ? children[0] : children[1];
+    }
+
+    // replace the sibling by a new parent of the sibling and the leaf
+    int32_t old_parent = mTreeNodes[sibling].mParent;
+    int32_t new_parent = _allocateNode();
+    mTreeNodes[new_parent].mParent = old_parent;
+    mTreeNodes[new_parent].mChild1 = sibling;
+    mTreeNodes[new_parent].mChild2 = leaf;
+    mTreeNodes[new_parent].mHeight = mTreeNodes[sibling].mHeight + 1;
+    _setUnion(new_parent, sibling, leaf);
+    mTreeNodes[sibling].mParent = new_parent;
+    mTreeNodes[leaf].mParent = new_parent;
+
+    if(old_parent == NO_NODE) {
+        mRoot = new_parent;
+    } else {
+        if(mTreeNodes[old_parent].mChild1 == sibling)
+            mTreeNodes[old_parent].mChild1 = new_parent;
+        else
+            mTreeNodes[old_parent].mChild2 = new_parent;
+    }
+
+    _refit(old_parent);
+}
+
+void AabbTree::_removeLeaf(int32_t leaf) {
+    if(leaf == mRoot) {
+        mRoot = NO_NODE;
+        return;
+    }
+
+    // the sibling takes the place of the parent
+    int32_t parent = mTreeNodes[leaf].mParent;
+    int32_t grand_parent = mTreeNodes[parent].mParent;
+    int32_t sibling = (mTreeNodes[parent].mChild1 == leaf) ? mTreeNodes[parent].mChild2 : mTreeNodes[parent].mChild1;
+
+    mTreeNodes[sibling].mParent = grand_parent;
+    if(grand_parent == NO_NODE) {
+        mRoot = sibling;
+    } else {
+        if(mTreeNodes[grand_parent].mChild1 == parent)
+            mTreeNodes[grand_parent].mChild1 = sibling;
+        else
+            mTreeNodes[grand_parent].mChild2 = sibling;
+    }
+    _freeNode(parent);
+    mTreeNodes[leaf].mParent = NO_NODE;
+
+    _refit(grand_parent);
+}
+
+void AabbTree::_refit(int32_t node) {
+    while(node != NO_NODE) {
+        node = _balance(node);
+
+        TreeNode& n = mTreeNodes[node];
+        n.mHeight = 1 + std::max(mTreeNodes[n.mChild1].mHeight, mTreeNodes[n.mChild2].mHeight);
+        _setUnion(node, n.mChild1, n.mChild2);
+        node = n.mParent;
+    }
+}
+
+int32_t AabbTree::_balance(int32_t a) {
+    TreeNode& node_a = mTreeNodes[a];
+    if(node_a.mChild1 == NO_NODE || node_a.mHeight < 2)
+        return a;
+
+    int32_t b = node_a.mChild1;
+    int32_t c = node_a.mChild2;
+    int32_t balance = mTreeNodes[c].mHeight - mTreeNodes[b].mHeight;
+    if(balance >= -1 && balance <= 1)
+        return a;
+
+    // rotate the higher child up, it keeps its higher grandchild and gives the other one to a
+    int32_t up = (balance > 1) ? c : b;
+    int32_t other = (balance > 1) ? b : c;
+    TreeNode& node_up = mTreeNodes[up];
+    int32_t f = node_up.mChild1;
+    int32_t g = node_up.mChild2;
+
+    node_up.mChild1 = a;
+    node_up.mParent = node_a.mParent;
+    node_a.mParent = up;
+    if(node_up.mParent == NO_NODE) {
+        mRoot = up;
+    } else if(mTreeNodes[node_up.mParent].mChild1 == a) {
+        mTreeNodes[node_up.mParent].mChild1 = up;
+    } else {
+        mTreeNodes[node_up.mParent].mChild2 = up;
+    }
+
+    int32_t keep = (mTreeNodes[f].mHeight > mTreeNodes[g].mHeight) ? f : g;
+    int32_t give = (keep == f) ? g : f;
+    node_up.mChild2 = keep;
+    if(balance > 1)
+        node_a.mChild2 = give;
+    else
+        node_a.mChild1 = give;
+    mTreeNodes[give].mParent = a;
+
+    _setUnion(a, other, give);
+    node_a.mHeight = 1 + std::max(mTreeNodes[other].mHeight, mTreeNodes[give].mHeight);
+    _setUnion(up, a, keep);
+    node_up.mHeight = 1 + std::max(node_a.mHeight, mTreeNodes[keep].mHeight);
+    return up;
+}
+
+void AabbTree::_setUnion(int32_t node, int32_t a, int32_t b) {
+    TreeNode& n = mTreeNodes[node];
+    n.mMin = mTreeNodes[a].mMin;
+    n.mMax = mTreeNodes[a].mMax;
+    n.mMin.makeFloor(mTreeNodes[b].mMin);
+    n.mMax.makeCeil(mTreeNodes[b].mMax);
+}
+
+} // namespace dt
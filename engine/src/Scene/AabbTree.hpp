@@ -0,0 +1,122 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_AABBTREE
+#define DUCTTAPE_ENGINE_SCENE_AABBTREE
+
+#include <Config.hpp>
+
+#include <Scene/SpatialIndex.hpp>
+
+#include <OgreVector3.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace dt {
+
+/**
+  * A SpatialIndex that keeps the Nodes in a dynamic bounding volume hierarchy. Every Node is a leaf
+  * with a box slightly larger than its position, so small movements do not change the tree. New leaves
+  * are inserted where they enlarge the tree the least, and the tree is kept balanced by rotations.
+  */
+class DUCTTAPE_API AabbTree : public SpatialIndex {
+public:
+    /**
+      * Constructor.
+      * @param margin The distance a Node can move before its leaf has to be reinserted.
+      */
+    AabbTree(float margin = 1.f);
+
+    /**
+      * Returns the height of the tree.
+      * @returns The height of the tree, 0 if it has only one leaf.
+      */
+    int32_t getHeight() const;
+
+protected:
+    void _insertProxy(uint32_t proxy);
+    void _removeProxy(uint32_t proxy);
+    void _moveProxy(uint32_t proxy);
+    void _queryBox(const Ogre::Vector3& min, const Ogre::Vector3& max, std::vector<uint32_t>& result) const;
+    void _queryRadius(const Ogre::Vector3& center, float radius, std::vector<uint32_t>& result) const;
+    void _queryNearest(const Ogre::Vector3& point, uint32_t count, std::vector<uint32_t>& result) const;
+    void _queryVolume(const Ogre::PlaneBoundedVolume& volume, std::vector<uint32_t>& result) const;
+
+private:
+    static const int32_t NO_NODE;   //!< The tree node index for "no tree node".
+
+    /**
+      * A node of the tree. Leaves hold a proxy, inner nodes have two children.
+      */
+    struct TreeNode {
+        Ogre::Vector3 mMin;     //!< The minimum corner of the box.
+        Ogre::Vector3 mMax;     //!< The maximum corner of the box.
+        int32_t mParent;        //!< The parent, or the next unused tree node if this one is unused.
+        int32_t mChild1;        //!< The first child, or NO_NODE for leaves.
+        int32_t mChild2;        //!< The second child, or NO_NODE for leaves.
+        int32_t mHeight;        //!< 0 for leaves, -1 for unused tree nodes.
+        uint32_t mProxy;        //!< The proxy of a leaf.
+    };
+
+    /**
+      * Takes an unused tree node.
+      * @returns The tree node.
+      */
+    int32_t _allocateNode();
+
+    /**
+      * Returns a tree node to the unused ones.
+      * @param node The tree node.
+      */
+    void _freeNode(int32_t node);
+
+    /**
+      * Adds a leaf to the tree.
+      * @param leaf The leaf.
+      */
+    void _insertLeaf(int32_t leaf);
+
+    /**
+      * Removes a leaf from the tree, without freeing it.
+      * @param leaf The leaf.
+      */
+    void _removeLeaf(int32_t leaf);
+
+    /**
+      * Recalculates the boxes and heights from a tree node up to the root, balancing the tree on the way.
+      * @param node The tree node.
+      */
+    void _refit(int32_t node);
+
+    /**
+      * Rotates a tree node if one of its subtrees is higher than the other by more than one.
+      * @param node The tree node.
+      * @returns The tree node that took its place.
+      */
+    int32_t _balance(int32_t node);
+
+    /**
+      * Sets the box of an inner tree node to the union of the boxes of two others.
+      * @param node The tree node.
+      * @param a The first tree node.
+      * @param b The second tree node.
+      */
+    void _setUnion(int32_t node, int32_t a, int32_t b);
+
+    float mMargin;                      //!< The distance between the position of a Node and the border of its leaf.
+    int32_t mRoot;                      //!< The root of the tree, or NO_NODE if it is empty.
+    int32_t mFreeList;                  //!< The first unused tree node, or NO_NODE.
+    std::vector<TreeNode> mTreeNodes;   //!< All tree nodes, including unused ones.
+    std::vector<int32_t> mProxyLeaves;  //!< The leaf of each proxy.
+    mutable std::vector<int32_t> mStack;    //!< The tree nodes still to visit during a query.
+
+};
+
+} // namespace dt
+
+#endif
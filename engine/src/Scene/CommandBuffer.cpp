@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/CommandBuffer.hpp>
+
+#include <Scene/Scene.hpp>
+#include <Utils/Logger.hpp>
+
+#include <QMutexLocker>
+
+namespace dt {
+
+CommandBuffer::CommandBuffer(Scene* scene)
+    : mScene(scene) {}
+
+CommandBuffer::~CommandBuffer() {
+    for(auto command = mCommands.begin(); command != mCommands.end(); ++command) {
+        for(auto iter = command->mSpawned.begin(); iter != command->mSpawned.end(); ++iter) {
+            delete *iter;
+        }
+    }
+}
+
+void CommandBuffer::spawn(Node* parent, Node* child, SpawnCallback on_spawned) {
+    spawn(parent, std::vector<Node*>(1, child), on_spawned);
+}
+
+void CommandBuffer::spawn(Node* parent, const std::vector<Node*>& children, SpawnCallback on_spawned) {
+    Command command;
+    command.mType = Command::SPAWN;
+    command.mNode = 0;
+    command.mParent = parent->getRuntimeId();
+    command.mSpawned = children;
+    command.mOnSpawned = on_spawned;
+
+    QMutexLocker lock(&mMutex);
+    mCommands.push_back(command);
+}
+
+void CommandBuffer::kill(Node* node) {
+    kill(node->getRuntimeId());
+}
+
+void CommandBuffer::kill(uint64_t runtime_id) {
+    Command command;
+    command.mType = Command::KILL;
+    command.mNode = runtime_id;
+    command.mParent = 0;
+
+    QMutexLocker lock(&mMutex);
+    mCommands.push_back(command);
+}
+
+void CommandBuffer::reparent(Node* node, Node* parent) {
+    Command command;
+    command.mType = Command::REPARENT;
+    command.mNode = node->getRuntimeId();
+    command.mParent = parent->getRuntimeId();
+
+    QMutexLocker lock(&mMutex);
+    mCommands.push_back(command);
+}
+
+void CommandBuffer::apply() {
+    std::vector<Command> commands;
+    {
+        QMutexLocker lock(&mMutex);
+        commands.swap(mCommands);
+    }
+
+    for(auto command = commands.begin(); command != commands.end(); ++command) {
+        if(command->mType == Command::SPAWN) {
+            Node* parent = _findNode(command->mParent);
+            if(parent == nullptr) {
+                Logger::get().error("Cannot spawn " + Utils::toString(command->mSpawned.size())
+                                    + " nodes: the parent is not part of scene " + mScene->getName() + ".");
+                for(auto iter = command->mSpawned.begin(); iter != command->mSpawned.end(); ++iter) {
+                    delete *iter;
+                }
+                continue;
+            }
+
+            // Nodes that cannot be added are deleted, so remember the ids beforehand
+            std::vector<uint64_t> ids;
+            for(auto iter = command->mSpawned.begin(); iter != command->mSpawned.end(); ++iter) {
+                ids.push_back((*iter)->getRuntimeId());
+            }
+
+            parent->addChildNodes(command->mSpawned);
+            if(command->mOnSpawned) {
+                for(auto id = ids.begin(); id != ids.end(); ++id) {
+                    Node::NodeSP spawned = mScene->findNode(*id);
+                    if(spawned != nullptr)
+                        command->mOnSpawned(spawned);
+                }
+            }
+        } else if(command->mType == Command::KILL) {
+            Node* node = _findNode(command->mNode);
+            if(node != nullptr && node != mScene)
+                node->getParent()->removeChildNode(node->getName());
+        } else {
+            Node* node = _findNode(command->mNode);
+            Node* parent = _findNode(command->mParent);
+            if(node != nullptr && parent != nullptr && node != mScene)
+                node->setParent(parent);
+        }
+    }
+}
+
+uint32_t CommandBuffer::getSize() const {
+    QMutexLocker lock(&mMutex);
+    return mCommands.size();
+}
+
+Node* CommandBuffer::_findNode(uint64_t runtime_id) {
+    if(runtime_id == mScene->getRuntimeId())
+        return mScene;
+    return mScene->findNode(runtime_id).get();
+}
+
+} // namespace dt
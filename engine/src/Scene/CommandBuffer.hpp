@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_COMMANDBUFFER
+#define DUCTTAPE_ENGINE_SCENE_COMMANDBUFFER
+
+#include <Config.hpp>
+
+#include <Scene/Node.hpp>
+
+#include <QMutex>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace dt {
+
+// forward declaration due to circular dependency
+class Scene;
+
+/**
+  * Collects structural changes of a Scene (spawning, killing and reparenting Nodes) and applies
+  * them in one batch. The Scene applies its buffer once per frame, after all Nodes and components
+  * have been updated, so the Node tree does not change while it is being iterated.
+  * Nodes are referenced by their runtime id, commands for Nodes that have been removed in the
+  * meantime are skipped. Commands can be recorded from any thread.
+  * @see Scene::getCommandBuffer()
+  */
+class DUCTTAPE_API CommandBuffer {
+    Q_DISABLE_COPY(CommandBuffer)
+public:
+    /**
+      * Called after a Node has been spawned, e.g. to add its components.
+      */
+    typedef std::function<void(Node::NodeSP)> SpawnCallback;
+
+    /**
+      * Constructor.
+      * @param scene The Scene the commands are applied to.
+      */
+    CommandBuffer(Scene* scene);
+
+    /**
+      * Destructor. Deletes the Nodes that have not been spawned yet.
+      */
+    ~CommandBuffer();
+
+    /**
+      * Adds a Node as child of another one when the buffer is applied. The buffer takes ownership of the Node.
+      * @param parent The parent, which is either the Scene or one of its Nodes (possibly spawned by an earlier command).
+      * @param child The Node to add.
+      * @param on_spawned Called with the Node once it has been added.
+      */
+    void spawn(Node* parent, Node* child, SpawnCallback on_spawned = SpawnCallback());
+
+    /**
+      * Adds many Nodes as children of another one when the buffer is applied, using Node::addChildNodes().
+      * The buffer takes ownership of the Nodes.
+      * @param parent The parent, which is either the Scene or one of its Nodes.
+      * @param children The Nodes to add.
+      * @param on_spawned Called with every Node once all of them have been added.
+      */
+    void spawn(Node* parent, const std::vector<Node*>& children, SpawnCallback on_spawned = SpawnCallback());
+
+    /**
+      * Removes a Node and all of its children when the buffer is applied.
+      * @param node The Node to remove.
+      */
+    void kill(Node* node);
+
+    /**
+      * Removes a Node and all of its children when the buffer is applied. Nothing happens if there is no Node
+      * with the id by then, so it is safe to use for Nodes that may have been removed meanwhile.
+      * @param runtime_id The runtime id of the Node to remove.
+      */
+    void kill(uint64_t runtime_id);
+
+    /**
+      * Moves a Node to another parent when the buffer is applied.
+      * @param node The Node to move.
+      * @param parent The new parent, which is either the Scene or one of its Nodes.
+      */
+    void reparent(Node* node, Node* parent);
+
+    /**
+      * Executes all recorded commands in the order they have been recorded. Commands recorded
+      * while applying (e.g. by a SpawnCallback) are kept for the next call.
+      */
+    void apply();
+
+    /**
+      * Returns the number of recorded commands.
+      * @returns The number of recorded commands.
+      */
+    uint32_t getSize() const;
+
+private:
+    /**
+      * A recorded structural change.
+      */
+    struct Command {
+        enum Type {
+            SPAWN,
+            KILL,
+            REPARENT
+        };
+
+        Type mType;                 //!< The type of the command.
+        uint64_t mNode;             //!< The runtime id of the Node to kill or reparent.
+        uint64_t mParent;           //!< The runtime id of the (new) parent.
+        std::vector<Node*> mSpawned;    //!< The Nodes to spawn.
+        SpawnCallback mOnSpawned;   //!< Called for every spawned Node.
+    };
+
+    /**
+      * Returns the Node of the Scene with a runtime id.
+      * @param runtime_id The runtime id.
+      * @returns The Node, or nullptr if it is not part of the Scene (anymore).
+      */
+    Node* _findNode(uint64_t runtime_id);
+
+    Scene* mScene;                  //!< The Scene the commands are applied to.
+    std::vector<Command> mCommands; //!< The recorded commands.
+    mutable QMutex mMutex;          //!< Guards mCommands.
+};
+
+} // namespace dt
+
+#endif
@@ -10,25 +10,65 @@
 
 #include <Logic/ScriptManager.hpp>
 #include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
 #include <Utils/Utils.hpp>
 
 namespace dt {
 
+const uint32_t Component::EVERY_TICK = 1;
+const uint32_t Component::ON_DEMAND = 0;
+const uint32_t Component::NEVER = 0xffffffff;
+
 Component::Component(const QString name)
     : mName(name),
+      mNode(nullptr),
       mIsEnabled(false),
-      mIsInitialized(false) {
-    // auto-generate the component name
-    if(mName == "") {
-        mName = "Component-" + Utils::toString(Utils::autoId());
-    }
+      mIsInitialized(false),
+      mStorageIndex(Scene::NOT_STORED),
+      mTickInterval(EVERY_TICK),
+      mIsSleeping(false),
+      mIsTickScheduled(false),
+      mIsUpdateRequested(false),
+      mTickPhase(Scene::NOT_STORED),
+      mTickIndex(0),
+      mLastUpdateTime(0),
+      mIsSignificanceEnabled(false),
+      mSignificance(SignificanceManager::HIGH),
+      mSignificanceTickScale(1),
+      mDeferredSignalIndex(Scene::NOT_STORED),
+      mWasEnabled(false),
+      mAutoId(name.isEmpty() ? Utils::autoId() : 0) {
+    HandleTable::allocate(static_cast<Component*>(this), mHandleIndex, mHandleGeneration);
+}
+
+Component::~Component() {
+    // only the base part is left here, the handle has usually been released on removal
+    _releaseHandle();
+}
 
-    mId = QUuid::createUuid();
+void* Component::operator new(size_t size) {
+    return SlabPool::allocate(size);
 }
 
-Component::~Component() {}
+void Component::operator delete(void* pointer, size_t size) {
+    SlabPool::deallocate(pointer, size);
+}
+
+void Component::_releaseHandle() {
+    HandleTable::release(mHandleIndex);
+    mHandleIndex = HandleTable::INVALID_INDEX;
+}
+
+Name Component::_getNameKey() const {
+    if(mName.isEmpty())
+        return Name::generated(Name::COMPONENT, mAutoId);
+    return Name(mName);
+}
 
 const QString Component::getName() const {
+    // the default name is only generated when it is needed
+    if(mName.isEmpty())
+        return "Component-" + QString::number(mAutoId);
     return mName;
 }
 
@@ -46,6 +86,125 @@ void Component::onDisable() {}
 
 void Component::onUpdate(double time_diff) {}
 
+void Component::onTransformChanged() {}
+
+void Component::onBake() {}
+
+void Component::onUnbake() {}
+
+uint32_t Component::getReadAccess() const {
+    return ALL_ACCESS;
+}
+
+uint32_t Component::getWriteAccess() const {
+    return ALL_ACCESS;
+}
+
+void Component::setTickInterval(uint32_t ticks) {
+    if(ticks == mTickInterval)
+        return;
+
+    Scene* scene = (mNode != nullptr) ? mNode->getScene() : nullptr;
+    if(scene != nullptr)
+        scene->_unscheduleComponent(this);
+    mTickInterval = ticks;
+    if(scene != nullptr)
+        scene->_scheduleComponent(this);
+}
+
+uint32_t Component::getTickInterval() const {
+    return mTickInterval;
+}
+
+bool Component::isSleeping() const {
+    return mIsSleeping;
+}
+
+bool Component::_isTickScheduled() const {
+    return _getScheduledTickInterval() != EVERY_TICK || mIsSleeping;
+}
+
+uint32_t Component::_getScheduledTickInterval() const {
+    if(mTickInterval == ON_DEMAND || mTickInterval == NEVER)
+        return mTickInterval;
+    return mTickInterval * mSignificanceTickScale;
+}
+
+void Component::setSignificanceEnabled(bool enabled) {
+    if(enabled == mIsSignificanceEnabled)
+        return;
+
+    Scene* scene = (mNode != nullptr) ? mNode->getScene() : nullptr;
+    if(scene != nullptr && !enabled)
+        scene->_untrackSignificance(this);
+    mIsSignificanceEnabled = enabled;
+    if(scene != nullptr && enabled)
+        scene->_trackSignificance(this);
+}
+
+bool Component::isSignificanceEnabled() const {
+    return mIsSignificanceEnabled;
+}
+
+SignificanceManager::Level Component::getSignificance() const {
+    return mSignificance;
+}
+
+void Component::onSignificanceChanged(SignificanceManager::Level level) {}
+
+void Component::_setSignificance(SignificanceManager::Level level, uint32_t tick_scale) {
+    if(tick_scale != mSignificanceTickScale) {
+        Scene* scene = (mNode != nullptr) ? mNode->getScene() : nullptr;
+        if(scene != nullptr)
+            scene->_unscheduleComponent(this);
+        mSignificanceTickScale = tick_scale;
+        if(scene != nullptr)
+            scene->_scheduleComponent(this);
+    }
+
+    if(level != mSignificance) {
+        mSignificance = level;
+        onSignificanceChanged(level);
+    }
+}
+
+void Component::sleep() {
+    if(mIsSleeping)
+        return;
+
+    Scene* scene = (mNode != nullptr) ? mNode->getScene() : nullptr;
+    if(scene != nullptr)
+        scene->_unscheduleComponent(this);
+    mIsSleeping = true;
+    if(scene != nullptr)
+        scene->_scheduleComponent(this);
+}
+
+void Component::wake() {
+    if(!mIsSleeping)
+        return;
+
+    Scene* scene = (mNode != nullptr) ? mNode->getScene() : nullptr;
+    if(scene != nullptr)
+        scene->_unscheduleComponent(this);
+    mIsSleeping = false;
+    if(scene != nullptr)
+        scene->_scheduleComponent(this);
+}
+
+void Component::requestUpdate() {
+    if(mTickInterval == NEVER || !_isTickScheduled() || mNode == nullptr)
+        return;
+
+    Scene* scene = mNode->getScene();
+    if(scene != nullptr)
+        scene->_requestUpdate(this);
+}
+
+bool Component::isParallelUpdateSafe() const {
+    return (getWriteAccess() & ~OWN_TRANSFORM) == 0 && (getReadAccess() & OTHER_TRANSFORMS) == 0;
+}
+
 void Component::setNode(Node* node) {
     mNode = node;
 }
@@ -57,6 +216,12 @@ void Component::serialize(IOPacket& packet) {
         packet.stream(type, "type");
     }
 
+    if(packet.getDirection() == IOPacket::SERIALIZE && mId.isNull())
+        mId = QUuid::createUuid();
+
+    if(packet.getDirection() == IOPacket::SERIALIZE && mName.isEmpty())
+        mName = getName();
+
     packet.stream(mId, "uuid");
     packet.stream(mName, "name");
     packet.stream(mIsEnabled, "enabled", true);
@@ -66,10 +231,60 @@ void Component::serialize(IOPacket& packet) {
 
 void Component::onSerialize(IOPacket& packet) {}
 
+Component* Component::clone() {
+    std::string type(metaObject()->className());
+    if(QMetaType::type(type.c_str()) == 0) {
+        Logger::get().error("Cannot clone component " + getName() + ": " + Utils::toString(type) +
+                            " does not override clone() and is not registered with the Serializer.");
+        return nullptr;
+    }
+
+    sf::Packet data;
+    IOPacket out(&data, IOPacket::SERIALIZE);
+    serialize(out);
+
+    // the type is read by the caller on deserialization
+    IOPacket in(&data, IOPacket::DESERIALIZE);
+    in.stream(type, "type");
+    Component* component = Serializer::createComponent(type);
+    component->serialize(in);
+    component->mId = QUuid();
+    return component;
+}
+
+bool Component::_isInComponentStorage() const {
+    return mStorageIndex != Scene::NOT_STORED;
+}
+
+void Component::_emitDeferredSignal() {
+    mDeferredSignalIndex = Scene::NOT_STORED;
+    if(mIsEnabled && !mWasEnabled)
+        emit componentEnabled();
+    else if(!mIsEnabled && mWasEnabled)
+        emit componentDisabled();
+}
+
+bool Component::_deferSignal(bool was_enabled) {
+    if(mDeferredSignalIndex != Scene::NOT_STORED)
+        return true; // already deferred, the state before the batch is kept
+
+    Scene* scene = mNode->getScene();
+    if(scene == nullptr || !scene->isLifecycleBatch())
+        return false;
+
+    mWasEnabled = was_enabled;
+    scene->_deferSignal(this);
+    return true;
+}
+
 Node* Component::getNode() {
     return mNode;
 }
 
+Handle<Component> Component::getHandle() const {
+    return Handle<Component>(mHandleIndex, mHandleGeneration);
+}
+
 QScriptValue Component::getScriptNode() {
     // Making QScriptValue from Node. Type conversion in C style only due to limitation of incomplete type.
     // return dt::ScriptManager::GetScriptEngine()->newQObject((QObject*)mNode);
@@ -89,6 +304,11 @@ void Component::deinitialize() {
     if(mIsInitialized) {
         mIsInitialized = false;
         disable();
+        if(mDeferredSignalIndex != Scene::NOT_STORED) {
+            // the batch must not touch the component after it is gone
+            mNode->getScene()->_cancelDeferredSignal(this);
+            _emitDeferredSignal();
+        }
         emit componentUninitialized();
         onDeinitialize();
     }
@@ -97,7 +317,8 @@ void Component::deinitialize() {
 void Component::enable() {
     if(!mIsEnabled && this->getNode()->isEnabled()) {
         mIsEnabled = true;
-        emit componentEnabled();
+        if(!_deferSignal(false))
+            emit componentEnabled();
         onEnable();
     }
 }
@@ -105,7 +326,8 @@ void Component::enable() {
 void Component::disable() {
     if(mIsEnabled) {
         mIsEnabled = false;
-        emit componentDisabled();
+        if(!_deferSignal(true))
+            emit componentDisabled();
         onDisable();
     }
 }
@@ -11,9 +11,13 @@
 
 #include <Config.hpp>
 
+#include <Utils/Handle.hpp>
+#include <Utils/Name.hpp>
+#include <Utils/SlabAllocator.hpp>
 #include <Utils/Utils.hpp>
 #include <Network/IOPacket.hpp>
 #include <Scene/Serializer.hpp>
+#include <Scene/SignificanceManager.hpp>
 #include <Logic/IScriptable.hpp>
 
 #include <QObject>
@@ -33,6 +37,8 @@ class Node;
   */
 class DUCTTAPE_API Component : public QObject {
     Q_OBJECT
+    friend class Scene;
+
     Q_PROPERTY(QString name READ getName CONSTANT FINAL)
     Q_PROPERTY(bool isEnabled READ isEnabled FINAL)
     Q_PROPERTY(bool isInitialized READ isInitialized FINAL)
@@ -41,7 +47,26 @@ class DUCTTAPE_API Component : public QObject {
 public:
     
     typedef std::shared_ptr<Component> ComponentSP;
+
+    /**
+      * The parts of the engine a component can access in onUpdate().
+      * @see getReadAccess()
+      * @see getWriteAccess()
+      */
+    enum Access {
+        NO_ACCESS = 0x00,           //!< Only the state of the component itself.
+        OWN_TRANSFORM = 0x01,       //!< The transform of the component's Node (and thereby the world transforms of its children).
+        OTHER_TRANSFORMS = 0x02,    //!< Other Nodes, including adding or removing Nodes and Components.
+        PHYSICS_WORLD = 0x04,       //!< The PhysicsWorld of the Scene.
+        SCRIPT_ENGINE = 0x08,       //!< The script engine.
+        ENGINE = 0x10,              //!< Anything else, e.g. the Ogre scene, audio, GUI or input.
+        ALL_ACCESS = 0xff           //!< Everything.
+    };
     
+    static const uint32_t EVERY_TICK;   //!< The tick interval of components that are updated every frame.
+    static const uint32_t ON_DEMAND;    //!< The tick interval of components that are only updated after requestUpdate().
+    static const uint32_t NEVER;        //!< The tick interval of components that are never updated per frame.
+
     /**
       * Constructor with set name.
       * @param name The Component name.
@@ -53,6 +78,20 @@ public:
       */
     virtual ~Component() = 0;
 
+    /**
+      * Allocates the memory for a Component from the SlabPool.
+      * @param size The size of the Component.
+      * @returns The memory.
+      */
+    static void* operator new(size_t size);
+
+    /**
+      * Returns the memory of a Component to the SlabPool.
+      * @param pointer The memory.
+      * @param size The size of the Component.
+      */
+    static void operator delete(void* pointer, size_t size);
+
     /**
       * Called when the component is activated. Initialize all scene objects here.
       */
@@ -79,6 +118,49 @@ public:
       */
     virtual void onUpdate(double time_diff);
 
+    /**
+      * Returns the parts of the engine onUpdate() reads from. The default is ALL_ACCESS, override this
+      * together with getWriteAccess() to allow the Scene to update the component in parallel.
+      * @returns The Access flags for reading.
+      * @see Scene::setParallelUpdate(bool enabled)
+      */
+    virtual uint32_t getReadAccess() const;
+
+    /**
+      * Returns the parts of the engine onUpdate() writes to. The default is ALL_ACCESS.
+      * @returns The Access flags for writing.
+      * @see getReadAccess()
+      */
+    virtual uint32_t getWriteAccess() const;
+
+    /**
+      * Returns whether the component can be updated on a worker thread, concurrently with the components
+      * of other subtrees. This is the case if it writes nothing but its own transform, and does not
+      * read the transforms of other Nodes.
+      * @returns Whether the component can be updated in parallel.
+      */
+    bool isParallelUpdateSafe() const;
+
+    /**
+      * Called when the Scene commits deferred transform changes of the Node (or one of its parents).
+      * Synchronize scene objects with the Node's position here.
+      * @see Scene::setDeferredTransformCommit(bool deferred)
+      */
+    virtual void onTransformChanged();
+
+    /**
+      * Called when the Node becomes static, after the component got its final transform. Merge scene
+      * objects that never move here, e.g. into static geometry.
+      * @see Node::bake()
+      */
+    virtual void onBake();
+
+    /**
+      * Called when the Node becomes dynamic again. Undo onBake() here.
+      * @see Node::unbake()
+      */
+    virtual void onUnbake();
+
     /**
       * Sets the node of this component.
       * @param node The node to be set.
@@ -89,9 +171,125 @@ public:
 
     virtual void onSerialize(IOPacket& packet);
 
+    /**
+      * Creates a new component with the same name and configuration, which is neither initialized nor
+      * assigned to a Node. Components that keep their configuration in a CopyOnWrite share it with
+      * their clones. The default implementation copies the component by serializing it, which requires
+      * the type to be registered with the Serializer.
+      * @returns The new component, or nullptr if the component cannot be cloned.
+      * @see Prefab
+      */
+    virtual Component* clone();
+
+    /**
+      * Sets how often onUpdate() is called. Components that are not updated every tick are updated
+      * by the Scene, which keeps one bucket per interval, so skipped ticks cost nothing. The time
+      * passed to onUpdate() is the time since the last update. Default: EVERY_TICK.
+      * @param ticks The number of ticks between two updates, or ON_DEMAND, or NEVER.
+      */
+    void setTickInterval(uint32_t ticks);
+
+    /**
+      * Returns how often onUpdate() is called.
+      * @returns The number of ticks between two updates, or ON_DEMAND, or NEVER.
+      */
+    uint32_t getTickInterval() const;
+
+    /**
+      * Returns whether the component is sleeping.
+      * @returns Whether the component is sleeping.
+      * @see sleep()
+      */
+    bool isSleeping() const;
+
+    /**
+      * Returns whether the per-frame updates of this component are scheduled by the Scene, instead of
+      * being done by its Node every tick.
+      * @internal
+      * @returns Whether the component is not updated every tick, or is sleeping.
+      */
+    bool _isTickScheduled() const;
+
+    /**
+      * Returns the number of ticks between two updates, taking the significance of the Node into account.
+      * @internal
+      * @returns The tick interval multiplied by the tick scale of the significance level, or ON_DEMAND, or NEVER.
+      */
+    uint32_t _getScheduledTickInterval() const;
+
+    /**
+      * Returns the Name this component is stored under by its Node. A generated name is not interned.
+      * @internal
+      * @returns The Name of this component.
+      */
+    Name _getNameKey() const;
+
+    /**
+      * Frees the slot of this component in the HandleTable, so its handles stop resolving before it is destroyed.
+      * Called by the Node when the component is removed, and by the destructor if it has not been removed.
+      * @internal
+      */
+    void _releaseHandle();
+
+    /**
+      * Sets whether this component does less work when its Node matters less to the player, e.g. because
+      * it is far away or outside the view. The Scene then scores the Node every frame, multiplies the tick
+      * interval of this component with the tick scale of the Node's level, and calls onSignificanceChanged()
+      * when the level changes. Default: false.
+      * @param enabled Whether to use the significance of the Node.
+      * @see SignificanceManager
+      */
+    void setSignificanceEnabled(bool enabled);
+
+    /**
+      * Returns whether this component uses the significance of its Node.
+      * @returns Whether the significance is used.
+      */
+    bool isSignificanceEnabled() const;
+
+    /**
+      * Returns the significance level of the Node, as of the last frame.
+      * @returns The level, HIGH if the significance is not used.
+      */
+    SignificanceManager::Level getSignificance() const;
+
+    /**
+      * Called when the significance level of the Node changes, e.g. to switch to cheaper behaviour.
+      * Must not add or remove Nodes or components.
+      * @param level The new level.
+      * @see setSignificanceEnabled(bool enabled)
+      */
+    virtual void onSignificanceChanged(SignificanceManager::Level level);
+
+    /**
+      * Sets the significance level of the Node.
+      * @internal
+      * @param level The level.
+      * @param tick_scale The factor for the tick interval at this level.
+      */
+    void _setSignificance(SignificanceManager::Level level, uint32_t tick_scale);
+
+    /**
+      * Returns whether this component is kept in the typed component storage of its Scene. Its
+      * per-frame update is done by the Scene then, instead of by its Node.
+      * @internal
+      * @returns Whether this component is kept in the typed component storage.
+      * @see Scene::setTypedComponentStorage(bool enabled)
+      */
+    bool _isInComponentStorage() const;
+
+    /**
+      * Emits the enabled or disabled signal deferred by a lifecycle batch of the Scene, if the component
+      * ended up in another state than before the batch.
+      * @internal
+      * @see Scene::beginLifecycleBatch()
+      */
+    void _emitDeferredSignal();
+
 public slots:
     /**
-      * Returns the name of the Component.
+      * Returns the name of the Component. A component created without a name is called "Component-<number>",
+      * the name is only generated when it is asked for.
       * @returns The name of the Component.
       */
     const QString getName() const;
@@ -108,6 +306,13 @@ public slots:
       */
     Node* getNode();
 
+    /**
+      * Returns a handle to this component. It does not keep the component alive, but detects when it has been destroyed.
+      * @returns The handle.
+      * @see Handle
+      */
+    Handle<Component> getHandle() const;
+
     /**
       * Returns the Node of this component. Used for scripting access.
       * @returns The Node of this component.
@@ -148,6 +353,23 @@ public slots:
 
     QScriptValue toQtScriptObject();
 
+    /**
+      * Puts the component to sleep. It does not receive any updates, not even transform changes,
+      * until wake() is called, e.g. by connecting a signal to it.
+      */
+    void sleep();
+
+    /**
+      * Wakes the component up after sleep().
+      */
+    void wake();
+
+    /**
+      * Requests a single update in the next tick, e.g. for components with the tick interval ON_DEMAND.
+      * Has no effect on components with the tick interval NEVER.
+      */
+    void requestUpdate();
+
 signals:
     void componentInitialized();
     void componentUninitialized();
@@ -155,13 +377,37 @@ signals:
     void componentDisabled();
 
 protected:
-    QString mName;  //!< The Component name.
+    QString mName;  //!< The Component name, or empty for a generated one. Use getName() to read it.
     Node* mNode;        //!< The parent Node.
 
 private:
     bool mIsEnabled;    //!< Whether the component is enabled or not.
     bool mIsInitialized;    //!< Whether the component has been created or not.
-    QUuid mId;    //!< The id for the component.
+    QUuid mId;    //!< The id for the component. Only created when the component is serialized.
+    uint32_t mStorageIndex; //!< The index of this component in the typed component storage of the Scene.
+    uint32_t mTickInterval; //!< The number of ticks between two updates, or ON_DEMAND, or NEVER.
+    bool mIsSleeping;       //!< Whether the component is sleeping.
+    bool mIsTickScheduled;  //!< Whether the component is registered with the tick scheduler of the Scene.
+    bool mIsUpdateRequested;    //!< Whether the component is queued for an update in the next tick.
+    uint32_t mTickPhase;    //!< The tick (modulo the interval) this component is updated in, or Scene::NOT_STORED.
+    uint32_t mTickIndex;    //!< The index of this component among the ones updated in the same tick.
+    double mLastUpdateTime; //!< The scene time of the last update by the tick scheduler.
+    bool mIsSignificanceEnabled;    //!< Whether the component uses the significance of its Node.
+    SignificanceManager::Level mSignificance;   //!< The significance level of the Node.
+    uint32_t mSignificanceTickScale;    //!< The factor for the tick interval at the significance level.
+    uint32_t mDeferredSignalIndex;  //!< The index of this component among the deferred signals of the Scene, or Scene::NOT_STORED.
+    bool mWasEnabled;       //!< Whether the component was enabled when its signal was deferred.
+    uint32_t mHandleIndex;  //!< The index of this component in the HandleTable.
+    uint32_t mHandleGeneration; //!< The generation of the slot of this component in the HandleTable.
+    uint32_t mAutoId;   //!< The number of the generated name, or 0 if the component has been given a name.
+
+
+    /**
+      * Defers the enabled or disabled signal if the Scene is in a lifecycle batch.
+      * @param was_enabled Whether the component was enabled before the change.
+      * @returns Whether the signal has been deferred.
+      */
+    bool _deferSignal(bool was_enabled);
 };
 
 } // namespace dt
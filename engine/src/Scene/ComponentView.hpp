@@ -0,0 +1,114 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_COMPONENTVIEW
+#define DUCTTAPE_ENGINE_SCENE_COMPONENTVIEW
+
+#include <Config.hpp>
+
+#include <Scene/Component.hpp>
+
+#include <cstdint>
+
+namespace dt {
+
+/**
+  * A range over all components of one type in the typed component storage of a Scene.
+  * The view points directly into the storage, so it is only valid until a component of this
+  * type is added or removed.
+  * @see Scene::view()
+  */
+template <typename ComponentType>
+class ComponentView {
+public:
+    /**
+      * Iterator over the components of a ComponentView.
+      */
+    class Iterator {
+    public:
+        /**
+          * Constructor.
+          * @param position The storage element the iterator points to.
+          */
+        explicit Iterator(Component* const* position)
+            : mPosition(position) {}
+
+        ComponentType* operator*() const {
+            return static_cast<ComponentType*>(*mPosition);
+        }
+
+        ComponentType* operator->() const {
+            return static_cast<ComponentType*>(*mPosition);
+        }
+
+        Iterator& operator++() {
+            ++mPosition;
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return mPosition == other.mPosition;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return mPosition != other.mPosition;
+        }
+
+    private:
+        Component* const* mPosition;    //!< The current storage element.
+    };
+
+    /**
+      * Constructor.
+      * @param begin The first component.
+      * @param end One past the last component.
+      */
+    ComponentView(Component* const* begin = nullptr, Component* const* end = nullptr)
+        : mBegin(begin),
+          mEnd(end) {}
+
+    /**
+      * Returns an iterator to the first component.
+      * @returns An iterator to the first component.
+      */
+    Iterator begin() const {
+        return Iterator(mBegin);
+    }
+
+    /**
+      * Returns an iterator past the last component.
+      * @returns An iterator past the last component.
+      */
+    Iterator end() const {
+        return Iterator(mEnd);
+    }
+
+    /**
+      * Returns the number of components in this view.
+      * @returns The number of components in this view.
+      */
+    uint32_t size() const {
+        return static_cast<uint32_t>(mEnd - mBegin);
+    }
+
+    /**
+      * Returns the component at an index.
+      * @param index The index, has to be less than size().
+      * @returns The component.
+      */
+    ComponentType* operator[](uint32_t index) const {
+        return static_cast<ComponentType*>(mBegin[index]);
+    }
+
+private:
+    Component* const* mBegin;   //!< The first component.
+    Component* const* mEnd;     //!< One past the last component.
+};
+
+} // namespace dt
+
+#endif
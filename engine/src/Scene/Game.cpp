@@ -8,26 +8,41 @@
 
 #include <Scene/Game.hpp>
 
+#include <Core/JobSystem.hpp>
 #include <Core/Root.hpp>
 #include <Scene/StateManager.hpp>
 #include <Input/InputManager.hpp>
 #include <Network/NetworkManager.hpp>
 #include <Network/GoodbyeEvent.hpp>
 #include <Graphics/DisplayManager.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/Profiler.hpp>
+#include <Utils/Utils.hpp>
 
 #include <SFML/System/Sleep.hpp>
 #include <SFML/Audio/Listener.hpp>
 
+#include <QThread>
+
 namespace dt {
 
 Game::Game()
     : mIsShutdownRequested(false),
-      mIsRunning(false) {}
+      mIsRunning(false),
+      mProfile(Root::CLIENT),
+      mFramePacing(FIXED_SLEEP),
+      mTargetFrameRate(0),
+      mSleepTime(5),
+      mSpinTime(2),
+      mSimulationFrameTime(0.001),
+      mIsUncapped(false),
+      mIsPipelined(false),
+      mAccumulator(0.0) {}
 
 void Game::run(State* start_state, int argc, char** argv) {
     Root& root = Root::getInstance();
 
-    root.initialize(argc, argv);
+    root.initialize(argc, argv, mProfile);
     root.getStateManager()->setNewState(start_state);
     QObject::connect(root.getInputManager(), SIGNAL(windowClosed()),
                      this,                   SLOT(requestShutdown()));
@@ -37,68 +52,74 @@ void Game::run(State* start_state, int argc, char** argv) {
     QObject::connect(this,                               SIGNAL(beginFrame(double)),
                      (QObject*)root.getPhysicsManager(), SLOT(updateFrame(double)), Qt::DirectConnection);
 
+    // a dedicated server does not render
+    DisplayManager* display = root.getDisplayManager();
+    bool pipelined = mIsPipelined && !root.isHeadless();
+    display->setPipelined(pipelined);
+
     mClock.restart();
+    mAccumulator = 0.0;
     mIsRunning = true;
-
-    // read http://gafferongames.com/game-physics/fix-your-timestep for more
-    // info about this timestep stuff, especially the accumulator and the
-    // "spiral of death"
-    double simulation_frame_time = 0.001;
-    double accumulator = 0.0;
-    sf::Clock anti_spiral_clock;
+    Profiler::setThreadName("Main");
 
     while(!mIsShutdownRequested) {
+        Profiler::beginFrame();
+
         // TIMING
         // TODO: Implement real timing instead of just getting the time difference
         double frame_time = mClock.getElapsedTime().asSeconds();
         mClock.restart();
 
-        // Shift states and cancel if none are left
-        if(!root.getStateManager()->shiftStates())
-            break;
-
-        // INPUT
-        InputManager::get()->capture();
-
-        accumulator += frame_time;
-        while(accumulator >= simulation_frame_time) {
-            anti_spiral_clock.restart();
-            // SIMULATION
-            emit beginFrame(simulation_frame_time);
-
+        {
+            DUCTTAPE_PROFILE_ZONE("Game::shiftStates");
+            // Shift states and cancel if none are left
+            if(!root.getStateManager()->shiftStates())
+                break;
+        }
 
-            // NETWORKING
-            root.getNetworkManager()->sendQueuedEvents();
+        // jobs that had to wait for the main thread
+        root.getJobSystem()->runMainThreadJobs();
 
-            double real_simulation_time = anti_spiral_clock.getElapsedTime().asSeconds();
-            if(real_simulation_time > simulation_frame_time) {
-                // this is bad! the simulation did not render fast enough
-                // to have some time left for rendering etc.
+        // INPUT
+        if(!root.isHeadless()) {
+            DUCTTAPE_PROFILE_ZONE("Game::captureInput");
+            InputManager::get()->capture();
+        }
 
-                // skip a frame to catch up
-                accumulator -= simulation_frame_time;
+        if(pipelined) {
+            // the last simulated frame is rendered while the next one is simulated
+            display->publishSnapshot();
+            JobCounter simulation;
+            root.getJobSystem()->run([this, frame_time] {
+                DUCTTAPE_PROFILE_ZONE("Game::simulate");
+                _simulate(frame_time);
+                _updateListener();
+            }, &simulation);
+            {
+                DUCTTAPE_PROFILE_ZONE("Game::render");
+                display->render();
+            }
+            // the main thread jobs run at the start of the next frame, not while the Scene is being simulated
+            root.getJobSystem()->wait(&simulation, false);
+        } else {
+            _simulate(frame_time);
 
-                accumulator -= real_simulation_time;
+            // DISPLAYING
+            // Won't work without a CameraComponent which initializes the render system!
+            if(!root.isHeadless()) {
+                DUCTTAPE_PROFILE_ZONE("Game::render");
+                display->render();
             }
-            accumulator -= simulation_frame_time;
-        }
 
-        // DISPLAYING
-        // Won't work without a CameraComponent which initializes the render system!
-        root.getDisplayManager()->render();
-
-        // Update the listener.
-        auto main_camera = root.getDisplayManager()->getMainCamera();
-        if(main_camera != nullptr) {
-            auto pos = main_camera->getNode()->getPosition();
-            auto dir = main_camera->getCamera()->getDirection();
-            sf::Listener::setPosition(pos.x, pos.y, pos.z);
-            sf::Listener::setDirection(dir.x, dir.y, dir.z);
+            _updateListener();
         }
 
-        sf::sleep(sf::milliseconds(5));
+        _waitForNextFrame();
     }
 
+    // apply what the last simulated frame recorded
+    display->setPipelined(false);
+
     // Send the GoodbyeEvent to close the network connection.
     root.getNetworkManager()->queueEvent(std::make_shared<GoodbyeEvent>("The client closed the session."));
     root.getNetworkManager()->sendQueuedEvents();
@@ -121,4 +142,185 @@ bool Game::isRunning() {
     return mIsRunning;
 }
 
+void Game::setProfile(Root::Profile profile) {
+    if(mIsRunning) {
+        Logger::get().error("Cannot change the profile while the game is running.");
+        return;
+    }
+    mProfile = profile;
+}
+
+Root::Profile Game::getProfile() const {
+    return mProfile;
+}
+
+void Game::setFramePacing(FramePacing pacing) {
+    mFramePacing = pacing;
+}
+
+Game::FramePacing Game::getFramePacing() const {
+    return mFramePacing;
+}
+
+void Game::setTargetFrameRate(double frame_rate) {
+    mTargetFrameRate = frame_rate > 0 ? frame_rate : 0;
+}
+
+double Game::getTargetFrameRate() const {
+    return mTargetFrameRate;
+}
+
+void Game::setSleepTime(uint32_t milliseconds) {
+    mSleepTime = milliseconds;
+}
+
+uint32_t Game::getSleepTime() const {
+    return mSleepTime;
+}
+
+void Game::setSpinTime(double milliseconds) {
+    mSpinTime = milliseconds > 0 ? milliseconds : 0;
+}
+
+double Game::getSpinTime() const {
+    return mSpinTime;
+}
+
+void Game::setSimulationFrameTime(double seconds) {
+    if(seconds <= 0) {
+        Logger::get().error("Cannot set a simulation frame time of " + Utils::toString(seconds) + " seconds.");
+        return;
+    }
+    if(mIsRunning) {
+        Logger::get().error("Cannot change the simulation frame time while the game is running.");
+        return;
+    }
+    mSimulationFrameTime = seconds;
+}
+
+double Game::getSimulationFrameTime() const {
+    return mSimulationFrameTime;
+}
+
+void Game::setUncapped(bool uncapped) {
+    mIsUncapped = uncapped;
+}
+
+bool Game::isUncapped() const {
+    return mIsUncapped;
+}
+
+void Game::setPipelinedRendering(bool pipelined) {
+    if(mIsRunning) {
+        Logger::get().error("Cannot change the pipelined rendering while the game is running.");
+        return;
+    }
+    mIsPipelined = pipelined;
+}
+
+bool Game::isPipelinedRendering() const {
+    return mIsPipelined;
+}
+
+void Game::_simulate(double frame_time) {
+    Root& root = Root::getInstance();
+
+    // read http://gafferongames.com/game-physics/fix-your-timestep for more
+    // info about this timestep stuff, especially the accumulator and the
+    // "spiral of death"
+    double simulation_frame_time = mSimulationFrameTime;
+    sf::Clock anti_spiral_clock;
+
+    // an uncapped loop simulates one step per frame, however long it took
+    mAccumulator += mIsUncapped ? simulation_frame_time : frame_time;
+    while(mAccumulator >= simulation_frame_time) {
+        DUCTTAPE_PROFILE_ZONE("Game::simulationStep");
+        anti_spiral_clock.restart();
+        // SIMULATION
+        emit beginFrame(simulation_frame_time);
+
+
+        // NETWORKING
+        {
+            DUCTTAPE_PROFILE_ZONE("Game::sendNetworkEvents");
+            root.getNetworkManager()->sendQueuedEvents();
+        }
+
+        double real_simulation_time = anti_spiral_clock.getElapsedTime().asSeconds();
+        if(!mIsUncapped && real_simulation_time > simulation_frame_time) {
+            // this is bad! the simulation did not render fast enough
+            // to have some time left for rendering etc.
+
+            // skip a frame to catch up
+            mAccumulator -= simulation_frame_time;
+
+            mAccumulator -= real_simulation_time;
+        }
+        mAccumulator -= simulation_frame_time;
+    }
+
+    // once per frame, as it has to wait for the rendering
+    root.getPhysicsManager()->drawDebug();
+}
+
+void Game::_updateListener() {
+    Root& root = Root::getInstance();
+    auto main_camera = root.getDisplayManager()->getMainCamera();
+    if(main_camera == nullptr || root.isHeadless())
+        return;
+
+    auto pos = main_camera->getNode()->getPosition();
+    RenderSnapshot* snapshot = root.getDisplayManager()->getRecordingSnapshot();
+    if(snapshot != nullptr) {
+        // the camera has not been moved yet, it follows the node once the snapshot is rendered
+        Ogre::Vector3 dir = main_camera->getNode()->getRotation(Node::SCENE) * Ogre::Vector3::NEGATIVE_UNIT_Z;
+        snapshot->setListener(pos, dir);
+    } else {
+        auto dir = main_camera->getCamera()->getDirection();
+        sf::Listener::setPosition(pos.x, pos.y, pos.z);
+        sf::Listener::setDirection(dir.x, dir.y, dir.z);
+    }
+}
+
+void Game::_waitForNextFrame() {
+    if(mIsUncapped)
+        return;
+
+    DUCTTAPE_PROFILE_ZONE("Game::waitForNextFrame");
+
+    // the time left until the end of this frame, the clock has been restarted at its beginning
+    double remaining = mTargetFrameRate > 0 ? 1.0 / mTargetFrameRate - mClock.getElapsedTime().asSeconds() : 0;
+
+    switch(mFramePacing) {
+    case FIXED_SLEEP:
+        sf::sleep(sf::milliseconds(mSleepTime));
+        break;
+
+    case SLEEP_UNTIL_DEADLINE: {
+        double sleep_time = remaining - mSpinTime / 1000.0;
+        if(sleep_time > 0)
+            sf::sleep(sf::microseconds(static_cast<int64_t>(sleep_time * 1000000.0)));
+        if(remaining > 0) {
+            double deadline = 1.0 / mTargetFrameRate;
+            while(mClock.getElapsedTime().asSeconds() < deadline) {}
+        }
+        break;
+    }
+
+    case YIELD:
+        if(remaining <= 0) {
+            QThread::yieldCurrentThread();
+        } else {
+            double deadline = 1.0 / mTargetFrameRate;
+            while(mClock.getElapsedTime().asSeconds() < deadline) {
+                QThread::yieldCurrentThread();
+            }
+        }
+        break;
+
+    case NONE:
+        break;
+    }
+}
+
 } // namespace dt
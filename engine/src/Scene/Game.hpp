@@ -11,10 +11,12 @@
 
 #include <Config.hpp>
 
+#include <Core/Root.hpp>
 #include <Scene/State.hpp>
 
 #include <SFML/System/Clock.hpp>
 
+#include <cstdint>
 #include <memory>
 
 namespace dt {
@@ -25,11 +27,128 @@ namespace dt {
 class DUCTTAPE_API Game : public QObject {
     Q_OBJECT
 public:
+    /**
+      * How the main loop waits at the end of a frame.
+      */
+    enum FramePacing {
+        FIXED_SLEEP,            //!< Sleep for a fixed time after every frame.
+        SLEEP_UNTIL_DEADLINE,   //!< Sleep until shortly before the end of the frame, then spin until the end.
+        YIELD,                  //!< Yield the thread until the end of the frame.
+        NONE                    //!< Start the next frame immediately.
+    };
+
     /**
       * Default constructor.
       */
     Game();
 
+    /**
+      * Sets the profile run() initializes the engine with. Call it before run().
+      * @param profile The profile. The default is Root::CLIENT.
+      */
+    void setProfile(Root::Profile profile);
+
+    /**
+      * Returns the profile run() initializes the engine with.
+      * @returns The profile.
+      */
+    Root::Profile getProfile() const;
+
+    /**
+      * Sets how the main loop waits at the end of a frame. The default is FIXED_SLEEP.
+      * SLEEP_UNTIL_DEADLINE and YIELD wait for the end of the frame given by the target frame rate,
+      * without a target frame rate they do not wait (SLEEP_UNTIL_DEADLINE) or yield once (YIELD).
+      * @param pacing The frame pacing.
+      */
+    void setFramePacing(FramePacing pacing);
+
+    /**
+      * Returns how the main loop waits at the end of a frame.
+      * @returns The frame pacing.
+      */
+    FramePacing getFramePacing() const;
+
+    /**
+      * Sets the number of frames per second the main loop aims for.
+      * @param frame_rate The frame rate, or 0 for no target. The default is 0.
+      */
+    void setTargetFrameRate(double frame_rate);
+
+    /**
+      * Returns the number of frames per second the main loop aims for.
+      * @returns The frame rate, or 0 if there is no target.
+      */
+    double getTargetFrameRate() const;
+
+    /**
+      * Sets the time slept after every frame with FIXED_SLEEP.
+      * @param milliseconds The time in milliseconds. The default is 5.
+      */
+    void setSleepTime(uint32_t milliseconds);
+
+    /**
+      * Returns the time slept after every frame with FIXED_SLEEP.
+      * @returns The time in milliseconds.
+      */
+    uint32_t getSleepTime() const;
+
+    /**
+      * Sets the time SLEEP_UNTIL_DEADLINE spins before the end of the frame instead of sleeping, to
+      * make up for the inaccuracy of the operating system's sleep.
+      * @param milliseconds The time in milliseconds. The default is 2.
+      */
+    void setSpinTime(double milliseconds);
+
+    /**
+      * Returns the time SLEEP_UNTIL_DEADLINE spins before the end of the frame.
+      * @returns The time in milliseconds.
+      */
+    double getSpinTime() const;
+
+    /**
+      * Sets the time of one simulation step, i.e. the time passed to beginFrame(). Call it before run().
+      * @param seconds The time in seconds. The default is 0.001.
+      */
+    void setSimulationFrameTime(double seconds);
+
+    /**
+      * Returns the time of one simulation step.
+      * @returns The time in seconds.
+      */
+    double getSimulationFrameTime() const;
+
+    /**
+      * Lets the main loop run as fast as possible, e.g. for offline simulation and benchmarks. Every frame
+      * advances the simulation by exactly one step, no matter how much real time has passed, and the loop
+      * does not wait at the end of a frame. The frame pacing and target frame rate are ignored meanwhile.
+      * @param uncapped Whether the main loop is uncapped.
+      */
+    void setUncapped(bool uncapped);
+
+    /**
+      * Returns whether the main loop runs as fast as possible.
+      * @returns Whether the main loop is uncapped.
+      */
+    bool isUncapped() const;
+
+    /**
+      * Sets whether the simulation of a frame runs on a worker thread while the main thread renders the
+      * previous frame, so a frame takes about as long as the slower of both instead of their sum. The
+      * simulation records its results into a RenderSnapshot, which is rendered one frame later. Input,
+      * state changes and scene creation stay on the main thread. Signals emitted by the simulation are
+      * emitted on the worker thread, connect to them with Qt::DirectConnection. Call it before run().
+      * Ignored on a dedicated server.
+      * @param pipelined Whether rendering is pipelined. The default is false.
+      * @see DisplayManager::setPipelined(bool pipelined)
+      */
+    void setPipelinedRendering(bool pipelined);
+
+    /**
+      * Returns whether the simulation runs on a worker thread while the main thread renders.
+      * @returns Whether rendering is pipelined.
+      */
+    bool isPipelinedRendering() const;
+
     /**
       * Returns whether a requested shutdown should be handled. Override this to cancel a shutdown, e.g. when the window was closed.
       * @returns Whether a requested shutdown should be handled.
@@ -61,9 +180,34 @@ signals:
     void beginFrame(double simulation_frame_time);
 
 protected:
+    /**
+      * Waits for the end of the frame, as set by the frame pacing.
+      */
+    void _waitForNextFrame();
+
+    /**
+      * Advances the simulation by the steps that fit into the frame time.
+      * @param frame_time The real time of the last frame, in seconds.
+      */
+    void _simulate(double frame_time);
+
+    /**
+      * Moves the audio listener to the main camera.
+      */
+    void _updateListener();
+
     sf::Clock mClock;           //!< A clock for timing the frames.
     bool mIsShutdownRequested;  //!< Whether a shutdown has been requested.
     bool mIsRunning;            //!< Whether the game loop is running.
+    Root::Profile mProfile;     //!< The profile the engine is initialized with.
+    FramePacing mFramePacing;   //!< How the main loop waits at the end of a frame.
+    double mTargetFrameRate;    //!< The number of frames per second the main loop aims for, or 0.
+    uint32_t mSleepTime;        //!< The time in milliseconds slept after every frame with FIXED_SLEEP.
+    double mSpinTime;           //!< The time in milliseconds spun before the end of the frame with SLEEP_UNTIL_DEADLINE.
+    double mSimulationFrameTime;    //!< The time of one simulation step in seconds.
+    bool mIsUncapped;           //!< Whether the main loop runs as fast as possible.
+    bool mIsPipelined;          //!< Whether the simulation runs on a worker thread while the main thread renders.
+    double mAccumulator;        //!< The simulation time not yet simulated, in seconds.
 };
 
 } // namespace dt
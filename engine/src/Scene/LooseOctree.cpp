@@ -0,0 +1,347 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/LooseOctree.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace dt {
+
+const int32_t LooseOctree::NO_CELL = -1;
+const float LooseOctree::MAX_HALF_SIZE = 1e7f;
+
+LooseOctree::LooseOctree(float half_size, float min_half_size, uint32_t capacity)
+    : mInitialHalfSize(half_size),
+      mMinHalfSize(min_half_size),
+      mCapacity(std::max(capacity, 1u)),
+      mRoot(NO_CELL) {}
+
+uint32_t LooseOctree::getCellCount() const {
+    return mCells.size() - mFreeCells.size();
+}
+
+void LooseOctree::_insertProxy(uint32_t proxy) {
+    if(proxy >= mProxyCells.size()) {
+        mProxyCells.resize(proxy + 1, NO_CELL);
+        mProxySlots.resize(proxy + 1, 0);
+    }
+
+    const Ogre::Vector3& position = mPositions[proxy];
+    if(mRoot == NO_CELL)
+        mRoot = _createCell(Ogre::Vector3::ZERO, mInitialHalfSize, NO_CELL);
+
+    // the comparisons are false for NaN positions, which therefore stay in the root
+    while(!_contains(mRoot, position) && mCells[mRoot].mHalfSize < MAX_HALF_SIZE
+          && std::fabs(position.x) < MAX_HALF_SIZE && std::fabs(position.y) < MAX_HALF_SIZE
+          && std::fabs(position.z) < MAX_HALF_SIZE) {
+        _grow(position);
+    }
+
+    int32_t cell = mRoot;
+    if(_contains(cell, position)) {
+        while(mCells[cell].mIsSplit) {
+            cell = _getChild(cell, _getOctant(cell, position));
+        }
+    }
+    _addToCell(cell, proxy);
+}
+
+void LooseOctree::_removeProxy(uint32_t proxy) {
+    int32_t cell = mProxyCells[proxy];
+    std::vector<uint32_t>& proxies = mCells[cell].mProxies;
+
+    // swap with the last proxy to keep the cell contiguous
+    uint32_t last = proxies.back();
+    proxies[mProxySlots[proxy]] = last;
+    mProxySlots[last] = mProxySlots[proxy];
+    proxies.pop_back();
+    mProxyCells[proxy] = NO_CELL;
+
+    _prune(cell);
+}
+
+void LooseOctree::_moveProxy(uint32_t proxy) {
+    // most movements stay inside the loose bounds, the root has no loose bounds
+    int32_t cell = mProxyCells[proxy];
+    const Ogre::Vector3& position = mPositions[proxy];
+    if(cell != mRoot ? _containsLoosely(cell, position) : (_contains(cell, position) && !mCells[cell].mIsSplit))
+        return;
+
+    _removeProxy(proxy);
+    _insertProxy(proxy);
+}
+
+void LooseOctree::_queryBox(const Ogre::Vector3& min, const Ogre::Vector3& max, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_CELL)
+        return;
+
+    mStack.clear();
+    mStack.push_back(mRoot);
+    while(!mStack.empty()) {
+        const Cell& cell = mCells[mStack.back()];
+        mStack.pop_back();
+
+        for(auto iter = cell.mProxies.begin(); iter != cell.mProxies.end(); ++iter) {
+            const Ogre::Vector3& p = mPositions[*iter];
+            if(p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z)
+                result.push_back(*iter);
+        }
+
+        for(uint32_t octant = 0; octant < 8; ++octant) {
+            int32_t child = cell.mChildren[octant];
+            if(child == NO_CELL)
+                continue;
+            Ogre::Vector3 child_min, child_max;
+            _getLooseBounds(child, child_min, child_max);
+            if(child_min.x <= max.x && child_max.x >= min.x && child_min.y <= max.y && child_max.y >= min.y
+               && child_min.z <= max.z && child_max.z >= min.z)
+                mStack.push_back(child);
+        }
+    }
+}
+
+void LooseOctree::_queryRadius(const Ogre::Vector3& center, float radius, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_CELL)
+        return;
+
+    float squared_radius = radius * radius;
+    mStack.clear();
+    mStack.push_back(mRoot);
+    while(!mStack.empty()) {
+        const Cell& cell = mCells[mStack.back()];
+        mStack.pop_back();
+
+        for(auto iter = cell.mProxies.begin(); iter != cell.mProxies.end(); ++iter) {
+            if(mPositions[*iter].squaredDistance(center) <= squared_radius)
+                result.push_back(*iter);
+        }
+
+        for(uint32_t octant = 0; octant < 8; ++octant) {
+            int32_t child = cell.mChildren[octant];
+            if(child == NO_CELL)
+                continue;
+            Ogre::Vector3 child_min, child_max;
+            _getLooseBounds(child, child_min, child_max);
+            if(_squaredDistance(center, child_min, child_max) <= squared_radius)
+                mStack.push_back(child);
+        }
+    }
+}
+
+void LooseOctree::_queryNearest(const Ogre::Vector3& point, uint32_t count, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_CELL)
+        return;
+
+    // best-first search: visit the cells by distance, stop when the closest cell is farther away than the worst result
+    typedef std::pair<float, int32_t> CellEntry;
+    typedef std::pair<float, uint32_t> ProxyEntry;
+    std::priority_queue<CellEntry, std::vector<CellEntry>, std::greater<CellEntry> > cells;
+    std::priority_queue<ProxyEntry> best;   // the worst result on top
+
+    cells.push(CellEntry(0.f, mRoot));
+    while(!cells.empty()) {
+        CellEntry next = cells.top();
+        cells.pop();
+        if(best.size() == count && next.first > best.top().first)
+            break;
+
+        const Cell& cell = mCells[next.second];
+        for(auto iter = cell.mProxies.begin(); iter != cell.mProxies.end(); ++iter) {
+            float distance = mPositions[*iter].squaredDistance(point);
+            if(best.size() < count) {
+                best.push(ProxyEntry(distance, *iter));
+            } else if(distance < best.top().first) {
+                best.pop();
+                best.push(ProxyEntry(distance, *iter));
+            }
+        }
+
+        for(uint32_t octant = 0; octant < 8; ++octant) {
+            int32_t child = cell.mChildren[octant];
+            if(child == NO_CELL)
+                continue;
+            Ogre::Vector3 child_min, child_max;
+            _getLooseBounds(child, child_min, child_max);
+            float distance = _squaredDistance(point, child_min, child_max);
+            if(best.size() < count || distance < best.top().first)
+                cells.push(CellEntry(distance, child));
+        }
+    }
+
+    uint32_t first = result.size();
+    result.resize(first + best.size());
+    for(uint32_t i = result.size(); i > first; --i) {
+        result[i - 1] = best.top().second;
+        best.pop();
+    }
+}
+
+void LooseOctree::_queryVolume(const Ogre::PlaneBoundedVolume& volume, std::vector<uint32_t>& result) const {
+    if(mRoot == NO_CELL)
+        return;
+
+    mStack.clear();
+    mStack.push_back(mRoot);
+    while(!mStack.empty()) {
+        const Cell& cell = mCells[mStack.back()];
+        mStack.pop_back();
+
+        for(auto iter = cell.mProxies.begin(); iter != cell.mProxies.end(); ++iter) {
+            if(!_isOutside(volume, mPositions[*iter]))
+                result.push_back(*iter);
+        }
+
+        for(uint32_t octant = 0; octant < 8; ++octant) {
+            int32_t child = cell.mChildren[octant];
+            if(child == NO_CELL)
+                continue;
+            Ogre::Vector3 child_min, child_max;
+            _getLooseBounds(child, child_min, child_max);
+            if(!_isOutside(volume, child_min, child_max))
+                mStack.push_back(child);
+        }
+    }
+}
+
+bool LooseOctree::_contains(int32_t cell, const Ogre::Vector3& point) const {
+    const Cell& c = mCells[cell];
+    return std::fabs(point.x - c.mCenter.x) <= c.mHalfSize && std::fabs(point.y - c.mCenter.y) <= c.mHalfSize
+        && std::fabs(point.z - c.mCenter.z) <= c.mHalfSize;
+}
+
+bool LooseOctree::_containsLoosely(int32_t cell, const Ogre::Vector3& point) const {
+    const Cell& c = mCells[cell];
+    float loose = c.mHalfSize * 2;
+    return std::fabs(point.x - c.mCenter.x) <= loose && std::fabs(point.y - c.mCenter.y) <= loose
+        && std::fabs(point.z - c.mCenter.z) <= loose;
+}
+
+uint32_t LooseOctree::_getOctant(int32_t cell, const Ogre::Vector3& point) const {
+    const Ogre::Vector3& center = mCells[cell].mCenter;
+    return (point.x >= center.x ? 1 : 0) | (point.y >= center.y ? 2 : 0) | (point.z >= center.z ? 4 : 0);
+}
+
+int32_t LooseOctree::_getChild(int32_t cell, uint32_t octant) {
+    if(mCells[cell].mChildren[octant] == NO_CELL) {
+        float half_size = mCells[cell].mHalfSize * 0.5f;
+        Ogre::Vector3 center = mCells[cell].mCenter + Ogre::Vector3((octant & 1) ? half_size : -half_size,
+                                                                    (octant & 2) ? half_size : -half_size,
+                                                                    (octant & 4) ? half_size : -half_size);
+        int32_t child = _createCell(center, half_size, cell);
+        mCells[cell].mChildren[octant] = child;
+    }
+    return mCells[cell].mChildren[octant];
+}
+
+int32_t LooseOctree::_createCell(const Ogre::Vector3& center, float half_size, int32_t parent) {
+    int32_t cell;
+    if(mFreeCells.empty()) {
+        cell = mCells.size();
+        mCells.push_back(Cell());
+    } else {
+        cell = mFreeCells.back();
+        mFreeCells.pop_back();
+    }
+
+    Cell& c = mCells[cell];
+    c.mCenter = center;
+    c.mHalfSize = half_size;
+    c.mParent = parent;
+    std::fill(c.mChildren, c.mChildren + 8, NO_CELL);
+    c.mIsSplit = false;
+    c.mProxies.clear();
+    return cell;
+}
+
+void LooseOctree::_addToCell(int32_t cell, uint32_t proxy) {
+    mProxyCells[proxy] = cell;
+    mProxySlots[proxy] = mCells[cell].mProxies.size();
+    mCells[cell].mProxies.push_back(proxy);
+
+    if(!mCells[cell].mIsSplit && mCells[cell].mProxies.size() > mCapacity && mCells[cell].mHalfSize > mMinHalfSize)
+        _split(cell);
+}
+
+void LooseOctree::_split(int32_t cell) {
+    mCells[cell].mIsSplit = true;
+
+    std::vector<uint32_t> proxies;
+    proxies.swap(mCells[cell].mProxies);
+    for(auto iter = proxies.begin(); iter != proxies.end(); ++iter) {
+        const Ogre::Vector3& position = mPositions[*iter];
+        // proxies that moved out of the tight bounds, or are outside the root, stay here
+        int32_t target = _contains(cell, position) ? _getChild(cell, _getOctant(cell, position)) : cell;
+        mProxyCells[*iter] = target;
+        mProxySlots[*iter] = mCells[target].mProxies.size();
+        mCells[target].mProxies.push_back(*iter);
+    }
+}
+
+void LooseOctree::_prune(int32_t cell) {
+    while(cell != NO_CELL && mCells[cell].mProxies.empty()) {
+        Cell& c = mCells[cell];
+        for(uint32_t octant = 0; octant < 8; ++octant) {
+            if(c.mChildren[octant] != NO_CELL)
+                return;
+        }
+
+        int32_t parent = c.mParent;
+        if(parent == NO_CELL) {
+            mRoot = NO_CELL;
+        } else {
+            Cell& p = mCells[parent];
+            std::replace(p.mChildren, p.mChildren + 8, cell, NO_CELL);
+            // a split cell without children takes new proxies itself again
+            if(std::count(p.mChildren, p.mChildren + 8, NO_CELL) == 8)
+                p.mIsSplit = false;
+        }
+        mFreeCells.push_back(cell);
+        cell = parent;
+    }
+}
+
+void LooseOctree::_grow(const Ogre::Vector3& point) {
+    int32_t old_root = mRoot;
+    float half_size = mCells[old_root].mHalfSize;
+    Ogre::Vector3 old_center = mCells[old_root].mCenter;
+
+    // the old root becomes the octant of the new root that points away from the point
+    Ogre::Vector3 center = old_center + Ogre::Vector3(point.x >= old_center.x ? half_size : -half_size,
+                                                     point.y >= old_center.y ? half_size : -half_size,
+                                                     point.z >= old_center.z ? half_size : -half_size);
+    mRoot = _createCell(center, half_size * 2, NO_CELL);
+    mCells[mRoot].mIsSplit = true;
+    mCells[mRoot].mChildren[_getOctant(mRoot, old_center)] = old_root;
+    mCells[old_root].mParent = mRoot;
+
+    // the old root may hold proxies outside of its bounds, which are not allowed below the root
+    std::vector<uint32_t> proxies;
+    proxies.swap(mCells[old_root].mProxies);
+    for(auto iter = proxies.begin(); iter != proxies.end(); ++iter) {
+        if(_containsLoosely(old_root, mPositions[*iter])) {
+            mProxySlots[*iter] = mCells[old_root].mProxies.size();
+            mCells[old_root].mProxies.push_back(*iter);
+        } else {
+            mProxyCells[*iter] = mRoot;
+            mProxySlots[*iter] = mCells[mRoot].mProxies.size();
+            mCells[mRoot].mProxies.push_back(*iter);
+        }
+    }
+}
+
+void LooseOctree::_getLooseBounds(int32_t cell, Ogre::Vector3& min, Ogre::Vector3& max) const {
+    const Cell& c = mCells[cell];
+    float loose = c.mHalfSize * 2;
+    min = c.mCenter - Ogre::Vector3(loose, loose, loose);
+    max = c.mCenter + Ogre::Vector3(loose, loose, loose);
+}
+
+} // namespace dt
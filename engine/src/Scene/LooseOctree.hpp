@@ -0,0 +1,157 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_LOOSEOCTREE
+#define DUCTTAPE_ENGINE_SCENE_LOOSEOCTREE
+
+#include <Config.hpp>
+
+#include <Scene/SpatialIndex.hpp>
+
+#include <OgreVector3.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace dt {
+
+/**
+  * A SpatialIndex that sorts the Nodes into the cells of an octree. Every cell is considered twice
+  * as large as it is when querying, so a Node only has to be moved to another cell after it has left
+  * its cell by half the cell size. Cells are split when they hold too many Nodes and removed when they
+  * become empty. The root cell grows when Nodes are added outside of it.
+  */
+class DUCTTAPE_API LooseOctree : public SpatialIndex {
+public:
+    /**
+      * Constructor.
+      * @param half_size The initial half size of the root cell, which is centered at the origin.
+      * @param min_half_size The half size below which cells are not split any more.
+      * @param capacity The number of Nodes a cell holds before it is split.
+      */
+    LooseOctree(float half_size = 256.f, float min_half_size = 1.f, uint32_t capacity = 16);
+
+    /**
+      * Returns the number of cells.
+      * @returns The number of cells.
+      */
+    uint32_t getCellCount() const;
+
+protected:
+    void _insertProxy(uint32_t proxy);
+    void _removeProxy(uint32_t proxy);
+    void _moveProxy(uint32_t proxy);
+    void _queryBox(const Ogre::Vector3& min, const Ogre::Vector3& max, std::vector<uint32_t>& result) const;
+    void _queryRadius(const Ogre::Vector3& center, float radius, std::vector<uint32_t>& result) const;
+    void _queryNearest(const Ogre::Vector3& point, uint32_t count, std::vector<uint32_t>& result) const;
+    void _queryVolume(const Ogre::PlaneBoundedVolume& volume, std::vector<uint32_t>& result) const;
+
+private:
+    static const int32_t NO_CELL;       //!< The cell index for "no cell".
+    static const float MAX_HALF_SIZE;   //!< The half size at which the root stops growing. Nodes outside stay in the root.
+
+    /**
+      * A cube of the octree.
+      */
+    struct Cell {
+        Ogre::Vector3 mCenter;          //!< The center of the cell.
+        float mHalfSize;                //!< Half the edge length of the cell, without the looseness.
+        int32_t mParent;                //!< The parent cell, or NO_CELL for the root.
+        int32_t mChildren[8];           //!< The child cell for each octant, or NO_CELL.
+        bool mIsSplit;                  //!< Whether new Nodes go into the child cells.
+        std::vector<uint32_t> mProxies; //!< The proxies in this cell.
+    };
+
+    /**
+      * Returns whether a point is inside the tight bounds of a cell.
+      * @param cell The cell.
+      * @param point The point.
+      * @returns Whether the point is inside.
+      */
+    bool _contains(int32_t cell, const Ogre::Vector3& point) const;
+
+    /**
+      * Returns whether a point is inside the loose bounds of a cell, which are twice as large as its tight bounds.
+      * @param cell The cell.
+      * @param point The point.
+      * @returns Whether the point is inside.
+      */
+    bool _containsLoosely(int32_t cell, const Ogre::Vector3& point) const;
+
+    /**
+      * Returns the octant of a cell a point belongs to.
+      * @param cell The cell.
+      * @param point The point.
+      * @returns The octant, 0 to 7.
+      */
+    uint32_t _getOctant(int32_t cell, const Ogre::Vector3& point) const;
+
+    /**
+      * Returns the child cell for an octant, creating it if needed.
+      * @param cell The cell.
+      * @param octant The octant.
+      * @returns The child cell.
+      */
+    int32_t _getChild(int32_t cell, uint32_t octant);
+
+    /**
+      * Creates a new cell.
+      * @param center The center.
+      * @param half_size The half size.
+      * @param parent The parent cell.
+      * @returns The new cell.
+      */
+    int32_t _createCell(const Ogre::Vector3& center, float half_size, int32_t parent);
+
+    /**
+      * Adds a proxy to a cell, splitting the cell if it is full.
+      * @param cell The cell.
+      * @param proxy The proxy.
+      */
+    void _addToCell(int32_t cell, uint32_t proxy);
+
+    /**
+      * Moves the proxies of a cell into new child cells.
+      * @param cell The cell.
+      */
+    void _split(int32_t cell);
+
+    /**
+      * Removes empty cells, starting at a cell and going up.
+      * @param cell The cell.
+      */
+    void _prune(int32_t cell);
+
+    /**
+      * Makes the root twice as large, towards a point outside of it.
+      * @param point The point.
+      */
+    void _grow(const Ogre::Vector3& point);
+
+    /**
+      * Returns the loose bounds of a cell.
+      * @param cell The cell.
+      * @param min Receives the minimum corner.
+      * @param max Receives the maximum corner.
+      */
+    void _getLooseBounds(int32_t cell, Ogre::Vector3& min, Ogre::Vector3& max) const;
+
+    float mInitialHalfSize;             //!< The half size of the root cell when it is created.
+    float mMinHalfSize;                 //!< The half size below which cells are not split.
+    uint32_t mCapacity;                 //!< The number of proxies a cell holds before it is split.
+    int32_t mRoot;                      //!< The root cell, or NO_CELL if the octree is empty.
+    std::vector<Cell> mCells;           //!< All cells, including unused ones.
+    std::vector<int32_t> mFreeCells;    //!< The unused cells.
+    std::vector<int32_t> mProxyCells;   //!< The cell of each proxy.
+    std::vector<uint32_t> mProxySlots;  //!< The index of each proxy in the proxies of its cell.
+    mutable std::vector<int32_t> mStack;    //!< The cells still to visit during a query.
+
+};
+
+} // namespace dt
+
+#endif
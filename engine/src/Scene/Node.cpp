@@ -9,6 +9,7 @@
 
 #include <Scene/StateManager.hpp>
 #include <Logic/ScriptManager.hpp>
+#include <Utils/Profiler.hpp>
 #include <Utils/Utils.hpp>
 #include <Scene/Scene.hpp>
 #include <Scene/Serializer.hpp>
@@ -20,17 +21,39 @@ Node::Node(const QString name)
       mPosition(Ogre::Vector3::ZERO),
       mScale(Ogre::Vector3(1,1,1)),
       mRotation(Ogre::Quaternion::IDENTITY),
+      mWorldPosition(Ogre::Vector3::ZERO),
+      mWorldScale(Ogre::Vector3(1,1,1)),
+      mWorldRotation(Ogre::Quaternion::IDENTITY),
+      mIsWorldTransformDirty(true),
+      mWorldTransformBulkCount(0),
+      mTransformPool(nullptr),
+      mTransformHandle(TransformPool::INVALID_HANDLE),
       mParent(nullptr),
       mIsUpdatingAfterChange(false),
+      mTransformCommitIndex(Scene::NOT_STORED),
+      mRuntimeId(Utils::runtimeId()),
+      mSpatialProxy(SpatialIndex::INVALID_PROXY),
       mDeathMark(false),
-      mIsEnabled(true) {
+      mIsEnabled(true),
+      mIsStatic(false),
+      mJournalIndex(TransformJournal::NOT_RECORDED),
+      mPublishedJournalIndex(TransformJournal::NOT_RECORDED),
+      mTags(0),
+      mAutoId(name.isEmpty() ? Utils::autoId() : 0) {
+    HandleTable::allocate(static_cast<Node*>(this), mHandleIndex, mHandleGeneration);
+}
 
-    // auto-generate name
-    if(mName == "") {
-        mName = "Node-" + Utils::toString(Utils::autoId());
-    }
+Node::~Node() {
+    // only the base part is left here, the handle has usually been released on removal
+    _releaseHandle();
+}
 
-    mId = QUuid::createUuid();
+void* Node::operator new(size_t size) {
+    return SlabPool::allocate(size);
+}
+
+void Node::operator delete(void* pointer, size_t size) {
+    SlabPool::deallocate(pointer, size);
 }
 
 void Node::initialize() {
@@ -40,6 +63,16 @@ void Node::initialize() {
 void Node::deinitialize() {
     onDeinitialize();
 
+    Scene* scene = getScene();
+    if(scene != nullptr)
+        scene->_unindexNode(this);
+
+    if(mTransformCommitIndex != Scene::NOT_STORED) {
+        if(scene != nullptr)
+            scene->_cancelTransformCommit(this);
+        mTransformCommitIndex = Scene::NOT_STORED;
+    }
+
     // clear all children
     while(mChildren.size() > 0) {
         removeChildNode(mChildren.begin()->first);
@@ -47,8 +80,14 @@ void Node::deinitialize() {
 
     // clear all components
     while(mComponents.size() > 0) {
-        removeComponent(mComponents.begin()->second->getName());
+        removeComponent(mComponents.begin()->first);
+    }
+
+    while(mPlainComponents.size() > 0) {
+        removePlainComponent(mPlainComponents.back().get());
     }
+
+    _leaveTransformPool();
 }
 
 void Node::onInitialize() {}
@@ -57,8 +96,14 @@ void Node::onDeinitialize() {}
 
 Node::NodeSP Node::addChildNode(Node* child) {
     if(child != nullptr) {
-        QString key(child->getName());
-        NodeSP child_sp(child);
+        Name key = child->_getNameKey();
+        if(mChildren.count(key) > 0) {
+            Logger::get().error("Cannot add child node " + child->getName() + ": a child node with this name already exists.");
+            delete child;
+            return findChildNode(key, false);
+        }
+
+        NodeSP child_sp(child, std::default_delete<Node>(), SlabAllocator<Node>());
         mChildren.insert(std::make_pair(key, child_sp));
         child_sp->setParent(this);
         child_sp->initialize();
@@ -66,6 +111,9 @@ Node::NodeSP Node::addChildNode(Node* child) {
         if(!mIsEnabled)
             child->disable();
 
+        if(mIsStatic)
+            child->bake();
+
         return findChildNode(key, false);
     }
     else {
@@ -73,43 +121,144 @@ Node::NodeSP Node::addChildNode(Node* child) {
     }
 }
 
+void Node::addChildNodes(const std::vector<Node*>& children) {
+    mChildren.reserve(mChildren.size() + children.size());
+    Scene* scene = getScene();
+    if(scene != nullptr)
+        scene->_reserveNodes(children.size());
+
+    for(auto iter = children.begin(); iter != children.end(); ++iter) {
+        addChildNode(*iter);
+    }
+}
+
 Node::NodeSP Node::findChildNode(const QString name, bool recursive) {
-    if(mChildren.find(name) != mChildren.end())
-        return mChildren.find(name)->second;
+    return findChildNode(Name::find(name), recursive);
+}
 
-    if(recursive){
-        for(std::map<QString, NodeSP>::iterator itr = mChildren.begin(); itr != mChildren.end(); itr++) {
-            if(itr->first == name)
-                return itr->second;
-            else {
-                const NodeSP& childNode = itr->second->findChildNode(name, recursive);
-                if(childNode)
-                    return childNode;
+Node::NodeSP Node::findChildNode(const Name& name, bool recursive) {
+    const NodeSP* child = _findChildNode(name, recursive);
+    return child != nullptr ? *child : NodeSP();
+}
+
+Node::NodeHandle Node::findChildNodeHandle(const QString name, bool recursive) {
+    return findChildNodeHandle(Name::find(name), recursive);
+}
+
+Node::NodeHandle Node::findChildNodeHandle(const Name& name, bool recursive) {
+    const NodeSP* child = _findChildNode(name, recursive);
+    return child != nullptr ? (*child)->getHandle() : NodeHandle();
+}
+
+void Node::_releaseHandle() {
+    HandleTable::release(mHandleIndex);
+    mHandleIndex = HandleTable::INVALID_INDEX;
+}
+
+const Node::NodeSP* Node::_findChildNode(const Name& name, bool recursive) {
+    auto iter = mChildren.find(name);
+    if(iter != mChildren.end())
+        return &iter->second;
+
+    Scene* scene = recursive ? getScene() : nullptr;
+    if(scene != nullptr) {
+        // any indexed Node with this name below this one, every indexed Node is below the Scene
+        const std::vector<Node*>& nodes = scene->findNodes(name);
+        for(auto node = nodes.begin(); node != nodes.end(); ++node) {
+            for(Node* parent = (*node)->mParent; parent != nullptr; parent = parent->mParent) {
+                if(parent == this || this == scene) {
+                    auto child = (*node)->mParent->mChildren.find(name);
+                    if(child != (*node)->mParent->mChildren.end())
+                        return &child->second;
+                    break;
+                }
             }
         }
+        return nullptr;
+    }
+
+    if(recursive){
+        for(iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+            const NodeSP* childNode = iter->second->_findChildNode(name, recursive);
+            if(childNode != nullptr)
+                return childNode;
+        }
     }
-    return NodeSP();
+    return nullptr;
 }
 
 bool Node::hasComponent(const QString name) {
+    return hasComponent(Name::find(name));
+}
+
+bool Node::hasComponent(const Name& name) {
     return (mComponents.count(name) > 0);
 }
 
 void Node::removeChildNode(const QString name) {
-    if(findChildNode(name, false) != nullptr) {
-        findChildNode(name, false)->deinitialize(); // destroy recursively
+    removeChildNode(Name::find(name));
+}
+
+void Node::removeChildNode(const Name& name) {
+    auto iter = mChildren.find(name);
+    if(iter != mChildren.end()) {
+        NodeSP child = iter->second;
+        child->deinitialize(); // destroy recursively
+        child->_releaseHandle();
         mChildren.erase(name);
     }
 }
 
 void Node::removeComponent(const QString name) {
-    if(hasComponent(name)) {
-        mComponents[name]->deinitialize();
+    removeComponent(Name::find(name));
+}
+
+void Node::removeComponent(const Name& name) {
+    auto iter = mComponents.find(name);
+    if(iter != mComponents.end()) {
+        std::shared_ptr<Component> component = iter->second;
+        Scene* scene = getScene();
+        if(scene != nullptr) {
+            scene->_untrackSignificance(component.get());
+            scene->_unstoreComponent(component.get());
+            scene->_unscheduleComponent(component.get());
+        }
+        component->deinitialize();
+        component->_releaseHandle();
         mComponents.erase(name);
     }
 }
 
+uint32_t Node::getPlainComponentCount() const {
+    return mPlainComponents.size();
+}
+
+void Node::removePlainComponent(PlainComponent* component) {
+    for(auto iter = mPlainComponents.begin(); iter != mPlainComponents.end(); ++iter) {
+        if(iter->get() == component) {
+            component->deinitialize();
+            // the last component takes its place
+            std::swap(*iter, mPlainComponents.back());
+            mPlainComponents.pop_back();
+            return;
+        }
+    }
+}
+
+void Node::removePlainComponent(const Name& name) {
+    removePlainComponent(findPlainComponent<PlainComponent>(name));
+}
+
+Name Node::_getNameKey() const {
+    if(mName.isEmpty())
+        return Name::generated(Name::NODE, mAutoId);
+    return Name(mName);
+}
+
 const QString Node::getName() const {
+    // the default name is only generated when it is needed
+    if(mName.isEmpty())
+        return "Node-" + QString::number(mAutoId);
     return mName;
 }
 
@@ -122,44 +271,77 @@ QString Node::getFullName() const {
 
 Ogre::Vector3 Node::getPosition(Node::RelativeTo rel) const {
     if(rel == PARENT || mParent == nullptr) {
+        if(mTransformPool != nullptr)
+            return mTransformPool->getPosition(mTransformHandle);
         return mPosition;
+    } else if(_isPoolWorldTransformCurrent()) {
+        return mTransformPool->getWorldPosition(mTransformHandle);
     } else {
-        return mParent->getPosition(SCENE) + mParent->getRotation() * mPosition;
+        _updateWorldTransform();
+        return mWorldPosition;
     }
 }
 
 void Node::setPosition(Ogre::Vector3 position, Node::RelativeTo rel) {
     if(mIsUpdatingAfterChange || !mIsEnabled)
         return;
+    if(mIsStatic) {
+        Logger::get().error("Cannot move static node " + getName() + ": unbake it first.");
+        return;
+    }
 
+    Ogre::Vector3 local;
     if(rel == PARENT || mParent == nullptr) {
-        mPosition = position;
+        local = position;
     } else {
-        mPosition = mParent->getRotation() * position - mParent->getPosition(SCENE);
+        local = mParent->getRotation() * position - mParent->getPosition(SCENE);
     }
-    onUpdate(0);
+
+    if(mTransformPool != nullptr)
+        mTransformPool->setPosition(mTransformHandle, local);
+    else
+        mPosition = local;
+    _invalidateWorldTransform();
+    if(!_queueTransformCommit())
+        onUpdate(0);
 }
 
 Ogre::Vector3 Node::getScale(Node::RelativeTo rel) const {
     if(rel == PARENT || mParent == nullptr) {
+        if(mTransformPool != nullptr)
+            return mTransformPool->getScale(mTransformHandle);
         return mScale;
+    } else if(_isPoolWorldTransformCurrent()) {
+        return mTransformPool->getWorldScale(mTransformHandle);
     } else {
-        Ogre::Vector3 p = mParent->getScale(SCENE);
-        return Ogre::Vector3(p.x * mScale.x, p.y * mScale.y, p.z * mScale.z);
+        _updateWorldTransform();
+        return mWorldScale;
     }
 }
 
 void Node::setScale(Ogre::Vector3 scale, Node::RelativeTo rel) {
     if(mIsUpdatingAfterChange || !mIsEnabled)
         return;
+    if(mIsStatic) {
+        Logger::get().error("Cannot move static node " + getName() + ": unbake it first.");
+        return;
+    }
 
+    Ogre::Vector3 local;
     if(rel == PARENT || mParent == nullptr) {
-        mScale = scale;
+        local = scale;
     } else {
         Ogre::Vector3 p = mParent->getScale(SCENE);
-        mScale = Ogre::Vector3(scale.x / p.x, scale.y / p.y, scale.z / p.z);
+        local = Ogre::Vector3(scale.x / p.x, scale.y / p.y, scale.z / p.z);
     }
-    onUpdate(0);
+
+    if(mTransformPool != nullptr)
+        mTransformPool->setScale(mTransformHandle, local);
+    else
+        mScale = local;
+    _invalidateWorldTransform();
+    if(!_queueTransformCommit())
+        onUpdate(0);
 }
 
 void Node::setScale(float scale, Node::RelativeTo rel) {
@@ -168,23 +350,40 @@ void Node::setScale(float scale, Node::RelativeTo rel) {
 
 Ogre::Quaternion Node::getRotation(Node::RelativeTo rel) const {
     if(rel == PARENT || mParent == nullptr) {
+        if(mTransformPool != nullptr)
+            return mTransformPool->getRotation(mTransformHandle);
         return mRotation;
+    } else if(_isPoolWorldTransformCurrent()) {
+        return mTransformPool->getWorldRotation(mTransformHandle);
     } else {
-        return mParent->getRotation(SCENE) * mRotation;
+        _updateWorldTransform();
+        return mWorldRotation;
     }
 }
 
 void Node::setRotation(Ogre::Quaternion rotation, Node::RelativeTo rel) {
     if(mIsUpdatingAfterChange || !mIsEnabled)
         return;
+    if(mIsStatic) {
+        Logger::get().error("Cannot move static node " + getName() + ": unbake it first.");
+        return;
+    }
 
+    Ogre::Quaternion local;
     if(rel == PARENT || mParent == nullptr) {
-        mRotation = rotation;
+        local = rotation;
     } else {
         // TODO: implement backward rotation
-        mRotation = mParent->getRotation(SCENE) * (-rotation);
+        local = mParent->getRotation(SCENE) * (-rotation);
     }
-    onUpdate(0);
+
+    if(mTransformPool != nullptr)
+        mTransformPool->setRotation(mTransformHandle, local);
+    else
+        mRotation = local;
+    _invalidateWorldTransform();
+    if(!_queueTransformCommit())
+        onUpdate(0);
 }
 
 void Node::setDirection(Ogre::Vector3 direction, Ogre::Vector3 front_vector) {
@@ -196,13 +395,19 @@ void Node::lookAt(Ogre::Vector3 target, Ogre::Vector3 front_vector, RelativeTo r
 }
 
 void Node::setParent(Node* parent) {
+    Scene* old_scene = getScene();
+
     if(parent != nullptr) {
-        if(!parent->findChildNode(mName, false)) { // we are not already a child of the new parent
+        Name key = _getNameKey();
+        if(!parent->findChildNode(key, false)) { // we are not already a child of the new parent
             if(mParent != nullptr) {                         // Remove it from its original parent.
-                auto iter = mParent->mChildren.find(mName);
-                parent->mChildren.insert(std::make_pair(mName, iter->second));
+                auto iter = mParent->mChildren.find(key);
+                parent->mChildren.insert(std::make_pair(key, iter->second));
                 mParent->mChildren.erase(iter);
                 mParent = parent;
+                _setTransformPool(mParent->mTransformPool);
+                _changeScene(old_scene);
+                _invalidateWorldTransform();
             }
             else {
                 parent->addChildNode(this);
@@ -213,13 +418,19 @@ void Node::setParent(Node* parent) {
     /*
     if(mParent != parent && mParent != nullptr) {
         // new parent
-        mParent->RemoveChildNode(mName);
+        mParent->RemoveChildNode(getName());
     } */
 
     mParent = parent;
 
+    if(!_isScene())
+        _setTransformPool(mParent != nullptr ? mParent->mTransformPool : nullptr);
+    _changeScene(old_scene);
+
     // the absolute position might have changed!
-    _updateAllComponents(0);
+    _invalidateWorldTransform();
+    if(!_queueTransformCommit())
+        _updateAllComponents(0);
 }
 
 Node* Node::getParent() {
@@ -235,6 +446,93 @@ Scene* Node::getScene() {
         return nullptr;
 }
 
+const QUuid& Node::getId() {
+    if(mId.isNull()) {
+        Scene* scene = getScene();
+        if(scene != nullptr)
+            scene->_unindexNode(this);
+
+        mId = QUuid::createUuid();
+
+        if(scene != nullptr)
+            scene->_indexNode(this);
+    }
+    return mId;
+}
+
+uint64_t Node::getRuntimeId() const {
+    return mRuntimeId;
+}
+
+Node::NodeHandle Node::getHandle() const {
+    return NodeHandle(mHandleIndex, mHandleGeneration);
+}
+
+uint32_t Node::getTransformHandle() const {
+    return mTransformHandle;
+}
+
+void Node::bake() {
+    if(mIsStatic)
+        return;
+
+    // the last transform the components see
+    _invalidateWorldTransform();
+    _commitTransform();
+    _setStatic(true, getScene());
+}
+
+void Node::unbake() {
+    if(!mIsStatic)
+        return;
+    if(mParent != nullptr && mParent->mIsStatic) {
+        Logger::get().error("Cannot unbake node " + getName() + ": its parent is static.");
+        return;
+    }
+
+    _setStatic(false, getScene());
+    _invalidateWorldTransform();
+    if(!_queueTransformCommit())
+        _commitTransform();
+}
+
+bool Node::hasTransformChanged() const {
+    return mJournalIndex != TransformJournal::NOT_RECORDED || mPublishedJournalIndex != TransformJournal::NOT_RECORDED;
+}
+
+void Node::addTags(uint64_t tags) {
+    _setTags(mTags | tags);
+}
+
+void Node::removeTags(uint64_t tags) {
+    _setTags(mTags & ~tags);
+}
+
+uint64_t Node::getTags() const {
+    return mTags;
+}
+
+bool Node::hasTags(uint64_t tags) const {
+    return (mTags & tags) == tags;
+}
+
+void Node::addTag(const QString& tag) {
+    addTags(TagIndex::getTag(tag));
+}
+
+void Node::removeTag(const QString& tag) {
+    removeTags(TagIndex::findTag(tag));
+}
+
+bool Node::hasTag(const QString& tag) const {
+    uint64_t mask = TagIndex::findTag(tag);
+    return mask != 0 && hasTags(mask);
+}
+
+bool Node::isStatic() const {
+    return mIsStatic;
+}
+
 void Node::setIsUpdatingAfterChange(bool flag) {
     mIsUpdatingAfterChange = flag;
 }
@@ -247,12 +545,33 @@ void Node::onUpdate(double time_diff) {
 }
 
 void Node::serialize(IOPacket& packet) {
+    if(mTransformPool != nullptr)
+        _readTransformFromPool();
+
+    // the name and id may change
+    Scene* scene = getScene();
+    if(scene != nullptr)
+        scene->_unindexNode(this);
+
+    if(packet.getDirection() == IOPacket::SERIALIZE && mId.isNull())
+        mId = QUuid::createUuid();
+
+    if(packet.getDirection() == IOPacket::SERIALIZE && mName.isEmpty())
+        mName = getName();
+
     packet.stream(mId, "uuid");
     packet.stream(mName, "name", mName);
     packet.stream(mPosition, "position");
     packet.stream(mScale, "scale", Ogre::Vector3::UNIT_SCALE);
     packet.stream(mRotation, "rotation");
     packet.stream(mIsEnabled, "enabled");
+
+    if(scene != nullptr)
+        scene->_indexNode(this);
+
+    if(mTransformPool != nullptr)
+        _writeTransformToPool();
+    _invalidateWorldTransform();
     onSerialize(packet);
 
     // Components
@@ -313,37 +632,284 @@ bool Node::_isScene() {
 void Node::_updateAllComponents(double time_diff) {
     mIsUpdatingAfterChange = (time_diff == 0);
 
-    for(auto iter = mComponents.begin(); iter != mComponents.end(); ++iter) {
-        if(iter->second->isEnabled()) {
-            iter->second->onUpdate(time_diff);
+    Scene* scene = (time_diff != 0 && mComponents.size() > 0) ? getScene() : nullptr;
+    bool parallel = (scene != nullptr && scene->isParallelUpdate());
+
+    // Components may be added while updating, which invalidates the iterators.
+    for(uint32_t i = 0; i < mComponents.size(); ++i) {
+        Component* component = (mComponents.begin() + i)->second.get();
+        // the Scene does the per-frame update of stored, scheduled and parallel-safe components
+        bool by_scene = time_diff != 0 && (component->_isInComponentStorage() || component->_isTickScheduled()
+                                           || (parallel && component->isParallelUpdateSafe()));
+        if(component->isEnabled() && !component->isSleeping() && !by_scene) {
+            DUCTTAPE_PROFILE_ZONE(component->metaObject()->className());
+            component->onUpdate(time_diff);
+        }
+    }
+
+    for(uint32_t i = 0; i < mPlainComponents.size(); ++i) {
+        PlainComponent* component = mPlainComponents[i].get();
+        if(component->isEnabled()) {
+            // plain components have no meta object, they name their type themselves
+            DUCTTAPE_PROFILE_ZONE(component->getTypeName());
+            component->onUpdate(time_diff);
         }
     }
 
     mIsUpdatingAfterChange = false;
 }
 
+void Node::_updateParallelComponents(double time_diff, bool recursive) {
+    if(!mIsEnabled || mIsStatic)
+        return;
+
+    for(auto iter = mComponents.begin(); iter != mComponents.end(); ++iter) {
+        Component* component = iter->second.get();
+        if(component->isEnabled() && component->isParallelUpdateSafe() && !component->_isTickScheduled()) {
+            DUCTTAPE_PROFILE_ZONE(component->metaObject()->className());
+            component->onUpdate(time_diff);
+        }
+    }
+
+    if(recursive) {
+        for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+            iter->second->_updateParallelComponents(time_diff, true);
+        }
+    }
+}
+
 void Node::_updateAllChildren(double time_diff) {
     mIsUpdatingAfterChange = (time_diff == 0);
 
-    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
-        if(iter->second->mDeathMark) {
-            //Kill it if the death mark is set.
-            Node* node = iter->second.get();
-            iter--;
-            QString name = node->getName();
+    // Children may be added while updating, which invalidates the iterators.
+    for(uint32_t i = 0; i < mChildren.size();) {
+        auto iter = mChildren.begin() + i;
+        if(iter->second->mDeathMark && getScene() == nullptr) {
+            // Kill it if the death mark is set. The last child takes its place.
+            Name name = iter->first;
             removeChildNode(name);
-        }
-        else {
-            iter->second->onUpdate(time_diff);
+        } else {
+            // killed children of a Scene are removed by its CommandBuffer, static ones are not updated
+            if(!iter->second->mDeathMark && !iter->second->mIsStatic)
+                iter->second->onUpdate(time_diff);
+            ++i;
         }
     }
 
     mIsUpdatingAfterChange = false;
 }
 
+void Node::_invalidateWorldTransform() {
+    Scene* scene = getScene();
+    _invalidateWorldTransform(scene != nullptr ? &scene->getTransformJournal() : nullptr);
+}
+
+void Node::_invalidateWorldTransform(TransformJournal* journal) {
+    bool is_dirty;
+    // With a pool, the subtree is only known to be dirty if both the pool entry and the cache are.
+    is_dirty = mIsWorldTransformDirty;
+    if(mTransformPool != nullptr) {
+        is_dirty = is_dirty && mTransformPool->isDirty(mTransformHandle);
+        mTransformPool->invalidate(mTransformHandle);
+    }
+    mIsWorldTransformDirty = true;
+
+    // Entries of new Nodes start out dirty, but are not recorded yet.
+    bool is_recorded = (journal == nullptr || journal->isRecorded(this));
+    if(is_dirty && is_recorded)
+        return; // the whole subtree is already dirty
+    if(!is_recorded)
+        journal->record(this);
+
+    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+        iter->second->_invalidateWorldTransform(journal);
+    }
+}
+
+bool Node::_isPoolWorldTransformCurrent() const {
+    return mTransformPool != nullptr && !mTransformPool->isDirty(mTransformHandle)
+        && !mTransformPool->hasUnpropagatedChanges();
+}
+
+void Node::_updateWorldTransform() const {
+    uint32_t bulk_count = (mTransformPool != nullptr) ? mTransformPool->getBulkChangeCount() : 0;
+    if(!mIsWorldTransformDirty && mWorldTransformBulkCount == bulk_count)
+        return;
+
+    if(mParent == nullptr) {
+        mWorldPosition = getPosition(PARENT);
+        mWorldScale = getScale(PARENT);
+        mWorldRotation = getRotation(PARENT);
+    } else {
+        // Same composition as the former recursive getters: the parent's local
+        // rotation is applied to the position. The parent's getters use its cache or the pool.
+        mWorldPosition = mParent->getPosition(SCENE) + mParent->getRotation(PARENT) * getPosition(PARENT);
+        mWorldScale = mParent->getScale(SCENE) * getScale(PARENT);
+        mWorldRotation = mParent->getRotation(SCENE) * getRotation(PARENT);
+    }
+    mIsWorldTransformDirty = false;
+    mWorldTransformBulkCount = bulk_count;
+}
+
+void Node::_setTransformPool(TransformPool* pool) {
+    if(pool == mTransformPool) {
+        if(pool != nullptr) {
+            uint32_t parent = (mParent != nullptr) ? mParent->mTransformHandle : TransformPool::INVALID_HANDLE;
+            pool->setParent(mTransformHandle, parent);
+        }
+        return;
+    }
+
+    _leaveTransformPool();
+    if(pool != nullptr)
+        _joinTransformPool(pool);
+}
+
+void Node::_leaveTransformPool() {
+    if(mTransformPool == nullptr)
+        return;
+
+    // children first, their entries reference ours
+    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+        iter->second->_leaveTransformPool();
+    }
+
+    _readTransformFromPool();
+    mTransformPool->destroy(mTransformHandle);
+    mTransformPool = nullptr;
+    mTransformHandle = TransformPool::INVALID_HANDLE;
+    mIsWorldTransformDirty = true;
+}
+
+void Node::_joinTransformPool(TransformPool* pool) {
+    uint32_t parent = (mParent != nullptr) ? mParent->mTransformHandle : TransformPool::INVALID_HANDLE;
+    mTransformPool = pool;
+    mTransformHandle = pool->create(parent, this);
+    _writeTransformToPool();
+    mIsWorldTransformDirty = true;
+
+    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+        iter->second->_joinTransformPool(pool);
+    }
+}
+
+void Node::_readTransformFromPool() {
+    mPosition = mTransformPool->getPosition(mTransformHandle);
+    mScale = mTransformPool->getScale(mTransformHandle);
+    mRotation = mTransformPool->getRotation(mTransformHandle);
+}
+
+void Node::_writeTransformToPool() {
+    mTransformPool->setPosition(mTransformHandle, mPosition);
+    mTransformPool->setScale(mTransformHandle, mScale);
+    mTransformPool->setRotation(mTransformHandle, mRotation);
+}
+
+bool Node::_queueTransformCommit() {
+    Scene* scene = getScene();
+    // changes made on the worker threads are always deferred until the workers are done
+    if(scene == nullptr || !(scene->isDeferredTransformCommit() || scene->_isUpdatingInParallel()))
+        return false;
+
+    if(mTransformCommitIndex == Scene::NOT_STORED)
+        scene->_queueTransformCommit(this);
+    return true;
+}
+
+void Node::_commitTransform() {
+    if(!mIsEnabled)
+        return;
+
+    for(auto iter = mComponents.begin(); iter != mComponents.end(); ++iter) {
+        if(iter->second->isEnabled() && !iter->second->isSleeping()) {
+            iter->second->onTransformChanged();
+        }
+    }
+
+    for(auto iter = mPlainComponents.begin(); iter != mPlainComponents.end(); ++iter) {
+        if((*iter)->isEnabled())
+            (*iter)->onTransformChanged();
+    }
+
+    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+        if(!iter->second->mIsStatic)
+            iter->second->_commitTransform();
+    }
+}
+
+void Node::_addComponentToScene(Component* component) {
+    Scene* scene = getScene();
+    if(scene != nullptr) {
+        scene->_storeComponent(component);
+        scene->_scheduleComponent(component);
+        scene->_trackSignificance(component);
+    }
+
+    if(mIsStatic)
+        component->onBake();
+}
+
+void Node::_setTags(uint64_t tags) {
+    if(tags == mTags)
+        return;
+
+    Scene* scene = getScene();
+    bool is_indexed = (scene != nullptr && scene != this);
+    if(is_indexed)
+        scene->getTagIndex().remove(this);
+    mTags = tags;
+    if(is_indexed)
+        scene->getTagIndex().add(this);
+}
+
+void Node::_setStatic(bool is_static, Scene* scene) {
+    mIsStatic = is_static;
+
+    // static components are neither stored nor scheduled by the Scene
+    for(auto iter = mComponents.begin(); iter != mComponents.end(); ++iter) {
+        Component* component = iter->second.get();
+        if(is_static) {
+            if(scene != nullptr) {
+                scene->_untrackSignificance(component);
+                scene->_unstoreComponent(component);
+                scene->_unscheduleComponent(component);
+            }
+            component->onBake();
+        } else {
+            component->onUnbake();
+            if(scene != nullptr) {
+                scene->_storeComponent(component);
+                scene->_scheduleComponent(component);
+                scene->_trackSignificance(component);
+            }
+        }
+    }
+
+    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+        iter->second->_setStatic(is_static, scene);
+    }
+}
+
+void Node::_changeScene(Scene* old_scene) {
+    Scene* scene = getScene();
+    if(scene == old_scene)
+        return;
+
+    if(old_scene != nullptr)
+        old_scene->_removeNode(this);
+    if(scene != nullptr)
+        scene->_addNode(this);
+}
+
 void Node::kill() {
-    if(mIsEnabled)
+    if(mIsEnabled && !mDeathMark) {
         mDeathMark = true;
+
+        // the Scene removes the Node at the end of the frame, otherwise the parent does on its next update
+        Scene* scene = getScene();
+        if(scene != nullptr && scene != this)
+            scene->getCommandBuffer().kill(this);
+    }
 }
 
 bool Node::isEnabled() {
@@ -362,6 +928,10 @@ void Node::enable() {
             iter->second->enable();
         }
 
+        for(auto iter = mPlainComponents.begin(); iter != mPlainComponents.end(); ++iter) {
+            (*iter)->enable();
+        }
+
         onEnable();
     }
 }
@@ -378,6 +948,10 @@ void Node::disable() {
             iter->second->disable();
         }
 
+        for(auto iter = mPlainComponents.begin(); iter != mPlainComponents.end(); ++iter) {
+            (*iter)->disable();
+        }
+
         onDisable();
     }
 }
@@ -12,7 +12,15 @@
 #include <Config.hpp>
 
 #include <Scene/Component.hpp>
+#include <Scene/PlainComponent.hpp>
+#include <Scene/TagIndex.hpp>
+#include <Scene/TransformJournal.hpp>
+#include <Scene/TransformPool.hpp>
+#include <Utils/Handle.hpp>
 #include <Utils/Logger.hpp>
+#include <Utils/Name.hpp>
+#include <Utils/NameMap.hpp>
+#include <Utils/SlabAllocator.hpp>
 #include <Utils/Utils.hpp>
 #include <Logic/IScriptable.hpp>
 #include <Network/IOPacket.hpp>
@@ -24,6 +32,7 @@
 #include <QString>
 
 #include <memory>
+#include <vector>
 
 namespace dt {
 
@@ -40,6 +49,12 @@ class State;
   */
 class DUCTTAPE_API Node : public QObject, public IScriptable {
     Q_OBJECT
+    friend class Prefab;
+    friend class Scene;
+    friend class StreamingComponent;
+    friend class TagIndex;
+    friend class TransformJournal;
+
     Q_ENUMS(RelativeTo)
 
     Q_PROPERTY(QString name READ getName CONSTANT FINAL)
@@ -50,6 +65,7 @@ class DUCTTAPE_API Node : public QObject, public IScriptable {
 public:
     
     typedef std::shared_ptr<Node> NodeSP;
+    typedef Handle<Node> NodeHandle;
     
     /**
       * The coordinates space for getting/setting rotation, position and scale.
@@ -65,6 +81,25 @@ public:
       */
     Node(const QString name = "");
 
+    /**
+      * Destructor.
+      */
+    ~Node();
+
+    /**
+      * Allocates the memory for a Node from the SlabPool.
+      * @param size The size of the Node.
+      * @returns The memory.
+      */
+    static void* operator new(size_t size);
+
+    /**
+      * Returns the memory of a Node to the SlabPool.
+      * @param pointer The memory.
+      * @param size The size of the Node.
+      */
+    static void operator delete(void* pointer, size_t size);
+
     /**
       * Initializer.
       */
@@ -92,6 +127,14 @@ public:
       */
     Node::NodeSP addChildNode(Node* child);
 
+    /**
+      * Adds many Nodes as children. The memory for all of them is allocated in advance, which is
+      * faster than adding them one by one.
+      * @param children The Nodes to be added as children.
+      * @see CommandBuffer::spawn(Node* parent, const std::vector<Node*>& children, SpawnCallback on_spawned)
+      */
+    void addChildNodes(const std::vector<Node*>& children);
+
     /**
       * Assigns a component to this node.
       * @param component The Component to be assigned.
@@ -99,42 +142,177 @@ public:
       */
     template <typename ComponentType>
     std::shared_ptr<ComponentType> addComponent(ComponentType* component) {
-        const QString cname = component->getName();
-        if(!hasComponent(cname)) {
-            std::shared_ptr<Component> ptr(component);
+        const Name key = component->_getNameKey();
+        if(!hasComponent(key)) {
+            std::shared_ptr<Component> ptr(component, std::default_delete<Component>(), SlabAllocator<Component>());
             ptr->setNode(this);
             ptr->initialize();
-            std::pair<QString, std::shared_ptr<Component> > pair(cname, ptr);
-            mComponents.insert(pair);
+            mComponents.insert(std::make_pair(key, ptr));
+            _addComponentToScene(component);
             
             if(!mIsEnabled)
                 component->disable();
 
-            _updateAllComponents(0);
+            if(!_queueTransformCommit())
+                _updateAllComponents(0);
         } else {
-            Logger::get().error("Cannot add component " + cname + ": a component with this name already exists.");
+            Logger::get().error("Cannot add component " + component->getName() + ": a component with this name already exists.");
         }
-        return findComponent<ComponentType>(cname);
+        return findComponent<ComponentType>(key);
     }
 
+    /**
+      * Assigns a plain component to this node. The Node owns the component, it is destroyed when it is removed.
+      * Its onUpdate() is first called in the next frame.
+      * @param component The PlainComponent to be assigned.
+      * @returns The component, or the existing one if the Node already has a plain component with the same name.
+      * @see PlainComponent
+      */
+    template <typename ComponentType>
+    ComponentType* addPlainComponent(ComponentType* component) {
+        const Name& name = component->getName();
+        if(name != Name() && findPlainComponent<PlainComponent>(name) != nullptr) {
+            Logger::get().error("Cannot add plain component " + name.toString() + ": a component with this name already exists.");
+            delete component;
+            return findPlainComponent<ComponentType>(name);
+        }
+
+        component->_setNode(this);
+        mPlainComponents.push_back(std::unique_ptr<PlainComponent>(component));
+        component->initialize();
+        return component;
+    }
+
+    /**
+      * Returns a plain component.
+      * @param name The name of the component to find.
+      * @returns The component, or nullptr if no plain component with the specified name and type exists.
+      */
+    template <typename ComponentType>
+    ComponentType* findPlainComponent(const Name& name) {
+        for(auto iter = mPlainComponents.begin(); iter != mPlainComponents.end(); ++iter) {
+            if((*iter)->getName() == name)
+                return dynamic_cast<ComponentType*>(iter->get());
+        }
+        return nullptr;
+    }
+
+    /**
+      * Returns the first plain component of a type, e.g. for unnamed components.
+      * @returns The component, or nullptr if there is no plain component of the type.
+      */
+    template <typename ComponentType>
+    ComponentType* findPlainComponent() {
+        for(auto iter = mPlainComponents.begin(); iter != mPlainComponents.end(); ++iter) {
+            ComponentType* component = dynamic_cast<ComponentType*>(iter->get());
+            if(component != nullptr)
+                return component;
+        }
+        return nullptr;
+    }
+
+    /**
+      * Returns the number of plain components of this Node.
+      * @returns The number of plain components.
+      */
+    uint32_t getPlainComponentCount() const;
+
+    /**
+      * Removes and destroys a plain component. The order of the other plain components may change.
+      * @param component The component.
+      */
+    void removePlainComponent(PlainComponent* component);
+
+    /**
+      * Removes and destroys a plain component with a specific name.
+      * @param name The name of the component.
+      */
+    void removePlainComponent(const Name& name);
+
     /**
       * Searches for a Node with the given name and returns a pointer to the first match.
+      * If the Node is part of a Scene, the recursive search uses the index of the Scene instead of
+      * walking the children. If several Nodes below this one have the name, any of them may be returned.
       * @param name The name of the Node searched.
       * @param recursive Whether to search within child nodes or not.
       * @returns A pointer to the Node with the name or nullptr if none is found.
       */
     Node::NodeSP findChildNode(const QString name, bool recursive = true);
 
+    /**
+      * Searches for a Node with the given name and returns a pointer to the first match.
+      * @see findChildNode(const QString name, bool recursive)
+      * @param name The interned name of the Node searched.
+      * @param recursive Whether to search within child nodes or not.
+      * @returns A pointer to the Node with the name or nullptr if none is found.
+      */
+    Node::NodeSP findChildNode(const Name& name, bool recursive = true);
+
+    /**
+      * Searches for a Node with the given name and returns a handle to the first match. Unlike findChildNode(),
+      * it does not copy a shared pointer.
+      * @see findChildNode(const QString name, bool recursive)
+      * @param name The name of the Node searched.
+      * @param recursive Whether to search within child nodes or not.
+      * @returns A handle to the Node with the name, or an invalid handle if none is found.
+      */
+    NodeHandle findChildNodeHandle(const QString name, bool recursive = true);
+
+    /**
+      * Searches for a Node with the given name and returns a handle to the first match.
+      * @see findChildNodeHandle(const QString name, bool recursive)
+      * @param name The interned name of the Node searched.
+      * @param recursive Whether to search within child nodes or not.
+      * @returns A handle to the Node with the name, or an invalid handle if none is found.
+      */
+    NodeHandle findChildNodeHandle(const Name& name, bool recursive = true);
+
     /**
       * Returns a component.
       * @param name The name of the component to find.
-      * @returns A pointer to the component, or nullptr if no component with the specified name exists.
+      * @returns A pointer to the component, or nullptr if no component with the specified name and type exists.
       */
     template <typename ComponentType>
     std::shared_ptr<ComponentType> findComponent(const QString name) {
-        if(!hasComponent(name))
+        return findComponent<ComponentType>(Name::find(name));
+    }
+
+    /**
+      * Returns a component.
+      * @param name The interned name of the component to find.
+      * @returns A pointer to the component, or nullptr if no component with the specified name and type exists.
+      */
+    template <typename ComponentType>
+    std::shared_ptr<ComponentType> findComponent(const Name& name) {
+        auto iter = mComponents.find(name);
+        if(iter == mComponents.end())
             return std::shared_ptr<ComponentType>();
-        return std::dynamic_pointer_cast<ComponentType>(mComponents[name]);
+        return std::dynamic_pointer_cast<ComponentType>(iter->second);
+    }
+
+    /**
+      * Returns a handle to a component.
+      * @param name The name of the component to find.
+      * @returns A handle to the component, or an invalid handle if no component with the specified name and type exists.
+      */
+    template <typename ComponentType>
+    Handle<ComponentType, Component> findComponentHandle(const QString name) {
+        return findComponentHandle<ComponentType>(Name::find(name));
+    }
+
+    /**
+      * Returns a handle to a component. Unlike findComponent(), it does not copy a shared pointer.
+      * @param name The interned name of the component to find.
+      * @returns A handle to the component, or an invalid handle if no component with the specified name and type exists.
+      * @see findComponent(const Name& name)
+      */
+    template <typename ComponentType>
+    Handle<ComponentType, Component> findComponentHandle(const Name& name) {
+        auto iter = mComponents.find(name);
+        if(iter == mComponents.end() || dynamic_cast<ComponentType*>(iter->second.get()) == nullptr)
+            return Handle<ComponentType, Component>();
+        const Handle<Component> handle = iter->second->getHandle();
+        return Handle<ComponentType, Component>(handle.getIndex(), handle.getGeneration());
     }
 
     /**
@@ -144,18 +322,37 @@ public:
       */
     bool hasComponent(const QString name);
 
+    /**
+      * Returns whether this node has the component assigned.
+      * @param name The interned name of the Component.
+      * @returns true if the component is assigned, otherwise false
+      */
+    bool hasComponent(const Name& name);
+
     /**
       * Removes a child Node with a specific name.
       * @param name The name of the Node to be removed.
       */
     void removeChildNode(const QString name);
 
+    /**
+      * Removes a child Node with a specific name.
+      * @param name The interned name of the Node to be removed.
+      */
+    void removeChildNode(const Name& name);
+
     /**
       * Removes a Component with a specific name.
       * @param name The name of the Component to be removed.
       */
     void removeComponent(const QString name);
 
+    /**
+      * Removes a Component with a specific name.
+      * @param name The interned name of the Component to be removed.
+      */
+    void removeComponent(const Name& name);
+
     /**
       * Returns the position of the Node.
       * @param rel Reference point.
@@ -264,6 +461,123 @@ public:
       */
     Scene* getScene();
 
+    /**
+      * Returns the unique id of this Node. It is only created on the first call (or when the Node
+      * is serialized), as creating a QUuid is expensive.
+      * @returns The unique id of this Node.
+      * @see Scene::findNode(const QUuid& id)
+      */
+    const QUuid& getId();
+
+    /**
+      * Returns an id of this Node that is unique for the lifetime of the process. Unlike
+      * getId(), it is not persistent, but it is cheap to create.
+      * @returns The runtime id of this Node.
+      * @see Scene::findNode(uint64_t runtime_id)
+      */
+    uint64_t getRuntimeId() const;
+
+    /**
+      * Returns a handle to this Node. It does not keep the Node alive, but detects when it has been destroyed.
+      * @returns The handle.
+      * @see Handle
+      */
+    NodeHandle getHandle() const;
+
+    /**
+      * Returns the handle of this Node in the TransformPool of its Scene. Use it for the bulk setters of the pool.
+      * @returns The handle, or TransformPool::INVALID_HANDLE if the Node is not attached to a Scene.
+      */
+    uint32_t getTransformHandle() const;
+
+    /**
+      * Returns whether the world transform of this Node changed in the last frame or since then, according to
+      * the TransformJournal of its Scene. Use it to skip mirroring an unchanged transform every frame.
+      * @returns Whether the world transform changed recently, false if the Node is not part of a Scene.
+      */
+    bool hasTransformChanged() const;
+
+    /**
+      * Adds tags to this Node, e.g. to find all enemies with Scene::findNodes().
+      * @param tags The tags, a bitmask of TagIndex::getTag() values.
+      */
+    void addTags(uint64_t tags);
+
+    /**
+      * Removes tags from this Node.
+      * @param tags The tags, a bitmask of TagIndex::getTag() values.
+      */
+    void removeTags(uint64_t tags);
+
+    /**
+      * Returns the tags of this Node.
+      * @returns The tags, a bitmask of TagIndex::getTag() values.
+      */
+    uint64_t getTags() const;
+
+    /**
+      * Returns whether this Node has all of the given tags.
+      * @param tags The tags, a bitmask of TagIndex::getTag() values.
+      * @returns Whether this Node has all of the tags.
+      */
+    bool hasTags(uint64_t tags) const;
+
+    /**
+      * Adds a tag to this Node, registering it if required.
+      * @param tag The name of the tag.
+      */
+    void addTag(const QString& tag);
+
+    /**
+      * Removes a tag from this Node.
+      * @param tag The name of the tag.
+      */
+    void removeTag(const QString& tag);
+
+    /**
+      * Returns whether this Node has a tag.
+      * @param tag The name of the tag.
+      * @returns Whether this Node has the tag.
+      */
+    bool hasTag(const QString& tag) const;
+
+    /**
+      * Bakes this Node and all of its children, for level geometry that never moves. The components get their
+      * final transform once and onBake() is called, e.g. to merge meshes into static geometry. Afterwards the
+      * subtree is skipped by the per-frame update of the Scene and its transforms cannot be changed, until
+      * unbake() is called. Nodes added to a static Node are baked as well.
+      * Moving the parent of a static Node does not update the components of the static Node.
+      */
+    void bake();
+
+    /**
+      * Makes this Node and all of its children dynamic again after bake(). Only the Node bake() was called on
+      * can be unbaked.
+      */
+    void unbake();
+
+    /**
+      * Returns whether this Node has been baked.
+      * @returns Whether this Node is static.
+      */
+    bool isStatic() const;
+
+    /**
+      * Updates the enabled components of this Node that are safe to update in parallel.
+      * @internal
+      * @param time_diff The frame time.
+      * @param recursive Whether to update the ones of all children as well.
+      * @see Scene::setParallelUpdate(bool enabled)
+      */
+    void _updateParallelComponents(double time_diff, bool recursive);
+
+    /**
+      * Returns the Name this Node is stored under. A generated name is not interned.
+      * @internal
+      * @returns The Name of this Node.
+      */
+    Name _getNameKey() const;
+
 protected:
 	/**
 	  * Set mIsUpdatingAfterChange.
@@ -273,7 +587,8 @@ protected:
 
 public slots:
     /**
-      * Returns the name of the Node.
+      * Returns the name of the Node. A Node created without a name is called "Node-<number>", the name is
+      * only generated when it is asked for.
       * @returns The name of the Node.
       */
     const QString getName() const;
@@ -312,7 +627,9 @@ public slots:
     void setPosition(float x, float y, float z, RelativeTo rel = PARENT);
 
     /**
-      * Sets the death mark to true. Then the node will be kill when it updates.
+      * Sets the death mark to true. If the node is part of a Scene, it is removed when the Scene applies
+      * its CommandBuffer at the end of the frame. Otherwise it is killed when its parent updates.
+      * @see Scene::getCommandBuffer()
       */
     void kill();
 
@@ -361,19 +678,144 @@ protected:
       */
     void _updateAllChildren(double time_diff);
 
-    std::map<QString, std::shared_ptr<Component> > mComponents;   //!< The list of Components.
-    QString mName;              //!< The Node name.
+    /**
+      * Marks the cached world transform of this Node and all of its children as outdated and records
+      * them in the TransformJournal of the Scene. Subtrees that are already dirty and recorded are skipped.
+      */
+    void _invalidateWorldTransform();
+
+    /**
+      * Marks the cached world transform of this Node and all of its children as outdated.
+      * @param journal The journal to record the Nodes in, or nullptr if the Node is not part of a Scene.
+      */
+    void _invalidateWorldTransform(TransformJournal* journal);
+
+    /**
+      * Private method. Returns whether the world transform in the TransformPool is up to date, so it can be read
+      * without calculating anything.
+      * @returns Whether the Node is part of a pool and its entry has been updated by the last batch pass.
+      */
+    bool _isPoolWorldTransformCurrent() const;
+
+    /**
+      * Recalculates the cached world transform if it is outdated. The parent's transform is
+      * brought up to date first, so this is O(1) for a clean parent chain. Used while the entry in the
+      * TransformPool is outdated as well, until the next batch pass.
+      */
+    void _updateWorldTransform() const;
+
+    /**
+      * Moves the transform of this Node and all of its children into another TransformPool.
+      * @param pool The new pool, or nullptr to store the transforms in the Node itself.
+      */
+    void _setTransformPool(TransformPool* pool);
+
+    /**
+      * Removes this Node and all of its children from their TransformPool, keeping the local transforms.
+      */
+    void _leaveTransformPool();
+
+    /**
+      * Adds this Node and all of its children to a TransformPool. The parent has to be added before.
+      * @param pool The pool to join.
+      */
+    void _joinTransformPool(TransformPool* pool);
+
+    /**
+      * Copies the local transform from the TransformPool into the Node's members.
+      */
+    void _readTransformFromPool();
+
+    /**
+      * Copies the local transform from the Node's members into the TransformPool.
+      */
+    void _writeTransformToPool();
+
+    /**
+      * Queues this Node for the transform commit pass of its Scene, if the Scene defers transform updates.
+      * @returns Whether the Node has been queued. If false, the caller has to update the components right away.
+      */
+    bool _queueTransformCommit();
+
+    /**
+      * Calls Component::onTransformChanged() on all enabled components of this Node and its children.
+      */
+    void _commitTransform();
+
+    /**
+      * Adds a component to the typed component storage and the tick scheduler of the Scene, if the
+      * Node is part of one, or bakes it if the Node is static.
+      * @param component The component that has been added.
+      */
+    void _addComponentToScene(Component* component);
+
+    /**
+      * Moves this Node and all of its children from the node index and component storage of their old
+      * Scene to the ones of the Scene the Node is now part of.
+      * @param old_scene The Scene the Node was part of before, or nullptr.
+      */
+    void _changeScene(Scene* old_scene);
+
+    /**
+      * Marks this Node and all of its children as static or dynamic and notifies the components.
+      * @param is_static Whether the Nodes are static.
+      * @param scene The Scene of the Nodes, or nullptr.
+      */
+    void _setStatic(bool is_static, Scene* scene);
+
+    /**
+      * Sets the tags of this Node and updates the tag index of its Scene.
+      * @param tags The new tags.
+      */
+    void _setTags(uint64_t tags);
+
+    NameMap<std::shared_ptr<Component> > mComponents;   //!< The list of Components.
+    std::vector<std::unique_ptr<PlainComponent> > mPlainComponents; //!< The plain components.
+    QString mName;              //!< The Node name, or empty for a generated one. Use getName() to read it.
 
 private:
-    std::map<QString, NodeSP> mChildren;  //!< List of child nodes.
-    Ogre::Vector3 mPosition;                    //!< The Node position.
-    Ogre::Vector3 mScale;                       //!< The Node scale.
-    Ogre::Quaternion mRotation;                 //!< The Node rotation.
+    /**
+      * Searches for a Node with the given name.
+      * @param name The interned name of the Node searched.
+      * @param recursive Whether to search within child nodes or not.
+      * @returns The entry of the Node in the children of its parent, or nullptr if none is found.
+      */
+    const NodeSP* _findChildNode(const Name& name, bool recursive);
+
+    /**
+      * Private method. Frees the slot of this Node in the HandleTable, so its handles stop resolving before it is
+      * destroyed. Called when the Node is removed from its parent, and by the destructor if it has not been removed.
+      */
+    void _releaseHandle();
+
+
+    NameMap<NodeSP> mChildren;  //!< List of child nodes.
+    Ogre::Vector3 mPosition;                    //!< The Node position. Only used while the Node is not part of a TransformPool.
+    Ogre::Vector3 mScale;                       //!< The Node scale. Only used while the Node is not part of a TransformPool.
+    Ogre::Quaternion mRotation;                 //!< The Node rotation. Only used while the Node is not part of a TransformPool.
+    mutable Ogre::Vector3 mWorldPosition;       //!< The cached position relative to the scene.
+    mutable Ogre::Vector3 mWorldScale;          //!< The cached scale relative to the scene.
+    mutable Ogre::Quaternion mWorldRotation;    //!< The cached rotation relative to the scene.
+    mutable bool mIsWorldTransformDirty;        //!< Whether the cached world transform has to be recalculated.
+    mutable uint32_t mWorldTransformBulkCount;  //!< The bulk change count of mTransformPool when the cached world transform was calculated.
+    TransformPool* mTransformPool;              //!< The pool holding the transform of this Node, if it is attached to a Scene.
+    uint32_t mTransformHandle;                  //!< The handle of this Node in mTransformPool.
     Node* mParent;                        //!< A pointer to the parent Node.
     bool mIsUpdatingAfterChange;          //!< Whether the node is just in the process of updating all components after a change occurred. This is to prevent infinite stack loops.
-    QUuid mId;                            //!< The node's uuid.
+    uint32_t mTransformCommitIndex;       //!< The index of the node in the transform commit queue of its Scene, or Scene::NOT_STORED.
+    QUuid mId;                            //!< The node's uuid. Null until it is needed.
+    uint64_t mRuntimeId;                  //!< The node's id for the lifetime of the process.
+    uint32_t mSpatialProxy;               //!< The proxy of the node in the spatial index of its scene.
     bool mDeathMark;                      //!< Whether the node is marked to be killed. If it's true, the node will be killed when it updates.
     bool mIsEnabled;                      //!< Whether the node is enabled or not.
+    bool mIsStatic;                       //!< Whether the node has been baked.
+    uint32_t mJournalIndex;               //!< The index of the node in the recording of the transform journal.
+    uint32_t mPublishedJournalIndex;      //!< The index of the node in the published changes of the transform journal.
+    uint64_t mTags;                       //!< The tags of the node.
+    std::vector<uint32_t> mTagIndices;    //!< The index of the node in the tag index of its scene, one per tag, by bit.
+    uint32_t mHandleIndex;                //!< The index of the node in the HandleTable.
+    uint32_t mHandleGeneration;           //!< The generation of the slot of the node in the HandleTable.
+    uint32_t mAutoId;                     //!< The number of the generated name, or 0 if the node has been given a name.
 };
 
 } // namespace dt
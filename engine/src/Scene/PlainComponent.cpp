@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/PlainComponent.hpp>
+
+#include <Scene/Node.hpp>
+#include <Utils/SlabAllocator.hpp>
+
+namespace dt {
+
+PlainComponent::PlainComponent(const Name& name)
+    : mName(name),
+      mNode(nullptr),
+      mIsEnabled(false),
+      mIsInitialized(false) {}
+
+PlainComponent::~PlainComponent() {}
+
+void* PlainComponent::operator new(size_t size) {
+    return SlabPool::allocate(size);
+}
+
+void PlainComponent::operator delete(void* pointer, size_t size) {
+    SlabPool::deallocate(pointer, size);
+}
+
+void PlainComponent::onInitialize() {}
+
+void PlainComponent::onDeinitialize() {}
+
+void PlainComponent::onEnable() {}
+
+void PlainComponent::onDisable() {}
+
+void PlainComponent::onUpdate(double time_diff) {}
+
+void PlainComponent::onTransformChanged() {}
+
+const char* PlainComponent::getTypeName() const {
+    return "PlainComponent";
+}
+
+const Name& PlainComponent::getName() const {
+    return mName;
+}
+
+Node* PlainComponent::getNode() const {
+    return mNode;
+}
+
+bool PlainComponent::isInitialized() const {
+    return mIsInitialized;
+}
+
+bool PlainComponent::isEnabled() const {
+    return mIsEnabled;
+}
+
+void PlainComponent::initialize() {
+    if(!mIsInitialized) {
+        mIsInitialized = true;
+        onInitialize();
+        enable();
+    }
+}
+
+void PlainComponent::deinitialize() {
+    if(mIsInitialized) {
+        mIsInitialized = false;
+        disable();
+        onDeinitialize();
+    }
+}
+
+void PlainComponent::enable() {
+    if(!mIsEnabled && mNode != nullptr && mNode->isEnabled()) {
+        mIsEnabled = true;
+        onEnable();
+    }
+}
+
+void PlainComponent::disable() {
+    if(mIsEnabled) {
+        mIsEnabled = false;
+        onDisable();
+    }
+}
+
+void PlainComponent::_setNode(Node* node) {
+    mNode = node;
+}
+
+} // namespace dt
@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_PLAINCOMPONENT
+#define DUCTTAPE_ENGINE_SCENE_PLAINCOMPONENT
+
+#include <Config.hpp>
+
+#include <Utils/Name.hpp>
+
+#include <QtGlobal>
+
+#include <cstddef>
+
+namespace dt {
+
+// forward declaration due to circular dependency
+class Node;
+
+/**
+  * A component without the QObject base of Component, for types with many instances, e.g. projectiles,
+  * particles or crowd agents. It has the same lifecycle hooks, but no signals, properties, script access,
+  * serialization or cloning, and it costs a fraction of the memory and creation time of a Component.
+  * Plain components are owned by their Node and updated by it every tick, after its other components.
+  * They do not take part in the typed component storage, the tick scheduler, the significance levels or
+  * the parallel update of the Scene. They can be mixed freely with Components on the same Node.
+  * @see Node::addPlainComponent(ComponentType* component)
+  */
+class DUCTTAPE_API PlainComponent {
+
+    Q_DISABLE_COPY(PlainComponent)
+
+public:
+    /**
+      * Constructor.
+      * @param name The name of the component. Only components with a name can be found by it.
+      */
+    PlainComponent(const Name& name = Name());
+
+    /**
+      * Pure virtual destructor makes this class abstract.
+      */
+    virtual ~PlainComponent() = 0;
+
+    /**
+      * Allocates the memory for a PlainComponent from the SlabPool.
+      * @param size The size of the PlainComponent.
+      * @returns The memory.
+      */
+    static void* operator new(size_t size);
+
+    /**
+      * Returns the memory of a PlainComponent to the SlabPool.
+      * @param pointer The memory.
+      * @param size The size of the PlainComponent.
+      */
+    static void operator delete(void* pointer, size_t size);
+
+    /**
+      * Called when the component is added to its Node.
+      */
+    virtual void onInitialize();
+
+    /**
+      * Called when the component is removed from its Node.
+      */
+    virtual void onDeinitialize();
+
+    /**
+      * Called when the component is enabled.
+      */
+    virtual void onEnable();
+
+    /**
+      * Called when the component is disabled.
+      */
+    virtual void onDisable();
+
+    /**
+      * Called every frame, and with a time of 0 when the transform of the Node changes.
+      * @param time_diff The frame delta time.
+      */
+    virtual void onUpdate(double time_diff);
+
+    /**
+      * Called when the Scene commits deferred transform changes of the Node (or one of its parents).
+      * @see Scene::setDeferredTransformCommit(bool deferred)
+      */
+    virtual void onTransformChanged();
+
+    /**
+      * Returns the name of the type of the component, which names the profile zones of its updates.
+      * @returns A string literal, e.g. "ProjectileComponent".
+      */
+    virtual const char* getTypeName() const;
+
+    /**
+      * Returns the name of the component.
+      * @returns The name, empty if the component has none.
+      */
+    const Name& getName() const;
+
+    /**
+      * Returns the Node of this component.
+      * @returns The Node, or nullptr if the component has not been added to one.
+      */
+    Node* getNode() const;
+
+    /**
+      * Returns whether the component is initialized.
+      * @returns Whether the component is initialized.
+      */
+    bool isInitialized() const;
+
+    /**
+      * Returns whether the component is enabled.
+      * @returns Whether the component is enabled.
+      */
+    bool isEnabled() const;
+
+    /**
+      * Initializes and enables the component.
+      */
+    void initialize();
+
+    /**
+      * Disables and deinitializes the component.
+      */
+    void deinitialize();
+
+    /**
+      * Enables the component, if its Node is enabled.
+      */
+    void enable();
+
+    /**
+      * Disables the component.
+      */
+    void disable();
+
+    /**
+      * Sets the Node of this component.
+      * @internal
+      * @param node The Node.
+      */
+    void _setNode(Node* node);
+
+protected:
+    Name mName;     //!< The name of the component.
+    Node* mNode;    //!< The parent Node.
+
+private:
+    bool mIsEnabled;        //!< Whether the component is enabled.
+    bool mIsInitialized;    //!< Whether the component is initialized.
+
+};
+
+} // namespace dt
+
+#endif
@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/Prefab.hpp>
+
+#include <Scene/Scene.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/Utils.hpp>
+
+namespace dt {
+
+Prefab::Transform::Transform(const Ogre::Vector3& position, const Ogre::Quaternion& rotation, const Ogre::Vector3& scale)
+    : mPosition(position),
+      mRotation(rotation),
+      mScale(scale) {}
+
+Prefab::Prefab(const QString name)
+    : mName(name) {}
+
+Prefab::Prefab(Node* node)
+    : mName(node->getName()),
+      mTransform(node->getPosition(), node->getRotation(), node->getScale()) {
+    for(auto iter = node->mComponents.begin(); iter != node->mComponents.end(); ++iter) {
+        Component* prototype = iter->second->clone();
+        if(prototype != nullptr)
+            mPrototypes.push_back(std::unique_ptr<Component>(prototype));
+    }
+    for(auto iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter) {
+        mChildren.push_back(std::unique_ptr<Prefab>(new Prefab(iter->second.get())));
+    }
+}
+
+Prefab::~Prefab() {}
+
+const QString& Prefab::getName() const {
+    return mName;
+}
+
+void Prefab::setTransform(const Transform& transform) {
+    mTransform = transform;
+}
+
+const Prefab::Transform& Prefab::getTransform() const {
+    return mTransform;
+}
+
+Prefab* Prefab::addChild(Prefab* child) {
+    mChildren.push_back(std::unique_ptr<Prefab>(child));
+    return child;
+}
+
+uint32_t Prefab::getNodeCount() const {
+    uint32_t count = 1;
+    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+        count += (*iter)->getNodeCount();
+    }
+    return count;
+}
+
+Node::NodeSP Prefab::instantiate(Node* parent, const Transform& transform, const QString name) {
+    if(!name.isEmpty() && parent->findChildNode(name, false) != nullptr) {
+        Logger::get().error("Cannot instantiate prefab " + mName + ": a child node named " + name + " already exists.");
+        return Node::NodeSP();
+    }
+
+    Scene* scene = parent->getScene();
+    if(scene != nullptr)
+        scene->_reserveNodes(getNodeCount());
+
+    Node* root = name.isEmpty() ? _createRoot(parent) : new Node(name);
+    _setTransform(root, transform);
+    Node::NodeSP root_sp = parent->addChildNode(root);
+    applyTo(root);
+    return root_sp;
+}
+
+std::vector<Node*> Prefab::instantiate(Node* parent, const std::vector<Transform>& transforms) {
+    // addChildNodes() makes room for the roots
+    Scene* scene = parent->getScene();
+    if(scene != nullptr)
+        scene->_reserveNodes(transforms.size() * (getNodeCount() - 1));
+
+    std::vector<Node*> roots;
+    roots.reserve(transforms.size());
+    for(auto iter = transforms.begin(); iter != transforms.end(); ++iter) {
+        Node* root = _createRoot(parent);
+        _setTransform(root, *iter);
+        roots.push_back(root);
+    }
+
+    parent->addChildNodes(roots);
+    for(auto iter = roots.begin(); iter != roots.end(); ++iter) {
+        applyTo(*iter);
+    }
+    return roots;
+}
+
+void Prefab::applyTo(Node* node) {
+    _apply(node, false);
+}
+
+void Prefab::moveTo(Node* node) {
+    _apply(node, true);
+    mPrototypes.clear();
+    mChildren.clear();
+}
+
+void Prefab::deserialize(IOPacket& packet) {
+    QUuid id;
+    bool is_enabled = true;
+    packet.stream(id, "uuid");
+    packet.stream(mName, "name", mName);
+    packet.stream(mTransform.mPosition, "position");
+    packet.stream(mTransform.mScale, "scale", Ogre::Vector3::UNIT_SCALE);
+    packet.stream(mTransform.mRotation, "rotation");
+    packet.stream(is_enabled, "enabled");
+
+    uint32_t count = packet.beginList(0, "components");
+    for(uint32_t i = 0; i < count; ++i) {
+        packet.beginObject();
+        std::string type;
+        packet.stream(type, "type", std::string(""));
+        Component* component = Serializer::createComponent(type);
+        component->serialize(packet);
+        mPrototypes.push_back(std::unique_ptr<Component>(component));
+        packet.endObject();
+    }
+    packet.endList();
+
+    count = packet.beginList(0, "children");
+    for(uint32_t i = 0; i < count; ++i) {
+        packet.beginObject();
+        addChild(new Prefab)->deserialize(packet);
+        packet.endObject();
+    }
+    packet.endList();
+}
+
+void Prefab::_apply(Node* node, bool move) {
+    for(auto iter = mPrototypes.begin(); iter != mPrototypes.end(); ++iter) {
+        Component* component = move ? iter->release() : (*iter)->clone();
+        if(component != nullptr)
+            node->addComponent(component);
+    }
+
+    for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter) {
+        Prefab* child = iter->get();
+        if(!child->mName.isEmpty() && node->findChildNode(child->mName, false) != nullptr) {
+            Logger::get().error("Cannot instantiate prefab " + child->mName + ": a child node with this name already exists.");
+            continue;
+        }
+
+        Node* child_node = new Node(child->mName);
+        _setTransform(child_node, child->mTransform);
+        node->addChildNode(child_node);
+        child->_apply(child_node, move);
+    }
+}
+
+Node* Prefab::_createRoot(Node* parent) const {
+    // only a child named like a generated name by hand can be in the way
+    Node* root = new Node();
+    while(parent->findChildNode(root->_getNameKey(), false) != nullptr) {
+        delete root;
+        root = new Node();
+    }
+    return root;
+}
+
+void Prefab::_setTransform(Node* node, const Transform& transform) {
+    node->setPosition(transform.mPosition);
+    node->setRotation(transform.mRotation);
+    node->setScale(transform.mScale);
+}
+
+} // namespace dt
@@ -0,0 +1,189 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_PREFAB
+#define DUCTTAPE_ENGINE_SCENE_PREFAB
+
+#include <Config.hpp>
+
+#include <Network/IOPacket.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Node.hpp>
+
+#include <OgreQuaternion.h>
+#include <OgreVector3.h>
+
+#include <QString>
+#include <QtGlobal>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dt {
+
+/**
+  * A template for a subtree of Nodes with components, e.g. a crate, a soldier or a bullet, which can
+  * be instantiated many times. Every Node of the template holds prototype components, which are never
+  * initialized. The instances get clones of them, which share their configuration with the prototype
+  * until they change it.
+  * @see Component::clone()
+  */
+class DUCTTAPE_API Prefab {
+
+    Q_DISABLE_COPY(Prefab)
+
+public:
+    typedef std::shared_ptr<Prefab> PrefabSP;
+
+    /**
+      * The local transform of a Node.
+      */
+    struct Transform {
+        /**
+          * Constructor.
+          * @param position The position.
+          * @param rotation The rotation.
+          * @param scale The scale.
+          */
+        Transform(const Ogre::Vector3& position = Ogre::Vector3::ZERO,
+                  const Ogre::Quaternion& rotation = Ogre::Quaternion::IDENTITY,
+                  const Ogre::Vector3& scale = Ogre::Vector3::UNIT_SCALE);
+
+        Ogre::Vector3 mPosition;    //!< The position.
+        Ogre::Quaternion mRotation; //!< The rotation.
+        Ogre::Vector3 mScale;       //!< The scale.
+    };
+
+    /**
+      * Constructor for an empty template.
+      * @param name The name of the Node. The roots of the instances get generated names like Nodes without a name.
+      */
+    Prefab(const QString name = "");
+
+    /**
+      * Constructor for a template of an existing subtree. The components of the subtree are cloned,
+      * the subtree itself is not changed.
+      * @param node The root of the subtree.
+      */
+    Prefab(Node* node);
+
+    ~Prefab();
+
+    /**
+      * Returns the name of the Node.
+      * @returns The name of the Node.
+      */
+    const QString& getName() const;
+
+    /**
+      * Sets the local transform of the Node. The root of an instance gets the transform passed to instantiate() instead.
+      * @param transform The transform.
+      */
+    void setTransform(const Transform& transform);
+
+    /**
+      * Returns the local transform of the Node.
+      * @returns The transform.
+      */
+    const Transform& getTransform() const;
+
+    /**
+      * Adds a prototype component to the Node. The Prefab takes ownership of it.
+      * @param prototype The component.
+      * @returns The component, to configure it.
+      */
+    template <typename ComponentType>
+    ComponentType* addComponent(ComponentType* prototype) {
+        mPrototypes.push_back(std::unique_ptr<Component>(prototype));
+        return prototype;
+    }
+
+    /**
+      * Adds a child Node to the template. The Prefab takes ownership of it.
+      * @param child The template of the child Node.
+      * @returns The child.
+      */
+    Prefab* addChild(Prefab* child);
+
+    /**
+      * Returns the number of Nodes in each instance.
+      * @returns The number of Nodes.
+      */
+    uint32_t getNodeCount() const;
+
+    /**
+      * Creates an instance.
+      * @param parent The Node to add the instance to.
+      * @param transform The local transform of the instance.
+      * @param name The name of the root of the instance. Generated if empty.
+      * @returns The root of the instance, or nullptr if the parent already has a child with the name.
+      */
+    Node::NodeSP instantiate(Node* parent, const Transform& transform = Transform(), const QString name = "");
+
+    /**
+      * Creates many instances. The memory for all Nodes is allocated in advance.
+      * @param parent The Node to add the instances to.
+      * @param transforms The local transform of every instance.
+      * @returns The roots of the instances.
+      */
+    std::vector<Node*> instantiate(Node* parent, const std::vector<Transform>& transforms);
+
+    /**
+      * Adds the components and children of the template to an existing Node, e.g. one spawned by a CommandBuffer.
+      * Neither the name nor the transform of the Node are changed.
+      * @param node The Node.
+      */
+    void applyTo(Node* node);
+
+    /**
+      * Like applyTo(), but moves the prototypes into the Node instead of cloning them. The Prefab is empty afterwards.
+      * Used for templates that are instantiated only once, e.g. streamed world cells.
+      * @param node The Node.
+      */
+    void moveTo(Node* node);
+
+    /**
+      * Reads the template from a Node written by Node::serialize(). The enabled state of the Nodes is ignored.
+      * The prototype components are constructed here, so this has to be done on the main thread.
+      * @param packet The packet to read from.
+      */
+    void deserialize(IOPacket& packet);
+
+private:
+    /**
+      * Adds the components and children of the template to a Node.
+      * @param node The Node.
+      * @param move Whether to move the prototypes instead of cloning them.
+      */
+    void _apply(Node* node, bool move);
+
+    /**
+      * Private method. Creates the root of a new instance with a generated name that is not used by a child
+      * of the parent yet. Generated names are not interned, so instances can be spawned endlessly.
+      * @param parent The parent of the instance.
+      * @returns The root.
+      */
+    Node* _createRoot(Node* parent) const;
+
+    /**
+      * Sets the local transform of a Node.
+      * @param node The Node.
+      * @param transform The transform.
+      */
+    static void _setTransform(Node* node, const Transform& transform);
+
+    QString mName;                                          //!< The name of the Node.
+    Transform mTransform;                                   //!< The local transform of the Node.
+    std::vector<std::unique_ptr<Component> > mPrototypes;   //!< The components the instances are cloned from.
+    std::vector<std::unique_ptr<Prefab> > mChildren;        //!< The templates of the child Nodes.
+
+};
+
+} // namespace dt
+
+#endif
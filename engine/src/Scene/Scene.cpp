@@ -8,30 +8,84 @@
 
 #include <Scene/Scene.hpp>
 
+#include <Core/JobSystem.hpp>
+#include <Core/Root.hpp>
 #include <Graphics/DisplayManager.hpp>
+#include <Graphics/MeshComponent.hpp>
+#include <Scene/AabbTree.hpp>
+#include <Scene/LooseOctree.hpp>
 #include <Physics/PhysicsManager.hpp>
 #include <Gui/GuiManager.hpp>
+#include <Utils/Profiler.hpp>
+
+#include <QMutexLocker>
+
+#include <algorithm>
 
 namespace dt {
 
+const uint32_t Scene::NOT_STORED = 0xffffffff;
+
 Scene::Scene(const QString name)
-    : Node(name) {}
+    : Node(name),
+      mIsDeferredTransformCommit(false),
+      mIsParallelUpdate(false),
+      mIsUpdatingInParallel(false),
+      mIsTypedComponentStorage(false),
+      mUpdatingArray(NOT_STORED),
+      mUpdatedCount(0),
+      mCommands(this),
+      mSpatialIndexType(SpatialIndex::NONE),
+      mScheduledComponents(0),
+      mTick(0),
+      mTime(0),
+      mExecutedUpdates(0),
+      mSkippedUpdates(0),
+      mLifecycleBatchDepth(0),
+      mIsPhysicsBatch(false),
+      mStaticGeometry(nullptr),
+      mIsStaticGeometryDirty(false) {
+    mTransforms.setJournal(&mTransformJournal);
+    _setTransformPool(&mTransforms);
+}
 
 void Scene::onInitialize() {
-    GuiManager::get()->setSceneManager(getSceneManager());
+    if(!Root::getInstance().isHeadless())
+        GuiManager::get()->setSceneManager(getSceneManager());
 
-    Logger::get().debug("Scene " + mName + " is being initialized.");
+    Logger::get().debug("Scene " + getName() + " is being initialized.");
 }
 
 void Scene::onDeinitialize() {
-    GuiManager::get()->getRootWindow().removeAllChildren();
-    GuiManager::get()->setSceneManager(nullptr);
+    for(auto iter = mPendingTransformCommits.begin(); iter != mPendingTransformCommits.end(); ++iter) {
+        if(*iter != nullptr)
+            (*iter)->mTransformCommitIndex = NOT_STORED;
+    }
+    mPendingTransformCommits.clear();
+    mTransformJournal.clear();
+    mTagIndex.clear();
+
+    setTypedComponentStorage(false);
+    setSpatialIndex(SpatialIndex::NONE);
+
+    if(mStaticGeometry != nullptr) {
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        getSceneManager()->destroyStaticGeometry(mStaticGeometry);
+        mStaticGeometry = nullptr;
+    }
+    mStaticMeshes.clear();
+    mIsStaticGeometryDirty = false;
 
-    Logger::get().debug("Scene " + mName + " is being deinitialized.");
+    if(!Root::getInstance().isHeadless()) {
+        GuiManager::get()->getRootWindow().removeAllChildren();
+        GuiManager::get()->setSceneManager(nullptr);
+    }
+
+    Logger::get().debug("Scene " + getName() + " is being deinitialized.");
 }
 
 Ogre::SceneManager* Scene::getSceneManager() {
-    return DisplayManager::get()->getSceneManager(mName);
+    return DisplayManager::get()->getSceneManager(getName());
 }
 
 bool Scene::_isScene() {
@@ -39,16 +93,745 @@ bool Scene::_isScene() {
 }
 
 void Scene::updateFrame(double simulation_frame_time) {
+    DUCTTAPE_PROFILE_ZONE("Scene::updateFrame");
+
+    if(mIsStaticGeometryDirty)
+        buildStaticGeometry();
+
+    mTransforms.updateWorldTransforms();
+    if(mSignificance != nullptr)
+        mSignificance->update();
     onUpdate(simulation_frame_time);
+
+    if(mIsTypedComponentStorage)
+        _updateStoredComponents(simulation_frame_time);
+
+    _updateScheduledComponents(simulation_frame_time);
+
+    if(mIsParallelUpdate)
+        _updateParallelComponents(simulation_frame_time);
+
+    mCommands.apply();
+
+    if(mIsDeferredTransformCommit)
+        commitTransforms();
+
+    // Records the Nodes moved by the bulk setters of the TransformPool, and leaves the world transforms up to
+    // date for the spatial index and the next frame. Skipped if nothing has moved.
+    mTransforms.updateWorldTransforms();
+
+    mTransformJournal.publish();
+    if(mSpatialIndex != nullptr) {
+        // only the Nodes that moved in this frame
+        const std::vector<Node*>& changed = mTransformJournal.getChangedNodes();
+        for(auto iter = changed.begin(); iter != changed.end(); ++iter) {
+            if((*iter)->mSpatialProxy != SpatialIndex::INVALID_PROXY)
+                mSpatialIndex->move((*iter)->mSpatialProxy, (*iter)->getPosition(SCENE));
+        }
+    }
+}
+
+CommandBuffer& Scene::getCommandBuffer() {
+    return mCommands;
+}
+
+TransformJournal& Scene::getTransformJournal() {
+    return mTransformJournal;
+}
+
+TagIndex& Scene::getTagIndex() {
+    return mTagIndex;
+}
+
+void Scene::findNodes(const TagIndex::Query& query, std::vector<Node*>& result) const {
+    if(query.mAll != 0 || query.mAny != 0) {
+        mTagIndex.find(query, result);
+        return;
+    }
+
+    // only excluded tags, every Node is a candidate
+    result.clear();
+    for(auto iter = mNodesByRuntimeId.begin(); iter != mNodesByRuntimeId.end(); ++iter) {
+        if(query.matches(iter->second->mTags))
+            result.push_back(iter->second);
+    }
+}
+
+void Scene::findNodes(const TagIndex::Query& query, const Ogre::Vector3& center, float radius, std::vector<Node*>& result) const {
+    // The spatial index only visits the Nodes around the sphere, but the tag arrays may be much smaller.
+    bool is_tagged = (query.mAll != 0 || query.mAny != 0);
+    if(mSpatialIndex != nullptr && (!is_tagged || mTagIndex.getCandidateCount(query) * 8 > mSpatialIndex->getSize())) {
+        mSpatialIndex->queryRadius(center, radius, result);
+        result.erase(std::remove_if(result.begin(), result.end(), [&query] (Node* node) {
+            return !query.matches(node->getTags());
+        }), result.end());
+        return;
+    }
+
+    findNodes(query, result);
+    const float squared_radius = radius * radius;
+    const SpatialIndex* index = mSpatialIndex.get();
+    result.erase(std::remove_if(result.begin(), result.end(), [&] (Node* node) {
+        // the position the spatial index knows, so both ways give the same result
+        Ogre::Vector3 position = (index != nullptr && node->mSpatialProxy != SpatialIndex::INVALID_PROXY)
+            ? index->getPosition(node->mSpatialProxy) : node->getPosition(SCENE);
+        return position.squaredDistance(center) > squared_radius;
+    }), result.end());
+}
+
+void Scene::_reserveNodes(uint32_t count) {
+    mTransforms.reserve(mTransforms.getSize() + count);
+    mNodesByName.reserve(mNodesByName.size() + count);
+    mNodesByRuntimeId.reserve(mNodesByRuntimeId.size() + count);
+}
+
+void Scene::setDeferredTransformCommit(bool deferred) {
+    if(mIsDeferredTransformCommit && !deferred) {
+        // do not lose any pending changes
+        commitTransforms();
+    }
+    mIsDeferredTransformCommit = deferred;
+}
+
+TransformPool* Scene::getTransformPool() {
+    return &mTransforms;
+}
+
+bool Scene::isDeferredTransformCommit() const {
+    return mIsDeferredTransformCommit;
+}
+
+void Scene::commitTransforms() {
+    // Changes made by the components during the commit are queued for the next one.
+    std::vector<Node*> roots = _takeTransformCommitRoots();
+    for(auto iter = roots.begin(); iter != roots.end(); ++iter) {
+        (*iter)->_commitTransform();
+    }
+}
+
+std::vector<Node*> Scene::_takeTransformCommitRoots() {
+    std::vector<Node*> pending;
+    pending.swap(mPendingTransformCommits);
+
+    // Only take the topmost queued nodes, their subtrees contain all the others. Cancelled nodes left a nullptr.
+    std::vector<Node*> roots;
+    for(auto iter = pending.begin(); iter != pending.end(); ++iter) {
+        if(*iter == nullptr)
+            continue;
+
+        bool covered = false;
+        for(Node* parent = (*iter)->getParent(); parent != nullptr && !covered; parent = parent->getParent()) {
+            covered = (parent->mTransformCommitIndex != NOT_STORED);
+        }
+        if(!covered)
+            roots.push_back(*iter);
+    }
+
+    for(auto iter = pending.begin(); iter != pending.end(); ++iter) {
+        if(*iter != nullptr)
+            (*iter)->mTransformCommitIndex = NOT_STORED;
+    }
+    return roots;
+}
+
+void Scene::_queueTransformCommit(Node* node) {
+    QMutexLocker lock(&mPendingTransformCommitsMutex);
+    node->mTransformCommitIndex = mPendingTransformCommits.size();
+    mPendingTransformCommits.push_back(node);
+}
+
+void Scene::_cancelTransformCommit(Node* node) {
+    // keep the other indices valid, the slot is skipped by the next commit
+    QMutexLocker lock(&mPendingTransformCommitsMutex);
+    mPendingTransformCommits[node->mTransformCommitIndex] = nullptr;
+}
+
+void Scene::setTypedComponentStorage(bool enabled) {
+    if(enabled == mIsTypedComponentStorage)
+        return;
+
+    if(enabled) {
+        mIsTypedComponentStorage = true;
+        _storeComponents(this);
+    } else {
+        for(auto array = mComponentArrays.begin(); array != mComponentArrays.end(); ++array) {
+            for(auto iter = array->begin(); iter != array->end(); ++iter) {
+                (*iter)->mStorageIndex = NOT_STORED;
+            }
+        }
+        mComponentArrays.clear();
+        mComponentArrayIndices.clear();
+        mUpdatingArray = NOT_STORED;
+        mIsTypedComponentStorage = false;
+    }
+}
+
+bool Scene::isTypedComponentStorage() const {
+    return mIsTypedComponentStorage;
+}
+
+void Scene::setParallelUpdate(bool enabled) {
+    mIsParallelUpdate = enabled;
+}
+
+bool Scene::isParallelUpdate() const {
+    return mIsParallelUpdate;
+}
+
+bool Scene::_isUpdatingInParallel() const {
+    return mIsUpdatingInParallel;
+}
+
+void Scene::_disableAfterParallelUpdate(Component* component) {
+    QMutexLocker lock(&mPendingDisablesMutex);
+    mPendingDisables.push_back(component);
+}
+
+void Scene::_updateParallelComponents(double time_diff) {
+    if(!mIsEnabled)
+        return;
+
+    DUCTTAPE_PROFILE_ZONE("Scene::updateParallelComponents");
+
+    // Split the Scene into enough independent subtrees. The components of the Nodes split up on
+    // the way are updated on the main thread first, as the subtrees below them read their transforms.
+    const uint32_t tasks = (JobSystem::get()->getWorkerCount() + 1) * 4;
+    std::vector<Node*> roots(1, this);
+    std::vector<Node*> split;
+    while(roots.size() < tasks) {
+        std::vector<Node*> subtrees;
+        uint32_t split_count = split.size();
+        for(auto root = roots.begin(); root != roots.end(); ++root) {
+            if((*root)->mChildren.empty()) {
+                subtrees.push_back(*root);
+                continue;
+            }
+
+            split.push_back(*root);
+            for(auto child = (*root)->mChildren.begin(); child != (*root)->mChildren.end(); ++child) {
+                if(child->second->isEnabled() && !child->second->mIsStatic)
+                    subtrees.push_back(child->second.get());
+            }
+        }
+        roots.swap(subtrees);
+
+        if(split.size() == split_count)
+            break; // only leaves left
+    }
+
+    for(auto iter = split.begin(); iter != split.end(); ++iter) {
+        (*iter)->_updateParallelComponents(time_diff, false);
+    }
+
+    if(roots.empty())
+        return;
+
+    // The workers read the world transforms of the entries above their subtrees, so these are calculated once here.
+    mTransforms.updateWorldTransforms();
+
+    mIsUpdatingInParallel = true;
+    uint32_t per_task = (roots.size() + tasks - 1) / tasks;
+    // the calling thread takes a batch as well, but no main thread jobs while the workers change the Scene
+    JobSystem::get()->parallelFor(0, roots.size(), per_task, [&roots, time_diff] (uint32_t index) {
+        roots[index]->_updateParallelComponents(time_diff, true);
+    }, false);
+    mIsUpdatingInParallel = false;
+
+    std::vector<Component*> disables;
+    disables.swap(mPendingDisables);
+    for(auto iter = disables.begin(); iter != disables.end(); ++iter) {
+        (*iter)->disable();
+    }
+
+    if(!mIsDeferredTransformCommit) {
+        // notify the components of the changed subtrees, as if the transforms had been set on the main thread
+        std::vector<Node*> changed = _takeTransformCommitRoots();
+        for(auto iter = changed.begin(); iter != changed.end(); ++iter) {
+            (*iter)->onUpdate(0);
+        }
+    }
+}
+
+uint64_t Scene::getExecutedUpdateCount() const {
+    return mExecutedUpdates;
+}
+
+uint64_t Scene::getSkippedUpdateCount() const {
+    return mSkippedUpdates;
+}
+
+void Scene::_scheduleComponent(Component* component) {
+    if(component->mIsTickScheduled || !component->_isTickScheduled() || component->mNode->mIsStatic)
+        return;
+
+    component->mIsTickScheduled = true;
+    component->mLastUpdateTime = mTime;
+    ++mScheduledComponents;
+
+    uint32_t interval = component->_getScheduledTickInterval();
+    if(component->mIsSleeping || interval == Component::ON_DEMAND || interval == Component::NEVER)
+        return; // not updated regularly, so it costs nothing
+
+    auto bucket = mTickBuckets.begin();
+    while(bucket != mTickBuckets.end() && bucket->mInterval != interval) {
+        ++bucket;
+    }
+    if(bucket == mTickBuckets.end()) {
+        TickBucket new_bucket;
+        new_bucket.mInterval = interval;
+        new_bucket.mPhases.resize(interval);
+        new_bucket.mNextPhase = 0;
+        bucket = mTickBuckets.insert(mTickBuckets.end(), new_bucket);
+    }
+
+    component->mTickPhase = bucket->mNextPhase;
+    bucket->mNextPhase = (bucket->mNextPhase + 1) % interval;
+    std::vector<Component*>& phase = bucket->mPhases[component->mTickPhase];
+    component->mTickIndex = phase.size();
+    phase.push_back(component);
+}
+
+void Scene::_unscheduleComponent(Component* component) {
+    if(!component->mIsTickScheduled)
+        return;
+
+    component->mIsTickScheduled = false;
+    --mScheduledComponents;
+
+    if(component->mTickPhase != NOT_STORED) {
+        for(auto bucket = mTickBuckets.begin(); bucket != mTickBuckets.end(); ++bucket) {
+            if(bucket->mInterval == component->_getScheduledTickInterval()) {
+                // swap with the last element to keep the phase contiguous
+                std::vector<Component*>& phase = bucket->mPhases[component->mTickPhase];
+                Component* last = phase.back();
+                phase[component->mTickIndex] = last;
+                last->mTickIndex = component->mTickIndex;
+                phase.pop_back();
+                break;
+            }
+        }
+        component->mTickPhase = NOT_STORED;
+    }
+
+    if(component->mIsUpdateRequested) {
+        QMutexLocker lock(&mRequestedUpdatesMutex);
+        mRequestedUpdates.erase(std::find(mRequestedUpdates.begin(), mRequestedUpdates.end(), component));
+        component->mIsUpdateRequested = false;
+    }
+}
+
+void Scene::_requestUpdate(Component* component) {
+    QMutexLocker lock(&mRequestedUpdatesMutex);
+    if(component->mIsTickScheduled && !component->mIsUpdateRequested) {
+        component->mIsUpdateRequested = true;
+        mRequestedUpdates.push_back(component);
+    }
+}
+
+void Scene::_updateScheduledComponents(double time_diff) {
+    ++mTick;
+    mTime += time_diff;
+    if(mScheduledComponents == 0)
+        return;
+
+    uint64_t executed = 0;
+    for(uint32_t b = 0; b < mTickBuckets.size(); ++b) {
+        std::vector<Component*>& phase = mTickBuckets[b].mPhases[mTick % mTickBuckets[b].mInterval];
+        // Components may be unscheduled while updating, the last one takes their place.
+        for(uint32_t i = 0; i < phase.size();) {
+            Component* component = phase[i];
+            if(_tickComponent(component))
+                ++executed;
+
+            if(i < phase.size() && phase[i] == component)
+                ++i;
+        }
+    }
+
+    // updates requested while updating are done in the next tick
+    std::vector<Component*> requested;
+    {
+        QMutexLocker lock(&mRequestedUpdatesMutex);
+        requested.swap(mRequestedUpdates);
+        for(auto iter = requested.begin(); iter != requested.end(); ++iter) {
+            (*iter)->mIsUpdateRequested = false;
+        }
+    }
+    for(auto iter = requested.begin(); iter != requested.end(); ++iter) {
+        // skip components that have been unscheduled by an earlier update
+        if((*iter)->mIsTickScheduled && _tickComponent(*iter))
+            ++executed;
+    }
+
+    mExecutedUpdates += executed;
+    if(mScheduledComponents > executed)
+        mSkippedUpdates += mScheduledComponents - executed;
+}
+
+bool Scene::_tickComponent(Component* component) {
+    // at most one update per tick, and none in the tick the component has been scheduled in
+    double time_diff = mTime - component->mLastUpdateTime;
+    if(!component->isEnabled() || time_diff <= 0)
+        return false;
+
+    component->mLastUpdateTime = mTime;
+    DUCTTAPE_PROFILE_ZONE(component->metaObject()->className());
+    component->onUpdate(time_diff);
+    return true;
+}
+
+void Scene::_storeComponents(Node* node) {
+    if(!mIsTypedComponentStorage)
+        return;
+
+    for(auto iter = node->mComponents.begin(); iter != node->mComponents.end(); ++iter) {
+        _storeComponent(iter->second.get());
+    }
+    for(auto iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter) {
+        _storeComponents(iter->second.get());
+    }
+}
+
+void Scene::setSpatialIndex(SpatialIndex::Type type) {
+    if(type == mSpatialIndexType)
+        return;
+
+    for(auto iter = mNodesByRuntimeId.begin(); iter != mNodesByRuntimeId.end(); ++iter) {
+        iter->second->mSpatialProxy = SpatialIndex::INVALID_PROXY;
+    }
+
+    mSpatialIndexType = type;
+    if(type == SpatialIndex::LOOSE_OCTREE) {
+        mSpatialIndex.reset(new LooseOctree());
+    } else if(type == SpatialIndex::AABB_TREE) {
+        mSpatialIndex.reset(new AabbTree());
+    } else {
+        mSpatialIndex.reset();
+        return;
+    }
+
+    mTransforms.updateWorldTransforms();
+    for(auto iter = mNodesByRuntimeId.begin(); iter != mNodesByRuntimeId.end(); ++iter) {
+        Node* node = iter->second;
+        node->mSpatialProxy = mSpatialIndex->insert(node, node->getPosition(SCENE));
+    }
+}
+
+SpatialIndex::Type Scene::getSpatialIndexType() const {
+    return mSpatialIndexType;
+}
+
+SpatialIndex* Scene::getSpatialIndex() {
+    return mSpatialIndex.get();
+}
+
+SignificanceManager* Scene::getSignificanceManager() {
+    if(mSignificance == nullptr)
+        mSignificance.reset(new SignificanceManager(this));
+    return mSignificance.get();
+}
+
+void Scene::_trackSignificance(Component* component) {
+    if(component->isSignificanceEnabled() && !component->mNode->mIsStatic)
+        getSignificanceManager()->_addComponent(component);
+}
+
+void Scene::_untrackSignificance(Component* component) {
+    if(mSignificance != nullptr)
+        mSignificance->_removeComponent(component);
+}
+
+Node::NodeSP Scene::findNode(const QUuid& id) {
+    auto iter = mNodesById.find(id);
+    if(iter == mNodesById.end())
+        return NodeSP();
+    return _getShared(iter->second);
+}
+
+Node::NodeSP Scene::findNode(uint64_t runtime_id) {
+    auto iter = mNodesByRuntimeId.find(runtime_id);
+    if(iter == mNodesByRuntimeId.end())
+        return NodeSP();
+    return _getShared(iter->second);
+}
+
+Node::NodeHandle Scene::findNodeHandle(uint64_t runtime_id) const {
+    auto iter = mNodesByRuntimeId.find(runtime_id);
+    if(iter == mNodesByRuntimeId.end())
+        return NodeHandle();
+    return iter->second->getHandle();
+}
+
+const std::vector<Node*>& Scene::findNodes(const Name& name) const {
+    static const std::vector<Node*> none;
+
+    auto iter = mNodesByName.find(name);
+    if(iter == mNodesByName.end())
+        return none;
+    return iter->second;
+}
+
+void Scene::_addNode(Node* node) {
+    _indexNode(node);
+    if(node->mDeathMark && node != this)
+        mCommands.kill(node); // killed before it became part of this Scene
+    for(auto iter = node->mComponents.begin(); iter != node->mComponents.end(); ++iter) {
+        _storeComponent(iter->second.get());
+        _scheduleComponent(iter->second.get());
+        _trackSignificance(iter->second.get());
+    }
+    for(auto iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter) {
+        _addNode(iter->second.get());
+    }
+}
+
+void Scene::_removeNode(Node* node) {
+    _unindexNode(node);
+    mTransformJournal.remove(node);
+    for(auto iter = node->mComponents.begin(); iter != node->mComponents.end(); ++iter) {
+        _untrackSignificance(iter->second.get());
+        _unstoreComponent(iter->second.get());
+        _unscheduleComponent(iter->second.get());
+    }
+    for(auto iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter) {
+        _removeNode(iter->second.get());
+    }
+}
+
+void Scene::_indexNode(Node* node) {
+    if(node == this)
+        return;
+
+    mNodesByName[node->_getNameKey()].push_back(node);
+    mNodesByRuntimeId[node->mRuntimeId] = node;
+    if(!node->mId.isNull())
+        mNodesById[node->mId] = node;
+
+    if(mSpatialIndex != nullptr && node->mSpatialProxy == SpatialIndex::INVALID_PROXY)
+        node->mSpatialProxy = mSpatialIndex->insert(node, node->getPosition(SCENE));
+
+    if(node->mTags != 0 && node->mTagIndices.empty())
+        mTagIndex.add(node);
+}
+
+void Scene::_unindexNode(Node* node) {
+    auto named = mNodesByName.find(node->_getNameKey());
+    if(named != mNodesByName.end()) {
+        std::vector<Node*>& nodes = named->second;
+        auto iter = std::find(nodes.begin(), nodes.end(), node);
+        if(iter != nodes.end()) {
+            *iter = nodes.back();
+            nodes.pop_back();
+        }
+        if(nodes.empty())
+            mNodesByName.erase(named);
+    }
+
+    mNodesByRuntimeId.erase(node->mRuntimeId);
+    mTagIndex.remove(node);
+
+    if(node->mSpatialProxy != SpatialIndex::INVALID_PROXY) {
+        if(mSpatialIndex != nullptr)
+            mSpatialIndex->remove(node->mSpatialProxy);
+        node->mSpatialProxy = SpatialIndex::INVALID_PROXY;
+    }
+
+    if(!node->mId.isNull()) {
+        auto id = mNodesById.find(node->mId);
+        if(id != mNodesById.end() && id->second == node)
+            mNodesById.erase(id);
+    }
+}
+
+Node::NodeSP Scene::_getShared(Node* node) {
+    // the shared pointer is owned by the parent
+    Node* parent = node->mParent;
+    auto child = parent->mChildren.find(node->_getNameKey());
+    if(child == parent->mChildren.end())
+        return NodeSP();
+    return child->second;
+}
+
+size_t Scene::UuidHash::operator()(const QUuid& id) const {
+    // the uuids are random, so a few of their bits are a good hash
+    return id.data1 ^ (static_cast<size_t>(id.data2) << 16) ^ id.data3;
+}
+
+void Scene::_storeComponent(Component* component) {
+    if(!mIsTypedComponentStorage || component->mStorageIndex != NOT_STORED || component->mNode->mIsStatic)
+        return;
+
+    const QMetaObject* type = component->metaObject();
+    auto index = mComponentArrayIndices.find(type);
+    if(index == mComponentArrayIndices.end()) {
+        index = mComponentArrayIndices.insert(std::make_pair(type, (uint32_t)mComponentArrays.size())).first;
+        mComponentArrays.push_back(std::vector<Component*>());
+    }
+
+    std::vector<Component*>& array = mComponentArrays[index->second];
+    component->mStorageIndex = array.size();
+    array.push_back(component);
+}
+
+void Scene::_unstoreComponent(Component* component) {
+    if(component->mStorageIndex == NOT_STORED)
+        return;
+
+    uint32_t array_index = mComponentArrayIndices[component->metaObject()];
+    std::vector<Component*>& array = mComponentArrays[array_index];
+    uint32_t hole = component->mStorageIndex;
+    component->mStorageIndex = NOT_STORED;
+
+    if(array_index == mUpdatingArray && hole < mUpdatedCount) {
+        // keep the updated components in front: the last updated one fills the hole and leaves one behind it
+        --mUpdatedCount;
+        array[hole] = array[mUpdatedCount];
+        array[hole]->mStorageIndex = hole;
+        hole = mUpdatedCount;
+    }
+
+    // fill the hole with the last element to keep the array dense
+    if(hole != array.size() - 1) {
+        array[hole] = array.back();
+        array[hole]->mStorageIndex = hole;
+    }
+    array.pop_back();
+}
+
+const std::vector<Component*>* Scene::_getComponentArray(const QMetaObject* type) const {
+    if(!mIsTypedComponentStorage) {
+        Logger::get().error("Scene " + getName() + ": Cannot view components, the typed component storage is disabled.");
+        return nullptr;
+    }
+
+    auto index = mComponentArrayIndices.find(type);
+    if(index == mComponentArrayIndices.end())
+        return nullptr;
+    return &mComponentArrays[index->second];
+}
+
+void Scene::_updateStoredComponents(double time_diff) {
+    // Components may add or remove other components while being updated, so indices are used
+    // instead of iterators. _unstoreComponent() keeps the components updated so far at the front
+    // of the array, the others behind mUpdatedCount.
+    for(uint32_t type = 0; type < mComponentArrays.size(); ++type) {
+        mUpdatingArray = type;
+        for(mUpdatedCount = 0; type < mComponentArrays.size() && mUpdatedCount < mComponentArrays[type].size();) {
+            Component* component = mComponentArrays[type][mUpdatedCount++];
+            // scheduled components are updated by the tick scheduler, parallel-safe ones by the workers
+            if(component->isEnabled() && !component->_isTickScheduled()
+                    && !(mIsParallelUpdate && component->isParallelUpdateSafe())) {
+                DUCTTAPE_PROFILE_ZONE(component->metaObject()->className());
+                component->onUpdate(time_diff);
+            }
+        }
+    }
+    mUpdatingArray = NOT_STORED;
+}
+
+void Scene::beginLifecycleBatch() {
+    if(mLifecycleBatchDepth++ > 0)
+        return;
+
+    // do not create a PhysicsWorld just for the batch
+    mIsPhysicsBatch = PhysicsManager::get()->hasWorld(getName());
+    if(mIsPhysicsBatch)
+        getPhysicsWorld()->beginBatch();
+}
+
+void Scene::endLifecycleBatch() {
+    if(mLifecycleBatchDepth == 0 || --mLifecycleBatchDepth > 0)
+        return;
+
+    if(mIsPhysicsBatch) {
+        getPhysicsWorld()->endBatch();
+        mIsPhysicsBatch = false;
+    }
+
+    // The receivers may remove components or open another batch, which then takes over the remaining signals.
+    for(uint32_t i = 0; i < mDeferredSignals.size() && mLifecycleBatchDepth == 0; ++i) {
+        Component* component = mDeferredSignals[i];
+        mDeferredSignals[i] = nullptr;
+        if(component != nullptr)
+            component->_emitDeferredSignal();
+    }
+    if(mLifecycleBatchDepth == 0)
+        mDeferredSignals.clear();
+}
+
+bool Scene::isLifecycleBatch() const {
+    return mLifecycleBatchDepth > 0;
+}
+
+void Scene::setSubtreesEnabled(const std::vector<Node*>& roots, bool enabled) {
+    beginLifecycleBatch();
+    for(auto iter = roots.begin(); iter != roots.end(); ++iter) {
+        if(enabled)
+            (*iter)->enable();
+        else
+            (*iter)->disable();
+    }
+    endLifecycleBatch();
+}
+
+void Scene::_deferSignal(Component* component) {
+    component->mDeferredSignalIndex = mDeferredSignals.size();
+    mDeferredSignals.push_back(component);
+}
+
+void Scene::_cancelDeferredSignal(Component* component) {
+    if(component->mDeferredSignalIndex < mDeferredSignals.size())
+        mDeferredSignals[component->mDeferredSignalIndex] = nullptr;
+    component->mDeferredSignalIndex = NOT_STORED;
+}
+
+Ogre::StaticGeometry* Scene::getStaticGeometry() {
+    Ogre::SceneManager* scene_mgr = getSceneManager();
+    if(mStaticGeometry == nullptr && scene_mgr != nullptr)
+        mStaticGeometry = scene_mgr->createStaticGeometry(Utils::toStdString(getName()) + "-static-geometry");
+    return mStaticGeometry;
+}
+
+void Scene::buildStaticGeometry() {
+    mIsStaticGeometryDirty = false;
+    if(mStaticGeometry == nullptr && mStaticMeshes.empty())
+        return;
+
+    QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+    Ogre::StaticGeometry* geometry = getStaticGeometry();
+    if(geometry == nullptr)
+        return;
+    geometry->reset();
+    for(auto iter = mStaticMeshes.begin(); iter != mStaticMeshes.end(); ++iter) {
+        Node* node = (*iter)->getNode();
+        geometry->addEntity((*iter)->getOgreEntity(), node->getPosition(Node::SCENE),
+                            node->getRotation(Node::SCENE), node->getScale(Node::SCENE));
+    }
+    if(!mStaticMeshes.empty())
+        geometry->build();
+}
+
+void Scene::_addStaticMesh(MeshComponent* mesh) {
+    mStaticMeshes.push_back(mesh);
+    mIsStaticGeometryDirty = true;
+}
+
+void Scene::_removeStaticMesh(MeshComponent* mesh) {
+    auto iter = std::find(mStaticMeshes.begin(), mStaticMeshes.end(), mesh);
+    if(iter != mStaticMeshes.end()) {
+        *iter = mStaticMeshes.back();
+        mStaticMeshes.pop_back();
+        mIsStaticGeometryDirty = true;
+    }
 }
 
 PhysicsWorld::PhysicsWorldSP Scene::getPhysicsWorld() {
     PhysicsManager* mgr = PhysicsManager::get();
     // create a world if none exists
-    if(!mgr->hasWorld(mName)) {
-        return mgr->addWorld(new PhysicsWorld(mName, this));
+    if(!mgr->hasWorld(getName())) {
+        return mgr->addWorld(new PhysicsWorld(getName(), this));
     }
-    return mgr->getWorld(mName);
+    return mgr->getWorld(getName());
 }
 
 } // namespace dt
@@ -14,15 +14,33 @@
 //#include <Event/Event.hpp>
 //#include <Event/EventListener.hpp>
 #include <Physics/PhysicsWorld.hpp>
+#include <Scene/CommandBuffer.hpp>
+#include <Scene/ComponentView.hpp>
 #include <Scene/Node.hpp>
+#include <Scene/SignificanceManager.hpp>
+#include <Scene/SpatialIndex.hpp>
+#include <Scene/TagIndex.hpp>
+#include <Scene/TransformJournal.hpp>
+#include <Scene/TransformPool.hpp>
 
+#include <OgreStaticGeometry.h>
+
+#include <QMutex>
 #include <QObject>
 #include <QString>
+#include <QUuid>
 
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace dt {
 
+// forward declaration due to circular dependency
+class MeshComponent;
+
 /**
   * A class to represent a whole scene of the game world.
   */
@@ -31,6 +49,8 @@ class DUCTTAPE_API Scene : public Node {
 public:
     
     typedef std::shared_ptr<Scene> SceneSP;
+
+    static const uint32_t NOT_STORED;   //!< The storage index of a component outside of the typed component storage.
     
     /**
       * Default constructor.
@@ -43,7 +63,7 @@ public:
 
     /**
       * Returns the Ogre::SceneManager of this Scene.
-      * @returns The Ogre::SceneManager of this Scene.
+      * @returns The Ogre::SceneManager of this Scene, or nullptr on a dedicated server.
       */
     Ogre::SceneManager* getSceneManager();
 
@@ -52,11 +72,489 @@ public:
       * @returns The PhysicsWorld of this Scene.
       */
     PhysicsWorld::PhysicsWorldSP getPhysicsWorld();
+
+    /**
+      * Returns the pool holding the transforms of all Nodes in this Scene. Its world transforms are
+      * recalculated in one batch at the beginning and at the end of every frame, and before the parallel
+      * component update. A batch is skipped if nothing has moved since the last one.
+      * @returns The TransformPool of this Scene.
+      */
+    TransformPool* getTransformPool();
+
+    /**
+      * Returns the buffer for structural changes of this Scene. It is applied at the end of every
+      * frame, after all Nodes and components have been updated and before the transform commit.
+      * @returns The CommandBuffer of this Scene.
+      */
+    CommandBuffer& getCommandBuffer();
+
+    /**
+      * Returns the journal of the Nodes whose world transform changed. It is published at the end of every
+      * frame, after the transform commit.
+      * @returns The TransformJournal of this Scene.
+      */
+    TransformJournal& getTransformJournal();
+
+    /**
+      * Returns the index of the Nodes of this Scene by their tags.
+      * @returns The TagIndex of this Scene.
+      */
+    TagIndex& getTagIndex();
+
+    /**
+      * Finds the Nodes of this Scene matching a tag query, e.g. all enemies that are not dead. Queries
+      * with required or optional tags only look at the Nodes with these tags, queries that only exclude
+      * tags look at every Node.
+      * @param query The query.
+      * @param result Is filled with the Nodes, in no particular order.
+      */
+    void findNodes(const TagIndex::Query& query, std::vector<Node*>& result) const;
+
+    /**
+      * Finds the Nodes of this Scene matching a tag query within a sphere, e.g. all enemies within 50 m.
+      * Depending on which is smaller, either the Nodes with the tags are checked against the sphere, or
+      * the Nodes found by the spatial index are checked against the tags.
+      * @param query The query.
+      * @param center The center of the sphere.
+      * @param radius The radius of the sphere.
+      * @param result Is filled with the Nodes, in no particular order.
+      * @see setSpatialIndex(SpatialIndex::Type type)
+      */
+    void findNodes(const TagIndex::Query& query, const Ogre::Vector3& center, float radius, std::vector<Node*>& result) const;
+
+    /**
+      * Allocates the memory for a number of additional Nodes in advance.
+      * @internal
+      * @param count The number of Nodes that are about to be added.
+      */
+    void _reserveNodes(uint32_t count);
+
+    /**
+      * Sets whether transform changes are deferred. If enabled, setting the position, rotation or scale
+      * of a Node only marks it as changed, and the components are notified once per frame by commitTransforms()
+      * instead of updating the whole subtree on every write. Default: false.
+      * @param deferred Whether transform changes should be deferred.
+      */
+    void setDeferredTransformCommit(bool deferred);
+
+    /**
+      * Returns whether transform changes are deferred.
+      * @returns Whether transform changes are deferred.
+      */
+    bool isDeferredTransformCommit() const;
+
+    /**
+      * Notifies the components of all Nodes whose transform changed since the last commit.
+      * Called by updateFrame() in deferred mode.
+      */
+    void commitTransforms();
+
+    /**
+      * Queues a Node for the next transform commit.
+      * @internal
+      * @param node The Node whose transform changed.
+      */
+    void _queueTransformCommit(Node* node);
+
+    /**
+      * Removes a Node from the transform commit queue, e.g. because it is being removed.
+      * @internal
+      * @param node The Node to remove.
+      */
+    void _cancelTransformCommit(Node* node);
+
+    /**
+      * Sets whether the Scene keeps one array of components per component type. If enabled,
+      * view() can be used to iterate all components of a type without walking the Node tree, and
+      * the per-frame updates of the components are done type by type (in the order the types were
+      * first added to the Scene) after all Nodes have been updated. The arrays hold Component pointers,
+      * the components themselves are still allocated one by one, so this saves the tree walk but does
+      * not make the component data contiguous. Default: false.
+      * @param enabled Whether to use the typed component storage.
+      */
+    void setTypedComponentStorage(bool enabled);
+
+    /**
+      * Returns whether the Scene keeps one array of components per component type.
+      * @returns Whether the typed component storage is used.
+      */
+    bool isTypedComponentStorage() const;
+
+    /**
+      * Returns all components of one type in this Scene. Subclasses of the type are not included,
+      * as they are stored in arrays of their own. Requires the typed component storage.
+      * @returns A view of all components of the type.
+      * @see setTypedComponentStorage(bool enabled)
+      */
+    template <typename ComponentType>
+    ComponentView<ComponentType> view() const {
+        const std::vector<Component*>* components = _getComponentArray(&ComponentType::staticMetaObject);
+        if(components == nullptr || components->empty())
+            return ComponentView<ComponentType>();
+        return ComponentView<ComponentType>(&components->front(), &components->front() + components->size());
+    }
+
+    /**
+      * Sets whether components that are safe to update in parallel are updated on the worker threads
+      * of the JobSystem. After all Nodes have been updated on the main thread, the independent subtrees of
+      * the Scene are distributed among the workers, which update the parallel-safe components in them.
+      * Transform changes made by these components are passed on to the other components after
+      * all workers have finished. All other components are still updated on the main thread. Default: false.
+      * @param enabled Whether to update components in parallel.
+      * @see Component::isParallelUpdateSafe()
+      */
+    void setParallelUpdate(bool enabled);
+
+    /**
+      * Returns whether components that are safe to update in parallel are updated on worker threads.
+      * @returns Whether components are updated in parallel.
+      */
+    bool isParallelUpdate() const;
+
+    /**
+      * Returns whether the worker threads are currently updating components.
+      * @internal
+      * @returns Whether the worker threads are currently updating components.
+      */
+    bool _isUpdatingInParallel() const;
+
+    /**
+      * Disables a component on the main thread once the worker threads are done. Components updated in
+      * parallel must not disable themselves, as that emits signals and runs their onDisable() on a worker.
+      * @internal
+      * @param component The component to disable.
+      */
+    void _disableAfterParallelUpdate(Component* component);
+
+    /**
+      * Returns the number of updates done by the tick scheduler, i.e. of components that are not updated every tick.
+      * @returns The number of updates done.
+      * @see Component::setTickInterval(uint32_t ticks)
+      */
+    uint64_t getExecutedUpdateCount() const;
+
+    /**
+      * Returns the number of updates skipped by the tick scheduler, because the components were sleeping,
+      * disabled, or not due in that tick.
+      * @returns The number of updates skipped.
+      */
+    uint64_t getSkippedUpdateCount() const;
+
+    /**
+      * Registers a component with the tick scheduler, if it is not updated every tick and its Node is not static.
+      * @internal
+      * @param component The component.
+      */
+    void _scheduleComponent(Component* component);
+
+    /**
+      * Removes a component from the tick scheduler.
+      * @internal
+      * @param component The component.
+      */
+    void _unscheduleComponent(Component* component);
+
+    /**
+      * Queues a scheduled component for an update in the next tick.
+      * @internal
+      * @param component The component.
+      */
+    void _requestUpdate(Component* component);
+
+    /**
+      * Sets the data structure that indexes the world positions of the Nodes of this Scene. The index is
+      * built from all Nodes, Nodes are added and removed as they join and leave the Scene, and the
+      * positions are refreshed at the end of every frame. Default: SpatialIndex::NONE.
+      * @param type The data structure.
+      */
+    void setSpatialIndex(SpatialIndex::Type type);
+
+    /**
+      * Returns the type of the spatial index of this Scene.
+      * @returns The data structure that indexes the Nodes.
+      */
+    SpatialIndex::Type getSpatialIndexType() const;
+
+    /**
+      * Returns the spatial index of this Scene, for range, nearest-neighbour and frustum queries.
+      * @returns The spatial index, or nullptr if there is none.
+      * @see setSpatialIndex(SpatialIndex::Type type)
+      */
+    SpatialIndex* getSpatialIndex();
+
+    /**
+      * Returns the SignificanceManager of this Scene, which scores the Nodes whose components opted in
+      * at the beginning of every frame. Creates it on demand.
+      * @returns The SignificanceManager of this Scene.
+      * @see Component::setSignificanceEnabled(bool enabled)
+      */
+    SignificanceManager* getSignificanceManager();
+
+    /**
+      * Starts scoring the Node of a component that uses its significance.
+      * @internal
+      * @param component The component.
+      */
+    void _trackSignificance(Component* component);
+
+    /**
+      * Stops scoring the Node of a component for it.
+      * @internal
+      * @param component The component.
+      */
+    void _untrackSignificance(Component* component);
+
+    /**
+      * Opens a lifecycle batch, for enabling or disabling many Nodes at once without a hitch. Until the batch is
+      * closed, the enabled and disabled signals of the components are deferred, and the rigid bodies are only
+      * queued for adding to or removing from the PhysicsWorld. Batches can be nested.
+      * @see endLifecycleBatch()
+      */
+    void beginLifecycleBatch();
+
+    /**
+      * Closes a lifecycle batch. When the outermost batch is closed, the PhysicsWorld applies the queued
+      * changes at once, and every component whose state differs from the one before the batch emits a
+      * single enabled or disabled signal. Components that were disabled and enabled again emit none.
+      */
+    void endLifecycleBatch();
+
+    /**
+      * Returns whether a lifecycle batch is open.
+      * @returns Whether a lifecycle batch is open.
+      */
+    bool isLifecycleBatch() const;
+
+    /**
+      * Enables or disables several subtrees in one lifecycle batch.
+      * @param roots The roots of the subtrees.
+      * @param enabled Whether to enable or disable the subtrees.
+      * @see beginLifecycleBatch()
+      */
+    void setSubtreesEnabled(const std::vector<Node*>& roots, bool enabled);
+
+    /**
+      * Queues the enabled or disabled signal of a component until the lifecycle batch is closed.
+      * @internal
+      * @param component The component.
+      */
+    void _deferSignal(Component* component);
+
+    /**
+      * Removes a component from the deferred signals, e.g. because it is being deinitialized.
+      * @internal
+      * @param component The component.
+      */
+    void _cancelDeferredSignal(Component* component);
+
+    /**
+      * Returns the static geometry the meshes of baked Nodes are merged into. Creates it on-demand.
+      * @returns The Ogre::StaticGeometry of this Scene, or nullptr on a dedicated server.
+      * @see Node::bake()
+      */
+    Ogre::StaticGeometry* getStaticGeometry();
+
+    /**
+      * Rebuilds the static geometry from the meshes of all baked Nodes. Called by updateFrame() whenever
+      * meshes have been baked or unbaked since the last build, so baking several subtrees in one frame only
+      * builds once. Call it directly to avoid the cost in the first frame after loading a level.
+      */
+    void buildStaticGeometry();
+
+    /**
+      * Adds a mesh to the static geometry at the next build.
+      * @internal
+      * @param mesh The mesh of a baked Node.
+      */
+    void _addStaticMesh(MeshComponent* mesh);
+
+    /**
+      * Removes a mesh from the static geometry at the next build.
+      * @internal
+      * @param mesh The mesh.
+      */
+    void _removeStaticMesh(MeshComponent* mesh);
+
+    /**
+      * Returns the Node with the given id.
+      * @param id The id of the Node.
+      * @returns A pointer to the Node, or nullptr if there is no Node with this id in this Scene.
+      */
+    Node::NodeSP findNode(const QUuid& id);
+
+    /**
+      * Returns the Node with the given runtime id.
+      * @param runtime_id The runtime id of the Node.
+      * @returns A pointer to the Node, or nullptr if there is no Node with this runtime id in this Scene.
+      */
+    Node::NodeSP findNode(uint64_t runtime_id);
+
+    /**
+      * Returns a handle to the Node with the given runtime id, without copying a shared pointer.
+      * @param runtime_id The runtime id of the Node.
+      * @returns A handle to the Node, or an invalid handle if there is no Node with this runtime id in this Scene.
+      */
+    NodeHandle findNodeHandle(uint64_t runtime_id) const;
+
+    /**
+      * Returns the Nodes of this Scene with the given name, in no particular order.
+      * @param name The name of the Nodes.
+      * @returns The Nodes with the name. Only valid until a Node is added or removed.
+      */
+    const std::vector<Node*>& findNodes(const Name& name) const;
+
+    /**
+      * Adds a Node and all of its children to the name/id index and to the typed component storage.
+      * @internal
+      * @param node The Node that has been added to this Scene.
+      */
+    void _addNode(Node* node);
+
+    /**
+      * Removes a Node and all of its children from the name/id index and from the typed component storage.
+      * @internal
+      * @param node The Node that is being removed from this Scene.
+      */
+    void _removeNode(Node* node);
+
+    /**
+      * Adds a single Node to the name/id index and to the spatial index.
+      * @internal
+      * @param node The Node.
+      */
+    void _indexNode(Node* node);
+
+    /**
+      * Removes a single Node from the name/id index and from the spatial index.
+      * @internal
+      * @param node The Node.
+      */
+    void _unindexNode(Node* node);
+
+    /**
+      * Adds a component to the typed component storage, if it is enabled and the Node is not static.
+      * @internal
+      * @param component The component to add.
+      */
+    void _storeComponent(Component* component);
+
+    /**
+      * Removes a component from the typed component storage.
+      * @internal
+      * @param component The component to remove.
+      */
+    void _unstoreComponent(Component* component);
+
 public slots:
     void updateFrame(double simulation_frame_time);
 protected:
     bool _isScene();
 
+private:
+    /**
+      * The scheduled components with the same tick interval, split up by the tick they are updated in.
+      */
+    struct TickBucket {
+        uint32_t mInterval;                                 //!< The number of ticks between two updates.
+        std::vector<std::vector<Component*> > mPhases;      //!< The components for each tick modulo the interval.
+        uint32_t mNextPhase;                                //!< The phase for the next component, to spread the load.
+    };
+
+    /**
+      * Hash function for QUuids.
+      */
+    struct UuidHash {
+        size_t operator()(const QUuid& id) const;
+    };
+
+    /**
+      * Adds the components of a Node and all of its children to the typed component storage.
+      * @param node The Node.
+      */
+    void _storeComponents(Node* node);
+
+    /**
+      * Returns the shared pointer owning a Node of this Scene.
+      * @param node The Node.
+      * @returns The shared pointer held by the parent of the Node.
+      */
+    Node::NodeSP _getShared(Node* node);
+
+    /**
+      * Returns the array of components of a type.
+      * @param type The meta object of the component type.
+      * @returns The array, or nullptr if there is no component of this type.
+      */
+    const std::vector<Component*>* _getComponentArray(const QMetaObject* type) const;
+
+    /**
+      * Updates all components in the typed component storage, type by type.
+      * @param time_diff The frame time.
+      */
+    void _updateStoredComponents(double time_diff);
+
+    /**
+      * Updates the components of the tick scheduler that are due in this tick.
+      * @param time_diff The frame time.
+      */
+    void _updateScheduledComponents(double time_diff);
+
+    /**
+      * Updates a scheduled component, passing the time since its last update.
+      * @param component The component.
+      * @returns Whether the component has been updated.
+      */
+    bool _tickComponent(Component* component);
+
+    /**
+      * Updates the parallel-safe components of all enabled Nodes on the worker threads.
+      * @param time_diff The frame time.
+      */
+    void _updateParallelComponents(double time_diff);
+
+    /**
+      * Empties the transform commit queue.
+      * @returns The topmost queued Nodes, their subtrees contain all the others.
+      */
+    std::vector<Node*> _takeTransformCommitRoots();
+
+    TransformPool mTransforms;                          //!< The transforms of all Nodes in this Scene.
+    TransformJournal mTransformJournal;                 //!< The Nodes whose world transform changed.
+    TagIndex mTagIndex;                                 //!< The Nodes of this Scene by their tags.
+    bool mIsDeferredTransformCommit;                    //!< Whether transform changes are deferred until commitTransforms().
+    std::vector<Node*> mPendingTransformCommits;        //!< The Nodes whose transform changed since the last commit, nullptr if cancelled.
+    QMutex mPendingTransformCommitsMutex;               //!< Guards mPendingTransformCommits while updating in parallel.
+    bool mIsParallelUpdate;                             //!< Whether parallel-safe components are updated on worker threads.
+    bool mIsUpdatingInParallel;                         //!< Whether the worker threads are currently updating components.
+    std::vector<Component*> mPendingDisables;           //!< The components to disable after the parallel update.
+    QMutex mPendingDisablesMutex;                       //!< Guards mPendingDisables while updating in parallel.
+    bool mIsTypedComponentStorage;                      //!< Whether the components are kept in one array per type.
+    std::vector<std::vector<Component*> > mComponentArrays;         //!< One array of component pointers per type.
+    uint32_t mUpdatingArray;                            //!< The index of the array _updateStoredComponents() is walking, or NOT_STORED.
+    uint32_t mUpdatedCount;                             //!< The number of components at the front of mUpdatingArray updated so far.
+    std::map<const QMetaObject*, uint32_t> mComponentArrayIndices;  //!< The index in mComponentArrays for each type.
+    NameMap<std::vector<Node*> > mNodesByName;                      //!< All Nodes of this Scene by name.
+    std::unordered_map<QUuid, Node*, UuidHash> mNodesById;          //!< All Nodes of this Scene that have a uuid.
+    std::unordered_map<uint64_t, Node*> mNodesByRuntimeId;          //!< All Nodes of this Scene by runtime id.
+    CommandBuffer mCommands;                            //!< The structural changes applied at the end of the frame.
+    SpatialIndex::Type mSpatialIndexType;               //!< The data structure of mSpatialIndex.
+    std::unique_ptr<SpatialIndex> mSpatialIndex;        //!< The index of the world positions of all Nodes, or nullptr.
+    std::unique_ptr<SignificanceManager> mSignificance; //!< The scores of the Nodes, or nullptr if no component uses them.
+    std::vector<TickBucket> mTickBuckets;               //!< The scheduled components that are updated regularly.
+    std::vector<Component*> mRequestedUpdates;          //!< The scheduled components to update in the next tick.
+    QMutex mRequestedUpdatesMutex;                      //!< Guards mRequestedUpdates.
+    uint32_t mScheduledComponents;                      //!< The number of components registered with the tick scheduler.
+    uint64_t mTick;                                     //!< The number of ticks so far.
+    double mTime;                                       //!< The time simulated so far.
+    uint64_t mExecutedUpdates;                          //!< The number of updates done by the tick scheduler.
+    uint64_t mSkippedUpdates;                           //!< The number of updates skipped by the tick scheduler.
+    uint32_t mLifecycleBatchDepth;                      //!< The number of open lifecycle batches.
+    bool mIsPhysicsBatch;                               //!< Whether the lifecycle batch opened a batch of the PhysicsWorld.
+    std::vector<Component*> mDeferredSignals;           //!< The components whose signals are deferred, nullptr if cancelled.
+    Ogre::StaticGeometry* mStaticGeometry;              //!< The merged meshes of the baked Nodes, or nullptr.
+    std::vector<MeshComponent*> mStaticMeshes;          //!< The meshes of the baked Nodes.
+    bool mIsStaticGeometryDirty;                        //!< Whether mStaticMeshes changed since the last build.
+
 };
 
 } // namespace dt
@@ -0,0 +1,247 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/SignificanceManager.hpp>
+
+#include <Graphics/CameraComponent.hpp>
+#include <Graphics/DisplayManager.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
+
+#include <OgreCamera.h>
+#include <OgrePlane.h>
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+
+namespace dt {
+
+namespace {
+
+/**
+  * Orders scored Nodes by descending rank.
+  */
+template <typename EntryType>
+bool isMoreSignificant(const EntryType* first, const EntryType* second) {
+    return first->mRank > second->mRank;
+}
+
+/**
+  * Returns whether a sphere is at least partially inside all of the given planes, like Ogre::Frustum::isVisible.
+  */
+bool isInside(const std::vector<Ogre::Plane>& planes, const Ogre::Vector3& center, float radius) {
+    for(auto iter = planes.begin(); iter != planes.end(); ++iter) {
+        if(iter->getDistance(center) < -radius)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SignificanceManager::SignificanceManager(Scene* scene)
+    : mScene(scene),
+      mViewpoint(nullptr),
+      mDormantScreenSize(0.01f),
+      mHiddenWeight(0.25f) {
+    mBudget[HIGH] = 32;
+    mBudget[MEDIUM] = 128;
+    mBudget[LOW] = 0;
+    mBudget[DORMANT] = 0;
+    mTickScales[HIGH] = 1;
+    mTickScales[MEDIUM] = 2;
+    mTickScales[LOW] = 4;
+    mTickScales[DORMANT] = 16;
+    std::fill(mNodeCounts, mNodeCounts + LEVEL_COUNT, 0);
+}
+
+void SignificanceManager::update() {
+    if(mEntries.empty())
+        return;
+
+    // find the viewpoint
+    Node* viewpoint = mViewpoint;
+    float tan_half_fov = std::tan(Ogre::Radian(Ogre::Degree(30)).valueRadians());
+    mFrustumPlanes.clear();
+    CameraComponent* main_camera = DisplayManager::get()->getMainCamera();
+    if(viewpoint == nullptr && main_camera != nullptr && main_camera->getNode() != nullptr
+            && main_camera->getNode()->getScene() == mScene) {
+        viewpoint = main_camera->getNode();
+
+        // the camera may be rendered at the same time, so its state is copied once
+        QMutexLocker lock(DisplayManager::get()->getRenderMutex());
+        Ogre::Camera* camera = main_camera->getCamera();
+        tan_half_fov = std::tan(camera->getFOVy().valueRadians() / 2);
+        const Ogre::Plane* planes = camera->getFrustumPlanes();
+        for(uint32_t i = 0; i < 6; ++i) {
+            // an infinite far plane culls nothing
+            if(i != Ogre::FRUSTUM_PLANE_FAR || camera->getFarClipDistance() != 0)
+                mFrustumPlanes.push_back(planes[i]);
+        }
+    }
+    if(viewpoint == nullptr)
+        return;
+
+    // score the Nodes by the fraction of the screen height they cover
+    const Ogre::Vector3 eye = viewpoint->getPosition(Node::SCENE);
+    mOrder.clear();
+    for(auto iter = mEntries.begin(); iter != mEntries.end(); ++iter) {
+        const Ogre::Vector3 position = iter->mNode->getPosition(Node::SCENE);
+        float distance = std::max(eye.distance(position), iter->mRadius);
+        iter->mScore = iter->mRadius / (distance * tan_half_fov);
+        if(!mFrustumPlanes.empty() && !isInside(mFrustumPlanes, position, iter->mRadius))
+            iter->mScore *= mHiddenWeight;
+
+        // a small bonus for the current level keeps Nodes near a boundary from flickering between two levels
+        iter->mRank = iter->mScore * (1.f + 0.1f * (LEVEL_COUNT - 1 - iter->mLevel));
+        mOrder.push_back(&*iter);
+    }
+
+    // only the best Nodes within the budgets need to be in order
+    uint32_t ranked = std::min<uint32_t>(mBudget[HIGH] + mBudget[MEDIUM], mOrder.size());
+    std::partial_sort(mOrder.begin(), mOrder.begin() + ranked, mOrder.end(), isMoreSignificant<Entry>);
+
+    std::fill(mNodeCounts, mNodeCounts + LEVEL_COUNT, 0);
+    for(uint32_t i = 0; i < mOrder.size(); ++i) {
+        Entry* entry = mOrder[i];
+        Level level = LOW;
+        if(entry->mScore < mDormantScreenSize * (entry->mLevel == DORMANT ? 1.1f : 1.f))
+            level = DORMANT;
+        else if(i < mBudget[HIGH])
+            level = HIGH;
+        else if(i < ranked)
+            level = MEDIUM;
+
+        ++mNodeCounts[level];
+        if(level != entry->mLevel)
+            _setLevel(*entry, level);
+    }
+}
+
+void SignificanceManager::setViewpoint(Node* viewpoint) {
+    mViewpoint = viewpoint;
+}
+
+Node* SignificanceManager::getViewpoint() const {
+    return mViewpoint;
+}
+
+void SignificanceManager::setBudget(uint32_t high, uint32_t medium) {
+    mBudget[HIGH] = high;
+    mBudget[MEDIUM] = medium;
+}
+
+uint32_t SignificanceManager::getBudget(Level level) const {
+    return mBudget[level];
+}
+
+void SignificanceManager::setTickScale(Level level, uint32_t scale) {
+    mTickScales[level] = std::max<uint32_t>(scale, 1);
+    for(auto iter = mEntries.begin(); iter != mEntries.end(); ++iter) {
+        if(iter->mLevel == level)
+            _setLevel(*iter, level);
+    }
+}
+
+uint32_t SignificanceManager::getTickScale(Level level) const {
+    return mTickScales[level];
+}
+
+void SignificanceManager::setDormantScreenSize(float screen_size) {
+    mDormantScreenSize = screen_size;
+}
+
+float SignificanceManager::getDormantScreenSize() const {
+    return mDormantScreenSize;
+}
+
+void SignificanceManager::setHiddenWeight(float weight) {
+    mHiddenWeight = weight;
+}
+
+float SignificanceManager::getHiddenWeight() const {
+    return mHiddenWeight;
+}
+
+void SignificanceManager::setRadius(Node* node, float radius) {
+    auto iter = mEntryIndices.find(node);
+    if(iter != mEntryIndices.end())
+        mEntries[iter->second].mRadius = radius;
+}
+
+float SignificanceManager::getScore(Node* node) const {
+    auto iter = mEntryIndices.find(node);
+    return iter == mEntryIndices.end() ? 0.f : mEntries[iter->second].mScore;
+}
+
+uint32_t SignificanceManager::getNodeCount() const {
+    return mEntries.size();
+}
+
+uint32_t SignificanceManager::getNodeCount(Level level) const {
+    return mNodeCounts[level];
+}
+
+void SignificanceManager::_addComponent(Component* component) {
+    Node* node = component->getNode();
+    auto iter = mEntryIndices.find(node);
+    if(iter == mEntryIndices.end()) {
+        // new Nodes start at full detail until the next update
+        Entry entry;
+        entry.mNode = node;
+        entry.mRadius = 1.f;
+        entry.mScore = 0.f;
+        entry.mRank = 0.f;
+        entry.mLevel = HIGH;
+        iter = mEntryIndices.insert(std::make_pair(node, mEntries.size())).first;
+        mEntries.push_back(entry);
+        ++mNodeCounts[HIGH];
+    }
+
+    Entry& entry = mEntries[iter->second];
+    if(std::find(entry.mComponents.begin(), entry.mComponents.end(), component) == entry.mComponents.end()) {
+        entry.mComponents.push_back(component);
+        component->_setSignificance(entry.mLevel, mTickScales[entry.mLevel]);
+    }
+}
+
+void SignificanceManager::_removeComponent(Component* component) {
+    auto iter = mEntryIndices.find(component->getNode());
+    if(iter == mEntryIndices.end())
+        return;
+
+    Entry& entry = mEntries[iter->second];
+    auto position = std::find(entry.mComponents.begin(), entry.mComponents.end(), component);
+    if(position == entry.mComponents.end())
+        return;
+    entry.mComponents.erase(position);
+    component->_setSignificance(HIGH, 1);
+
+    if(entry.mComponents.empty()) {
+        // swap with the last entry to keep the entries contiguous
+        uint32_t index = iter->second;
+        --mNodeCounts[entry.mLevel];
+        mEntryIndices.erase(iter);
+        if(index != mEntries.size() - 1) {
+            mEntries[index] = mEntries.back();
+            mEntryIndices[mEntries[index].mNode] = index;
+        }
+        mEntries.pop_back();
+    }
+}
+
+void SignificanceManager::_setLevel(Entry& entry, Level level) {
+    entry.mLevel = level;
+    for(auto iter = entry.mComponents.begin(); iter != entry.mComponents.end(); ++iter) {
+        (*iter)->_setSignificance(level, mTickScales[level]);
+    }
+}
+
+} // namespace dt
@@ -0,0 +1,210 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_SIGNIFICANCEMANAGER
+#define DUCTTAPE_ENGINE_SCENE_SIGNIFICANCEMANAGER
+
+#include <Config.hpp>
+
+#include <OgrePlane.h>
+
+#include <QtGlobal>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dt {
+
+// forward declaration
+class CameraComponent;
+class Component;
+class Node;
+class Scene;
+
+/**
+  * Scores the Nodes of a Scene by how much they matter to the player, so that far-away or hidden
+  * Nodes can do less work. Only Nodes with components that opted in are scored.
+  * The score of a Node is the fraction of the screen height it covers, reduced if it is outside the view
+  * frustum. Every frame, the highest scoring Nodes within the budget get the level HIGH, the next ones MEDIUM,
+  * and all others LOW, or DORMANT if they are too small to notice. The components are notified when the level
+  * of their Node changes, and their tick interval is multiplied by the tick scale of the level.
+  * @see Component::setSignificanceEnabled(bool enabled)
+  */
+class DUCTTAPE_API SignificanceManager {
+
+    Q_DISABLE_COPY(SignificanceManager)
+
+public:
+    /**
+      * The significance of a Node, from most to least significant.
+      */
+    enum Level {
+        HIGH = 0,       //!< Full detail.
+        MEDIUM = 1,     //!< Slightly reduced detail.
+        LOW = 2,        //!< Strongly reduced detail.
+        DORMANT = 3,    //!< As little work as possible.
+        LEVEL_COUNT = 4 //!< The number of levels.
+    };
+
+    /**
+      * Constructor.
+      * @param scene The Scene whose Nodes are scored.
+      */
+    SignificanceManager(Scene* scene);
+
+    /**
+      * Scores all Nodes and notifies the components whose level changed. Called by the Scene at the beginning of every frame.
+      */
+    void update();
+
+    /**
+      * Sets the Node the significance is measured from. Without a viewpoint, the main camera of the
+      * DisplayManager is used if it is part of the Scene. Without a camera, all Nodes count as visible
+      * and a vertical field of view of 60 degrees is assumed.
+      * @param viewpoint The Node, or nullptr to use the main camera.
+      */
+    void setViewpoint(Node* viewpoint);
+
+    /**
+      * Returns the Node the significance is measured from.
+      * @returns The Node, or nullptr if the main camera is used.
+      */
+    Node* getViewpoint() const;
+
+    /**
+      * Sets the number of Nodes that may be at the levels HIGH and MEDIUM. Default: 32 and 128.
+      * @param high The number of Nodes at the level HIGH.
+      * @param medium The number of Nodes at the level MEDIUM.
+      */
+    void setBudget(uint32_t high, uint32_t medium);
+
+    /**
+      * Returns the number of Nodes that may be at a level.
+      * @param level HIGH or MEDIUM.
+      * @returns The number of Nodes.
+      */
+    uint32_t getBudget(Level level) const;
+
+    /**
+      * Sets the factor the tick interval of the components is multiplied with at a level.
+      * Default: 1 for HIGH, 2 for MEDIUM, 4 for LOW and 16 for DORMANT.
+      * @param level The level.
+      * @param scale The factor.
+      * @see Component::setTickInterval(uint32_t ticks)
+      */
+    void setTickScale(Level level, uint32_t scale);
+
+    /**
+      * Returns the factor the tick interval of the components is multiplied with at a level.
+      * @param level The level.
+      * @returns The factor.
+      */
+    uint32_t getTickScale(Level level) const;
+
+    /**
+      * Sets the score below which Nodes are DORMANT, as a fraction of the screen height. Default: 0.01.
+      * @param screen_size The fraction of the screen height.
+      */
+    void setDormantScreenSize(float screen_size);
+
+    /**
+      * Returns the score below which Nodes are DORMANT.
+      * @returns The fraction of the screen height.
+      */
+    float getDormantScreenSize() const;
+
+    /**
+      * Sets the factor the score of Nodes outside the view frustum is multiplied with. Default: 0.25.
+      * @param weight The factor.
+      */
+    void setHiddenWeight(float weight);
+
+    /**
+      * Returns the factor the score of Nodes outside the view frustum is multiplied with.
+      * @returns The factor.
+      */
+    float getHiddenWeight() const;
+
+    /**
+      * Sets the radius of a Node, which determines how much of the screen it covers. Default: 1.
+      * @param node The Node. It has to have a component that opted in.
+      * @param radius The radius.
+      */
+    void setRadius(Node* node, float radius);
+
+    /**
+      * Returns the last score of a Node.
+      * @param node The Node.
+      * @returns The fraction of the screen height it covers, weighted by its visibility, or 0 if it is not scored.
+      */
+    float getScore(Node* node) const;
+
+    /**
+      * Returns the number of Nodes that are scored.
+      * @returns The number of Nodes.
+      */
+    uint32_t getNodeCount() const;
+
+    /**
+      * Returns the number of Nodes at a level.
+      * @param level The level.
+      * @returns The number of Nodes.
+      */
+    uint32_t getNodeCount(Level level) const;
+
+    /**
+      * Starts scoring the Node of a component.
+      * @internal
+      * @param component The component.
+      */
+    void _addComponent(Component* component);
+
+    /**
+      * Stops scoring the Node of a component, if it has no other components that opted in.
+      * @internal
+      * @param component The component.
+      */
+    void _removeComponent(Component* component);
+
+private:
+    /**
+      * A scored Node.
+      */
+    struct Entry {
+        Node* mNode;                            //!< The Node.
+        std::vector<Component*> mComponents;    //!< The components of the Node that opted in.
+        float mRadius;                          //!< The radius of the Node.
+        float mScore;                           //!< The score of the last update.
+        float mRank;                            //!< The score the Nodes are ordered by.
+        Level mLevel;                           //!< The level of the last update.
+    };
+
+    /**
+      * Changes the level of a Node and notifies its components.
+      * @param entry The Node.
+      * @param level The new level.
+      */
+    void _setLevel(Entry& entry, Level level);
+
+    Scene* mScene;                                      //!< The Scene whose Nodes are scored.
+    Node* mViewpoint;                                   //!< The Node the significance is measured from, or nullptr.
+    uint32_t mBudget[LEVEL_COUNT];                      //!< The number of Nodes allowed at each level.
+    uint32_t mTickScales[LEVEL_COUNT];                  //!< The factor for the tick interval at each level.
+    uint32_t mNodeCounts[LEVEL_COUNT];                  //!< The number of Nodes at each level.
+    float mDormantScreenSize;                           //!< The score below which Nodes are DORMANT.
+    float mHiddenWeight;                                //!< The factor for the score of Nodes outside the view frustum.
+    std::vector<Entry> mEntries;                        //!< The scored Nodes.
+    std::unordered_map<Node*, uint32_t> mEntryIndices;  //!< The index in mEntries of each scored Node.
+    std::vector<Entry*> mOrder;                         //!< The scored Nodes, ordered by rank during the update.
+    std::vector<Ogre::Plane> mFrustumPlanes;            //!< The view frustum of the main camera, copied during the update.
+
+};
+
+} // namespace dt
+
+#endif
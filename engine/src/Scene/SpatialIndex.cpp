@@ -0,0 +1,163 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/SpatialIndex.hpp>
+
+#include <Scene/Node.hpp>
+
+namespace dt {
+
+const uint32_t SpatialIndex::INVALID_PROXY = 0xffffffff;
+
+SpatialIndex::SpatialIndex() {}
+
+SpatialIndex::~SpatialIndex() {}
+
+uint32_t SpatialIndex::insert(Node* node, const Ogre::Vector3& position) {
+    uint32_t proxy;
+    if(mFreeProxies.empty()) {
+        proxy = mNodes.size();
+        mNodes.push_back(node);
+        mPositions.push_back(position);
+    } else {
+        proxy = mFreeProxies.back();
+        mFreeProxies.pop_back();
+        mNodes[proxy] = node;
+        mPositions[proxy] = position;
+    }
+    _insertProxy(proxy);
+    return proxy;
+}
+
+void SpatialIndex::remove(uint32_t proxy) {
+    _removeProxy(proxy);
+    mNodes[proxy] = nullptr;
+    mFreeProxies.push_back(proxy);
+}
+
+void SpatialIndex::move(uint32_t proxy, const Ogre::Vector3& position) {
+    if(mPositions[proxy] == position)
+        return;
+
+    mPositions[proxy] = position;
+    _moveProxy(proxy);
+}
+
+void SpatialIndex::update() {
+    for(uint32_t proxy = 0; proxy < mNodes.size(); ++proxy) {
+        if(mNodes[proxy] != nullptr)
+            move(proxy, mNodes[proxy]->getPosition(Node::SCENE));
+    }
+}
+
+uint32_t SpatialIndex::getSize() const {
+    return mNodes.size() - mFreeProxies.size();
+}
+
+Node* SpatialIndex::getNode(uint32_t proxy) const {
+    return mNodes[proxy];
+}
+
+const Ogre::Vector3& SpatialIndex::getPosition(uint32_t proxy) const {
+    return mPositions[proxy];
+}
+
+void SpatialIndex::queryBox(const Ogre::AxisAlignedBox& box, std::vector<Node*>& result) const {
+    result.clear();
+    if(box.isNull())
+        return;
+
+    mQueryProxies.clear();
+    if(box.isInfinite()) {
+        for(uint32_t proxy = 0; proxy < mNodes.size(); ++proxy) {
+            if(mNodes[proxy] != nullptr)
+                mQueryProxies.push_back(proxy);
+        }
+    } else {
+        _queryBox(box.getMinimum(), box.getMaximum(), mQueryProxies);
+    }
+    _resolve(mQueryProxies, result);
+}
+
+void SpatialIndex::queryRadius(const Ogre::Vector3& center, float radius, std::vector<Node*>& result) const {
+    mQueryProxies.clear();
+    _queryRadius(center, radius, mQueryProxies);
+    _resolve(mQueryProxies, result);
+}
+
+void SpatialIndex::queryNearest(const Ogre::Vector3& point, uint32_t count, std::vector<Node*>& result) const {
+    mQueryProxies.clear();
+    if(count > 0)
+        _queryNearest(point, count, mQueryProxies);
+    _resolve(mQueryProxies, result);
+}
+
+void SpatialIndex::queryVolume(const Ogre::PlaneBoundedVolume& volume, std::vector<Node*>& result) const {
+    mQueryProxies.clear();
+    _queryVolume(volume, mQueryProxies);
+    _resolve(mQueryProxies, result);
+}
+
+void SpatialIndex::queryFrustum(const Ogre::Frustum& frustum, std::vector<Node*>& result) const {
+    // the frustum planes point inwards
+    Ogre::PlaneBoundedVolume volume(Ogre::Plane::NEGATIVE_SIDE);
+    for(unsigned short i = 0; i < 6; ++i) {
+        volume.planes.push_back(frustum.getFrustumPlane(i));
+    }
+    queryVolume(volume, result);
+}
+
+void SpatialIndex::queryRadius(const std::vector<Ogre::Vector3>& centers, float radius,
+                               std::vector<std::vector<Node*> >& results) const {
+    results.resize(centers.size());
+    for(uint32_t i = 0; i < centers.size(); ++i) {
+        queryRadius(centers[i], radius, results[i]);
+    }
+}
+
+void SpatialIndex::queryNearest(const std::vector<Ogre::Vector3>& points, uint32_t count,
+                                std::vector<std::vector<Node*> >& results) const {
+    results.resize(points.size());
+    for(uint32_t i = 0; i < points.size(); ++i) {
+        queryNearest(points[i], count, results[i]);
+    }
+}
+
+float SpatialIndex::_squaredDistance(const Ogre::Vector3& point, const Ogre::Vector3& min, const Ogre::Vector3& max) {
+    // the distance to the closest point of the box
+    Ogre::Vector3 closest = point;
+    closest.makeCeil(min);
+    closest.makeFloor(max);
+    return point.squaredDistance(closest);
+}
+
+bool SpatialIndex::_isOutside(const Ogre::PlaneBoundedVolume& volume, const Ogre::Vector3& min, const Ogre::Vector3& max) {
+    Ogre::Vector3 center = (min + max) * 0.5f;
+    Ogre::Vector3 half_size = (max - min) * 0.5f;
+    for(auto plane = volume.planes.begin(); plane != volume.planes.end(); ++plane) {
+        if(plane->getSide(center, half_size) == volume.outside)
+            return true;
+    }
+    return false;
+}
+
+bool SpatialIndex::_isOutside(const Ogre::PlaneBoundedVolume& volume, const Ogre::Vector3& point) {
+    for(auto plane = volume.planes.begin(); plane != volume.planes.end(); ++plane) {
+        if(plane->getSide(point) == volume.outside)
+            return true;
+    }
+    return false;
+}
+
+void SpatialIndex::_resolve(const std::vector<uint32_t>& proxies, std::vector<Node*>& result) const {
+    result.resize(proxies.size());
+    for(uint32_t i = 0; i < proxies.size(); ++i) {
+        result[i] = mNodes[proxies[i]];
+    }
+}
+
+} // namespace dt
@@ -0,0 +1,253 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_SPATIALINDEX
+#define DUCTTAPE_ENGINE_SCENE_SPATIALINDEX
+
+#include <Config.hpp>
+
+#include <OgreAxisAlignedBox.h>
+#include <OgreFrustum.h>
+#include <OgrePlaneBoundedVolume.h>
+#include <OgreVector3.h>
+
+#include <QtGlobal>
+
+#include <cstdint>
+#include <vector>
+
+namespace dt {
+
+class Node;
+
+/**
+  * An index of the world positions of Nodes, answering range, nearest-neighbour and frustum queries
+  * without looking at every Node. Every indexed Node is represented by a proxy, which stores the
+  * position the Node had when it was last inserted or moved.
+  * The subclasses implement the actual data structure. The queries share internal buffers, so they
+  * must not be called from several threads at once.
+  * @see Scene::setSpatialIndex(SpatialIndex::Type type)
+  */
+class DUCTTAPE_API SpatialIndex {
+
+    Q_DISABLE_COPY(SpatialIndex)
+
+public:
+    /**
+      * The available data structures.
+      */
+    enum Type {
+        NONE,           //!< No spatial index.
+        LOOSE_OCTREE,   //!< A LooseOctree. Cheap to build and update, best for Nodes spread over the world.
+        AABB_TREE       //!< An AabbTree. Has no cell size, so it adapts to Nodes that are clustered or far apart.
+    };
+
+    static const uint32_t INVALID_PROXY;    //!< The proxy for "not indexed".
+
+    virtual ~SpatialIndex();
+
+    /**
+      * Adds a Node to the index.
+      * @param node The Node.
+      * @param position The world position of the Node.
+      * @returns The proxy of the Node.
+      */
+    uint32_t insert(Node* node, const Ogre::Vector3& position);
+
+    /**
+      * Removes a Node from the index.
+      * @param proxy The proxy of the Node.
+      */
+    void remove(uint32_t proxy);
+
+    /**
+      * Changes the position of a Node in the index.
+      * @param proxy The proxy of the Node.
+      * @param position The new world position of the Node.
+      */
+    void move(uint32_t proxy, const Ogre::Vector3& position);
+
+    /**
+      * Reads the world positions of all indexed Nodes and moves the proxies of the Nodes that have moved.
+      * The Scene only moves the Nodes in its TransformJournal at the end of every frame, so call this after
+      * changing transforms through the bulk setters of the TransformPool.
+      */
+    void update();
+
+    /**
+      * Returns the number of indexed Nodes.
+      * @returns The number of indexed Nodes.
+      */
+    uint32_t getSize() const;
+
+    /**
+      * Returns the Node of a proxy.
+      * @param proxy The proxy.
+      * @returns The Node.
+      */
+    Node* getNode(uint32_t proxy) const;
+
+    /**
+      * Returns the indexed position of a proxy.
+      * @param proxy The proxy.
+      * @returns The position of the Node at the last update.
+      */
+    const Ogre::Vector3& getPosition(uint32_t proxy) const;
+
+    /**
+      * Finds all Nodes inside a box.
+      * @param box The box.
+      * @param result Is filled with the Nodes, in no particular order.
+      */
+    void queryBox(const Ogre::AxisAlignedBox& box, std::vector<Node*>& result) const;
+
+    /**
+      * Finds all Nodes inside a sphere.
+      * @param center The center of the sphere.
+      * @param radius The radius of the sphere.
+      * @param result Is filled with the Nodes, in no particular order.
+      */
+    void queryRadius(const Ogre::Vector3& center, float radius, std::vector<Node*>& result) const;
+
+    /**
+      * Finds the Nodes closest to a point.
+      * @param point The point.
+      * @param count The maximum number of Nodes to find.
+      * @param result Is filled with the Nodes, sorted by their distance to the point.
+      */
+    void queryNearest(const Ogre::Vector3& point, uint32_t count, std::vector<Node*>& result) const;
+
+    /**
+      * Finds all Nodes inside a convex volume.
+      * @param volume The volume.
+      * @param result Is filled with the Nodes, in no particular order.
+      */
+    void queryVolume(const Ogre::PlaneBoundedVolume& volume, std::vector<Node*>& result) const;
+
+    /**
+      * Finds all Nodes inside a frustum, e.g. the view frustum of a camera.
+      * @param frustum The frustum.
+      * @param result Is filled with the Nodes, in no particular order.
+      */
+    void queryFrustum(const Ogre::Frustum& frustum, std::vector<Node*>& result) const;
+
+    /**
+      * Finds all Nodes inside a sphere, for many spheres at once.
+      * @param centers The centers of the spheres.
+      * @param radius The radius of the spheres.
+      * @param results Is filled with one list of Nodes per sphere.
+      */
+    void queryRadius(const std::vector<Ogre::Vector3>& centers, float radius, std::vector<std::vector<Node*> >& results) const;
+
+    /**
+      * Finds the Nodes closest to a point, for many points at once.
+      * @param points The points.
+      * @param count The maximum number of Nodes to find per point.
+      * @param results Is filled with one list of Nodes per point, each sorted by distance.
+      */
+    void queryNearest(const std::vector<Ogre::Vector3>& points, uint32_t count, std::vector<std::vector<Node*> >& results) const;
+
+protected:
+    /**
+      * Default constructor.
+      */
+    SpatialIndex();
+
+    /**
+      * Adds a new proxy to the data structure. Its Node and position are already set.
+      * @param proxy The proxy.
+      */
+    virtual void _insertProxy(uint32_t proxy) = 0;
+
+    /**
+      * Removes a proxy from the data structure. Its Node and position are still set.
+      * @param proxy The proxy.
+      */
+    virtual void _removeProxy(uint32_t proxy) = 0;
+
+    /**
+      * Updates a proxy whose position changed. The new position is already set.
+      * @param proxy The proxy.
+      */
+    virtual void _moveProxy(uint32_t proxy) = 0;
+
+    /**
+      * Collects the proxies inside a box.
+      * @param min The minimum corner of the box.
+      * @param max The maximum corner of the box.
+      * @param result Receives the proxies.
+      */
+    virtual void _queryBox(const Ogre::Vector3& min, const Ogre::Vector3& max, std::vector<uint32_t>& result) const = 0;
+
+    /**
+      * Collects the proxies inside a sphere.
+      * @param center The center of the sphere.
+      * @param radius The radius of the sphere.
+      * @param result Receives the proxies.
+      */
+    virtual void _queryRadius(const Ogre::Vector3& center, float radius, std::vector<uint32_t>& result) const = 0;
+
+    /**
+      * Collects the proxies closest to a point.
+      * @param point The point.
+      * @param count The maximum number of proxies.
+      * @param result Receives the proxies, sorted by distance.
+      */
+    virtual void _queryNearest(const Ogre::Vector3& point, uint32_t count, std::vector<uint32_t>& result) const = 0;
+
+    /**
+      * Collects the proxies inside a convex volume.
+      * @param volume The volume.
+      * @param result Receives the proxies.
+      */
+    virtual void _queryVolume(const Ogre::PlaneBoundedVolume& volume, std::vector<uint32_t>& result) const = 0;
+
+    /**
+      * Returns the squared distance between a point and a box.
+      * @param point The point.
+      * @param min The minimum corner of the box.
+      * @param max The maximum corner of the box.
+      * @returns The squared distance, 0 if the point is inside the box.
+      */
+    static float _squaredDistance(const Ogre::Vector3& point, const Ogre::Vector3& min, const Ogre::Vector3& max);
+
+    /**
+      * Returns whether a box is completely outside of a convex volume.
+      * @param volume The volume.
+      * @param min The minimum corner of the box.
+      * @param max The maximum corner of the box.
+      * @returns Whether the box is outside.
+      */
+    static bool _isOutside(const Ogre::PlaneBoundedVolume& volume, const Ogre::Vector3& min, const Ogre::Vector3& max);
+
+    /**
+      * Returns whether a point is outside of a convex volume.
+      * @param volume The volume.
+      * @param point The point.
+      * @returns Whether the point is outside.
+      */
+    static bool _isOutside(const Ogre::PlaneBoundedVolume& volume, const Ogre::Vector3& point);
+
+    std::vector<Node*> mNodes;              //!< The Node of each proxy, nullptr for unused proxies.
+    std::vector<Ogre::Vector3> mPositions;  //!< The indexed position of each proxy.
+
+private:
+    /**
+      * Converts proxies to Nodes.
+      * @param proxies The proxies.
+      * @param result Is filled with their Nodes.
+      */
+    void _resolve(const std::vector<uint32_t>& proxies, std::vector<Node*>& result) const;
+
+    std::vector<uint32_t> mFreeProxies;             //!< The unused proxies.
+    mutable std::vector<uint32_t> mQueryProxies;    //!< The query result before it is resolved, kept to avoid allocations.
+
+};
+
+} // namespace dt
+
+#endif
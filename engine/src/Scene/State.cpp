@@ -8,6 +8,7 @@
 
 #include <Scene/State.hpp>
 #include <Logic/ScriptManager.hpp>
+#include <Utils/Profiler.hpp>
 
 namespace dt {
 
@@ -57,6 +58,8 @@ void State::deleteScene(const QString name) {
 }
 
 void State::updateFrame(double simulation_frame_time) {
+    DUCTTAPE_PROFILE_ZONE("State::updateFrame");
+
     updateSceneFrame(simulation_frame_time);
     updateStateFrame(simulation_frame_time);
 }
@@ -57,8 +57,9 @@ bool StateManager::shiftStates() {
         }
         mStates.push_back(mNewState);
         getCurrentState()->initialize();
+        // the simulation may run on a job worker, a queued call would never be delivered
         QObject::connect(this,              SIGNAL(beginFrame(double)),
-                         getCurrentState(), SLOT(updateFrame(double)));
+                         getCurrentState(), SLOT(updateFrame(double)), Qt::DirectConnection);
         mHasNewState = false;
     }
 
@@ -0,0 +1,391 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/StreamingComponent.hpp>
+
+#include <Network/IOPacket.hpp>
+#include <Scene/Prefab.hpp>
+#include <Scene/Scene.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/Network/Packet.hpp>
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutexLocker>
+#include <QRunnable>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+
+namespace dt {
+
+namespace {
+
+/**
+  * Reads a cell file on the background thread.
+  */
+class LoadCellTask : public QRunnable {
+public:
+    LoadCellTask(std::function<void()> load)
+        : mLoad(load) {}
+
+    void run() {
+        mLoad();
+    }
+
+private:
+    std::function<void()> mLoad;
+};
+
+/**
+  * Orders cells by their distance to the nearest focus.
+  */
+template <typename CellType>
+bool isCloser(const CellType* first, const CellType* second) {
+    return first->mDistance < second->mDistance;
+}
+
+} // namespace
+
+StreamingComponent::StreamingComponent(const QString directory, float cell_size, const QString name)
+    : Component(name),
+      mDirectory(directory),
+      mCellSize(cell_size),
+      mLoadRadius(300.f),
+      mUnloadRadius(400.f),
+      mFileSizeBudget(0),
+      mAttachBudget(1),
+      mPendingLoads(0) {
+    // one thread keeps the disk access sequential, the main thread is never blocked by it
+    mLoader.setMaxThreadCount(1);
+}
+
+StreamingComponent::~StreamingComponent() {
+    mLoader.waitForDone();
+}
+
+void StreamingComponent::onInitialize() {}
+
+void StreamingComponent::onDeinitialize() {
+    mLoader.waitForDone();
+    mLoaded.clear();
+    mPendingLoads = 0;
+
+    while(!mCells.empty()) {
+        _unloadCell(mCells.begin());
+    }
+}
+
+void StreamingComponent::onUpdate(double time_diff) {
+    _stream(false);
+}
+
+uint32_t StreamingComponent::saveCells(Node* root, const QString directory, float cell_size) {
+    std::map<uint64_t, std::vector<Node*> > cells;
+    for(auto iter = root->mChildren.begin(); iter != root->mChildren.end(); ++iter) {
+        Ogre::Vector3 position = iter->second->getPosition();
+        int32_t x = static_cast<int32_t>(std::floor(position.x / cell_size));
+        int32_t z = static_cast<int32_t>(std::floor(position.z / cell_size));
+        cells[_getKey(x, z)].push_back(iter->second.get());
+    }
+
+    uint32_t count = 0;
+    for(auto cell = cells.begin(); cell != cells.end(); ++cell) {
+        sf::Packet data;
+        IOPacket packet(&data, IOPacket::SERIALIZE);
+        packet.beginList(cell->second.size(), "nodes");
+        for(auto node = cell->second.begin(); node != cell->second.end(); ++node) {
+            packet.beginObject();
+            (*node)->serialize(packet);
+            packet.endObject();
+        }
+        packet.endList();
+
+        int32_t x = static_cast<int32_t>(cell->first >> 32);
+        int32_t z = static_cast<int32_t>(cell->first & 0xffffffff);
+        QFile file(_getFileName(directory, x, z));
+        if(!file.open(QIODevice::WriteOnly)) {
+            Logger::get().error("Cannot open cell file " + file.fileName() + " for writing.");
+            continue;
+        }
+        file.write(static_cast<const char*>(data.getData()), data.getDataSize());
+        file.close();
+        ++count;
+    }
+    return count;
+}
+
+void StreamingComponent::addFocus(Node* node) {
+    if(std::find(mFoci.begin(), mFoci.end(), node) == mFoci.end()) {
+        mFoci.push_back(node);
+        QObject::connect(node, SIGNAL(destroyed(QObject*)), this, SLOT(onFocusDestroyed(QObject*)));
+    }
+}
+
+void StreamingComponent::removeFocus(Node* node) {
+    auto iter = std::find(mFoci.begin(), mFoci.end(), node);
+    if(iter != mFoci.end()) {
+        mFoci.erase(iter);
+        QObject::disconnect(node, SIGNAL(destroyed(QObject*)), this, SLOT(onFocusDestroyed(QObject*)));
+    }
+}
+
+void StreamingComponent::setLoadRadius(float load_radius) {
+    mLoadRadius = load_radius;
+    mUnloadRadius = std::max(mUnloadRadius, load_radius);
+}
+
+float StreamingComponent::getLoadRadius() const {
+    return mLoadRadius;
+}
+
+void StreamingComponent::setUnloadRadius(float unload_radius) {
+    mUnloadRadius = std::max(unload_radius, mLoadRadius);
+}
+
+float StreamingComponent::getUnloadRadius() const {
+    return mUnloadRadius;
+}
+
+void StreamingComponent::setFileSizeBudget(uint64_t bytes) {
+    mFileSizeBudget = bytes;
+}
+
+uint64_t StreamingComponent::getFileSizeBudget() const {
+    return mFileSizeBudget;
+}
+
+void StreamingComponent::setAttachBudget(uint32_t cells) {
+    mAttachBudget = cells;
+}
+
+uint32_t StreamingComponent::getAttachBudget() const {
+    return mAttachBudget;
+}
+
+StreamingComponent::CellState StreamingComponent::getCellState(int32_t x, int32_t z) const {
+    auto iter = mCells.find(_getKey(x, z));
+    return iter == mCells.end() ? UNLOADED : iter->second.mState;
+}
+
+uint32_t StreamingComponent::getAttachedCellCount() const {
+    uint32_t count = 0;
+    for(auto iter = mCells.begin(); iter != mCells.end(); ++iter) {
+        if(iter->second.mState == ATTACHED)
+            ++count;
+    }
+    return count;
+}
+
+uint64_t StreamingComponent::getLoadedFileSize() const {
+    uint64_t usage = 0;
+    for(auto iter = mCells.begin(); iter != mCells.end(); ++iter) {
+        usage += iter->second.mSize;
+    }
+    return usage;
+}
+
+void StreamingComponent::flush() {
+    _stream(true);
+    while(mPendingLoads > 0) {
+        mLoader.waitForDone();
+        _stream(true);
+    }
+}
+
+void StreamingComponent::onFocusDestroyed(QObject* focus) {
+    // the Node part of the focus is already gone, only the pointer is compared
+    auto iter = std::find(mFoci.begin(), mFoci.end(), static_cast<Node*>(focus));
+    if(iter != mFoci.end())
+        mFoci.erase(iter);
+}
+
+void StreamingComponent::_stream(bool blocking) {
+    // collect the cells read since the last update, cells unloaded in the meantime are dropped
+    std::vector<LoadResult> loaded;
+    {
+        QMutexLocker lock(&mLoadedMutex);
+        loaded.swap(mLoaded);
+    }
+    for(auto result = loaded.begin(); result != loaded.end(); ++result) {
+        --mPendingLoads;
+        auto iter = mCells.find(result->mKey);
+        if(iter != mCells.end() && iter->second.mState == LOADING) {
+            iter->second.mState = LOADED;
+            iter->second.mSize = result->mSize;
+            iter->second.mData = result->mData;
+        }
+    }
+
+    // the focus positions relative to the Node the cells are attached to
+    std::vector<Ogre::Vector3> foci;
+    const Ogre::Vector3 origin = getNode()->getPosition(Node::SCENE);
+    for(auto iter = mFoci.begin(); iter != mFoci.end(); ++iter) {
+        foci.push_back((*iter)->getPosition(Node::SCENE) - origin);
+    }
+
+    // unload the cells beyond the unload radius
+    uint64_t usage = 0;
+    for(auto iter = mCells.begin(); iter != mCells.end();) {
+        Cell& cell = iter->second;
+        cell.mDistance = std::numeric_limits<float>::max();
+        for(auto focus = foci.begin(); focus != foci.end(); ++focus) {
+            cell.mDistance = std::min(cell.mDistance, _getDistance(cell.mX, cell.mZ, *focus));
+        }
+
+        if(cell.mDistance > mUnloadRadius) {
+            _unloadCell(iter++);
+        } else {
+            usage += cell.mSize;
+            ++iter;
+        }
+    }
+
+    // over the budget, unload the farthest cells that are kept only because of the hysteresis
+    if(mFileSizeBudget > 0 && usage > mFileSizeBudget) {
+        std::vector<Cell*> evictable;
+        for(auto iter = mCells.begin(); iter != mCells.end(); ++iter) {
+            if(iter->second.mDistance > mLoadRadius && iter->second.mState != LOADING)
+                evictable.push_back(&iter->second);
+        }
+        std::sort(evictable.begin(), evictable.end(), isCloser<Cell>);
+        while(usage > mFileSizeBudget && !evictable.empty()) {
+            Cell* cell = evictable.back();
+            evictable.pop_back();
+            usage -= cell->mSize;
+            _unloadCell(mCells.find(_getKey(cell->mX, cell->mZ)));
+        }
+    }
+
+    // request the missing cells within the load radius, nearest first
+    std::vector<Cell> missing;
+    for(auto focus = foci.begin(); focus != foci.end(); ++focus) {
+        int32_t min_x = static_cast<int32_t>(std::floor((focus->x - mLoadRadius) / mCellSize));
+        int32_t max_x = static_cast<int32_t>(std::floor((focus->x + mLoadRadius) / mCellSize));
+        int32_t min_z = static_cast<int32_t>(std::floor((focus->z - mLoadRadius) / mCellSize));
+        int32_t max_z = static_cast<int32_t>(std::floor((focus->z + mLoadRadius) / mCellSize));
+        for(int32_t x = min_x; x <= max_x; ++x) {
+            for(int32_t z = min_z; z <= max_z; ++z) {
+                float distance = _getDistance(x, z, *focus);
+                if(distance <= mLoadRadius && mCells.count(_getKey(x, z)) == 0) {
+                    Cell cell = {x, z, LOADING, 0, distance, QByteArray(), 0};
+                    missing.push_back(cell);
+                }
+            }
+        }
+    }
+    std::vector<const Cell*> requests;
+    for(auto iter = missing.begin(); iter != missing.end(); ++iter) {
+        requests.push_back(&*iter);
+    }
+    std::sort(requests.begin(), requests.end(), isCloser<Cell>);
+
+    // a short queue keeps the background thread working on the cells that are still needed
+    const uint32_t max_pending_loads = blocking ? std::numeric_limits<uint32_t>::max() : 4;
+    for(auto iter = requests.begin(); iter != requests.end() && mPendingLoads < max_pending_loads; ++iter) {
+        if(mFileSizeBudget > 0 && usage >= mFileSizeBudget)
+            break;
+
+        uint64_t key = _getKey((*iter)->mX, (*iter)->mZ);
+        if(mCells.count(key) > 0)
+            continue;   // requested for another focus
+
+        mCells.insert(std::make_pair(key, **iter));
+        ++mPendingLoads;
+        mLoader.start(new LoadCellTask(std::bind(&StreamingComponent::_loadCell, this, key,
+                                                 _getFileName(mDirectory, (*iter)->mX, (*iter)->mZ))));
+    }
+
+    // attach the loaded cells, nearest first
+    std::vector<Cell*> attachable;
+    for(auto iter = mCells.begin(); iter != mCells.end(); ++iter) {
+        if(iter->second.mState == LOADED)
+            attachable.push_back(&iter->second);
+    }
+    std::sort(attachable.begin(), attachable.end(), isCloser<Cell>);
+    if(!blocking && attachable.size() > mAttachBudget)
+        attachable.resize(mAttachBudget);
+
+    Scene* scene = getNode()->getScene();
+    for(auto iter = attachable.begin(); iter != attachable.end(); ++iter) {
+        Cell* cell = *iter;
+        cell->mState = ATTACHED;
+        if(cell->mData.isEmpty())
+            continue;   // there is no file for this cell
+
+        // the components are created at the end of the frame, together with all other structural changes
+        QByteArray data = cell->mData;
+        cell->mData.clear();
+        Node* cell_node = new Node("cell_" + Utils::toString(cell->mX) + "_" + Utils::toString(cell->mZ));
+        cell->mNodeId = cell_node->getRuntimeId();
+        scene->getCommandBuffer().spawn(getNode(), cell_node, [data](Node::NodeSP node) {
+            _attachCell(data, node.get());
+        });
+    }
+}
+
+void StreamingComponent::_loadCell(uint64_t key, const QString file_name) {
+    LoadResult result = {key, 0, QByteArray()};
+
+    QFile file(file_name);
+    if(file.exists() && file.open(QIODevice::ReadOnly)) {
+        result.mData = file.readAll();
+        result.mSize = result.mData.size();
+        file.close();
+    }
+
+    QMutexLocker lock(&mLoadedMutex);
+    mLoaded.push_back(result);
+}
+
+void StreamingComponent::_attachCell(const QByteArray& data, Node* node) {
+    sf::Packet packet_data;
+    packet_data.append(data.constData(), data.size());
+    IOPacket packet(&packet_data, IOPacket::DESERIALIZE);
+
+    // the cell is instantiated once, so the prototypes are moved into the Nodes instead of being cloned
+    Prefab prefab(node->getName());
+    uint32_t count = packet.beginList(0, "nodes");
+    for(uint32_t i = 0; i < count; ++i) {
+        packet.beginObject();
+        prefab.addChild(new Prefab)->deserialize(packet);
+        packet.endObject();
+    }
+    packet.endList();
+    prefab.moveTo(node);
+}
+
+void StreamingComponent::_unloadCell(std::unordered_map<uint64_t, Cell>::iterator iter) {
+    // a LOADING cell is dropped once the background thread is done with it
+    Scene* scene = getNode()->getScene();
+    // the Node may have been removed by someone else meanwhile, it is only looked up when the buffer is applied
+    if(iter->second.mNodeId != 0 && scene != nullptr)
+        scene->getCommandBuffer().kill(iter->second.mNodeId);
+    mCells.erase(iter);
+}
+
+float StreamingComponent::_getDistance(int32_t x, int32_t z, const Ogre::Vector3& point) const {
+    float dx = std::max(std::max(x * mCellSize - point.x, point.x - (x + 1) * mCellSize), 0.f);
+    float dz = std::max(std::max(z * mCellSize - point.z, point.z - (z + 1) * mCellSize), 0.f);
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+uint64_t StreamingComponent::_getKey(int32_t x, int32_t z) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+QString StreamingComponent::_getFileName(const QString& directory, int32_t x, int32_t z) {
+    QString name = "cell_" + Utils::toString(x) + "_" + Utils::toString(z) + ".dtcell";
+    return directory.isEmpty() ? name : directory + "/" + name;
+}
+
+} // namespace dt
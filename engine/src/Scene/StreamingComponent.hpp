@@ -0,0 +1,265 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_STREAMINGCOMPONENT
+#define DUCTTAPE_ENGINE_SCENE_STREAMINGCOMPONENT
+
+#include <Config.hpp>
+
+#include <Scene/Component.hpp>
+#include <Scene/Node.hpp>
+
+#include <OgreVector3.h>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dt {
+
+/**
+  * Streams the Nodes of a large world in square cells around one or more focus Nodes, e.g. the camera and
+  * the players. The cells lie on the x/z plane of the Node this component is added to, usually the Scene,
+  * and every cell is stored in a file of its own (see saveCells()).
+  * The files of the cells within the load radius of a focus are read on a background thread. The main thread
+  * parses them and creates the Nodes and components when it attaches a cell, a few cells per frame, as the
+  * constructors of the components may use the engine. Cells are unloaded once they are farther than the unload
+  * radius from every focus, so moving back and forth along a cell border does not reload them. If the files of
+  * the cells in memory exceed the file size budget, the farthest cells outside the load radius are unloaded early
+  * and no more cells are loaded until there is room again.
+  * Changes to streamed Nodes are lost when their cell is unloaded.
+  */
+class DUCTTAPE_API StreamingComponent : public Component {
+    Q_OBJECT
+public:
+    /**
+      * The state of a cell.
+      */
+    enum CellState {
+        UNLOADED,   //!< The cell is not in memory.
+        LOADING,    //!< The cell file is being read on the background thread.
+        LOADED,     //!< The cell file has been read and waits to be attached.
+        ATTACHED    //!< The Nodes of the cell have been added to the Scene.
+    };
+
+    /**
+      * Constructor.
+      * @param directory The directory with the cell files.
+      * @param cell_size The edge length of a cell. Must be the one the cells were saved with.
+      * @param name The name of the component.
+      */
+    StreamingComponent(const QString directory = "", float cell_size = 100.f, const QString name = "");
+
+    ~StreamingComponent();
+
+    void onInitialize();
+    void onDeinitialize();
+    void onUpdate(double time_diff);
+
+    /**
+      * Splits the children of a Node into cells by their position and writes every non-empty cell to a file.
+      * @param root The Node, usually the Scene. Its children keep their position relative to it.
+      * @param directory The directory to write the cell files to.
+      * @param cell_size The edge length of a cell.
+      * @returns The number of cell files written.
+      */
+    static uint32_t saveCells(Node* root, const QString directory, float cell_size);
+
+    /**
+      * Adds a Node the cells are loaded around. It is removed automatically when it is deleted.
+      * @param node The Node.
+      */
+    void addFocus(Node* node);
+
+    /**
+      * Removes a Node the cells are loaded around.
+      * @param node The Node.
+      */
+    void removeFocus(Node* node);
+
+    /**
+      * Sets the distance from a focus within which cells are loaded. Default: 300.
+      * @param load_radius The distance. The unload radius is raised if it is smaller.
+      */
+    void setLoadRadius(float load_radius);
+
+    /**
+      * Returns the distance from a focus within which cells are loaded.
+      * @returns The distance.
+      */
+    float getLoadRadius() const;
+
+    /**
+      * Sets the distance from every focus beyond which cells are unloaded. Default: 400.
+      * @param unload_radius The distance. Values below the load radius are raised to it.
+      */
+    void setUnloadRadius(float unload_radius);
+
+    /**
+      * Returns the distance from every focus beyond which cells are unloaded.
+      * @returns The distance.
+      */
+    float getUnloadRadius() const;
+
+    /**
+      * Sets the budget for the total size of the files of the cells in memory. The memory used by the Nodes
+      * of a cell is not measured, but grows with the size of its file. Default: 0 (no limit).
+      * @param bytes The budget in bytes, or 0 for no limit.
+      */
+    void setFileSizeBudget(uint64_t bytes);
+
+    /**
+      * Returns the budget for the total size of the files of the cells in memory.
+      * @returns The budget in bytes, or 0 for no limit.
+      */
+    uint64_t getFileSizeBudget() const;
+
+    /**
+      * Sets the number of cells attached per frame. Spreads the cost of creating the components of
+      * many cells over several frames. Default: 1.
+      * @param cells The number of cells.
+      */
+    void setAttachBudget(uint32_t cells);
+
+    /**
+      * Returns the number of cells attached per frame.
+      * @returns The number of cells.
+      */
+    uint32_t getAttachBudget() const;
+
+    /**
+      * Returns the state of a cell.
+      * @param x The index of the cell along the x axis.
+      * @param z The index of the cell along the z axis.
+      * @returns The state of the cell.
+      */
+    CellState getCellState(int32_t x, int32_t z) const;
+
+    /**
+      * Returns the number of cells that have been attached to the Scene.
+      * @returns The number of cells.
+      */
+    uint32_t getAttachedCellCount() const;
+
+    /**
+      * Returns the total size of the files of all cells in memory.
+      * @returns The size in bytes.
+      */
+    uint64_t getLoadedFileSize() const;
+
+    /**
+      * Loads all cells within the load radius at once and attaches them, ignoring the attach budget,
+      * e.g. behind a loading screen. The Nodes are added to the Scene at the end of the frame.
+      */
+    void flush();
+
+private slots:
+    /**
+      * Removes a focus that is being deleted.
+      * @param focus The focus.
+      */
+    void onFocusDestroyed(QObject* focus);
+
+private:
+    /**
+      * A cell that is not UNLOADED.
+      */
+    struct Cell {
+        int32_t mX;                         //!< The index of the cell along the x axis.
+        int32_t mZ;                         //!< The index of the cell along the z axis.
+        CellState mState;                   //!< The state of the cell.
+        uint64_t mSize;                     //!< The size of the cell file.
+        float mDistance;                    //!< The distance to the nearest focus.
+        QByteArray mData;                   //!< The content of the cell file of a LOADED cell.
+        uint64_t mNodeId;                   //!< The runtime id of the Node holding the content of an ATTACHED cell, or 0 if it is empty.
+    };
+
+    /**
+      * A cell read on the background thread.
+      */
+    struct LoadResult {
+        uint64_t mKey;                      //!< The key of the cell.
+        uint64_t mSize;                     //!< The size of the cell file.
+        QByteArray mData;                   //!< The content of the cell file, empty if there is none.
+    };
+
+    /**
+      * Loads, unloads and attaches cells.
+      * @param blocking Whether to request all missing cells and attach all loaded ones, ignoring the limits per frame.
+      */
+    void _stream(bool blocking);
+
+    /**
+      * Reads a cell file. Called on the background thread, so the content is not parsed yet.
+      * @param key The key of the cell.
+      * @param file_name The name of the cell file.
+      */
+    void _loadCell(uint64_t key, const QString file_name);
+
+    /**
+      * Creates the Nodes and components of a cell. Called on the main thread when the cell is attached.
+      * @param data The content of the cell file.
+      * @param node The Node holding the content of the cell.
+      */
+    static void _attachCell(const QByteArray& data, Node* node);
+
+    /**
+      * Removes a cell, including its Nodes.
+      * @param iter The cell.
+      */
+    void _unloadCell(std::unordered_map<uint64_t, Cell>::iterator iter);
+
+    /**
+      * Returns the distance between a point on the x/z plane and a cell.
+      * @param x The index of the cell along the x axis.
+      * @param z The index of the cell along the z axis.
+      * @param point The point. Its y coordinate is ignored.
+      * @returns The distance, 0 if the point is inside the cell.
+      */
+    float _getDistance(int32_t x, int32_t z, const Ogre::Vector3& point) const;
+
+    /**
+      * Returns the key of a cell.
+      * @param x The index of the cell along the x axis.
+      * @param z The index of the cell along the z axis.
+      * @returns The key.
+      */
+    static uint64_t _getKey(int32_t x, int32_t z);
+
+    /**
+      * Returns the name of the file of a cell.
+      * @param directory The directory with the cell files.
+      * @param x The index of the cell along the x axis.
+      * @param z The index of the cell along the z axis.
+      * @returns The file name.
+      */
+    static QString _getFileName(const QString& directory, int32_t x, int32_t z);
+
+    QString mDirectory;                         //!< The directory with the cell files.
+    float mCellSize;                            //!< The edge length of a cell.
+    float mLoadRadius;                          //!< The distance from a focus within which cells are loaded.
+    float mUnloadRadius;                        //!< The distance from every focus beyond which cells are unloaded.
+    uint64_t mFileSizeBudget;                   //!< The maximum size of the files of the cells in memory, or 0.
+    uint32_t mAttachBudget;                     //!< The number of cells attached per frame.
+    uint32_t mPendingLoads;                     //!< The number of cells being read on the background thread.
+    std::vector<Node*> mFoci;                   //!< The Nodes the cells are loaded around.
+    std::unordered_map<uint64_t, Cell> mCells;  //!< The cells that are not UNLOADED.
+    QMutex mLoadedMutex;                        //!< Guards mLoaded.
+    std::vector<LoadResult> mLoaded;            //!< The cells read by the background thread since the last update.
+    QThreadPool mLoader;                        //!< The background thread.
+
+};
+
+} // namespace dt
+
+#endif
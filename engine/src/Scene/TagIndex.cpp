@@ -0,0 +1,193 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/TagIndex.hpp>
+
+#include <Scene/Node.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/Utils.hpp>
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+namespace dt {
+
+namespace {
+
+/**
+  * The names of the registered tags. Tags are registered from several threads, so all access is locked.
+  */
+struct TagTable {
+    QMutex mMutex;
+    std::vector<QString> mNames;    //!< The name of each bit.
+    QHash<QString, uint32_t> mBits; //!< The bit of each name.
+};
+
+TagTable& getTable() {
+    // constructed on first use, tags may be registered during static initialization
+    static TagTable table;
+    return table;
+}
+
+/**
+  * Returns the number of set bits.
+  */
+uint32_t countBits(uint64_t bits) {
+    uint32_t count = 0;
+    for(; bits != 0; bits &= bits - 1) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+  * Returns the index of the lowest set bit.
+  */
+uint32_t lowestBit(uint64_t bits) {
+    return countBits((bits & (~bits + 1)) - 1);
+}
+
+} // anonymous namespace
+
+const uint32_t TagIndex::MAX_TAGS = 64;
+
+TagIndex::Query::Query(uint64_t all, uint64_t any, uint64_t none)
+    : mAll(all),
+      mAny(any),
+      mNone(none) {}
+
+bool TagIndex::Query::matches(uint64_t tags) const {
+    return (tags & mAll) == mAll && (mAny == 0 || (tags & mAny) != 0) && (tags & mNone) == 0;
+}
+
+uint64_t TagIndex::getTag(const QString& name) {
+    TagTable& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+
+    QHash<QString, uint32_t>::const_iterator iter = table.mBits.find(name);
+    if(iter != table.mBits.end())
+        return uint64_t(1) << iter.value();
+
+    if(table.mNames.size() == MAX_TAGS) {
+        Logger::get().error("Cannot register tag " + name + ": all " + Utils::toString(MAX_TAGS) + " tags are in use.");
+        return 0;
+    }
+    uint32_t bit = table.mNames.size();
+    table.mNames.push_back(name);
+    table.mBits.insert(name, bit);
+    return uint64_t(1) << bit;
+}
+
+uint64_t TagIndex::findTag(const QString& name) {
+    TagTable& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+
+    QHash<QString, uint32_t>::const_iterator iter = table.mBits.find(name);
+    return iter != table.mBits.end() ? uint64_t(1) << iter.value() : 0;
+}
+
+QString TagIndex::getTagName(uint64_t tag) {
+    TagTable& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+
+    uint32_t bit = lowestBit(tag);
+    return (tag != 0 && bit < table.mNames.size()) ? table.mNames[bit] : QString();
+}
+
+TagIndex::TagIndex()
+    : mNodes(MAX_TAGS) {}
+
+void TagIndex::add(Node* node) {
+    node->mTagIndices.clear();
+    for(uint64_t tags = node->mTags; tags != 0; tags &= tags - 1) {
+        std::vector<Node*>& nodes = mNodes[lowestBit(tags)];
+        node->mTagIndices.push_back(nodes.size());
+        nodes.push_back(node);
+    }
+}
+
+void TagIndex::remove(Node* node) {
+    uint32_t rank = 0;
+    for(uint64_t tags = node->mTags; tags != 0 && rank < node->mTagIndices.size(); tags &= tags - 1, ++rank) {
+        uint32_t bit = lowestBit(tags);
+        std::vector<Node*>& nodes = mNodes[bit];
+        uint32_t index = node->mTagIndices[rank];
+
+        // the last Node of the tag takes its place
+        Node* moved = nodes.back();
+        nodes[index] = moved;
+        moved->mTagIndices[countBits(moved->mTags & ((uint64_t(1) << bit) - 1))] = index;
+        nodes.pop_back();
+    }
+    node->mTagIndices.clear();
+}
+
+const std::vector<Node*>& TagIndex::getNodes(uint64_t tag) const {
+    // lowestBit(0) is past the last bit, so tag 0 has no list of its own
+    static const std::vector<Node*> no_nodes;
+    if(tag == 0)
+        return no_nodes;
+    return mNodes[lowestBit(tag) % MAX_TAGS];
+}
+
+void TagIndex::find(const Query& query, std::vector<Node*>& result) const {
+    result.clear();
+
+    if(query.mAll != 0) {
+        // every match has the rarest required tag
+        const std::vector<Node*>* rarest = nullptr;
+        for(uint64_t tags = query.mAll; tags != 0; tags &= tags - 1) {
+            const std::vector<Node*>& nodes = mNodes[lowestBit(tags)];
+            if(rarest == nullptr || nodes.size() < rarest->size())
+                rarest = &nodes;
+        }
+        for(auto iter = rarest->begin(); iter != rarest->end(); ++iter) {
+            if(query.matches((*iter)->mTags))
+                result.push_back(*iter);
+        }
+    } else if(query.mAny != 0) {
+        for(uint64_t tags = query.mAny; tags != 0; tags &= tags - 1) {
+            uint32_t bit = lowestBit(tags);
+            // Nodes with one of the lower optional tags have been found already
+            uint64_t found = query.mAny & ((uint64_t(1) << bit) - 1);
+            const std::vector<Node*>& nodes = mNodes[bit];
+            for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+                if(((*iter)->mTags & found) == 0 && ((*iter)->mTags & query.mNone) == 0)
+                    result.push_back(*iter);
+            }
+        }
+    }
+}
+
+uint32_t TagIndex::getCandidateCount(const Query& query) const {
+    uint32_t count = 0;
+    if(query.mAll != 0) {
+        count = 0xffffffff;
+        for(uint64_t tags = query.mAll; tags != 0; tags &= tags - 1) {
+            count = std::min(count, static_cast<uint32_t>(mNodes[lowestBit(tags)].size()));
+        }
+    } else {
+        for(uint64_t tags = query.mAny; tags != 0; tags &= tags - 1) {
+            count += mNodes[lowestBit(tags)].size();
+        }
+    }
+    return count;
+}
+
+void TagIndex::clear() {
+    for(auto tag = mNodes.begin(); tag != mNodes.end(); ++tag) {
+        for(auto iter = tag->begin(); iter != tag->end(); ++iter) {
+            (*iter)->mTagIndices.clear();
+        }
+        tag->clear();
+    }
+}
+
+} // namespace dt
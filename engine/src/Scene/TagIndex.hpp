@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_TAGINDEX
+#define DUCTTAPE_ENGINE_SCENE_TAGINDEX
+
+#include <Config.hpp>
+
+#include <QString>
+#include <QtGlobal>
+
+#include <cstdint>
+#include <vector>
+
+namespace dt {
+
+// forward declaration due to circular dependency
+class Node;
+
+/**
+  * An index of the Nodes of a Scene by their tags. Every Node has a bitmask of up to 64 tags, e.g. "enemy" or
+  * "interactable", and the index keeps one dense array of Nodes per tag, so queries only look at the Nodes
+  * of the tags they ask for instead of walking the Node tree.
+  * Tags are registered by name once per process and are the same bit in every Scene.
+  * @see Scene::getTagIndex()
+  * @see Node::addTag(const QString& tag)
+  */
+class DUCTTAPE_API TagIndex {
+
+    Q_DISABLE_COPY(TagIndex)
+
+public:
+    static const uint32_t MAX_TAGS;     //!< The number of distinct tags.
+
+    /**
+      * A filter for the tags of Nodes.
+      */
+    struct DUCTTAPE_API Query {
+        /**
+          * Constructor.
+          * @param all The tags a Node must all have. 0 for none.
+          * @param any The tags a Node must have at least one of. 0 for no restriction.
+          * @param none The tags a Node must not have.
+          */
+        Query(uint64_t all = 0, uint64_t any = 0, uint64_t none = 0);
+
+        /**
+          * Returns whether a Node with the given tags matches.
+          * @param tags The tags of the Node.
+          * @returns Whether the tags match.
+          */
+        bool matches(uint64_t tags) const;
+
+        uint64_t mAll;      //!< The tags a Node must all have (AND).
+        uint64_t mAny;      //!< The tags a Node must have at least one of (OR), or 0.
+        uint64_t mNone;     //!< The tags a Node must not have (NOT).
+    };
+
+    /**
+      * Returns the tag with the given name, registering it if required.
+      * @param name The name of the tag.
+      * @returns The tag, a bitmask with one bit set, or 0 if all tags are in use.
+      */
+    static uint64_t getTag(const QString& name);
+
+    /**
+      * Returns the tag with the given name without registering it.
+      * @param name The name of the tag.
+      * @returns The tag, or 0 if no tag with this name has been registered.
+      */
+    static uint64_t findTag(const QString& name);
+
+    /**
+      * Returns the name of a tag.
+      * @param tag The tag, a bitmask with one bit set.
+      * @returns The name, or an empty string if the tag has not been registered.
+      */
+    static QString getTagName(uint64_t tag);
+
+    /**
+      * Default constructor.
+      */
+    TagIndex();
+
+    /**
+      * Adds a Node to the arrays of its tags.
+      * @param node The Node.
+      */
+    void add(Node* node);
+
+    /**
+      * Removes a Node from the arrays of its tags. Has to be called before the tags of the Node change.
+      * @param node The Node.
+      */
+    void remove(Node* node);
+
+    /**
+      * Returns the Nodes with a tag.
+      * @param tag The tag, a bitmask with one bit set.
+      * @returns The Nodes, in no particular order, or an empty list for 0. Only valid until a Node is tagged,
+      * untagged, added or removed.
+      */
+    const std::vector<Node*>& getNodes(uint64_t tag) const;
+
+    /**
+      * Finds the Nodes matching a query. A query with required tags only looks at the Nodes of its
+      * rarest required tag, one with only optional tags at the Nodes of each of them. A query
+      * without required or optional tags matches no Node here; Scene::findNodes() handles it.
+      * @param query The query.
+      * @param result Is filled with the Nodes, in no particular order.
+      */
+    void find(const Query& query, std::vector<Node*>& result) const;
+
+    /**
+      * Returns the number of Nodes find() has to look at for a query.
+      * @param query The query.
+      * @returns The number of Nodes.
+      */
+    uint32_t getCandidateCount(const Query& query) const;
+
+    /**
+      * Removes all Nodes.
+      */
+    void clear();
+
+private:
+    std::vector<std::vector<Node*> > mNodes;    //!< The Nodes of each tag, by bit.
+
+};
+
+} // namespace dt
+
+#endif
@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/TransformJournal.hpp>
+
+#include <Scene/Node.hpp>
+
+#include <QMutexLocker>
+
+namespace dt {
+
+const uint32_t TransformJournal::NOT_RECORDED = 0xffffffff;
+
+TransformJournal::TransformJournal() {}
+
+void TransformJournal::record(Node* node) {
+    QMutexLocker lock(&mMutex);
+    if(node->mJournalIndex != NOT_RECORDED)
+        return;
+
+    node->mJournalIndex = mRecorded.size();
+    mRecorded.push_back(node);
+}
+
+void TransformJournal::remove(Node* node) {
+    QMutexLocker lock(&mMutex);
+    if(node->mJournalIndex != NOT_RECORDED)
+        _removeAt(mRecorded, node->mJournalIndex, false);
+    if(node->mPublishedJournalIndex != NOT_RECORDED)
+        _removeAt(mChanged, node->mPublishedJournalIndex, true);
+}
+
+bool TransformJournal::isRecorded(const Node* node) const {
+    QMutexLocker lock(&mMutex);
+    return node->mJournalIndex != NOT_RECORDED;
+}
+
+void TransformJournal::publish() {
+    QMutexLocker lock(&mMutex);
+    for(auto iter = mChanged.begin(); iter != mChanged.end(); ++iter) {
+        (*iter)->mPublishedJournalIndex = NOT_RECORDED;
+    }
+    for(auto iter = mRecorded.begin(); iter != mRecorded.end(); ++iter) {
+        (*iter)->mPublishedJournalIndex = (*iter)->mJournalIndex;
+        (*iter)->mJournalIndex = NOT_RECORDED;
+    }
+
+    // keep the capacity of both lists
+    mChanged.swap(mRecorded);
+    mRecorded.clear();
+}
+
+const std::vector<Node*>& TransformJournal::getChangedNodes() const {
+    return mChanged;
+}
+
+const std::vector<Node*>& TransformJournal::getRecordedNodes() const {
+    return mRecorded;
+}
+
+void TransformJournal::clear() {
+    QMutexLocker lock(&mMutex);
+    for(auto iter = mChanged.begin(); iter != mChanged.end(); ++iter) {
+        (*iter)->mPublishedJournalIndex = NOT_RECORDED;
+    }
+    for(auto iter = mRecorded.begin(); iter != mRecorded.end(); ++iter) {
+        (*iter)->mJournalIndex = NOT_RECORDED;
+    }
+    mChanged.clear();
+    mRecorded.clear();
+}
+
+void TransformJournal::_removeAt(std::vector<Node*>& nodes, uint32_t index, bool is_published) {
+    uint32_t& removed = is_published ? nodes[index]->mPublishedJournalIndex : nodes[index]->mJournalIndex;
+    removed = NOT_RECORDED;
+
+    if(index != nodes.size() - 1) {
+        nodes[index] = nodes.back();
+        uint32_t& moved = is_published ? nodes[index]->mPublishedJournalIndex : nodes[index]->mJournalIndex;
+        moved = index;
+    }
+    nodes.pop_back();
+}
+
+} // namespace dt
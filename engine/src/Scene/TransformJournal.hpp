@@ -0,0 +1,105 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_TRANSFORMJOURNAL
+#define DUCTTAPE_ENGINE_SCENE_TRANSFORMJOURNAL
+
+#include <Config.hpp>
+
+#include <QMutex>
+
+#include <cstdint>
+#include <vector>
+
+namespace dt {
+
+// forward declaration due to circular dependency
+class Node;
+
+/**
+  * Records which Nodes of a Scene had their world transform changed, so systems that mirror the transforms
+  * (presentation, trigger areas, the spatial index, replication) only have to look at those instead of
+  * polling every Node. A Node is recorded once per frame when its own transform or the one of a parent
+  * changes. At the end of every frame the Scene publishes the recorded Nodes as getChangedNodes() and starts
+  * a new recording. Changes made through the bulk setters of the TransformPool are recorded for the changed
+  * Nodes and their children when the pool updates its world transforms, at the end of the frame at the latest.
+  * Recording, removing and checking Nodes is locked, so Nodes can be recorded from any thread. Publishing
+  * and the lists returned are meant for the main thread while no Nodes are recorded.
+  * @see Scene::getTransformJournal()
+  */
+class DUCTTAPE_API TransformJournal {
+
+    Q_DISABLE_COPY(TransformJournal)
+
+public:
+    static const uint32_t NOT_RECORDED; //!< The journal index of a Node that is not in a list.
+
+    /**
+      * Default constructor.
+      */
+    TransformJournal();
+
+    /**
+      * Adds a Node to the current recording, if it is not part of it yet.
+      * @param node The Node whose world transform changed.
+      */
+    void record(Node* node);
+
+    /**
+      * Removes a Node from the recording and the published changes, e.g. because it is being removed from the Scene.
+      * @param node The Node.
+      */
+    void remove(Node* node);
+
+    /**
+      * Returns whether a Node is part of the current recording.
+      * @param node The Node.
+      * @returns Whether the world transform of the Node changed since the last publish().
+      */
+    bool isRecorded(const Node* node) const;
+
+    /**
+      * Publishes the current recording as getChangedNodes() and starts a new one. Called by the Scene at the
+      * end of every frame.
+      */
+    void publish();
+
+    /**
+      * Returns the Nodes whose world transform changed in the last frame.
+      * @returns The Nodes, in no particular order and without duplicates.
+      */
+    const std::vector<Node*>& getChangedNodes() const;
+
+    /**
+      * Returns the Nodes whose world transform changed since the last frame.
+      * @returns The Nodes, in no particular order and without duplicates.
+      */
+    const std::vector<Node*>& getRecordedNodes() const;
+
+    /**
+      * Removes all Nodes from the recording and the published changes.
+      */
+    void clear();
+
+private:
+    /**
+      * Removes the entry at an index by moving the last entry there.
+      * @param nodes The list.
+      * @param index The index of the entry.
+      * @param is_published Whether the list holds the published changes.
+      */
+    void _removeAt(std::vector<Node*>& nodes, uint32_t index, bool is_published);
+
+    std::vector<Node*> mRecorded;   //!< The Nodes that changed since the last publish().
+    std::vector<Node*> mChanged;    //!< The Nodes that changed in the last frame.
+    mutable QMutex mMutex;          //!< Guards the lists and the journal indices of the Nodes.
+
+};
+
+} // namespace dt
+
+#endif
@@ -0,0 +1,522 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Scene/TransformPool.hpp>
+
+#include <Scene/TransformJournal.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define DUCTTAPE_TRANSFORMPOOL_SSE
+    #include <xmmintrin.h>
+#endif
+
+namespace dt {
+
+namespace {
+
+/**
+  * Reorders an array so that the new element i is the old element order[i].
+  */
+template <typename T>
+void permute(std::vector<T>& array, const std::vector<uint32_t>& order) {
+    std::vector<T> result(array.size());
+    for(uint32_t i = 0; i < order.size(); ++i) {
+        result[i] = array[order[i]];
+    }
+    array.swap(result);
+}
+
+#ifdef DUCTTAPE_TRANSFORMPOOL_SSE
+/**
+  * Loads the values of four (parent) entries into one register.
+  */
+inline __m128 gather(const std::vector<float>& array, const int32_t* parent_slots) {
+    return _mm_set_ps(array[parent_slots[3]], array[parent_slots[2]], array[parent_slots[1]], array[parent_slots[0]]);
+}
+#endif
+
+} // anonymous namespace
+
+const uint32_t TransformPool::INVALID_HANDLE = 0xffffffff;
+
+TransformPool::TransformPool()
+    : mJournal(nullptr),
+      mIsSorted(true),
+      mHasDirtyEntries(false),
+      mBulkChangeCount(0),
+      mHasUnpropagatedChanges(false) {
+    std::vector<float>* arrays[] = {
+        &mPosX, &mPosY, &mPosZ, &mRotW, &mRotX, &mRotY, &mRotZ, &mScaleX, &mScaleY, &mScaleZ,
+        &mWorldPosX, &mWorldPosY, &mWorldPosZ, &mWorldRotW, &mWorldRotX, &mWorldRotY, &mWorldRotZ,
+        &mWorldScaleX, &mWorldScaleY, &mWorldScaleZ
+    };
+    mFloatArrays.assign(arrays, arrays + sizeof(arrays) / sizeof(arrays[0]));
+}
+
+void TransformPool::setJournal(TransformJournal* journal) {
+    mJournal = journal;
+}
+
+uint32_t TransformPool::create(uint32_t parent, Node* node) {
+    uint32_t handle;
+    if(mFreeHandles.size() > 0) {
+        handle = mFreeHandles.back();
+        mFreeHandles.pop_back();
+    } else {
+        handle = mSlotOfHandle.size();
+        mSlotOfHandle.push_back(INVALID_HANDLE);
+        mNodeOfHandle.push_back(nullptr);
+    }
+    mNodeOfHandle[handle] = node;
+
+    uint32_t slot = getSize();
+    _pushBack();
+    mSlotOfHandle[handle] = slot;
+    mHandleOfSlot[slot] = handle;
+    mParentHandle[slot] = parent;
+    mParentSlot[slot] = (parent == INVALID_HANDLE) ? -1 : static_cast<int32_t>(mSlotOfHandle[parent]);
+
+    // still parent-before-child, but no longer grouped by depth
+    mIsSorted = false;
+    mHasDirtyEntries = true;
+    return handle;
+}
+
+void TransformPool::destroy(uint32_t handle) {
+    uint32_t slot = mSlotOfHandle[handle];
+    uint32_t last = getSize() - 1;
+    if(slot != last) {
+        _move(last, slot);
+        mSlotOfHandle[mHandleOfSlot[slot]] = slot;
+        mIsSorted = false;
+    }
+    _popBack();
+
+    mSlotOfHandle[handle] = INVALID_HANDLE;
+    mNodeOfHandle[handle] = nullptr;
+    mFreeHandles.push_back(handle);
+}
+
+void TransformPool::setParent(uint32_t handle, uint32_t parent) {
+    mParentHandle[mSlotOfHandle[handle]] = parent;
+    mIsSorted = false;
+}
+
+uint32_t TransformPool::getSize() const {
+    return mHandleOfSlot.size();
+}
+
+void TransformPool::reserve(uint32_t count) {
+    for(auto iter = mFloatArrays.begin(); iter != mFloatArrays.end(); ++iter) {
+        (*iter)->reserve(count);
+    }
+    mParentSlot.reserve(count);
+    mParentHandle.reserve(count);
+    mDirty.reserve(count);
+    mHandleOfSlot.reserve(count);
+    mSlotOfHandle.reserve(count);
+    mNodeOfHandle.reserve(count);
+}
+
+Ogre::Vector3 TransformPool::getPosition(uint32_t handle) const {
+    uint32_t slot = mSlotOfHandle[handle];
+    return Ogre::Vector3(mPosX[slot], mPosY[slot], mPosZ[slot]);
+}
+
+void TransformPool::setPosition(uint32_t handle, const Ogre::Vector3& position) {
+    uint32_t slot = mSlotOfHandle[handle];
+    mPosX[slot] = position.x;
+    mPosY[slot] = position.y;
+    mPosZ[slot] = position.z;
+}
+
+void TransformPool::setPositions(const std::vector<uint32_t>& handles, const std::vector<Ogre::Vector3>& positions) {
+    for(uint32_t i = 0; i < handles.size(); ++i) {
+        uint32_t slot = mSlotOfHandle[handles[i]];
+        mPosX[slot] = positions[i].x;
+        mPosY[slot] = positions[i].y;
+        mPosZ[slot] = positions[i].z;
+        mDirty[slot] = 1;
+    }
+    mBulkChanges.insert(mBulkChanges.end(), handles.begin(), handles.end());
+    mHasDirtyEntries = true;
+    mHasUnpropagatedChanges = true;
+    ++mBulkChangeCount;
+}
+
+Ogre::Vector3 TransformPool::getScale(uint32_t handle) const {
+    uint32_t slot = mSlotOfHandle[handle];
+    return Ogre::Vector3(mScaleX[slot], mScaleY[slot], mScaleZ[slot]);
+}
+
+void TransformPool::setScale(uint32_t handle, const Ogre::Vector3& scale) {
+    uint32_t slot = mSlotOfHandle[handle];
+    mScaleX[slot] = scale.x;
+    mScaleY[slot] = scale.y;
+    mScaleZ[slot] = scale.z;
+}
+
+void TransformPool::setScales(const std::vector<uint32_t>& handles, const std::vector<Ogre::Vector3>& scales) {
+    for(uint32_t i = 0; i < handles.size(); ++i) {
+        uint32_t slot = mSlotOfHandle[handles[i]];
+        mScaleX[slot] = scales[i].x;
+        mScaleY[slot] = scales[i].y;
+        mScaleZ[slot] = scales[i].z;
+        mDirty[slot] = 1;
+    }
+    mBulkChanges.insert(mBulkChanges.end(), handles.begin(), handles.end());
+    mHasDirtyEntries = true;
+    mHasUnpropagatedChanges = true;
+    ++mBulkChangeCount;
+}
+
+Ogre::Quaternion TransformPool::getRotation(uint32_t handle) const {
+    uint32_t slot = mSlotOfHandle[handle];
+    return Ogre::Quaternion(mRotW[slot], mRotX[slot], mRotY[slot], mRotZ[slot]);
+}
+
+void TransformPool::setRotation(uint32_t handle, const Ogre::Quaternion& rotation) {
+    uint32_t slot = mSlotOfHandle[handle];
+    mRotW[slot] = rotation.w;
+    mRotX[slot] = rotation.x;
+    mRotY[slot] = rotation.y;
+    mRotZ[slot] = rotation.z;
+}
+
+void TransformPool::setRotations(const std::vector<uint32_t>& handles, const std::vector<Ogre::Quaternion>& rotations) {
+    for(uint32_t i = 0; i < handles.size(); ++i) {
+        uint32_t slot = mSlotOfHandle[handles[i]];
+        mRotW[slot] = rotations[i].w;
+        mRotX[slot] = rotations[i].x;
+        mRotY[slot] = rotations[i].y;
+        mRotZ[slot] = rotations[i].z;
+        mDirty[slot] = 1;
+    }
+    mBulkChanges.insert(mBulkChanges.end(), handles.begin(), handles.end());
+    mHasDirtyEntries = true;
+    mHasUnpropagatedChanges = true;
+    ++mBulkChangeCount;
+}
+
+Ogre::Vector3 TransformPool::getWorldPosition(uint32_t handle) const {
+    Ogre::Vector3 position, scale;
+    Ogre::Quaternion rotation;
+    _getWorldTransform(mSlotOfHandle[handle], position, rotation, scale);
+    return position;
+}
+
+Ogre::Vector3 TransformPool::getWorldScale(uint32_t handle) const {
+    Ogre::Vector3 position, scale;
+    Ogre::Quaternion rotation;
+    _getWorldTransform(mSlotOfHandle[handle], position, rotation, scale);
+    return scale;
+}
+
+Ogre::Quaternion TransformPool::getWorldRotation(uint32_t handle) const {
+    Ogre::Vector3 position, scale;
+    Ogre::Quaternion rotation;
+    _getWorldTransform(mSlotOfHandle[handle], position, rotation, scale);
+    return rotation;
+}
+
+void TransformPool::invalidate(uint32_t handle) {
+    mDirty[mSlotOfHandle[handle]] = 1;
+    // The workers only invalidate the entries of their own subtrees, the main thread reads the flag after joining them.
+    mHasDirtyEntries.store(true, std::memory_order_relaxed);
+}
+
+bool TransformPool::isDirty(uint32_t handle) const {
+    return mDirty[mSlotOfHandle[handle]] != 0;
+}
+
+bool TransformPool::hasUnpropagatedChanges() const {
+    return mHasUnpropagatedChanges;
+}
+
+uint32_t TransformPool::getBulkChangeCount() const {
+    return mBulkChangeCount;
+}
+
+void TransformPool::updateWorldTransforms() {
+    // the bulk setters mark their entries as dirty as well
+    if(!mHasDirtyEntries)
+        return;
+
+    if(!mIsSorted)
+        _sort();
+
+    const uint32_t count = getSize();
+    uint32_t i = 0;
+
+#ifdef DUCTTAPE_TRANSFORMPOOL_SSE
+    const __m128 two = _mm_set1_ps(2.f);
+
+    for(; i + 4 <= count; i += 4) {
+        const int32_t* p = &mParentSlot[i];
+        const int32_t signed_i = static_cast<int32_t>(i);
+
+        // All four parents have to be finished before this group (no roots, no parent inside the group).
+        // The arrays are grouped by depth, so this is true for almost every group.
+        if(p[0] < 0 || p[1] < 0 || p[2] < 0 || p[3] < 0 ||
+           p[0] >= signed_i || p[1] >= signed_i || p[2] >= signed_i || p[3] >= signed_i) {
+            for(uint32_t j = i; j < i + 4; ++j) {
+                _calculate(j);
+            }
+            continue;
+        }
+
+        // world position = parent world position + parent local rotation * local position
+        const __m128 qw = gather(mRotW, p);
+        const __m128 qx = gather(mRotX, p);
+        const __m128 qy = gather(mRotY, p);
+        const __m128 qz = gather(mRotZ, p);
+        const __m128 vx = _mm_loadu_ps(&mPosX[i]);
+        const __m128 vy = _mm_loadu_ps(&mPosY[i]);
+        const __m128 vz = _mm_loadu_ps(&mPosZ[i]);
+
+        // Same as Ogre::Quaternion::operator*(const Vector3&)
+        __m128 uvx = _mm_sub_ps(_mm_mul_ps(qy, vz), _mm_mul_ps(qz, vy));
+        __m128 uvy = _mm_sub_ps(_mm_mul_ps(qz, vx), _mm_mul_ps(qx, vz));
+        __m128 uvz = _mm_sub_ps(_mm_mul_ps(qx, vy), _mm_mul_ps(qy, vx));
+        __m128 uuvx = _mm_sub_ps(_mm_mul_ps(qy, uvz), _mm_mul_ps(qz, uvy));
+        __m128 uuvy = _mm_sub_ps(_mm_mul_ps(qz, uvx), _mm_mul_ps(qx, uvz));
+        __m128 uuvz = _mm_sub_ps(_mm_mul_ps(qx, uvy), _mm_mul_ps(qy, uvx));
+        const __m128 two_w = _mm_mul_ps(two, qw);
+        uvx = _mm_mul_ps(uvx, two_w);
+        uvy = _mm_mul_ps(uvy, two_w);
+        uvz = _mm_mul_ps(uvz, two_w);
+        uuvx = _mm_mul_ps(uuvx, two);
+        uuvy = _mm_mul_ps(uuvy, two);
+        uuvz = _mm_mul_ps(uuvz, two);
+
+        _mm_storeu_ps(&mWorldPosX[i], _mm_add_ps(gather(mWorldPosX, p), _mm_add_ps(vx, _mm_add_ps(uvx, uuvx))));
+        _mm_storeu_ps(&mWorldPosY[i], _mm_add_ps(gather(mWorldPosY, p), _mm_add_ps(vy, _mm_add_ps(uvy, uuvy))));
+        _mm_storeu_ps(&mWorldPosZ[i], _mm_add_ps(gather(mWorldPosZ, p), _mm_add_ps(vz, _mm_add_ps(uvz, uuvz))));
+
+        // world rotation = parent world rotation * local rotation
+        const __m128 aw = gather(mWorldRotW, p);
+        const __m128 ax = gather(mWorldRotX, p);
+        const __m128 ay = gather(mWorldRotY, p);
+        const __m128 az = gather(mWorldRotZ, p);
+        const __m128 bw = _mm_loadu_ps(&mRotW[i]);
+        const __m128 bx = _mm_loadu_ps(&mRotX[i]);
+        const __m128 by = _mm_loadu_ps(&mRotY[i]);
+        const __m128 bz = _mm_loadu_ps(&mRotZ[i]);
+
+        _mm_storeu_ps(&mWorldRotW[i], _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)));
+        _mm_storeu_ps(&mWorldRotX[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by)));
+        _mm_storeu_ps(&mWorldRotY[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx)), _mm_mul_ps(ax, bz)));
+        _mm_storeu_ps(&mWorldRotZ[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(az, bw)), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx)));
+
+        // world scale = parent world scale * local scale
+        _mm_storeu_ps(&mWorldScaleX[i], _mm_mul_ps(gather(mWorldScaleX, p), _mm_loadu_ps(&mScaleX[i])));
+        _mm_storeu_ps(&mWorldScaleY[i], _mm_mul_ps(gather(mWorldScaleY, p), _mm_loadu_ps(&mScaleY[i])));
+        _mm_storeu_ps(&mWorldScaleZ[i], _mm_mul_ps(gather(mWorldScaleZ, p), _mm_loadu_ps(&mScaleZ[i])));
+    }
+#endif
+
+    for(; i < count; ++i) {
+        _calculate(i);
+    }
+
+    std::fill(mDirty.begin(), mDirty.end(), 0);
+    mHasDirtyEntries = false;
+    mHasUnpropagatedChanges = false;
+
+    if(!mBulkChanges.empty())
+        _recordBulkChanges();
+}
+
+void TransformPool::_sort() {
+    const uint32_t count = getSize();
+
+    // calculate the depth of every entry
+    std::vector<int32_t> depth(count, -1);
+    std::vector<uint32_t> chain;
+    uint32_t max_depth = 0;
+    for(uint32_t slot = 0; slot < count; ++slot) {
+        uint32_t current = slot;
+        while(depth[current] < 0 && mParentHandle[current] != INVALID_HANDLE) {
+            chain.push_back(current);
+            current = mSlotOfHandle[mParentHandle[current]];
+        }
+        if(depth[current] < 0)
+            depth[current] = 0;
+
+        while(chain.size() > 0) {
+            depth[chain.back()] = depth[current] + 1;
+            current = chain.back();
+            chain.pop_back();
+        }
+        max_depth = std::max(max_depth, static_cast<uint32_t>(depth[slot]));
+    }
+
+    // counting sort by depth, stable within the same depth
+    std::vector<uint32_t> offsets(max_depth + 2, 0);
+    for(uint32_t slot = 0; slot < count; ++slot) {
+        ++offsets[depth[slot] + 1];
+    }
+    for(uint32_t d = 1; d < offsets.size(); ++d) {
+        offsets[d] += offsets[d - 1];
+    }
+    std::vector<uint32_t> order(count);
+    for(uint32_t slot = 0; slot < count; ++slot) {
+        order[offsets[depth[slot]]++] = slot;
+    }
+
+    for(auto iter = mFloatArrays.begin(); iter != mFloatArrays.end(); ++iter) {
+        permute(**iter, order);
+    }
+    permute(mParentHandle, order);
+    permute(mDirty, order);
+    permute(mHandleOfSlot, order);
+
+    for(uint32_t slot = 0; slot < count; ++slot) {
+        mSlotOfHandle[mHandleOfSlot[slot]] = slot;
+    }
+    for(uint32_t slot = 0; slot < count; ++slot) {
+        uint32_t parent = mParentHandle[slot];
+        mParentSlot[slot] = (parent == INVALID_HANDLE) ? -1 : static_cast<int32_t>(mSlotOfHandle[parent]);
+    }
+
+    mIsSorted = true;
+}
+
+bool TransformPool::_getWorldTransform(uint32_t slot, Ogre::Vector3& position, Ogre::Quaternion& rotation,
+                                       Ogre::Vector3& scale) const {
+    const bool is_dirty = mDirty[slot] != 0;
+    const uint32_t parent_handle = mParentHandle[slot];
+
+    // The bulk setters do not invalidate the children, so any parent may have moved.
+    if(parent_handle != INVALID_HANDLE && (is_dirty || mHasUnpropagatedChanges)) {
+        const uint32_t p = mSlotOfHandle[parent_handle];
+        Ogre::Vector3 parent_position, parent_scale;
+        Ogre::Quaternion parent_rotation;
+        if(_getWorldTransform(p, parent_position, parent_rotation, parent_scale) || is_dirty) {
+            // same composition as _calculate()
+            position = parent_position
+                + Ogre::Quaternion(mRotW[p], mRotX[p], mRotY[p], mRotZ[p]) * Ogre::Vector3(mPosX[slot], mPosY[slot], mPosZ[slot]);
+            rotation = parent_rotation * Ogre::Quaternion(mRotW[slot], mRotX[slot], mRotY[slot], mRotZ[slot]);
+            scale = parent_scale * Ogre::Vector3(mScaleX[slot], mScaleY[slot], mScaleZ[slot]);
+            return true;
+        }
+    } else if(is_dirty) {
+        position = Ogre::Vector3(mPosX[slot], mPosY[slot], mPosZ[slot]);
+        rotation = Ogre::Quaternion(mRotW[slot], mRotX[slot], mRotY[slot], mRotZ[slot]);
+        scale = Ogre::Vector3(mScaleX[slot], mScaleY[slot], mScaleZ[slot]);
+        return true;
+    }
+
+    position = Ogre::Vector3(mWorldPosX[slot], mWorldPosY[slot], mWorldPosZ[slot]);
+    rotation = Ogre::Quaternion(mWorldRotW[slot], mWorldRotX[slot], mWorldRotY[slot], mWorldRotZ[slot]);
+    scale = Ogre::Vector3(mWorldScaleX[slot], mWorldScaleY[slot], mWorldScaleZ[slot]);
+    return false;
+}
+
+void TransformPool::_calculate(uint32_t slot) {
+    uint32_t parent_handle = mParentHandle[slot];
+    if(parent_handle == INVALID_HANDLE) {
+        mWorldPosX[slot] = mPosX[slot];
+        mWorldPosY[slot] = mPosY[slot];
+        mWorldPosZ[slot] = mPosZ[slot];
+        mWorldRotW[slot] = mRotW[slot];
+        mWorldRotX[slot] = mRotX[slot];
+        mWorldRotY[slot] = mRotY[slot];
+        mWorldRotZ[slot] = mRotZ[slot];
+        mWorldScaleX[slot] = mScaleX[slot];
+        mWorldScaleY[slot] = mScaleY[slot];
+        mWorldScaleZ[slot] = mScaleZ[slot];
+        return;
+    }
+
+    uint32_t p = mSlotOfHandle[parent_handle];
+
+    // Same composition as Node: the parent's local rotation is applied to the position.
+    Ogre::Quaternion parent_rotation(mRotW[p], mRotX[p], mRotY[p], mRotZ[p]);
+    Ogre::Vector3 position = Ogre::Vector3(mWorldPosX[p], mWorldPosY[p], mWorldPosZ[p])
+        + parent_rotation * Ogre::Vector3(mPosX[slot], mPosY[slot], mPosZ[slot]);
+    mWorldPosX[slot] = position.x;
+    mWorldPosY[slot] = position.y;
+    mWorldPosZ[slot] = position.z;
+
+    Ogre::Quaternion rotation = Ogre::Quaternion(mWorldRotW[p], mWorldRotX[p], mWorldRotY[p], mWorldRotZ[p])
+        * Ogre::Quaternion(mRotW[slot], mRotX[slot], mRotY[slot], mRotZ[slot]);
+    mWorldRotW[slot] = rotation.w;
+    mWorldRotX[slot] = rotation.x;
+    mWorldRotY[slot] = rotation.y;
+    mWorldRotZ[slot] = rotation.z;
+
+    mWorldScaleX[slot] = mWorldScaleX[p] * mScaleX[slot];
+    mWorldScaleY[slot] = mWorldScaleY[p] * mScaleY[slot];
+    mWorldScaleZ[slot] = mWorldScaleZ[p] * mScaleZ[slot];
+}
+
+void TransformPool::_recordBulkChanges() {
+    if(mJournal != nullptr) {
+        const uint32_t count = getSize();
+        mIsBulkChanged.assign(count, 0);
+        for(auto iter = mBulkChanges.begin(); iter != mBulkChanges.end(); ++iter) {
+            // the entry may have been destroyed since
+            if(mSlotOfHandle[*iter] != INVALID_HANDLE)
+                mIsBulkChanged[mSlotOfHandle[*iter]] = 1;
+        }
+
+        // parents come before their children, so one pass marks the whole subtrees
+        for(uint32_t slot = 0; slot < count; ++slot) {
+            if(!mIsBulkChanged[slot] && mParentSlot[slot] >= 0 && mIsBulkChanged[mParentSlot[slot]])
+                mIsBulkChanged[slot] = 1;
+
+            Node* node = mNodeOfHandle[mHandleOfSlot[slot]];
+            if(mIsBulkChanged[slot] && node != nullptr)
+                mJournal->record(node);
+        }
+    }
+    mBulkChanges.clear();
+}
+
+void TransformPool::_pushBack() {
+    for(auto iter = mFloatArrays.begin(); iter != mFloatArrays.end(); ++iter) {
+        (*iter)->push_back(0.f);
+    }
+    mRotW.back() = 1.f;
+    mScaleX.back() = 1.f;
+    mScaleY.back() = 1.f;
+    mScaleZ.back() = 1.f;
+    mWorldRotW.back() = 1.f;
+    mWorldScaleX.back() = 1.f;
+    mWorldScaleY.back() = 1.f;
+    mWorldScaleZ.back() = 1.f;
+
+    mParentSlot.push_back(-1);
+    mParentHandle.push_back(INVALID_HANDLE);
+    mDirty.push_back(1);
+    mHandleOfSlot.push_back(INVALID_HANDLE);
+}
+
+void TransformPool::_move(uint32_t from, uint32_t to) {
+    for(auto iter = mFloatArrays.begin(); iter != mFloatArrays.end(); ++iter) {
+        (**iter)[to] = (**iter)[from];
+    }
+    mParentSlot[to] = mParentSlot[from];
+    mParentHandle[to] = mParentHandle[from];
+    mDirty[to] = mDirty[from];
+    mHandleOfSlot[to] = mHandleOfSlot[from];
+}
+
+void TransformPool::_popBack() {
+    for(auto iter = mFloatArrays.begin(); iter != mFloatArrays.end(); ++iter) {
+        (*iter)->pop_back();
+    }
+    mParentSlot.pop_back();
+    mParentHandle.pop_back();
+    mDirty.pop_back();
+    mHandleOfSlot.pop_back();
+}
+
+} // namespace dt
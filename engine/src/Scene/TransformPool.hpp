@@ -0,0 +1,289 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_SCENE_TRANSFORMPOOL
+#define DUCTTAPE_ENGINE_SCENE_TRANSFORMPOOL
+
+#include <Config.hpp>
+
+#include <OgreQuaternion.h>
+#include <OgreVector3.h>
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace dt {
+
+// forward declaration due to circular dependency
+class Node;
+class TransformJournal;
+
+/**
+  * Contiguous storage for the local and world transforms of all Nodes of a Scene.
+  * The transforms are kept as a structure of arrays, sorted so that every parent comes before
+  * its children (grouped by depth). This allows updateWorldTransforms() to recalculate all world
+  * transforms in a single linear pass, four entries at a time if SSE is available.
+  * Entries are addressed by handles, which stay valid while the arrays are being reordered.
+  * The Nodes moved by the bulk setters, and their children, are recorded in the journal set with setJournal()
+  * by the next updateWorldTransforms(). The world getters never write to the pool, so they can be called from
+  * several threads at once; outdated world transforms are calculated from the parents on every call until the
+  * next updateWorldTransforms().
+  * @see Scene::getTransformPool()
+  */
+class DUCTTAPE_API TransformPool {
+
+    Q_DISABLE_COPY(TransformPool)
+
+public:
+    static const uint32_t INVALID_HANDLE;   //!< The handle for "no entry", e.g. the parent of a root.
+
+    /**
+      * Default constructor.
+      */
+    TransformPool();
+
+    /**
+      * Sets the journal that records the Nodes changed by the bulk setters.
+      * @param journal The journal, or nullptr to not record them.
+      */
+    void setJournal(TransformJournal* journal);
+
+    /**
+      * Creates a new entry with identity transform.
+      * @param parent The handle of the parent entry, or INVALID_HANDLE.
+      * @param node The Node the entry belongs to, or nullptr. Only used to record changes in the journal.
+      * @returns The handle of the new entry.
+      */
+    uint32_t create(uint32_t parent = INVALID_HANDLE, Node* node = nullptr);
+
+    /**
+      * Destroys an entry. Its children have to be destroyed or reparented before.
+      * @param handle The handle of the entry to destroy.
+      */
+    void destroy(uint32_t handle);
+
+    /**
+      * Sets the parent of an entry. The caller has to invalidate the entry and its children.
+      * @param handle The handle of the entry.
+      * @param parent The handle of the new parent entry, or INVALID_HANDLE.
+      */
+    void setParent(uint32_t handle, uint32_t parent);
+
+    /**
+      * Returns the number of entries.
+      * @returns The number of entries.
+      */
+    uint32_t getSize() const;
+
+    /**
+      * Allocates the memory for a number of entries in advance, e.g. before creating many Nodes.
+      * @param count The total number of entries to make room for.
+      */
+    void reserve(uint32_t count);
+
+    /**
+      * Returns the local position of an entry.
+      * @param handle The handle of the entry.
+      * @returns The local position.
+      */
+    Ogre::Vector3 getPosition(uint32_t handle) const;
+
+    /**
+      * Sets the local position of an entry. The caller has to invalidate the entry and its children.
+      * @param handle The handle of the entry.
+      * @param position The new local position.
+      */
+    void setPosition(uint32_t handle, const Ogre::Vector3& position);
+
+    /**
+      * Sets the local positions of many entries at once. The children of these entries are
+      * updated by the next call to updateWorldTransforms() at the latest.
+      * @param handles The handles of the entries.
+      * @param positions The new local positions, one for each handle.
+      */
+    void setPositions(const std::vector<uint32_t>& handles, const std::vector<Ogre::Vector3>& positions);
+
+    /**
+      * Returns the local scale of an entry.
+      * @param handle The handle of the entry.
+      * @returns The local scale.
+      */
+    Ogre::Vector3 getScale(uint32_t handle) const;
+
+    /**
+      * Sets the local scale of an entry. The caller has to invalidate the entry and its children.
+      * @param handle The handle of the entry.
+      * @param scale The new local scale.
+      */
+    void setScale(uint32_t handle, const Ogre::Vector3& scale);
+
+    /**
+      * Sets the local scales of many entries at once.
+      * @param handles The handles of the entries.
+      * @param scales The new local scales, one for each handle.
+      */
+    void setScales(const std::vector<uint32_t>& handles, const std::vector<Ogre::Vector3>& scales);
+
+    /**
+      * Returns the local rotation of an entry.
+      * @param handle The handle of the entry.
+      * @returns The local rotation.
+      */
+    Ogre::Quaternion getRotation(uint32_t handle) const;
+
+    /**
+      * Sets the local rotation of an entry. The caller has to invalidate the entry and its children.
+      * @param handle The handle of the entry.
+      * @param rotation The new local rotation.
+      */
+    void setRotation(uint32_t handle, const Ogre::Quaternion& rotation);
+
+    /**
+      * Sets the local rotations of many entries at once.
+      * @param handles The handles of the entries.
+      * @param rotations The new local rotations, one for each handle.
+      */
+    void setRotations(const std::vector<uint32_t>& handles, const std::vector<Ogre::Quaternion>& rotations);
+
+    /**
+      * Returns the world position of an entry, calculating it from the parents if required, without storing it.
+      * @param handle The handle of the entry.
+      * @returns The world position.
+      */
+    Ogre::Vector3 getWorldPosition(uint32_t handle) const;
+
+    /**
+      * Returns the world scale of an entry, calculating it from the parents if required, without storing it.
+      * @param handle The handle of the entry.
+      * @returns The world scale.
+      */
+    Ogre::Vector3 getWorldScale(uint32_t handle) const;
+
+    /**
+      * Returns the world rotation of an entry, calculating it from the parents if required, without storing it.
+      * @param handle The handle of the entry.
+      * @returns The world rotation.
+      */
+    Ogre::Quaternion getWorldRotation(uint32_t handle) const;
+
+    /**
+      * Marks the world transform of an entry as outdated. The caller is responsible for
+      * invalidating the children as well.
+      * @param handle The handle of the entry.
+      */
+    void invalidate(uint32_t handle);
+
+    /**
+      * Returns whether the world transform of an entry is outdated.
+      * @param handle The handle of the entry.
+      * @returns Whether the world transform of an entry is outdated.
+      */
+    bool isDirty(uint32_t handle) const;
+
+    /**
+      * Returns whether the bulk setters changed entries since the last updateWorldTransforms().
+      * @returns Whether there are changes that have not been propagated to the children yet.
+      */
+    bool hasUnpropagatedChanges() const;
+
+    /**
+      * Returns the number of calls to the bulk setters so far. World transforms cached outside of the pool
+      * before this number changed may be outdated, as the bulk setters do not invalidate any entry.
+      * @returns The number of bulk changes.
+      */
+    uint32_t getBulkChangeCount() const;
+
+    /**
+      * Recalculates the world transforms of all entries in one batch pass, and records the Nodes changed by the
+      * bulk setters since the last pass in the journal, together with all of their children. Does nothing if no
+      * entry has been created, invalidated or changed by the bulk setters since the last pass.
+      */
+    void updateWorldTransforms();
+
+private:
+    /**
+      * Reorders the arrays by depth, so every parent comes before its children.
+      */
+    void _sort();
+
+    /**
+      * Private method. Returns the world transform of a single entry, calculating it from its parents if required.
+      * Nothing is stored.
+      * @param slot The array index of the entry.
+      * @param position Receives the world position.
+      * @param rotation Receives the world rotation.
+      * @param scale Receives the world scale.
+      * @returns Whether the world transform has been calculated instead of read from the arrays.
+      */
+    bool _getWorldTransform(uint32_t slot, Ogre::Vector3& position, Ogre::Quaternion& rotation,
+                            Ogre::Vector3& scale) const;
+
+    /**
+      * Calculates the world transform of the entry at the given slot from its parent.
+      * @param slot The array index of the entry.
+      */
+    void _calculate(uint32_t slot);
+
+    /**
+      * Records the Nodes of the entries changed by the bulk setters and of their children in the journal.
+      * The arrays have to be sorted.
+      */
+    void _recordBulkChanges();
+
+    /**
+      * Appends an entry at the end of the arrays.
+      */
+    void _pushBack();
+
+    /**
+      * Moves the entry at one slot to another slot, overwriting it.
+      * @param from The source slot.
+      * @param to The destination slot.
+      */
+    void _move(uint32_t from, uint32_t to);
+
+    /**
+      * Removes the last entry of the arrays.
+      */
+    void _popBack();
+
+    // local transform
+    std::vector<float> mPosX, mPosY, mPosZ;                 //!< The local positions.
+    std::vector<float> mRotW, mRotX, mRotY, mRotZ;          //!< The local rotations.
+    std::vector<float> mScaleX, mScaleY, mScaleZ;           //!< The local scales.
+
+    // world transform
+    std::vector<float> mWorldPosX, mWorldPosY, mWorldPosZ;              //!< The world positions.
+    std::vector<float> mWorldRotW, mWorldRotX, mWorldRotY, mWorldRotZ;  //!< The world rotations.
+    std::vector<float> mWorldScaleX, mWorldScaleY, mWorldScaleZ;        //!< The world scales.
+
+    std::vector<int32_t> mParentSlot;       //!< The array index of each entry's parent, or -1.
+    std::vector<uint32_t> mParentHandle;    //!< The handle of each entry's parent.
+    std::vector<uint8_t> mDirty;            //!< Whether the world transform of each entry is outdated.
+    std::vector<uint32_t> mHandleOfSlot;    //!< The handle of the entry at each array index.
+
+    std::vector<uint32_t> mSlotOfHandle;    //!< The array index for each handle.
+    std::vector<uint32_t> mFreeHandles;     //!< Handles that can be reused.
+    std::vector<std::vector<float>*> mFloatArrays;  //!< All of the float arrays above, for moving entries around.
+
+    std::vector<Node*> mNodeOfHandle;       //!< The Node of each handle, or nullptr.
+    std::vector<uint32_t> mBulkChanges;     //!< The handles changed by the bulk setters since the last pass.
+    std::vector<uint8_t> mIsBulkChanged;    //!< Whether each entry or one of its parents is in mBulkChanges. Scratch space.
+    TransformJournal* mJournal;             //!< The journal recording the Nodes changed by the bulk setters.
+
+    bool mIsSorted;                 //!< Whether the arrays are sorted by depth.
+    std::atomic<bool> mHasDirtyEntries; //!< Whether an entry may have an outdated world transform. Set by the parallel update workers as well.
+    uint32_t mBulkChangeCount;      //!< The number of calls to the bulk setters.
+    bool mHasUnpropagatedChanges;   //!< Whether bulk setters changed entries without invalidating their children.
+};
+
+} // namespace dt
+
+#endif
@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_UTILS_COPYONWRITE
+#define DUCTTAPE_ENGINE_UTILS_COPYONWRITE
+
+#include <Config.hpp>
+
+#include <memory>
+
+namespace dt {
+
+/**
+  * A value that is shared between copies until one of them changes it.
+  * Copying only copies a pointer. The first write access to a shared value makes a private copy of it,
+  * so the other copies keep the old value. Used for the configuration of components, which is the
+  * same for all instances of a Prefab.
+  * @see Prefab
+  */
+template <typename T>
+class CopyOnWrite {
+public:
+    /**
+      * Default constructor. Creates a default constructed value.
+      */
+    CopyOnWrite()
+        : mData(std::make_shared<T>()) {}
+
+    /**
+      * Constructor.
+      * @param data The value.
+      */
+    explicit CopyOnWrite(const T& data)
+        : mData(std::make_shared<T>(data)) {}
+
+    /**
+      * Returns the value for reading.
+      * @returns The value.
+      */
+    const T& get() const {
+        return *mData;
+    }
+
+    /**
+      * Returns the value for reading.
+      * @returns A pointer to the value.
+      */
+    const T* operator->() const {
+        return mData.get();
+    }
+
+    /**
+      * Returns the value for writing. Makes a private copy first if it is shared.
+      * @returns The value.
+      */
+    T& edit() {
+        if(!mData.unique())
+            mData = std::make_shared<T>(*mData);
+        return *mData;
+    }
+
+    /**
+      * Returns whether the value is shared with another copy.
+      * @returns Whether the value is shared.
+      */
+    bool isShared() const {
+        return !mData.unique();
+    }
+
+    /**
+      * Returns whether the value is shared with a certain copy.
+      * @param other The other copy.
+      * @returns Whether both use the same value.
+      */
+    bool isSharedWith(const CopyOnWrite<T>& other) const {
+        return mData == other.mData;
+    }
+
+private:
+    std::shared_ptr<T> mData;   //!< The value, shared between the copies.
+};
+
+} // namespace dt
+
+#endif
@@ -0,0 +1,111 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_UTILS_HANDLE
+#define DUCTTAPE_ENGINE_UTILS_HANDLE
+
+#include <Config.hpp>
+
+#include <Utils/HandleTable.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace dt {
+
+/**
+  * A weak reference to a Node or Component: the 32-bit index of its slot in the HandleTable and the 32-bit
+  * generation of the slot. Unlike a shared pointer it does not keep the object alive and copying it does
+  * not touch a reference count. Resolve it with get() every time the object is needed; it returns nullptr
+  * once the object has been destroyed.
+  * @param Type The type of the object.
+  * @param Base The type the object has been registered with, i.e. Node or Component.
+  * @see Node::getHandle()
+  * @see Component::getHandle()
+  */
+template <typename Type, typename Base = Type>
+class Handle {
+public:
+    /**
+      * Default constructor. Creates a handle that refers to nothing.
+      */
+    Handle()
+        : mIndex(HandleTable::INVALID_INDEX),
+          mGeneration(0) {}
+
+    /**
+      * Constructor.
+      * @param index The index of the slot.
+      * @param generation The generation of the slot.
+      */
+    Handle(uint32_t index, uint32_t generation)
+        : mIndex(index),
+          mGeneration(generation) {}
+
+    /**
+      * Converts a handle to a derived type, e.g. of a MeshComponent to one of a Component.
+      * @param other The handle.
+      */
+    template <typename Other>
+    Handle(const Handle<Other, Base>& other)
+        : mIndex(other.getIndex()),
+          mGeneration(other.getGeneration()) {
+        static_assert(std::is_convertible<Other*, Type*>::value, "The handle cannot be converted to this type.");
+    }
+
+    /**
+      * Returns the object.
+      * @returns The object, or nullptr if it has been destroyed or the handle refers to nothing.
+      */
+    Type* get() const {
+        return static_cast<Type*>(static_cast<Base*>(HandleTable::resolve(mIndex, mGeneration)));
+    }
+
+    Type* operator->() const {
+        return get();
+    }
+
+    /**
+      * Returns whether the object still exists.
+      * @returns Whether get() returns an object.
+      */
+    bool isValid() const {
+        return get() != nullptr;
+    }
+
+    /**
+      * Returns the index of the slot.
+      * @returns The index.
+      */
+    uint32_t getIndex() const {
+        return mIndex;
+    }
+
+    /**
+      * Returns the generation of the slot the handle was created with.
+      * @returns The generation.
+      */
+    uint32_t getGeneration() const {
+        return mGeneration;
+    }
+
+    bool operator==(const Handle& other) const {
+        return mIndex == other.mIndex && mGeneration == other.mGeneration;
+    }
+
+    bool operator!=(const Handle& other) const {
+        return !(*this == other);
+    }
+
+private:
+    uint32_t mIndex;        //!< The index of the slot.
+    uint32_t mGeneration;   //!< The generation of the slot.
+};
+
+} // namespace dt
+
+#endif
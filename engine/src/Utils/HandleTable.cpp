@@ -0,0 +1,135 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Utils/HandleTable.hpp>
+
+#include <Utils/Logger.hpp>
+#include <Utils/Utils.hpp>
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <atomic>
+#include <vector>
+
+namespace dt {
+
+namespace {
+
+/**
+  * One slot of the table. Written under the lock of the table, read without it.
+  */
+struct Slot {
+    std::atomic<void*> mObject;         //!< The object, or nullptr if the slot is free.
+    std::atomic<uint32_t> mGeneration;  //!< Increased every time the slot is freed.
+};
+
+const uint32_t MAX_CHUNKS = 4096;   //!< The size of the chunk directory.
+
+/**
+  * The global table. Allocating and releasing is locked, resolving only reads the chunks.
+  */
+struct Table {
+    Table()
+        : mSlotCount(0),
+          mSlotsInUse(0) {
+        for(uint32_t i = 0; i < MAX_CHUNKS; ++i) {
+            mChunks[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    QMutex mMutex;
+    std::atomic<Slot*> mChunks[MAX_CHUNKS]; //!< The chunks of slots. Never moved or freed.
+    uint32_t mSlotCount;                //!< The number of slots handed out so far.
+    uint32_t mSlotsInUse;               //!< The number of slots with an object.
+    std::vector<uint32_t> mFreeIndices; //!< The released slots, reused last in first out.
+};
+
+Table& getTable() {
+    // constructed on first use, Nodes may be created during static initialization
+    static Table table;
+    return table;
+}
+
+} // anonymous namespace
+
+const uint32_t HandleTable::INVALID_INDEX = 0xffffffff;
+const uint32_t HandleTable::CHUNK_SIZE = 4096;
+const uint32_t HandleTable::MAX_SLOTS = MAX_CHUNKS * 4096;
+
+void HandleTable::allocate(void* object, uint32_t& index, uint32_t& generation) {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+
+    if(!table.mFreeIndices.empty()) {
+        index = table.mFreeIndices.back();
+        table.mFreeIndices.pop_back();
+    } else if(table.mSlotCount < MAX_SLOTS) {
+        index = table.mSlotCount++;
+        std::atomic<Slot*>& chunk = table.mChunks[index / CHUNK_SIZE];
+        if(chunk.load(std::memory_order_relaxed) == nullptr) {
+            Slot* new_chunk = new Slot[CHUNK_SIZE];
+            for(uint32_t i = 0; i < CHUNK_SIZE; ++i) {
+                // generation 0 is never valid, so default handles never resolve
+                new_chunk[i].mObject.store(nullptr, std::memory_order_relaxed);
+                new_chunk[i].mGeneration.store(1, std::memory_order_relaxed);
+            }
+            // the slots are initialized before resolve() can see the chunk
+            chunk.store(new_chunk, std::memory_order_release);
+        }
+    } else {
+        Logger::get().error("Cannot create a handle: all " + Utils::toString(MAX_SLOTS) + " slots are in use.");
+        index = INVALID_INDEX;
+        generation = 0;
+        return;
+    }
+
+    Slot& slot = table.mChunks[index / CHUNK_SIZE].load(std::memory_order_relaxed)[index % CHUNK_SIZE];
+    slot.mObject.store(object, std::memory_order_release);
+    generation = slot.mGeneration.load(std::memory_order_relaxed);
+    ++table.mSlotsInUse;
+}
+
+void HandleTable::release(uint32_t index) {
+    if(index == INVALID_INDEX)
+        return;
+
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+
+    Slot& slot = table.mChunks[index / CHUNK_SIZE].load(std::memory_order_relaxed)[index % CHUNK_SIZE];
+    slot.mObject.store(nullptr, std::memory_order_relaxed);
+    uint32_t next = slot.mGeneration.load(std::memory_order_relaxed) + 1;
+    slot.mGeneration.store(next == 0 ? 1 : next, std::memory_order_release);
+    table.mFreeIndices.push_back(index);
+    --table.mSlotsInUse;
+}
+
+void* HandleTable::resolve(uint32_t index, uint32_t generation) {
+    if(index >= MAX_SLOTS)
+        return nullptr;
+
+    const Slot* chunk = getTable().mChunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+    if(chunk == nullptr)
+        return nullptr;
+
+    // The slot may be released and reused meanwhile. The object is only returned if the generation
+    // has not changed while it was read.
+    const Slot& slot = chunk[index % CHUNK_SIZE];
+    if(slot.mGeneration.load(std::memory_order_acquire) != generation)
+        return nullptr;
+    void* object = slot.mObject.load(std::memory_order_acquire);
+    return slot.mGeneration.load(std::memory_order_acquire) == generation ? object : nullptr;
+}
+
+uint32_t HandleTable::getSlotsInUse() {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    return table.mSlotsInUse;
+}
+
+} // namespace dt
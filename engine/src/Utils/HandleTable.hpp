@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_UTILS_HANDLETABLE
+#define DUCTTAPE_ENGINE_UTILS_HANDLETABLE
+
+#include <Config.hpp>
+
+#include <cstdint>
+
+namespace dt {
+
+/**
+  * The global table behind the generational handles of Nodes and Components. Every object gets a slot,
+  * addressed by a 32-bit index, and the slot has a 32-bit generation that is increased when the object is
+  * destroyed. A handle stores the index and the generation it was created with, so resolving it is a single
+  * array access, and a handle to a destroyed object resolves to nullptr even after its slot has been reused.
+  * The slots are allocated in chunks that never move, and their fields are atomic, so handles can be resolved
+  * from any thread while other objects are being created or released. Nodes and Components release their slot
+  * when they are removed from their parent, before they are destroyed. Using the object of a handle while another
+  * thread removes it is still not safe.
+  * @see Handle
+  */
+class DUCTTAPE_API HandleTable {
+public:
+    static const uint32_t INVALID_INDEX;    //!< The index of a handle that refers to nothing.
+    static const uint32_t CHUNK_SIZE;       //!< The number of slots allocated at once.
+    static const uint32_t MAX_SLOTS;        //!< The maximum number of objects alive at the same time.
+
+    /**
+      * Assigns a slot to an object.
+      * @param object The object.
+      * @param index Is set to the index of the slot.
+      * @param generation Is set to the current generation of the slot.
+      */
+    static void allocate(void* object, uint32_t& index, uint32_t& generation);
+
+    /**
+      * Frees the slot of a destroyed object. All handles to it become stale.
+      * @param index The index of the slot.
+      */
+    static void release(uint32_t index);
+
+    /**
+      * Returns the object of a handle.
+      * @param index The index of the slot.
+      * @param generation The generation the handle was created with.
+      * @returns The object, or nullptr if it has been destroyed or the handle is invalid.
+      */
+    static void* resolve(uint32_t index, uint32_t generation);
+
+    /**
+      * Returns the number of objects that have a slot.
+      * @returns The number of slots in use.
+      */
+    static uint32_t getSlotsInUse();
+};
+
+} // namespace dt
+
+#endif
@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Utils/Name.hpp>
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <vector>
+
+namespace dt {
+
+namespace {
+
+/**
+  * The global string table. Names are created from several threads, so all access is locked.
+  */
+struct NameTable {
+    NameTable() {
+        // the empty string always has the id 0
+        mStrings.push_back(QString());
+        mIds.insert(QString(), 0);
+    }
+
+    QMutex mMutex;
+    std::vector<QString> mStrings;  //!< The string of each id.
+    QHash<QString, uint32_t> mIds;  //!< The id of each string.
+};
+
+NameTable& getTable() {
+    // constructed on first use, Names may be created during static initialization
+    static NameTable table;
+    return table;
+}
+
+const uint32_t GENERATED_BIT = 0x80000000;      //!< Set in the ids of generated names.
+const uint32_t COMPONENT_BIT = 0x40000000;      //!< Set in the ids of generated component names.
+const uint32_t MAX_GENERATED = 0x3ffffffe;      //!< The largest number of a generated name, below INVALID_ID.
+
+const char* PREFIXES[] = {"Node-", "Component-"};
+
+/**
+  * Returns the id of a generated name.
+  * @param prefix The prefix.
+  * @param number The number, between 1 and MAX_GENERATED.
+  */
+uint32_t generatedId(Name::Prefix prefix, uint32_t number) {
+    return GENERATED_BIT | (prefix == Name::COMPONENT ? COMPONENT_BIT : 0) | number;
+}
+
+/**
+  * Parses a string that looks like a generated name. Only the exact form getName() produces is accepted,
+  * e.g. "Node-012" is an ordinary string, so every generated id stands for exactly one string.
+  * @param string The string.
+  * @param id Is set to the id of the generated name.
+  * @returns Whether the string is a generated name.
+  */
+bool parseGenerated(const QString& string, uint32_t& id) {
+    for(uint32_t p = 0; p < 2; ++p) {
+        QString prefix(PREFIXES[p]);
+        if(!string.startsWith(prefix))
+            continue;
+
+        int32_t length = string.size() - prefix.size();
+        if(length < 1 || length > 10 || string.at(prefix.size()).unicode() == '0')
+            return false;
+
+        uint64_t number = 0;
+        for(int32_t i = prefix.size(); i < string.size(); ++i) {
+            ushort c = string.at(i).unicode();
+            if(c < '0' || c > '9')
+                return false;
+            number = number * 10 + (c - '0');
+        }
+        if(number > MAX_GENERATED)
+            return false;
+
+        id = generatedId(static_cast<Name::Prefix>(p), static_cast<uint32_t>(number));
+        return true;
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+const uint32_t Name::INVALID_ID = 0xffffffff;
+
+Name::Name()
+    : mId(0) {}
+
+Name::Name(const QString& string) {
+    if(parseGenerated(string, mId))
+        return;
+
+    NameTable& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+
+    QHash<QString, uint32_t>::const_iterator iter = table.mIds.find(string);
+    if(iter != table.mIds.end()) {
+        mId = iter.value();
+    } else {
+        mId = table.mStrings.size();
+        table.mStrings.push_back(string);
+        table.mIds.insert(string, mId);
+    }
+}
+
+Name Name::find(const QString& string) {
+    Name name;
+    if(parseGenerated(string, name.mId))
+        return name;
+
+    NameTable& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+
+    name.mId = table.mIds.value(string, INVALID_ID);
+    return name;
+}
+
+Name Name::generated(Prefix prefix, uint32_t number) {
+    // numbers that cannot be encoded are interned like any other string
+    if(number == 0 || number > MAX_GENERATED)
+        return Name(QString(PREFIXES[prefix]) + QString::number(number));
+
+    Name name;
+    name.mId = generatedId(prefix, number);
+    return name;
+}
+
+uint32_t Name::getId() const {
+    return mId;
+}
+
+bool Name::isValid() const {
+    return mId != INVALID_ID;
+}
+
+QString Name::toString() const {
+    if(!isValid())
+        return QString();
+    if(mId & GENERATED_BIT)
+        return QString(PREFIXES[(mId & COMPONENT_BIT) ? COMPONENT : NODE]) + QString::number(mId & ~(GENERATED_BIT | COMPONENT_BIT));
+
+    NameTable& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    return table.mStrings[mId];
+}
+
+bool Name::operator==(const Name& other) const {
+    return mId == other.mId;
+}
+
+bool Name::operator!=(const Name& other) const {
+    return mId != other.mId;
+}
+
+bool Name::operator<(const Name& other) const {
+    return mId < other.mId;
+}
+
+} // namespace dt
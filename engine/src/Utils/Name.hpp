@@ -0,0 +1,99 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_UTILS_NAME
+#define DUCTTAPE_ENGINE_UTILS_NAME
+
+#include <Config.hpp>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace dt {
+
+/**
+  * An interned string. Every distinct string is stored once in a global table and a Name is only
+  * the 32-bit index into this table, so comparing and hashing Names is as cheap as comparing integers.
+  * Use it for names that are looked up often, e.g. of Nodes and Components.
+  * Strings are never removed from the table. The names generated for Nodes and Components without a
+  * name, like "Node-12", are therefore not stored at all: their number is encoded in the id instead, so
+  * spawning and killing objects does not grow the table.
+  */
+class DUCTTAPE_API Name {
+public:
+    static const uint32_t INVALID_ID;   //!< The id of a Name that has never been interned.
+
+    /**
+      * The prefixes of generated names.
+      */
+    enum Prefix {
+        NODE,       //!< "Node-<number>"
+        COMPONENT   //!< "Component-<number>"
+    };
+
+    /**
+      * Default constructor. Creates the empty name.
+      */
+    Name();
+
+    /**
+      * Constructor. Adds the string to the table if it is not interned yet.
+      * @param string The string.
+      */
+    explicit Name(const QString& string);
+
+    /**
+      * Returns the Name of a string without adding it to the table.
+      * @param string The string.
+      * @returns The Name, which is invalid if the string has never been interned.
+      */
+    static Name find(const QString& string);
+
+    /**
+      * Returns the Name of a generated name without adding it to the table. It is equal to the Name of the
+      * same string, e.g. generated(NODE, 12) == Name("Node-12").
+      * @param prefix The prefix of the name.
+      * @param number The number of the name.
+      * @returns The Name.
+      */
+    static Name generated(Prefix prefix, uint32_t number);
+
+    /**
+      * Returns the id of this Name.
+      * @returns The id of this Name.
+      */
+    uint32_t getId() const;
+
+    /**
+      * Returns whether this Name has been interned, i.e. if it can be equal to any other Name.
+      * @returns Whether this Name is valid.
+      */
+    bool isValid() const;
+
+    /**
+      * Returns the string of this Name.
+      * @returns The string of this Name, or an empty string if it is invalid.
+      */
+    QString toString() const;
+
+    bool operator==(const Name& other) const;
+
+    bool operator!=(const Name& other) const;
+
+    /**
+      * Orders Names by their id, not alphabetically.
+      */
+    bool operator<(const Name& other) const;
+
+private:
+    uint32_t mId;   //!< The index of the string in the table.
+};
+
+} // namespace dt
+
+#endif
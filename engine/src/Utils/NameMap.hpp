@@ -0,0 +1,267 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_UTILS_NAMEMAP
+#define DUCTTAPE_ENGINE_UTILS_NAMEMAP
+
+#include <Config.hpp>
+
+#include <Utils/Name.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace dt {
+
+/**
+  * A flat hash map from Names to values.
+  * The entries are stored contiguously in insertion order, an open-addressing table with linear
+  * probing maps the Names to the entries. Erasing an entry moves the last entry into its place,
+  * so erasing invalidates iterators to the last entry, and inserting may invalidate all iterators.
+  * The interface follows std::map where possible.
+  */
+template <typename Value>
+class NameMap {
+public:
+    typedef std::pair<Name, Value> Entry;
+    typedef typename std::vector<Entry>::iterator iterator;
+    typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+    /**
+      * Default constructor.
+      */
+    NameMap()
+        : mMask(0),
+          mShift(32) {}
+
+    iterator begin() {
+        return mEntries.begin();
+    }
+
+    const_iterator begin() const {
+        return mEntries.begin();
+    }
+
+    iterator end() {
+        return mEntries.end();
+    }
+
+    const_iterator end() const {
+        return mEntries.end();
+    }
+
+    /**
+      * Returns the number of entries.
+      * @returns The number of entries.
+      */
+    uint32_t size() const {
+        return mEntries.size();
+    }
+
+    /**
+      * Returns whether the map is empty.
+      * @returns Whether the map is empty.
+      */
+    bool empty() const {
+        return mEntries.empty();
+    }
+
+    /**
+      * Searches for an entry.
+      * @param name The Name to search for.
+      * @returns An iterator to the entry, or end() if there is none.
+      */
+    iterator find(const Name& name) {
+        uint32_t slot = _findSlot(name);
+        if(mSlots.empty() || mSlots[slot] == EMPTY)
+            return mEntries.end();
+        return mEntries.begin() + mSlots[slot];
+    }
+
+    /**
+      * Searches for an entry.
+      * @param name The Name to search for.
+      * @returns An iterator to the entry, or end() if there is none.
+      */
+    const_iterator find(const Name& name) const {
+        uint32_t slot = _findSlot(name);
+        if(mSlots.empty() || mSlots[slot] == EMPTY)
+            return mEntries.end();
+        return mEntries.begin() + mSlots[slot];
+    }
+
+    /**
+      * Returns the number of entries with the Name, which is either 0 or 1.
+      * @param name The Name to search for.
+      * @returns The number of entries with the Name.
+      */
+    uint32_t count(const Name& name) const {
+        return (find(name) != end()) ? 1 : 0;
+    }
+
+    /**
+      * Adds an entry, if there is none with the same Name yet.
+      * @param entry The entry to add.
+      * @returns An iterator to the entry with the Name, and whether the entry has been added.
+      */
+    std::pair<iterator, bool> insert(const Entry& entry) {
+        if((mEntries.size() + 1) * 2 > mSlots.size())
+            _rehash(mSlots.empty() ? 8 : mSlots.size() * 2);
+
+        uint32_t slot = _findSlot(entry.first);
+        if(mSlots[slot] != EMPTY)
+            return std::make_pair(mEntries.begin() + mSlots[slot], false);
+
+        mSlots[slot] = mEntries.size();
+        mEntries.push_back(entry);
+        return std::make_pair(mEntries.end() - 1, true);
+    }
+
+    /**
+      * Returns the value for a Name, adding a default constructed one if there is none.
+      * @param name The Name.
+      * @returns The value.
+      */
+    Value& operator[](const Name& name) {
+        return insert(Entry(name, Value())).first->second;
+    }
+
+    /**
+      * Removes an entry.
+      * @param position An iterator to the entry.
+      * @returns An iterator to the entry that took its place, which is end() if it was the last one.
+      */
+    iterator erase(iterator position) {
+        uint32_t index = position - mEntries.begin();
+        _eraseSlot(_findSlot(position->first));
+
+        // move the last entry into the gap
+        uint32_t last = mEntries.size() - 1;
+        if(index != last) {
+            mSlots[_findSlot(mEntries[last].first)] = index;
+            mEntries[index] = std::move(mEntries[last]);
+        }
+        mEntries.pop_back();
+        return mEntries.begin() + index;
+    }
+
+    /**
+      * Removes the entry with a Name.
+      * @param name The Name.
+      * @returns The number of entries removed.
+      */
+    uint32_t erase(const Name& name) {
+        iterator iter = find(name);
+        if(iter == end())
+            return 0;
+        erase(iter);
+        return 1;
+    }
+
+    /**
+      * Allocates the memory for a number of entries in advance.
+      * @param count The total number of entries to make room for.
+      */
+    void reserve(uint32_t count) {
+        mEntries.reserve(count);
+        uint32_t size = mSlots.empty() ? 8 : mSlots.size();
+        while(count * 2 > size) {
+            size *= 2;
+        }
+        if(size != mSlots.size())
+            _rehash(size);
+    }
+
+    /**
+      * Removes all entries.
+      */
+    void clear() {
+        mEntries.clear();
+        mSlots.clear();
+        mMask = 0;
+        mShift = 32;
+    }
+
+private:
+    static const uint32_t EMPTY = 0xffffffff;   //!< The value of unused slots.
+
+    /**
+      * Returns the preferred slot of a Name.
+      * @param name The Name.
+      * @returns The slot.
+      */
+    uint32_t _hash(const Name& name) const {
+        // Fibonacci hashing, the ids are consecutive
+        return (name.getId() * 2654435769u) >> mShift;
+    }
+
+    /**
+      * Returns the slot containing a Name, or the empty slot where it would be inserted.
+      * @param name The Name.
+      * @returns The slot, or 0 if there are no slots.
+      */
+    uint32_t _findSlot(const Name& name) const {
+        if(mSlots.empty())
+            return 0;
+
+        uint32_t slot = _hash(name);
+        while(mSlots[slot] != EMPTY && mEntries[mSlots[slot]].first != name) {
+            slot = (slot + 1) & mMask;
+        }
+        return slot;
+    }
+
+    /**
+      * Empties a slot, moving following entries back so no lookup chain is broken.
+      * @param slot The slot.
+      */
+    void _eraseSlot(uint32_t slot) {
+        uint32_t next = slot;
+        while(true) {
+            next = (next + 1) & mMask;
+            if(mSlots[next] == EMPTY)
+                break;
+
+            // move the entry back if its preferred slot is not between the gap and its position
+            uint32_t preferred = _hash(mEntries[mSlots[next]].first);
+            if(((next - preferred) & mMask) >= ((next - slot) & mMask)) {
+                mSlots[slot] = mSlots[next];
+                slot = next;
+            }
+        }
+        mSlots[slot] = EMPTY;
+    }
+
+    /**
+      * Resizes the slot table and reinserts all entries.
+      * @param size The new number of slots, a power of two.
+      */
+    void _rehash(uint32_t size) {
+        mSlots.assign(size, EMPTY);
+        mMask = size - 1;
+        mShift = 32;
+        for(uint32_t i = size; i > 1; i /= 2) {
+            --mShift;
+        }
+        for(uint32_t i = 0; i < mEntries.size(); ++i) {
+            mSlots[_findSlot(mEntries[i].first)] = i;
+        }
+    }
+
+    std::vector<Entry> mEntries;    //!< The entries in insertion order.
+    std::vector<uint32_t> mSlots;   //!< The index in mEntries for each slot, or EMPTY.
+    uint32_t mMask;                 //!< The number of slots minus one.
+    uint32_t mShift;                //!< 32 minus the number of bits of a slot index.
+};
+
+template <typename Value>
+const uint32_t NameMap<Value>::EMPTY;
+
+} // namespace dt
+
+#endif
@@ -0,0 +1,365 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Utils/Profiler.hpp>
+
+#include <Utils/Logger.hpp>
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <sstream>
+
+namespace dt {
+
+namespace {
+
+const uint32_t MAX_THREADS = 64;    //!< The maximum number of threads that can record zones.
+
+/**
+  * A finished zone.
+  */
+struct ZoneEvent {
+    const char* mName;      //!< The name of the zone.
+    int64_t mBegin;         //!< The start of the zone, in microseconds.
+    int64_t mEnd;           //!< The end of the zone, in microseconds.
+    int64_t mSelfTime;      //!< The time not spent in nested zones, in microseconds.
+    uint32_t mThread;       //!< The index of the thread that recorded the zone.
+};
+
+/**
+  * A zone that has been started but not ended yet.
+  */
+struct OpenZone {
+    const char* mName;      //!< The name of the zone.
+    int64_t mBegin;         //!< The start of the zone, in microseconds.
+    int64_t mChildTime;     //!< The time spent in the nested zones so far, in microseconds.
+};
+
+/**
+  * The zones of one thread.
+  */
+struct ThreadBuffer {
+    QMutex mMutex;                      //!< Guards mEvents and mName.
+    uint32_t mIndex;                    //!< The index of the thread.
+    QString mName;                      //!< The name of the thread in the trace, or empty.
+    std::vector<ZoneEvent> mEvents;     //!< The finished zones not taken over by a frame yet.
+    std::vector<OpenZone> mOpenZones;   //!< The started zones. Only used by the thread itself.
+};
+
+/**
+  * A finished frame.
+  */
+struct Frame {
+    int64_t mBegin;                             //!< The start of the frame, in microseconds.
+    int64_t mEnd;                               //!< The end of the frame, in microseconds.
+    std::vector<ZoneEvent> mEvents;             //!< The zones finished during the frame.
+    std::vector<ProfileZoneStats> mStats;       //!< The time spent per zone name.
+};
+
+/**
+  * The global profiler state. The threads look up their buffers without locking, only registering a
+  * thread and everything about the frames is locked.
+  */
+struct Table {
+    Table()
+        : mThreadCount(0),
+          mFrameCapacity(Profiler::DEFAULT_FRAME_CAPACITY),
+          mFrameBegin(0),
+          mFrameThread(0),
+          mIsFrameOpen(false) {
+        for(uint32_t i = 0; i < MAX_THREADS; ++i) {
+            mThreads[i] = nullptr;
+            mBuffers[i] = nullptr;
+        }
+    }
+
+    QMutex mMutex;
+    sf::Clock mClock;                               //!< The time all zones are measured against.
+    std::atomic<QThread*> mThreads[MAX_THREADS];    //!< The threads that have recorded zones.
+    ThreadBuffer* mBuffers[MAX_THREADS];            //!< The buffers of the threads. Never freed.
+    std::atomic<uint32_t> mThreadCount;             //!< The number of registered threads.
+    std::deque<Frame> mFrames;                      //!< The finished frames, oldest first.
+    uint32_t mFrameCapacity;                        //!< The maximum number of frames kept.
+    int64_t mFrameBegin;                            //!< The start of the current frame.
+    uint32_t mFrameThread;                          //!< The thread that started the current frame.
+    bool mIsFrameOpen;                              //!< Whether a frame is being recorded.
+};
+
+Table& getTable() {
+    static Table table;
+    return table;
+}
+
+int64_t getTime(Table& table) {
+    return table.mClock.getElapsedTime().asMicroseconds();
+}
+
+/**
+  * Returns the buffer of the calling thread, registering the thread on its first zone.
+  */
+ThreadBuffer* getThreadBuffer(Table& table) {
+    QThread* thread = QThread::currentThread();
+    uint32_t count = table.mThreadCount;
+    for(uint32_t i = 0; i < count; ++i) {
+        if(table.mThreads[i] == thread)
+            return table.mBuffers[i];
+    }
+
+    // only the thread itself registers it, so it cannot have been registered meanwhile
+    QMutexLocker lock(&table.mMutex);
+    count = table.mThreadCount;
+    if(count == MAX_THREADS)
+        return nullptr;
+
+    ThreadBuffer* buffer = new ThreadBuffer();
+    buffer->mIndex = count;
+    table.mBuffers[count] = buffer;
+    table.mThreads[count] = thread;
+    table.mThreadCount = count + 1;
+    return buffer;
+}
+
+void addStats(std::vector<ProfileZoneStats>& stats, const ZoneEvent& event) {
+    double time = (event.mEnd - event.mBegin) / 1000000.0;
+    for(auto iter = stats.begin(); iter != stats.end(); ++iter) {
+        if(iter->mName == event.mName || std::strcmp(iter->mName, event.mName) == 0) {
+            ++iter->mCalls;
+            iter->mTotalTime += time;
+            iter->mSelfTime += event.mSelfTime / 1000000.0;
+            iter->mMaxTime = std::max(iter->mMaxTime, time);
+            return;
+        }
+    }
+    ProfileZoneStats zone = {event.mName, 1, time, event.mSelfTime / 1000000.0, time};
+    stats.push_back(zone);
+}
+
+bool hasLongerTotalTime(const ProfileZoneStats& first, const ProfileZoneStats& second) {
+    return first.mTotalTime > second.mTotalTime;
+}
+
+/**
+  * Escapes a string for a JSON document.
+  */
+std::string escape(const std::string& text) {
+    std::string escaped;
+    for(auto iter = text.begin(); iter != text.end(); ++iter) {
+        if(*iter == '"' || *iter == '\\')
+            escaped += '\\';
+        if(static_cast<unsigned char>(*iter) >= 0x20)
+            escaped += *iter;
+    }
+    return escaped;
+}
+
+} // anonymous namespace
+
+const uint32_t Profiler::DEFAULT_FRAME_CAPACITY = 300;
+
+std::atomic<bool> Profiler::sIsEnabled(false);
+
+void Profiler::setEnabled(bool enabled) {
+    sIsEnabled = enabled;
+}
+
+void Profiler::setFrameCapacity(uint32_t frames) {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    table.mFrameCapacity = std::max(frames, 1u);
+    while(table.mFrames.size() > table.mFrameCapacity) {
+        table.mFrames.pop_front();
+    }
+}
+
+uint32_t Profiler::getFrameCapacity() {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    return table.mFrameCapacity;
+}
+
+void Profiler::beginFrame() {
+    Table& table = getTable();
+    bool enabled = isEnabled();
+    ThreadBuffer* thread = enabled ? getThreadBuffer(table) : nullptr;
+    int64_t now = getTime(table);
+
+    QMutexLocker lock(&table.mMutex);
+    uint32_t thread_count = table.mThreadCount;
+    if(table.mIsFrameOpen) {
+        table.mFrames.push_back(Frame());
+        Frame& frame = table.mFrames.back();
+        frame.mBegin = table.mFrameBegin;
+        frame.mEnd = now;
+
+        for(uint32_t i = 0; i < thread_count; ++i) {
+            QMutexLocker buffer_lock(&table.mBuffers[i]->mMutex);
+            std::vector<ZoneEvent>& events = table.mBuffers[i]->mEvents;
+            frame.mEvents.insert(frame.mEvents.end(), events.begin(), events.end());
+            events.clear();
+        }
+        // the frame itself spans its zones on the thread that started it
+        ZoneEvent frame_event = {"Frame", frame.mBegin, frame.mEnd, 0, table.mFrameThread};
+        frame.mEvents.push_back(frame_event);
+
+        for(auto iter = frame.mEvents.begin(); iter != frame.mEvents.end(); ++iter) {
+            addStats(frame.mStats, *iter);
+        }
+        std::sort(frame.mStats.begin(), frame.mStats.end(), hasLongerTotalTime);
+
+        while(table.mFrames.size() > table.mFrameCapacity) {
+            table.mFrames.pop_front();
+        }
+    } else if(enabled) {
+        // zones finished while no frame was recorded would end up outside of the first frame
+        for(uint32_t i = 0; i < thread_count; ++i) {
+            QMutexLocker buffer_lock(&table.mBuffers[i]->mMutex);
+            table.mBuffers[i]->mEvents.clear();
+        }
+    }
+
+    table.mIsFrameOpen = enabled && thread != nullptr;
+    table.mFrameBegin = now;
+    table.mFrameThread = thread != nullptr ? thread->mIndex : 0;
+}
+
+void Profiler::setThreadName(const QString& name) {
+    ThreadBuffer* buffer = getThreadBuffer(getTable());
+    if(buffer == nullptr)
+        return;
+
+    QMutexLocker lock(&buffer->mMutex);
+    buffer->mName = name;
+}
+
+void Profiler::beginZone(const char* name) {
+    Table& table = getTable();
+    ThreadBuffer* buffer = getThreadBuffer(table);
+    if(buffer == nullptr)
+        return;
+
+    OpenZone zone = {name, getTime(table), 0};
+    buffer->mOpenZones.push_back(zone);
+}
+
+void Profiler::endZone() {
+    Table& table = getTable();
+    ThreadBuffer* buffer = getThreadBuffer(table);
+    if(buffer == nullptr || buffer->mOpenZones.empty())
+        return;
+
+    OpenZone zone = buffer->mOpenZones.back();
+    buffer->mOpenZones.pop_back();
+    int64_t end = getTime(table);
+    if(!buffer->mOpenZones.empty())
+        buffer->mOpenZones.back().mChildTime += end - zone.mBegin;
+
+    ZoneEvent event = {zone.mName, zone.mBegin, end, end - zone.mBegin - zone.mChildTime, buffer->mIndex};
+    QMutexLocker lock(&buffer->mMutex);
+    buffer->mEvents.push_back(event);
+}
+
+uint32_t Profiler::getFrameCount() {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    return table.mFrames.size();
+}
+
+double Profiler::getFrameTime(uint32_t frames_ago) {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    if(frames_ago >= table.mFrames.size())
+        return 0.0;
+
+    const Frame& frame = table.mFrames[table.mFrames.size() - 1 - frames_ago];
+    return (frame.mEnd - frame.mBegin) / 1000000.0;
+}
+
+std::vector<ProfileZoneStats> Profiler::getFrameStats(uint32_t frames_ago) {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    if(frames_ago >= table.mFrames.size())
+        return std::vector<ProfileZoneStats>();
+
+    return table.mFrames[table.mFrames.size() - 1 - frames_ago].mStats;
+}
+
+QString Profiler::toChromeTrace(uint32_t frames) {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    uint32_t count = table.mFrames.size();
+    if(frames == 0 || frames > count)
+        frames = count;
+
+    std::ostringstream json;
+    json << "{\"traceEvents\":[";
+    bool first = true;
+
+    uint32_t thread_count = table.mThreadCount;
+    for(uint32_t i = 0; i < thread_count; ++i) {
+        QString name;
+        {
+            QMutexLocker buffer_lock(&table.mBuffers[i]->mMutex);
+            name = table.mBuffers[i]->mName;
+        }
+        if(name.isEmpty())
+            continue;
+
+        json << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+             << ",\"args\":{\"name\":\"" << escape(name.toStdString()) << "\"}}";
+        first = false;
+    }
+
+    for(uint32_t f = count - frames; f < count; ++f) {
+        const std::vector<ZoneEvent>& events = table.mFrames[f].mEvents;
+        for(auto iter = events.begin(); iter != events.end(); ++iter) {
+            json << (first ? "\n" : ",\n") << "{\"name\":\"" << escape(iter->mName)
+                 << "\",\"cat\":\"ducttape\",\"ph\":\"X\",\"ts\":" << iter->mBegin
+                 << ",\"dur\":" << iter->mEnd - iter->mBegin << ",\"pid\":1,\"tid\":" << iter->mThread << "}";
+            first = false;
+        }
+    }
+
+    json << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return QString(json.str().c_str());
+}
+
+bool Profiler::writeChromeTrace(const QString& file_name, uint32_t frames) {
+    QFile file(file_name);
+    if(!file.open(QIODevice::WriteOnly)) {
+        Logger::get().error("Cannot open trace file " + file_name + " for writing.");
+        return false;
+    }
+
+    QByteArray json = toChromeTrace(frames).toUtf8();
+    file.write(json.constData(), json.size());
+    file.close();
+    return true;
+}
+
+void Profiler::clear() {
+    Table& table = getTable();
+    QMutexLocker lock(&table.mMutex);
+    table.mFrames.clear();
+    table.mIsFrameOpen = false;
+
+    uint32_t thread_count = table.mThreadCount;
+    for(uint32_t i = 0; i < thread_count; ++i) {
+        QMutexLocker buffer_lock(&table.mBuffers[i]->mMutex);
+        table.mBuffers[i]->mEvents.clear();
+    }
+}
+
+} // namespace dt
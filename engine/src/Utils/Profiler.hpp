@@ -0,0 +1,183 @@
+
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_UTILS_PROFILER
+#define DUCTTAPE_ENGINE_UTILS_PROFILER
+
+#include <Config.hpp>
+
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace dt {
+
+/**
+  * The time spent in all zones of the same name during one frame.
+  */
+struct ProfileZoneStats {
+    const char* mName;      //!< The name of the zones.
+    uint32_t mCalls;        //!< The number of zones.
+    double mTotalTime;      //!< The time spent in the zones, in seconds.
+    double mSelfTime;       //!< The time spent in the zones but not in the zones nested in them, in seconds.
+    double mMaxTime;        //!< The time of the longest zone, in seconds.
+};
+
+/**
+  * Records nested zones of code on all threads and groups them into frames. The last frames are kept in
+  * memory together with the time spent per zone name, and can be written as a Chrome trace, to be opened in
+  * chrome://tracing. Zone names must be string literals or other strings that stay valid while the frames
+  * are kept, e.g. the class names of the Qt meta objects.
+  * Up to 64 threads can record zones. While profiling is disabled, a zone costs one check of a flag.
+  * Defining DUCTTAPE_DISABLE_PROFILER removes the zones entirely.
+  * @see ProfileZone
+  */
+class DUCTTAPE_API Profiler {
+public:
+    static const uint32_t DEFAULT_FRAME_CAPACITY;   //!< The number of frames kept by default.
+
+    /**
+      * Enables or disables the recording. The frames recorded so far are kept.
+      * @param enabled Whether zones shall be recorded.
+      */
+    static void setEnabled(bool enabled);
+
+    /**
+      * Returns whether zones are recorded.
+      * @returns Whether the profiler is enabled.
+      */
+    static bool isEnabled() {
+        return sIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+      * Sets the number of frames kept in memory. The oldest frames are dropped first.
+      * @param frames The number of frames. The default is DEFAULT_FRAME_CAPACITY.
+      */
+    static void setFrameCapacity(uint32_t frames);
+
+    /**
+      * Returns the number of frames kept in memory.
+      * @returns The number of frames.
+      */
+    static uint32_t getFrameCapacity();
+
+    /**
+      * Ends the current frame, taking over the zones all threads have finished since the last call, and
+      * starts the next one. Called by the Game once per frame.
+      */
+    static void beginFrame();
+
+    /**
+      * Gives the calling thread a name in the Chrome trace.
+      * @param name The name of the thread.
+      */
+    static void setThreadName(const QString& name);
+
+    /**
+      * Starts a zone on the calling thread. Use ProfileZone instead.
+      * @param name The name of the zone.
+      */
+    static void beginZone(const char* name);
+
+    /**
+      * Ends the last zone started on the calling thread. Use ProfileZone instead.
+      */
+    static void endZone();
+
+    /**
+      * Returns the number of recorded frames kept in memory.
+      * @returns The number of frames.
+      */
+    static uint32_t getFrameCount();
+
+    /**
+      * Returns the duration of a recorded frame.
+      * @param frames_ago The frame, 0 being the last one finished.
+      * @returns The duration in seconds, or 0 if there is no such frame.
+      */
+    static double getFrameTime(uint32_t frames_ago = 0);
+
+    /**
+      * Returns the time spent per zone name in a recorded frame.
+      * @param frames_ago The frame, 0 being the last one finished.
+      * @returns The stats of every zone name, longest total time first.
+      */
+    static std::vector<ProfileZoneStats> getFrameStats(uint32_t frames_ago = 0);
+
+    /**
+      * Returns recorded frames as a Chrome trace in the JSON trace event format.
+      * @param frames The number of frames, starting with the last one finished, or 0 for all frames.
+      * @returns The JSON document.
+      */
+    static QString toChromeTrace(uint32_t frames = 0);
+
+    /**
+      * Writes recorded frames as a Chrome trace in the JSON trace event format.
+      * @param file_name The name of the file.
+      * @param frames The number of frames, starting with the last one finished, or 0 for all frames.
+      * @returns Whether the file has been written.
+      */
+    static bool writeChromeTrace(const QString& file_name, uint32_t frames = 0);
+
+    /**
+      * Drops all recorded frames and the zones not taken over by a frame yet.
+      */
+    static void clear();
+
+private:
+    static std::atomic<bool> sIsEnabled;    //!< Whether zones are recorded.
+};
+
+/**
+  * Records a zone from its construction to its destruction. Use DUCTTAPE_PROFILE_ZONE to create one.
+  * @see Profiler
+  */
+class DUCTTAPE_API ProfileZone {
+
+    Q_DISABLE_COPY(ProfileZone)
+
+public:
+    /**
+      * Starts the zone.
+      * @param name The name of the zone, or nullptr if profiling is disabled.
+      */
+    explicit ProfileZone(const char* name)
+        : mIsRecording(name != nullptr) {
+        if(mIsRecording)
+            Profiler::beginZone(name);
+    }
+
+    /**
+      * Ends the zone.
+      */
+    ~ProfileZone() {
+        if(mIsRecording)
+            Profiler::endZone();
+    }
+
+private:
+    bool mIsRecording;  //!< Whether the zone has been started.
+};
+
+} // namespace dt
+
+#define DUCTTAPE_PROFILE_CONCAT_HELPER(a, b) a ## b
+#define DUCTTAPE_PROFILE_CONCAT(a, b) DUCTTAPE_PROFILE_CONCAT_HELPER(a, b)
+
+#if defined(DUCTTAPE_DISABLE_PROFILER)
+    #define DUCTTAPE_PROFILE_ZONE(name)
+#else
+    // the name is only evaluated while profiling is enabled
+    #define DUCTTAPE_PROFILE_ZONE(name) \
+        dt::ProfileZone DUCTTAPE_PROFILE_CONCAT(profile_zone_, __LINE__)(dt::Profiler::isEnabled() ? (name) : nullptr)
+#endif
+
+#endif
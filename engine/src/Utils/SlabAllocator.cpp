@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include <Utils/SlabAllocator.hpp>
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <atomic>
+#include <vector>
+
+namespace dt {
+
+const size_t SlabPool::GRANULARITY = 16;
+const size_t SlabPool::MAX_BLOCK_SIZE = 1024;
+const size_t SlabPool::SLAB_SIZE = 64 * 1024;
+
+namespace {
+
+/**
+  * The blocks of one size class.
+  */
+struct SizeClass {
+    SizeClass()
+        : mFreeList(nullptr) {}
+
+    QMutex mMutex;
+    void* mFreeList;                //!< The first free block, each free block points to the next one.
+    std::vector<char*> mSlabs;      //!< All slabs of this size class.
+};
+
+struct Pools {
+    Pools()
+        : mBlocksInUse(0) {}
+
+    SizeClass mClasses[SlabPool::MAX_BLOCK_SIZE / SlabPool::GRANULARITY];
+    std::atomic<uint64_t> mBlocksInUse;
+};
+
+Pools& getPools() {
+    // Never destroyed: objects in the pools may be deleted during static destruction.
+    static Pools* pools = new Pools();
+    return *pools;
+}
+
+} // anonymous namespace
+
+void* SlabPool::allocate(size_t size) {
+    if(size == 0)
+        size = 1;
+    if(size > MAX_BLOCK_SIZE)
+        return ::operator new(size);
+
+    Pools& pools = getPools();
+    size_t index = (size - 1) / GRANULARITY;
+    SizeClass& size_class = pools.mClasses[index];
+    void* block;
+    {
+        QMutexLocker lock(&size_class.mMutex);
+        if(size_class.mFreeList == nullptr) {
+            // cut a new slab into blocks
+            size_t block_size = (index + 1) * GRANULARITY;
+            char* slab = static_cast<char*>(::operator new(SLAB_SIZE));
+            size_class.mSlabs.push_back(slab);
+            for(size_t offset = 0; offset + block_size <= SLAB_SIZE; offset += block_size) {
+                *reinterpret_cast<void**>(slab + offset) = size_class.mFreeList;
+                size_class.mFreeList = slab + offset;
+            }
+        }
+        block = size_class.mFreeList;
+        size_class.mFreeList = *static_cast<void**>(block);
+    }
+
+    ++pools.mBlocksInUse;
+    return block;
+}
+
+void SlabPool::deallocate(void* block, size_t size) {
+    if(block == nullptr)
+        return;
+    if(size == 0)
+        size = 1;
+    if(size > MAX_BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+
+    Pools& pools = getPools();
+    SizeClass& size_class = pools.mClasses[(size - 1) / GRANULARITY];
+    {
+        QMutexLocker lock(&size_class.mMutex);
+        *static_cast<void**>(block) = size_class.mFreeList;
+        size_class.mFreeList = block;
+    }
+
+    --pools.mBlocksInUse;
+}
+
+uint64_t SlabPool::getBlocksInUse() {
+    return getPools().mBlocksInUse;
+}
+
+} // namespace dt
@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_UTILS_SLABALLOCATOR
+#define DUCTTAPE_ENGINE_UTILS_SLABALLOCATOR
+
+#include <Config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace dt {
+
+/**
+  * A pool of small memory blocks. Blocks of the same size class are cut from large slabs and
+  * recycled through a free list, so allocating many objects of the same type (e.g. Nodes and
+  * Components) is cheap and keeps them close together in memory.
+  * Freed blocks are kept for reuse and are never returned to the system.
+  */
+class DUCTTAPE_API SlabPool {
+public:
+    static const size_t GRANULARITY;    //!< The sizes of the blocks are multiples of this (in bytes).
+    static const size_t MAX_BLOCK_SIZE; //!< Larger allocations are passed on to the global operator new.
+    static const size_t SLAB_SIZE;      //!< The size of the slabs the blocks are cut from (in bytes).
+
+    /**
+      * Allocates a block of memory.
+      * @param size The size of the block in bytes.
+      * @returns The block.
+      */
+    static void* allocate(size_t size);
+
+    /**
+      * Returns a block to the pool.
+      * @param block The block.
+      * @param size The size the block has been allocated with.
+      */
+    static void deallocate(void* block, size_t size);
+
+    /**
+      * Returns the number of blocks currently allocated from the pool.
+      * @returns The number of blocks in use.
+      */
+    static uint64_t getBlocksInUse();
+};
+
+/**
+  * A standard allocator using the SlabPool, e.g. for the control blocks of shared pointers.
+  */
+template <typename Type>
+class SlabAllocator {
+public:
+    typedef Type value_type;
+    typedef Type* pointer;
+    typedef const Type* const_pointer;
+    typedef Type& reference;
+    typedef const Type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <typename Other>
+    struct rebind {
+        typedef SlabAllocator<Other> other;
+    };
+
+    SlabAllocator() {}
+
+    template <typename Other>
+    SlabAllocator(const SlabAllocator<Other>&) {}
+
+    pointer address(reference value) const {
+        return &value;
+    }
+
+    const_pointer address(const_reference value) const {
+        return &value;
+    }
+
+    pointer allocate(size_type count, const void* = nullptr) {
+        return static_cast<pointer>(SlabPool::allocate(count * sizeof(Type)));
+    }
+
+    void deallocate(pointer block, size_type count) {
+        SlabPool::deallocate(block, count * sizeof(Type));
+    }
+
+    size_type max_size() const {
+        return static_cast<size_type>(-1) / sizeof(Type);
+    }
+
+    void construct(pointer block, const Type& value) {
+        new(block) Type(value);
+    }
+
+    void destroy(pointer block) {
+        block->~Type();
+    }
+};
+
+template <typename Type, typename Other>
+bool operator==(const SlabAllocator<Type>&, const SlabAllocator<Other>&) {
+    return true;
+}
+
+template <typename Type, typename Other>
+bool operator!=(const SlabAllocator<Type>&, const SlabAllocator<Other>&) {
+    return false;
+}
+
+} // namespace dt
+
+#endif
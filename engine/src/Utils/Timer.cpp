@@ -23,8 +23,9 @@ Timer::Timer(const QString message, double interval, bool repeat, bool threaded)
         _runThread();
     } else {
         mTimeLeft = mInterval;
+        // the simulation may run on a job worker, a queued call would never be delivered
         QObject::connect(Root::getInstance().getStateManager(), SIGNAL(beginFrame(double)),
-                         this,                                  SLOT(updateTimeLeft(double)));
+                         this,                                  SLOT(updateTimeLeft(double)), Qt::DirectConnection);
     }
 }
 
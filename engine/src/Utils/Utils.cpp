@@ -8,6 +8,14 @@
 
 #include <Utils/Utils.hpp>
 
+#include <QFile>
+
+#include <atomic>
+
+#ifdef DUCTTAPE_SYSTEM_LINUX
+#include <unistd.h>
+#endif
+
 namespace dt {
 
 namespace Utils {
@@ -30,11 +38,29 @@ std::wstring toWString(const QString qstring) {
     return result;
 }
 
-uint32_t mAutoId = 0;
+std::atomic<uint32_t> mAutoId(0);
 
 uint32_t autoId() {
-    mAutoId++;
-    return mAutoId;
+    return ++mAutoId;
+}
+
+std::atomic<uint64_t> mRuntimeId(0);
+
+uint64_t runtimeId() {
+    return ++mRuntimeId;
+}
+
+uint64_t residentMemory() {
+#ifdef DUCTTAPE_SYSTEM_LINUX
+    // the second field is the number of resident pages
+    QFile statm("/proc/self/statm");
+    if(!statm.open(QIODevice::ReadOnly))
+        return 0;
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    return fields.size() > 1 ? fields[1].toULongLong() * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
 }
 
 } // namespace Utils
@@ -14,6 +14,7 @@
 #include <QString>
 #include <QUuid>
 
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include <cstdint>
@@ -42,14 +43,27 @@ DUCTTAPE_API std::string toStdString(const QString qstring);
   */
 DUCTTAPE_API std::wstring toWString(const QString qstring);
 
-extern uint32_t mAutoId;
+extern std::atomic<uint32_t> mAutoId;
 
 /**
-  * A tool for assigning Id's
+  * A tool for assigning Id's. Can be called from any thread.
   * @returns the new id
   */
 uint32_t autoId();
 
+/**
+  * Returns a new id that is unique for the lifetime of the process. Much cheaper than a QUuid, as
+  * it is only an atomic increment.
+  * @returns The new id.
+  */
+DUCTTAPE_API uint64_t runtimeId();
+
+/**
+  * Returns the resident memory (RSS) of the process.
+  * @returns The resident memory in bytes, or 0 if it cannot be read on this platform.
+  */
+DUCTTAPE_API uint64_t residentMemory();
+
 } // namespace Utils
 
 } // namespace dt
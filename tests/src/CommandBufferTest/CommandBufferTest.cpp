@@ -0,0 +1,115 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "CommandBufferTest/CommandBufferTest.hpp"
+
+#include <Logic/TriggerComponent.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace CommandBufferTest {
+
+/**
+  * Creates count Nodes named prefix0, prefix1, ...
+  */
+std::vector<dt::Node*> createNodes(const QString& prefix, uint32_t count) {
+    std::vector<dt::Node*> nodes;
+    for(uint32_t i = 0; i < count; ++i) {
+        nodes.push_back(new dt::Node(prefix + dt::Utils::toString(i)));
+    }
+    return nodes;
+}
+
+bool CommandBufferTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t count = 10000;
+    dt::Scene scene("CommandBufferTest");
+    dt::CommandBuffer& commands = scene.getCommandBuffer();
+
+    // nothing changes until the buffer is applied
+    dt::Node* parent = new dt::Node("parent");
+    uint32_t spawned = 0;
+    commands.spawn(&scene, parent);
+    commands.spawn(parent, createNodes("child", count), [&spawned](dt::Node::NodeSP node) {
+        node->addComponent(new dt::TriggerComponent("trigger"));
+        ++spawned;
+    });
+    if(scene.findChildNode("parent") != nullptr || commands.getSize() != 2) {
+        std::cerr << "The spawn commands have been applied too early." << std::endl;
+        return false;
+    }
+
+    scene.updateFrame(0.01);
+    if(spawned != count || parent->findChildNode("child0", false) == nullptr || commands.getSize() != 0) {
+        std::cerr << "Only " << spawned << " of " << count << " nodes have been spawned." << std::endl;
+        return false;
+    }
+
+    // killed nodes are removed at the end of the frame, reparenting happens in order
+    dt::Node::NodeSP killed = parent->findChildNode("child1", false);
+    killed->kill();
+    commands.reparent(parent->findChildNode("child2", false).get(), &scene);
+    commands.kill(parent->findChildNode("child2", false).get());
+    commands.reparent(parent->findChildNode("child3", false).get(), &scene);
+    if(killed->getParent() != parent) {
+        std::cerr << "The killed node has been removed too early." << std::endl;
+        return false;
+    }
+
+    scene.updateFrame(0.01);
+    if(parent->findChildNode("child1", false) != nullptr || scene.findChildNode("child2") != nullptr
+            || scene.findChildNode("child3", false) == nullptr) {
+        std::cerr << "The kill and reparent commands have not been applied correctly." << std::endl;
+        return false;
+    }
+
+    // killing by runtime id skips nodes that are gone by then
+    uint64_t removed_id = parent->findChildNode("child4", false)->getRuntimeId();
+    commands.kill(removed_id);
+    commands.kill(parent->findChildNode("child5", false)->getRuntimeId());
+    parent->removeChildNode("child4");
+    scene.updateFrame(0.01);
+    if(parent->findChildNode("child5", false) != nullptr || scene.findNode(removed_id) != nullptr) {
+        std::cerr << "The nodes have not been killed by their runtime id." << std::endl;
+        return false;
+    }
+
+    // compare bulk creation with adding the nodes one by one
+    std::vector<dt::Node*> nodes = createNodes("single", count);
+    sf::Clock clock;
+    for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        scene.addChildNode(*iter);
+    }
+    double single_time = clock.getElapsedTime().asSeconds();
+
+    nodes = createNodes("bulk", count);
+    clock.restart();
+    scene.addChildNodes(nodes);
+    double bulk_time = clock.getElapsedTime().asSeconds();
+
+    if(scene.findChildNode("bulk" + dt::Utils::toString(count - 1), false) == nullptr) {
+        std::cerr << "The nodes have not been added in bulk." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " nodes: added one by one in " << single_time * 1000 << " ms, in bulk in "
+              << bulk_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString CommandBufferTest::getTestName() {
+    return "CommandBuffer";
+}
+
+} // namespace CommandBufferTest
@@ -0,0 +1,130 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "ComponentStorageTest/ComponentStorageTest.hpp"
+
+#include <Logic/TriggerComponent.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+
+namespace ComponentStorageTest {
+
+bool ComponentStorageTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t count = 10000;
+    dt::Scene scene("ComponentStorageTest");
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node::NodeSP node = scene.addChildNode(new dt::Node("node" + dt::Utils::toString(i)));
+        node->addComponent(new CounterComponent("counter"));
+        if(i % 2 == 0)
+            node->addComponent(new dt::TriggerComponent("trigger"));
+    }
+
+    scene.setTypedComponentStorage(true);
+    if(scene.view<CounterComponent>().size() != count || scene.view<dt::TriggerComponent>().size() != count / 2) {
+        std::cerr << "The typed component storage does not contain all components." << std::endl;
+        return false;
+    }
+
+    // every component has to be updated once, either by the scene or by its node
+    scene.updateFrame(0.01);
+    if(!checkUpdates(scene, 1))
+        return false;
+
+    scene.setTypedComponentStorage(false);
+    scene.updateFrame(0.01);
+    if(!checkUpdates(scene, 2))
+        return false;
+    scene.setTypedComponentStorage(true);
+
+    // removed and moved nodes have to leave the storage
+    scene.removeChildNode("node0");
+    dt::Scene other("ComponentStorageTestOther");
+    other.setTypedComponentStorage(true);
+    scene.findChildNode("node1", false)->setParent(&other);
+    if(scene.view<CounterComponent>().size() != count - 2 || other.view<CounterComponent>().size() != 1) {
+        std::cerr << "Removed or moved components are still in the typed component storage." << std::endl;
+        return false;
+    }
+
+    // compare iterating a view with walking the node tree
+    sf::Clock clock;
+    uint32_t sum = 0;
+    dt::ComponentView<CounterComponent> view = scene.view<CounterComponent>();
+    for(auto iter = view.begin(); iter != view.end(); ++iter) {
+        sum += (*iter)->mUpdates;
+    }
+    double view_time = clock.getElapsedTime().asSeconds();
+
+    clock.restart();
+    uint32_t walk_sum = 0;
+    for(uint32_t i = 2; i < count; ++i) {
+        walk_sum += scene.findChildNode("node" + dt::Utils::toString(i), false)->findComponent<CounterComponent>("counter")->mUpdates;
+    }
+    double walk_time = clock.getElapsedTime().asSeconds();
+
+    if(sum != walk_sum) {
+        std::cerr << "The view does not match the node tree." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " components: view " << view_time * 1000 << " ms, node lookup " << walk_time * 1000 << " ms" << std::endl;
+
+    // removing components that have or have not been updated yet must not make others skip or repeat the update
+    const uint32_t removers[] = {2, count - 2};
+    const uint32_t victims[] = {count - 1, 3};
+    for(uint32_t i = 0; i < 2; ++i) {
+        CounterComponent* remover = scene.findChildNode("node" + dt::Utils::toString(removers[i]), false)
+            ->findComponent<CounterComponent>("counter").get();
+        remover->mVictim = scene.findChildNode("node" + dt::Utils::toString(victims[i]), false)
+            ->findComponent<CounterComponent>("counter").get();
+    }
+    scene.updateFrame(0.01);
+    if(scene.view<CounterComponent>().size() != count - 4 || !checkUpdates(scene, 3))
+        return false;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString ComponentStorageTest::getTestName() {
+    return "ComponentStorage";
+}
+
+////////////////////////////////////////////////////////////////
+
+CounterComponent::CounterComponent(const QString name)
+    : dt::Component(name),
+      mUpdates(0),
+      mVictim(nullptr) {}
+
+void CounterComponent::onUpdate(double time_diff) {
+    if(time_diff > 0)
+        ++mUpdates;
+    if(mVictim != nullptr) {
+        mVictim->getNode()->removeComponent(mVictim->getName());
+        mVictim = nullptr;
+    }
+}
+
+bool checkUpdates(dt::Scene& scene, uint32_t expected) {
+    dt::ComponentView<CounterComponent> view = scene.view<CounterComponent>();
+    for(auto iter = view.begin(); iter != view.end(); ++iter) {
+        if((*iter)->mUpdates != expected) {
+            std::cerr << "Component " << dt::Utils::toStdString((*iter)->getFullName()) << " has been updated "
+                      << (*iter)->mUpdates << " times instead of " << expected << "." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace ComponentStorageTest
@@ -0,0 +1,51 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_COMPONENTSTORAGETEST
+#define DUCTTAPE_ENGINE_TESTS_COMPONENTSTORAGETEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Scene.hpp>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace ComponentStorageTest {
+
+class ComponentStorageTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class CounterComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    CounterComponent(const QString name = "");
+    void onUpdate(double time_diff);
+
+    uint32_t mUpdates;
+    CounterComponent* mVictim;  //!< A component to remove from its node in the next update, or nullptr.
+};
+
+/**
+  * Checks that every CounterComponent in the scene has been updated exactly the given number of times.
+  */
+bool checkUpdates(dt::Scene& scene, uint32_t expected);
+
+} // namespace ComponentStorageTest
+
+#endif
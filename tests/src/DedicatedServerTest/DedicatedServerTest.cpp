@@ -0,0 +1,75 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "DedicatedServerTest/DedicatedServerTest.hpp"
+
+#include <Graphics/DisplayManager.hpp>
+
+#include <iostream>
+
+namespace DedicatedServerTest {
+
+bool DedicatedServerTest::run(int argc, char** argv) {
+    dt::Root& root = dt::Root::getInstance();
+    root.initialize(argc, argv, dt::Root::DEDICATED_SERVER);
+
+    if(!root.isHeadless() || root.getStartupTime() <= 0) {
+        std::cerr << "The dedicated server profile has not been initialized." << std::endl;
+        return false;
+    }
+
+    dt::Scene scene("DedicatedServerTest");
+    if(scene.getSceneManager() != nullptr || scene.getStaticGeometry() != nullptr) {
+        std::cerr << "The scene of a dedicated server has an Ogre::SceneManager." << std::endl;
+        return false;
+    }
+
+    // the presentation components do nothing
+    dt::Node* node = scene.addChildNode(new dt::Node("node")).get();
+    dt::MeshComponent* mesh = node->addComponent(new dt::MeshComponent("Sphere", "", "mesh")).get();
+    dt::LightComponent* light = node->addComponent(new dt::LightComponent("light")).get();
+    dt::CameraComponent* camera = node->addComponent(new dt::CameraComponent("camera")).get();
+    dt::ParticleSystemComponent* particles = node->addComponent(new dt::ParticleSystemComponent("particles")).get();
+    node->addComponent(new dt::BillboardSetComponent("billboards", 1, "")).get();
+    node->addComponent(new dt::TextComponent("text", "text")).get();
+
+    light->setColor(1, 0, 0);
+    camera->lookAt(0, 0, -10);
+    if(particles->addEmitter("emitter", "Point") != nullptr || mesh->getOgreEntity() != nullptr) {
+        std::cerr << "A presentation component has created an Ogre object." << std::endl;
+        return false;
+    }
+
+    for(int i = 0; i < 10; ++i) {
+        node->setPosition(static_cast<float>(i), 0, 0);
+        scene.updateFrame(0.01);
+    }
+    node->bake();
+    scene.updateFrame(0.01);
+    node->unbake();
+    node->disable();
+    node->enable();
+
+    if(dt::DisplayManager::get()->getRenderWindow() != nullptr) {
+        std::cerr << "A render window has been created." << std::endl;
+        return false;
+    }
+
+    scene.removeChildNode("node");
+
+    std::cout << "Dedicated server: started in " << root.getStartupTime() * 1000 << " ms, "
+              << root.getStartupMemory() / 1024 << " KiB resident" << std::endl;
+
+    root.deinitialize();
+    return true;
+}
+
+QString DedicatedServerTest::getTestName() {
+    return "DedicatedServer";
+}
+
+} // namespace DedicatedServerTest
@@ -0,0 +1,36 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_DEDICATEDSERVERTEST
+#define DUCTTAPE_ENGINE_TESTS_DEDICATEDSERVERTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Graphics/BillboardSetComponent.hpp>
+#include <Graphics/CameraComponent.hpp>
+#include <Graphics/LightComponent.hpp>
+#include <Graphics/MeshComponent.hpp>
+#include <Graphics/ParticleSystemComponent.hpp>
+#include <Graphics/TextComponent.hpp>
+#include <Scene/Scene.hpp>
+
+#include <QString>
+
+namespace DedicatedServerTest {
+
+class DedicatedServerTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+} // namespace DedicatedServerTest
+
+#endif
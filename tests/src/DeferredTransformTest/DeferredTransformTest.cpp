@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "DeferredTransformTest/DeferredTransformTest.hpp"
+
+#include <Utils/Utils.hpp>
+
+#include <iostream>
+
+namespace DeferredTransformTest {
+
+bool checkChanges(const QString& name, TransformCounterComponent* component, uint32_t expected) {
+    if(component->mChanges != expected) {
+        std::cerr << dt::Utils::toStdString(name) << ": expected " << expected << " transform notifications, got "
+                  << component->mChanges << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DeferredTransformTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    dt::Scene scene("DeferredTransformTest");
+    scene.setDeferredTransformCommit(true);
+
+    dt::Node::NodeSP parent = scene.addChildNode(new dt::Node("parent"));
+    dt::Node::NodeSP child = parent->addChildNode(new dt::Node("child"));
+    dt::Node::NodeSP doomed = scene.addChildNode(new dt::Node("doomed"));
+    dt::Node::NodeSP other = scene.addChildNode(new dt::Node("other"));
+    TransformCounterComponent* parent_counter = parent->addComponent(new TransformCounterComponent("counter")).get();
+    TransformCounterComponent* child_counter = child->addComponent(new TransformCounterComponent("counter")).get();
+    TransformCounterComponent* other_counter = other->addComponent(new TransformCounterComponent("counter")).get();
+    scene.commitTransforms();
+    parent_counter->mChanges = 0;
+    child_counter->mChanges = 0;
+    other_counter->mChanges = 0;
+
+    // the notifications wait for the commit
+    parent->setPosition(1, 0, 0);
+    child->setPosition(0, 1, 0);
+    parent->setPosition(2, 0, 0);
+    if(!checkChanges("parent before commit", parent_counter, 0) || !checkChanges("child before commit", child_counter, 0))
+        return false;
+
+    // the queued child is part of the queued parent's subtree and notified once
+    scene.commitTransforms();
+    if(!checkChanges("parent", parent_counter, 1) || !checkChanges("child", child_counter, 1))
+        return false;
+
+    // a removed node leaves the queue without disturbing the nodes queued after it
+    doomed->setPosition(3, 0, 0);
+    other->setPosition(4, 0, 0);
+    doomed.reset();
+    scene.removeChildNode("doomed");
+    scene.updateFrame(0.01);
+    if(!checkChanges("other", other_counter, 1))
+        return false;
+
+    // turning the mode off flushes the queue
+    child->setPosition(0, 2, 0);
+    scene.setDeferredTransformCommit(false);
+    if(!checkChanges("child after flush", child_counter, 2) || !checkChanges("parent after flush", parent_counter, 1))
+        return false;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString DeferredTransformTest::getTestName() {
+    return "DeferredTransform";
+}
+
+////////////////////////////////////////////////////////////////
+
+TransformCounterComponent::TransformCounterComponent(const QString name)
+    : dt::Component(name),
+      mChanges(0) {}
+
+void TransformCounterComponent::onTransformChanged() {
+    ++mChanges;
+}
+
+} // namespace DeferredTransformTest
@@ -0,0 +1,46 @@
+
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_DEFERREDTRANSFORMTEST
+#define DUCTTAPE_ENGINE_TESTS_DEFERREDTRANSFORMTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Scene.hpp>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace DeferredTransformTest {
+
+class DeferredTransformTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class TransformCounterComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    TransformCounterComponent(const QString name = "");
+    void onTransformChanged();
+
+    uint32_t mChanges;  //!< The number of transform notifications.
+};
+
+} // namespace DeferredTransformTest
+
+#endif
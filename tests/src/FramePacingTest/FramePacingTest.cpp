@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "FramePacingTest/FramePacingTest.hpp"
+
+#include <Scene/StateManager.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+
+namespace FramePacingTest {
+
+const double STEP = 0.01;       //!< The simulation step of the test.
+const uint32_t STEPS = 1000;    //!< The number of steps simulated.
+
+bool FramePacingTest::run(int argc, char** argv) {
+    // pacing without running the loop
+    PacedGame paced;
+    paced.setTargetFrameRate(100);
+    paced.setFramePacing(dt::Game::SLEEP_UNTIL_DEADLINE);
+    double deadline_wait = paced.waitOneFrame();
+    paced.setFramePacing(dt::Game::YIELD);
+    double yield_wait = paced.waitOneFrame();
+    paced.setFramePacing(dt::Game::NONE);
+    double no_wait = paced.waitOneFrame();
+
+    if(deadline_wait < 0.01 || yield_wait < 0.01) {
+        std::cerr << "The frame ended before its deadline: " << deadline_wait * 1000 << " ms and "
+                  << yield_wait * 1000 << " ms instead of 10 ms." << std::endl;
+        return false;
+    }
+    if(deadline_wait > 0.015 || no_wait > 0.005) {
+        std::cerr << "The frame has been paced too long: " << deadline_wait * 1000 << " ms." << std::endl;
+        return false;
+    }
+
+    // 10 seconds of simulation, as fast as possible
+    dt::Game game;
+    game.setSimulationFrameTime(STEP);
+    game.setUncapped(true);
+    Main* main = new Main();
+    sf::Clock clock;
+    game.run(main, argc, argv);
+    double real_time = clock.getElapsedTime().asSeconds();
+
+    if(main->mSteps != STEPS || !main->mIsStepConstant) {
+        std::cerr << "Expected " << STEPS << " steps of " << STEP << " seconds, got " << main->mSteps << "." << std::endl;
+        return false;
+    }
+    if(real_time >= main->mSimulationTime) {
+        std::cerr << "The uncapped loop ran in real time." << std::endl;
+        return false;
+    }
+
+    std::cout << "Paced frame at 100 fps: " << deadline_wait * 1000 << " ms (deadline), "
+              << yield_wait * 1000 << " ms (yield)" << std::endl;
+    std::cout << main->mSimulationTime << " s simulated uncapped in " << real_time * 1000 << " ms" << std::endl;
+    return true;
+}
+
+QString FramePacingTest::getTestName() {
+    return "FramePacing";
+}
+
+////////////////////////////////////////////////////////////////
+
+double PacedGame::waitOneFrame() {
+    mClock.restart();
+    _waitForNextFrame();
+    return mClock.getElapsedTime().asSeconds();
+}
+
+////////////////////////////////////////////////////////////////
+
+Main::Main()
+    : mSteps(0),
+      mSimulationTime(0),
+      mIsStepConstant(true) {}
+
+void Main::onInitialize() {}
+
+void Main::updateStateFrame(double simulation_frame_time) {
+    if(simulation_frame_time != STEP)
+        mIsStepConstant = false;
+
+    ++mSteps;
+    mSimulationTime += simulation_frame_time;
+    if(mSteps == STEPS)
+        dt::StateManager::get()->pop(1);
+}
+
+} // namespace FramePacingTest
@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_FRAMEPACINGTEST
+#define DUCTTAPE_ENGINE_TESTS_FRAMEPACINGTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Scene/Game.hpp>
+#include <Scene/State.hpp>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace FramePacingTest {
+
+class FramePacingTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+/**
+  * Gives access to the wait at the end of a frame.
+  */
+class PacedGame : public dt::Game {
+    Q_OBJECT
+
+public:
+    /**
+      * Waits for the end of a frame that has just begun.
+      * @returns The time waited in seconds.
+      */
+    double waitOneFrame();
+};
+
+////////////////////////////////////////////////////////////////
+
+class Main : public dt::State {
+    Q_OBJECT
+
+public:
+    Main();
+    void onInitialize();
+    void updateStateFrame(double simulation_frame_time);
+
+    uint32_t mSteps;            //!< The number of simulation steps.
+    double mSimulationTime;     //!< The simulated time.
+    bool mIsStepConstant;       //!< Whether every step had the configured length.
+};
+
+} // namespace FramePacingTest
+
+#endif
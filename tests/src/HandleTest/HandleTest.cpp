@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "HandleTest/HandleTest.hpp"
+
+#include <Utils/Handle.hpp>
+#include <Utils/HandleTable.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace HandleTest {
+
+bool HandleTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    dt::Scene scene("HandleTest");
+    uint32_t used_slots = dt::HandleTable::getSlotsInUse();
+
+    // lookups
+    dt::Node* parent = scene.addChildNode(new dt::Node("parent")).get();
+    dt::Node* node = parent->addChildNode(new dt::Node("target")).get();
+    TargetComponent* target = node->addComponent(new TargetComponent("target")).get();
+
+    dt::Node::NodeHandle node_handle = scene.findChildNodeHandle("target");
+    if(node_handle.get() != node || node_handle != node->getHandle()
+       || scene.findNodeHandle(node->getRuntimeId()) != node_handle) {
+        std::cerr << "The handle of the node has not been found." << std::endl;
+        return false;
+    }
+    if(scene.findChildNodeHandle("nothing").isValid() || parent->findChildNodeHandle("target", false).get() != node) {
+        std::cerr << "The lookup of a child handle is wrong." << std::endl;
+        return false;
+    }
+    dt::Handle<TargetComponent, dt::Component> component_handle = node->findComponentHandle<TargetComponent>("target");
+    dt::Handle<dt::Component> base_handle = component_handle;
+    if(component_handle.get() != target || base_handle.get() != target || dt::HandleTable::getSlotsInUse() != used_slots + 3) {
+        std::cerr << "The handle of the component has not been found." << std::endl;
+        return false;
+    }
+    component_handle->mHits++;
+
+    // stale handles, the slots are released on removal even if the objects are still alive
+    dt::Node::NodeSP kept_node = parent->findChildNode("target", false);
+    std::shared_ptr<TargetComponent> kept_component = node->findComponent<TargetComponent>("target");
+    node->removeComponent("target");
+    if(component_handle.isValid() || base_handle.get() != nullptr) {
+        std::cerr << "The handle of a removed component still resolves." << std::endl;
+        return false;
+    }
+    parent->removeChildNode("target");
+    if(node_handle.isValid() || dt::HandleTable::getSlotsInUse() != used_slots + 1) {
+        std::cerr << "The handle of a removed node still resolves." << std::endl;
+        return false;
+    }
+    kept_component.reset();
+    kept_node.reset();
+    if(dt::HandleTable::getSlotsInUse() != used_slots + 1) {
+        std::cerr << "A released slot has been released again." << std::endl;
+        return false;
+    }
+
+    // the slot is reused with another generation
+    dt::Node* reused = parent->addChildNode(new dt::Node("reused")).get();
+    dt::Node::NodeHandle reused_handle = reused->getHandle();
+    if(reused_handle.getIndex() != node_handle.getIndex() || reused_handle.getGeneration() == node_handle.getGeneration()
+       || node_handle.isValid() || reused_handle.get() != reused) {
+        std::cerr << "The reused slot resolves the stale handle." << std::endl;
+        return false;
+    }
+    if(dt::Node::NodeHandle().isValid()) {
+        std::cerr << "The default handle resolves." << std::endl;
+        return false;
+    }
+
+    // resolving handles against copying shared pointers
+    const uint32_t count = 10000;
+    const uint32_t rounds = 100;
+    std::vector<dt::Node::NodeSP> shared;
+    std::vector<dt::Node::NodeHandle> handles;
+    for(uint32_t i = 0; i < count; ++i) {
+        shared.push_back(parent->addChildNode(new dt::Node("node" + dt::Utils::toString(i))));
+        handles.push_back(shared.back()->getHandle());
+    }
+
+    uint64_t shared_sum = 0;
+    sf::Clock clock;
+    for(uint32_t round = 0; round < rounds; ++round) {
+        for(auto iter = shared.begin(); iter != shared.end(); ++iter) {
+            dt::Node::NodeSP copy = *iter;
+            shared_sum += copy->getRuntimeId();
+        }
+    }
+    double shared_time = clock.getElapsedTime().asSeconds();
+
+    uint64_t handle_sum = 0;
+    clock.restart();
+    for(uint32_t round = 0; round < rounds; ++round) {
+        for(auto iter = handles.begin(); iter != handles.end(); ++iter) {
+            handle_sum += iter->get()->getRuntimeId();
+        }
+    }
+    double handle_time = clock.getElapsedTime().asSeconds();
+
+    if(handle_sum != shared_sum) {
+        std::cerr << "The handles resolve to other nodes." << std::endl;
+        return false;
+    }
+
+    std::cout << count * rounds << " shared pointer copies: " << shared_time * 1000 << " ms" << std::endl;
+    std::cout << count * rounds << " handle resolves: " << handle_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString HandleTest::getTestName() {
+    return "Handle";
+}
+
+////////////////////////////////////////////////////////////////
+
+TargetComponent::TargetComponent(const QString name)
+    : Component(name),
+      mHits(0) {}
+
+} // namespace HandleTest
@@ -0,0 +1,42 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_HANDLETEST
+#define DUCTTAPE_ENGINE_TESTS_HANDLETEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Scene.hpp>
+
+#include <QString>
+
+namespace HandleTest {
+
+class HandleTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class TargetComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    TargetComponent(const QString name = "");
+
+    int mHits;  //!< The number of hits.
+};
+
+} // namespace HandleTest
+
+#endif
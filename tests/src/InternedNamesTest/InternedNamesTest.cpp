@@ -0,0 +1,80 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "InternedNamesTest/InternedNamesTest.hpp"
+
+#include <Graphics/CameraComponent.hpp>
+
+#include <iostream>
+
+namespace InternedNamesTest {
+
+SilentTriggerComponent::SilentTriggerComponent(const QString name)
+    : dt::TriggerComponent(name) {}
+
+bool InternedNamesTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    dt::Name name1("interned name");
+    dt::Name name2(QString("interned") + " name");
+    if(name1 != name2 || name1.toString() != "interned name") {
+        std::cerr << "Equal strings were not interned as the same name." << std::endl;
+        return false;
+    }
+    if(dt::Name::find("never interned").isValid()) {
+        std::cerr << "Looking up a name must not intern it." << std::endl;
+        return false;
+    }
+
+    // generated names are encoded in the id and equal to the same string
+    dt::Name generated = dt::Name::generated(dt::Name::NODE, 12);
+    if(generated != dt::Name("Node-12") || generated != dt::Name::find("Node-12")
+            || generated.toString() != "Node-12" || generated == dt::Name::generated(dt::Name::COMPONENT, 12)) {
+        std::cerr << "The generated name does not match its string." << std::endl;
+        return false;
+    }
+    if(dt::Name::find("Node-012").isValid()) {
+        std::cerr << "A string that is not a generated name has been treated as one." << std::endl;
+        return false;
+    }
+
+    dt::Node node("node");
+    dt::Node::NodeSP unnamed = node.addChildNode(new dt::Node());
+    if(node.findChildNode(unnamed->getName(), false) != unnamed) {
+        std::cerr << "The node was not found by its generated name." << std::endl;
+        return false;
+    }
+
+    node.addComponent(new dt::TriggerComponent("trigger"));
+    if(node.findComponent<dt::TriggerComponent>(dt::Name("trigger")) == nullptr
+            || node.findComponent<dt::Component>("trigger") == nullptr) {
+        std::cerr << "The component was not found by its name." << std::endl;
+        return false;
+    }
+    if(node.findComponent<dt::CameraComponent>("trigger") != nullptr
+            || node.findComponent<SilentTriggerComponent>("trigger") != nullptr
+            || node.findComponentHandle<SilentTriggerComponent>("trigger").isValid()) {
+        std::cerr << "The component was returned as a type it does not have." << std::endl;
+        return false;
+    }
+
+    node.addComponent(new SilentTriggerComponent("silent"));
+    if(node.findComponent<SilentTriggerComponent>("silent") == nullptr
+            || node.findComponent<dt::TriggerComponent>("silent") == nullptr) {
+        std::cerr << "The subclass was not found by its name." << std::endl;
+        return false;
+    }
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString InternedNamesTest::getTestName() {
+    return "InternedNames";
+}
+
+} // namespace InternedNamesTest
@@ -0,0 +1,39 @@
+
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_INTERNEDNAMESTEST
+#define DUCTTAPE_ENGINE_TESTS_INTERNEDNAMESTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Logic/TriggerComponent.hpp>
+#include <Scene/Node.hpp>
+#include <Utils/Name.hpp>
+
+namespace InternedNamesTest {
+
+class InternedNamesTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+/**
+  * A subclass without Q_OBJECT, sharing the meta object of TriggerComponent.
+  */
+class SilentTriggerComponent : public dt::TriggerComponent {
+public:
+    SilentTriggerComponent(const QString name);
+};
+
+} // namespace InternedNamesTest
+
+#endif
@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "JobSystemTest/JobSystemTest.hpp"
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace JobSystemTest {
+
+bool JobSystemTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+    dt::JobSystem* jobs = dt::JobSystem::get();
+
+    if(jobs->getWorkerCount() == 0 || !jobs->isMainThread() || jobs->getWorkerIndex() != -1) {
+        std::cerr << "The workers have not been started." << std::endl;
+        return false;
+    }
+
+    // parallel for
+    const uint32_t count = 1000000;
+    std::vector<uint32_t> values(count, 0);
+    sf::Clock clock;
+    jobs->parallelFor(0, count, 0, [&values] (uint32_t index) {
+        values[index] = index * 2;
+    });
+    double parallel_time = clock.getElapsedTime().asSeconds();
+    for(uint32_t i = 0; i < count; ++i) {
+        if(values[i] != i * 2) {
+            std::cerr << "Index " << i << " has not been processed." << std::endl;
+            return false;
+        }
+    }
+
+    // jobs waiting for the jobs they started
+    dt::JobCounter outer;
+    std::atomic<uint32_t> inner_jobs(0);
+    for(uint32_t i = 0; i < 16; ++i) {
+        jobs->run([jobs, &inner_jobs] {
+            dt::JobCounter inner;
+            for(uint32_t j = 0; j < 16; ++j) {
+                jobs->run([&inner_jobs] { ++inner_jobs; }, &inner);
+            }
+            jobs->wait(&inner);
+        }, &outer);
+    }
+    jobs->wait(&outer);
+    if(inner_jobs != 256 || !outer.isDone()) {
+        std::cerr << "Expected 256 nested jobs, got " << inner_jobs << "." << std::endl;
+        return false;
+    }
+
+    // dependencies
+    dt::JobCounter first;
+    dt::JobCounter second;
+    std::atomic<uint32_t> first_jobs(0);
+    uint32_t seen = 0;
+    for(uint32_t i = 0; i < 32; ++i) {
+        jobs->run([&first_jobs] { ++first_jobs; }, &first);
+    }
+    jobs->runAfter(&first, [&first_jobs, &seen] { seen = first_jobs; }, &second);
+    jobs->wait(&second);
+    if(seen != 32) {
+        std::cerr << "The dependent job has run after " << seen << " of 32 jobs." << std::endl;
+        return false;
+    }
+
+    // main thread jobs
+    dt::JobCounter main_thread;
+    bool on_main_thread = false;
+    jobs->run([jobs, &main_thread, &on_main_thread] {
+        jobs->runOnMainThread([jobs, &on_main_thread] {
+            on_main_thread = jobs->isMainThread();
+        }, &main_thread);
+    }, &main_thread);
+    jobs->wait(&main_thread);
+    if(!on_main_thread) {
+        std::cerr << "The main thread job has not run on the main thread." << std::endl;
+        return false;
+    }
+
+    // the main thread jobs can be kept from running while waiting, e.g. for the simulation of a frame
+    dt::JobCounter simulation;
+    std::atomic<bool> is_simulating(true);
+    std::atomic<bool> has_run_during_simulation(false);
+    jobs->run([jobs, &is_simulating, &has_run_during_simulation] {
+        jobs->runOnMainThread([&is_simulating, &has_run_during_simulation] {
+            if(is_simulating)
+                has_run_during_simulation = true;
+        });
+        sf::sleep(sf::milliseconds(5));
+        is_simulating = false;
+    }, &simulation);
+    jobs->wait(&simulation, false);
+    if(has_run_during_simulation || jobs->runMainThreadJobs() != 1) {
+        std::cerr << "The main thread job has run while waiting for the simulation." << std::endl;
+        return false;
+    }
+
+    // neither while waiting for the batches of a parallel loop
+    std::atomic<bool> is_looping(true);
+    std::atomic<bool> has_run_during_loop(false);
+    jobs->parallelFor(0, 4, 1, [jobs, &is_looping, &has_run_during_loop] (uint32_t index) {
+        if(index != 3)
+            return;
+        jobs->runOnMainThread([&is_looping, &has_run_during_loop] {
+            if(is_looping)
+                has_run_during_loop = true;
+        });
+        sf::sleep(sf::milliseconds(5));
+        is_looping = false;
+    });
+    if(has_run_during_loop || jobs->runMainThreadJobs() != 1) {
+        std::cerr << "The main thread job has run while waiting for the parallel loop." << std::endl;
+        return false;
+    }
+
+    std::cout << jobs->getWorkerCount() << " workers, " << count << " indices in " << parallel_time * 1000
+              << " ms, " << jobs->getStolenJobCount() << " jobs stolen" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString JobSystemTest::getTestName() {
+    return "JobSystem";
+}
+
+} // namespace JobSystemTest
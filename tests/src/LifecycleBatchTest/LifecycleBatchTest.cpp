@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "LifecycleBatchTest/LifecycleBatchTest.hpp"
+
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace LifecycleBatchTest {
+
+bool LifecycleBatchTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    dt::Scene scene("LifecycleBatchTest");
+    OgreProcedural::Root::getInstance()->sceneManager = scene.getSceneManager();
+    OgreProcedural::SphereGenerator().setRadius(1.f).realizeMesh("Sphere");
+
+    // a level section with a rigid body on every node
+    const uint32_t count = 5000;
+    SignalCounter counter;
+    dt::Node* section = scene.addChildNode(new dt::Node("section")).get();
+    std::vector<dt::PhysicsBodyComponent*> bodies;
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node* node = section->addChildNode(new dt::Node("crate" + dt::Utils::toString(i))).get();
+        node->setPosition(static_cast<float>(i % 100) * 3, 0, static_cast<float>(i / 100) * 3);
+        node->addComponent(new dt::MeshComponent("Sphere", "", "mesh"));
+        dt::PhysicsBodyComponent* body = node->addComponent(new dt::PhysicsBodyComponent("mesh", "body",
+                                                            dt::PhysicsBodyComponent::SPHERE, 1.f)).get();
+        QObject::connect(body, SIGNAL(componentEnabled()), &counter, SLOT(onEnabled()));
+        QObject::connect(body, SIGNAL(componentDisabled()), &counter, SLOT(onDisabled()));
+        bodies.push_back(body);
+    }
+    btMotionState* motion_state = bodies.front()->getRigidBody()->getMotionState();
+
+    // one by one
+    sf::Clock clock;
+    section->disable();
+    double disable_time = clock.getElapsedTime().asSeconds();
+    clock.restart();
+    section->enable();
+    double enable_time = clock.getElapsedTime().asSeconds();
+
+    if(counter.mDisabled != count || counter.mEnabled != count) {
+        std::cerr << "Expected " << count << " signals each, got " << counter.mDisabled << " and " << counter.mEnabled << "." << std::endl;
+        return false;
+    }
+    if(bodies.front()->getRigidBody()->getMotionState() != motion_state) {
+        std::cerr << "The motion state has been reallocated." << std::endl;
+        return false;
+    }
+
+    // batched, the signals arrive after the batch
+    counter.mEnabled = counter.mDisabled = 0;
+    std::vector<dt::Node*> roots(1, section);
+    clock.restart();
+    scene.beginLifecycleBatch();
+    section->disable();
+    uint32_t signals_in_batch = counter.mDisabled;
+    bool queued = bodies.back()->getRigidBody()->getBroadphaseHandle() != nullptr;
+    scene.endLifecycleBatch();
+    double batch_disable_time = clock.getElapsedTime().asSeconds();
+    clock.restart();
+    scene.setSubtreesEnabled(roots, true);
+    double batch_enable_time = clock.getElapsedTime().asSeconds();
+
+    if(signals_in_batch != 0 || !queued) {
+        std::cerr << "The batch has not been deferred." << std::endl;
+        return false;
+    }
+    if(counter.mDisabled != count || counter.mEnabled != count) {
+        std::cerr << "Expected " << count << " coalesced signals each, got " << counter.mDisabled << " and " << counter.mEnabled << "." << std::endl;
+        return false;
+    }
+    for(auto iter = bodies.begin(); iter != bodies.end(); ++iter) {
+        if((*iter)->getRigidBody()->getBroadphaseHandle() == nullptr) {
+            std::cerr << "A body has not been added to the world again." << std::endl;
+            return false;
+        }
+    }
+
+    // toggling within one batch cancels out
+    counter.mEnabled = counter.mDisabled = 0;
+    scene.beginLifecycleBatch();
+    scene.setSubtreesEnabled(roots, false);
+    scene.setSubtreesEnabled(roots, true);
+    scene.endLifecycleBatch();
+    if(counter.mDisabled != 0 || counter.mEnabled != 0 || !bodies.front()->isEnabled()) {
+        std::cerr << "Toggling within one batch emitted " << counter.mDisabled + counter.mEnabled << " signals." << std::endl;
+        return false;
+    }
+
+    // removing a node while its body is queued
+    scene.beginLifecycleBatch();
+    section->disable();
+    section->removeChildNode("crate0");
+    scene.endLifecycleBatch();
+    section->enable();
+    if(section->findChildNode("crate0", false) != nullptr || counter.mDisabled != count) {
+        std::cerr << "The removed node has not received its signal." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " nodes one by one: disabled in " << disable_time * 1000 << " ms, enabled in "
+              << enable_time * 1000 << " ms" << std::endl;
+    std::cout << count << " nodes batched: disabled in " << batch_disable_time * 1000 << " ms, enabled in "
+              << batch_enable_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString LifecycleBatchTest::getTestName() {
+    return "LifecycleBatch";
+}
+
+////////////////////////////////////////////////////////////////
+
+SignalCounter::SignalCounter()
+    : mEnabled(0),
+      mDisabled(0) {}
+
+void SignalCounter::onEnabled() {
+    ++mEnabled;
+}
+
+void SignalCounter::onDisabled() {
+    ++mDisabled;
+}
+
+} // namespace LifecycleBatchTest
@@ -0,0 +1,55 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_LIFECYCLEBATCHTEST
+#define DUCTTAPE_ENGINE_TESTS_LIFECYCLEBATCHTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Graphics/MeshComponent.hpp>
+#include <Physics/PhysicsBodyComponent.hpp>
+#include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
+
+#include <OgreProcedural.h>
+
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+
+namespace LifecycleBatchTest {
+
+class LifecycleBatchTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class SignalCounter : public QObject {
+    Q_OBJECT
+
+public:
+    SignalCounter();
+
+public slots:
+    void onEnabled();
+    void onDisabled();
+
+public:
+    uint32_t mEnabled;  //!< The number of enabled signals received.
+    uint32_t mDisabled; //!< The number of disabled signals received.
+};
+
+} // namespace LifecycleBatchTest
+
+#endif
@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "NodeCreationTest/NodeCreationTest.hpp"
+
+#include <Logic/TriggerComponent.hpp>
+#include <Utils/SlabAllocator.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace NodeCreationTest {
+
+bool NodeCreationTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t count = 10000;
+    dt::Scene scene("NodeCreationTest");
+    uint64_t blocks = dt::SlabPool::getBlocksInUse();
+
+    sf::Clock clock;
+    std::vector<dt::Node*> nodes;
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node* node = scene.addChildNode(new dt::Node()).get();
+        node->addComponent(new dt::TriggerComponent());
+        nodes.push_back(node);
+    }
+    double create_time = clock.getElapsedTime().asSeconds();
+
+    // the runtime ids are unique and increasing, no uuid is needed to find a node
+    for(uint32_t i = 1; i < count; ++i) {
+        if(nodes[i]->getRuntimeId() <= nodes[i - 1]->getRuntimeId()) {
+            std::cerr << "The runtime ids are not increasing." << std::endl;
+            return false;
+        }
+    }
+    if(scene.findNode(nodes[count / 2]->getRuntimeId()).get() != nodes[count / 2]) {
+        std::cerr << "The node was not found by its runtime id." << std::endl;
+        return false;
+    }
+
+    // the uuid is created on demand and stays the same
+    QUuid id = nodes[0]->getId();
+    if(id.isNull() || nodes[0]->getId() != id || scene.findNode(id).get() != nodes[0]) {
+        std::cerr << "The uuid was not created on demand." << std::endl;
+        return false;
+    }
+
+    clock.restart();
+    for(uint32_t i = 0; i < count; ++i) {
+        scene.removeChildNode(nodes[i]->getName());
+    }
+    double destroy_time = clock.getElapsedTime().asSeconds();
+
+    if(dt::SlabPool::getBlocksInUse() != blocks) {
+        std::cerr << "Not all blocks have been returned to the pool: " << dt::SlabPool::getBlocksInUse() - blocks
+                  << " still in use." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " nodes with a component: created in " << create_time * 1000 << " ms, destroyed in "
+              << destroy_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString NodeCreationTest::getTestName() {
+    return "NodeCreation";
+}
+
+} // namespace NodeCreationTest
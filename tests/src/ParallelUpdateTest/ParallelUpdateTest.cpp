@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "ParallelUpdateTest/ParallelUpdateTest.hpp"
+
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <QThread>
+
+#include <iostream>
+#include <vector>
+
+namespace ParallelUpdateTest {
+
+QThread* MainThread = nullptr;
+
+/**
+  * Adds branches of two nodes with a MoverComponent each, the inner one has an ObserverComponent as well.
+  */
+void fillScene(dt::Scene& scene, uint32_t branches, std::vector<ObserverComponent*>& observers) {
+    for(uint32_t i = 0; i < branches; ++i) {
+        dt::Node::NodeSP node = scene.addChildNode(new dt::Node("branch" + dt::Utils::toString(i)));
+        node->addComponent(new MoverComponent("mover"));
+        dt::Node::NodeSP leaf = node->addChildNode(new dt::Node("leaf" + dt::Utils::toString(i)));
+        leaf->addComponent(new MoverComponent("mover"));
+        observers.push_back(leaf->addComponent(new ObserverComponent("observer")).get());
+    }
+}
+
+bool ParallelUpdateTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+    MainThread = QThread::currentThread();
+
+    const uint32_t branches = 5000;
+    const uint32_t frames = 10;
+    std::vector<ObserverComponent*> serial_observers;
+    std::vector<ObserverComponent*> parallel_observers;
+    dt::Scene serial("ParallelUpdateTestSerial");
+    dt::Scene parallel("ParallelUpdateTestParallel");
+    fillScene(serial, branches, serial_observers);
+    fillScene(parallel, branches, parallel_observers);
+    parallel.setParallelUpdate(true);
+
+    sf::Clock clock;
+    for(uint32_t i = 0; i < frames; ++i) {
+        serial.updateFrame(0.01);
+    }
+    double serial_time = clock.getElapsedTime().asSeconds();
+
+    MoverComponent::mUpdates = 0;
+    clock.restart();
+    for(uint32_t i = 0; i < frames; ++i) {
+        parallel.updateFrame(0.01);
+    }
+    double parallel_time = clock.getElapsedTime().asSeconds();
+
+    if(MoverComponent::mUpdates != branches * 2 * frames) {
+        std::cerr << "Expected " << branches * 2 * frames << " updates of parallel-safe components, got "
+                  << MoverComponent::mUpdates << "." << std::endl;
+        return false;
+    }
+
+    for(uint32_t i = 0; i < branches; ++i) {
+        ObserverComponent* s = serial_observers[i];
+        ObserverComponent* p = parallel_observers[i];
+        if(!p->mIsOnMainThread) {
+            std::cerr << "A component that is not parallel-safe has been updated on a worker thread." << std::endl;
+            return false;
+        }
+        if(p->mUpdates != frames || p->mNotifications == 0) {
+            std::cerr << "The observer of branch " << i << " has been updated " << p->mUpdates << " times and notified "
+                      << p->mNotifications << " times." << std::endl;
+            return false;
+        }
+        if(s->getNode()->getPosition(dt::Node::SCENE) != p->getNode()->getPosition(dt::Node::SCENE)) {
+            std::cerr << "The parallel update moved branch " << i << " to a different position." << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << frames << " frames of " << branches * 2 << " nodes: serial " << serial_time * 1000
+              << " ms, parallel " << parallel_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString ParallelUpdateTest::getTestName() {
+    return "ParallelUpdate";
+}
+
+////////////////////////////////////////////////////////////////
+
+std::atomic<uint32_t> MoverComponent::mUpdates(0);
+
+MoverComponent::MoverComponent(const QString name)
+    : dt::Component(name) {}
+
+void MoverComponent::onUpdate(double time_diff) {
+    if(time_diff > 0) {
+        mNode->setPosition(mNode->getPosition() + Ogre::Vector3(1, 0, 0));
+        ++mUpdates;
+    }
+}
+
+uint32_t MoverComponent::getReadAccess() const {
+    return OWN_TRANSFORM;
+}
+
+uint32_t MoverComponent::getWriteAccess() const {
+    return OWN_TRANSFORM;
+}
+
+ObserverComponent::ObserverComponent(const QString name)
+    : dt::Component(name),
+      mUpdates(0),
+      mNotifications(0),
+      mIsOnMainThread(true) {}
+
+void ObserverComponent::onUpdate(double time_diff) {
+    if(time_diff > 0)
+        ++mUpdates;
+    else
+        ++mNotifications;
+
+    if(QThread::currentThread() != MainThread)
+        mIsOnMainThread = false;
+}
+
+} // namespace ParallelUpdateTest
@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_PARALLELUPDATETEST
+#define DUCTTAPE_ENGINE_TESTS_PARALLELUPDATETEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Scene.hpp>
+
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+
+namespace ParallelUpdateTest {
+
+class ParallelUpdateTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+/**
+  * Moves its node along the x axis. Safe to update in parallel.
+  */
+class MoverComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    MoverComponent(const QString name = "");
+    void onUpdate(double time_diff);
+    uint32_t getReadAccess() const;
+    uint32_t getWriteAccess() const;
+
+    static std::atomic<uint32_t> mUpdates;  //!< The number of per-frame updates of all MoverComponents.
+};
+
+/**
+  * Counts its updates, which all have to happen on the main thread.
+  */
+class ObserverComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    ObserverComponent(const QString name = "");
+    void onUpdate(double time_diff);
+
+    uint32_t mUpdates;          //!< The number of per-frame updates.
+    uint32_t mNotifications;    //!< The number of transform change notifications.
+    bool mIsOnMainThread;       //!< Whether all updates happened on the main thread.
+};
+
+} // namespace ParallelUpdateTest
+
+#endif
@@ -0,0 +1,172 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "PipelinedRenderingTest/PipelinedRenderingTest.hpp"
+
+#include <Graphics/DisplayManager.hpp>
+#include <Scene/StateManager.hpp>
+
+#include <OgreProcedural.h>
+#include <OgreSceneNode.h>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+
+namespace PipelinedRenderingTest {
+
+const double STEP = 0.01;       //!< The simulation step of the test.
+const uint32_t STEPS = 200;     //!< The number of steps simulated.
+
+bool PipelinedRenderingTest::run(int argc, char** argv) {
+    dt::Game game;
+    game.setPipelinedRendering(true);
+    game.setSimulationFrameTime(STEP);
+    game.setUncapped(true);
+    Main* main = new Main();
+    QObject::connect(&game, SIGNAL(beginFrame(double)), main, SLOT(onSimulationStep(double)), Qt::DirectConnection);
+    sf::Clock clock;
+    game.run(main, argc, argv);
+    double real_time = clock.getElapsedTime().asSeconds();
+
+    if(!main->mError.isEmpty()) {
+        std::cerr << main->mError.toStdString() << std::endl;
+        return false;
+    }
+    if(main->mSteps != STEPS) {
+        std::cerr << "Expected " << STEPS << " steps, got " << main->mSteps << "." << std::endl;
+        return false;
+    }
+    // every step simulated on a worker has to reach the State and its Scene
+    if(main->mSceneUpdates < STEPS || main->mSimulatedSteps < STEPS) {
+        std::cerr << "The Scene has been updated " << main->mSceneUpdates << " times in "
+                  << main->mSimulatedSteps << " simulation steps." << std::endl;
+        return false;
+    }
+    if(main->mWorkerSteps == 0) {
+        std::cerr << "The simulation has only run on the main thread." << std::endl;
+        return false;
+    }
+
+    std::cout << STEPS << " pipelined frames in " << real_time * 1000 << " ms" << std::endl;
+    return true;
+}
+
+QString PipelinedRenderingTest::getTestName() {
+    return "PipelinedRendering";
+}
+
+////////////////////////////////////////////////////////////////
+
+UpdateCounterComponent::UpdateCounterComponent(const QString name)
+    : dt::Component(name),
+      mUpdates(0) {}
+
+void UpdateCounterComponent::onUpdate(double time_diff) {
+    if(time_diff > 0)
+        ++mUpdates;
+}
+
+////////////////////////////////////////////////////////////////
+
+Main::Main()
+    : mSteps(0),
+      mWorkerSteps(0),
+      mSimulatedSteps(0),
+      mSceneUpdates(0),
+      mCounter(nullptr),
+      mMainThread(nullptr),
+      mMeshNode(nullptr),
+      mMesh(nullptr) {}
+
+void Main::onInitialize() {
+    mMainThread = QThread::currentThread();
+
+    auto scene = addScene(new dt::Scene("PipelinedRenderingTest"));
+    OgreProcedural::Root::getInstance()->sceneManager = scene->getSceneManager();
+    OgreProcedural::SphereGenerator().setRadius(1.f).realizeMesh("Sphere");
+
+    dt::Node* camera_node = scene->addChildNode(new dt::Node("camera")).get();
+    camera_node->addComponent(new dt::CameraComponent("camera"));
+    camera_node->setPosition(Ogre::Vector3(0, 5, 10));
+
+    mMeshNode = scene->addChildNode(new dt::Node("sphere")).get();
+    mMesh = mMeshNode->addComponent(new dt::MeshComponent("Sphere", "", "mesh")).get();
+    mCounter = mMeshNode->addComponent(new UpdateCounterComponent("counter")).get();
+
+    mError = checkSnapshots();
+    if(!mError.isEmpty())
+        dt::StateManager::get()->pop(1);
+}
+
+void Main::updateStateFrame(double simulation_frame_time) {
+    if(QThread::currentThread() != mMainThread)
+        ++mWorkerSteps;
+
+    ++mSteps;
+    mMeshNode->setPosition(Ogre::Vector3(static_cast<float>(mSteps) * 0.01f, 0, 0));
+    if(mSteps == STEPS) {
+        // the Scene is updated before the state in every step
+        mSceneUpdates = mCounter->mUpdates;
+        dt::StateManager::get()->pop(1);
+    }
+}
+
+void Main::onSimulationStep(double simulation_frame_time) {
+    ++mSimulatedSteps;
+}
+
+QString Main::checkSnapshots() {
+    dt::DisplayManager* display = dt::DisplayManager::get();
+    if(!display->isPipelined())
+        return "The DisplayManager is not pipelined.";
+
+    // the state of the initialization is rendered with the first frame
+    display->publishSnapshot();
+    display->render();
+    Ogre::SceneNode* scene_node = mMesh->getOgreSceneNode();
+
+    // recorded, not applied
+    mMeshNode->setPosition(Ogre::Vector3(5, 0, 0));
+    mMesh->onTransformChanged();
+    uint32_t size = display->getRecordingSnapshot()->getSize();
+    if(size == 0 || scene_node->getPosition() == Ogre::Vector3(5, 0, 0))
+        return "The transform has not been recorded.";
+
+    // the last value wins
+    for(uint32_t i = 0; i < 10; ++i) {
+        mMeshNode->setPosition(Ogre::Vector3(6, 0, static_cast<float>(i)));
+        mMesh->onTransformChanged();
+    }
+    if(display->getRecordingSnapshot()->getSize() != size)
+        return "Recording a transform again has grown the snapshot.";
+
+    // published, then applied by the frame
+    display->publishSnapshot();
+    if(display->getRecordingSnapshot()->getSize() != 0 || scene_node->getPosition() != Ogre::Vector3(0, 0, 0))
+        return "Publishing has not swapped the snapshots.";
+    display->render();
+    if(scene_node->getPosition() != Ogre::Vector3(6, 0, 9) || display->getPublishedSnapshot()->getSize() != 0)
+        return "The published snapshot has not been applied.";
+
+    // destroyed objects are removed from the snapshots
+    dt::Node* temporary = mMeshNode->getScene()->addChildNode(new dt::Node("temporary")).get();
+    temporary->addComponent(new dt::MeshComponent("Sphere", "", "mesh"));
+    temporary->setPosition(Ogre::Vector3(1, 2, 3));
+    temporary->findComponent<dt::MeshComponent>("mesh")->onTransformChanged();
+    display->publishSnapshot();
+    temporary->setPosition(Ogre::Vector3(3, 2, 1));
+    temporary->findComponent<dt::MeshComponent>("mesh")->onTransformChanged();
+    mMeshNode->getScene()->removeChildNode("temporary");
+    if(display->getRecordingSnapshot()->getSize() != 0 || display->getPublishedSnapshot()->getSize() != 0)
+        return "The removed mesh is still in a snapshot.";
+    display->render();
+
+    return "";
+}
+
+} // namespace PipelinedRenderingTest
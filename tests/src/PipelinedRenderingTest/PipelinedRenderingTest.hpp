@@ -0,0 +1,86 @@
+
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_PIPELINEDRENDERINGTEST
+#define DUCTTAPE_ENGINE_TESTS_PIPELINEDRENDERINGTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Graphics/CameraComponent.hpp>
+#include <Graphics/MeshComponent.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Game.hpp>
+#include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
+#include <Scene/State.hpp>
+
+#include <QString>
+#include <QThread>
+
+#include <cstdint>
+
+namespace PipelinedRenderingTest {
+
+class PipelinedRenderingTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class UpdateCounterComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    UpdateCounterComponent(const QString name = "");
+    void onUpdate(double time_diff);
+
+    uint32_t mUpdates;  //!< The number of per-frame updates.
+};
+
+////////////////////////////////////////////////////////////////
+
+class Main : public dt::State {
+    Q_OBJECT
+
+public:
+    Main();
+    void onInitialize();
+    void updateStateFrame(double simulation_frame_time);
+
+    /**
+      * Checks that transforms are recorded, published and applied by the DisplayManager.
+      * @returns An error message, or an empty string.
+      */
+    QString checkSnapshots();
+
+public slots:
+    /**
+      * Counts the simulation steps of the Game, connected to its beginFrame signal.
+      * @param simulation_frame_time The time of the step.
+      */
+    void onSimulationStep(double simulation_frame_time);
+
+public:
+    QString mError;             //!< The first failed check, or empty.
+    uint32_t mSteps;            //!< The number of simulation steps.
+    uint32_t mWorkerSteps;      //!< The number of simulation steps run on another thread than the main thread.
+    uint32_t mSimulatedSteps;   //!< The number of simulation steps the Game has run.
+    uint32_t mSceneUpdates;     //!< The number of updates of the Scene's components when the state has been popped.
+    UpdateCounterComponent* mCounter;   //!< Counts the updates of the Scene.
+    QThread* mMainThread;       //!< The thread the state has been initialized on.
+    dt::Node* mMeshNode;        //!< The node of the mesh that is moved.
+    dt::MeshComponent* mMesh;   //!< The mesh that is moved.
+};
+
+} // namespace PipelinedRenderingTest
+
+#endif
@@ -0,0 +1,219 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "PlainComponentTest/PlainComponentTest.hpp"
+
+#include <Utils/Profiler.hpp>
+#include <Utils/SlabAllocator.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <QFile>
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace PlainComponentTest {
+
+/**
+  * Returns the resident memory of the process, assuming 4 KiB pages, or 0 if it cannot be read on this platform.
+  */
+uint64_t getResidentBytes() {
+    QFile statm("/proc/self/statm");
+    if(!statm.open(QIODevice::ReadOnly))
+        return 0;
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    return fields.size() > 1 ? fields[1].toULongLong() * 4096 : 0;
+}
+
+/**
+  * Adds one component to each Node and returns the time it took.
+  */
+template <typename Factory>
+double addComponents(const std::vector<dt::Node*>& nodes, Factory factory, int64_t& memory) {
+    uint64_t resident = getResidentBytes();
+    sf::Clock clock;
+    for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        factory(*iter);
+    }
+    double time = clock.getElapsedTime().asSeconds();
+    memory = static_cast<int64_t>(getResidentBytes()) - static_cast<int64_t>(resident);
+    return time;
+}
+
+bool PlainComponentTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    dt::Scene scene("PlainComponentTest");
+
+    // the lifecycle is the one of a Component
+    dt::Node* node = scene.addChildNode(new dt::Node("lifecycle")).get();
+    PlainProjectile* plain = node->addPlainComponent(new PlainProjectile(dt::Name("projectile")));
+    node->addComponent(new ProjectileComponent("projectile"));
+    if(!plain->isInitialized() || !plain->isEnabled() || plain->getNode() != node || PlainProjectile::sInitializations != 1) {
+        std::cerr << "The plain component has not been initialized." << std::endl;
+        return false;
+    }
+    if(node->addPlainComponent(new PlainProjectile(dt::Name("projectile"))) != plain || node->getPlainComponentCount() != 1) {
+        std::cerr << "A second plain component with the same name has been added." << std::endl;
+        return false;
+    }
+    if(node->findPlainComponent<PlainProjectile>() != plain || node->findPlainComponent<PlainProjectile>(dt::Name("projectile")) != plain) {
+        std::cerr << "The plain component has not been found." << std::endl;
+        return false;
+    }
+
+    scene.updateFrame(0.01);
+    node->disable();
+    scene.updateFrame(0.01);
+    if(plain->mUpdates != 1 || plain->isEnabled() || plain->mDisables != 1) {
+        std::cerr << "Expected 1 update and a disabled component, got " << plain->mUpdates << " updates." << std::endl;
+        return false;
+    }
+    node->enable();
+    scene.updateFrame(0.01);
+    if(plain->mUpdates != 2 || !plain->isEnabled() || plain->mEnables != 2) {
+        std::cerr << "The plain component has not been enabled again." << std::endl;
+        return false;
+    }
+
+    // every update gets a profile zone named after the type
+    dt::Profiler::clear();
+    dt::Profiler::setEnabled(true);
+    dt::Profiler::beginFrame();
+    scene.updateFrame(0.01);
+    dt::Profiler::beginFrame();
+    dt::Profiler::setEnabled(false);
+    std::vector<dt::ProfileZoneStats> stats = dt::Profiler::getFrameStats();
+    bool has_zone = false;
+    for(auto iter = stats.begin(); iter != stats.end(); ++iter) {
+        if(std::strcmp(iter->mName, plain->getTypeName()) == 0 && iter->mCalls == 1)
+            has_zone = true;
+    }
+    dt::Profiler::clear();
+    if(!has_zone) {
+        std::cerr << "The update of the plain component has not been profiled." << std::endl;
+        return false;
+    }
+
+    node->removePlainComponent(dt::Name("projectile"));
+    if(node->getPlainComponentCount() != 0 || PlainProjectile::sDeinitializations != 1) {
+        std::cerr << "The plain component has not been removed." << std::endl;
+        return false;
+    }
+    scene.removeChildNode("lifecycle");
+
+    // creation time and memory of many components
+    const uint32_t count = 20000;
+    std::vector<dt::Node*> nodes;
+    std::vector<dt::Node*> plain_nodes;
+    for(uint32_t i = 0; i < count; ++i) {
+        nodes.push_back(scene.addChildNode(new dt::Node()).get());
+        plain_nodes.push_back(scene.addChildNode(new dt::Node()).get());
+    }
+    uint64_t blocks = dt::SlabPool::getBlocksInUse();
+
+    int64_t memory = 0;
+    double create_time = addComponents(nodes, [] (dt::Node* node) {
+        node->addComponent(new ProjectileComponent("projectile"));
+    }, memory);
+    int64_t plain_memory = 0;
+    double plain_create_time = addComponents(plain_nodes, [] (dt::Node* node) {
+        node->addPlainComponent(new PlainProjectile());
+    }, plain_memory);
+
+    sf::Clock clock;
+    scene.updateFrame(0.01);
+    double update_time = clock.getElapsedTime().asSeconds();
+
+    for(auto iter = plain_nodes.begin(); iter != plain_nodes.end(); ++iter) {
+        if((*iter)->findPlainComponent<PlainProjectile>()->mUpdates != 1) {
+            std::cerr << "Not every plain component has been updated." << std::endl;
+            return false;
+        }
+    }
+
+    if(sizeof(PlainProjectile) >= sizeof(ProjectileComponent)) {
+        std::cerr << "The plain component is not smaller than the Component." << std::endl;
+        return false;
+    }
+
+    for(uint32_t i = 0; i < count; ++i) {
+        nodes[i]->removeComponent("projectile");
+        plain_nodes[i]->removePlainComponent(plain_nodes[i]->findPlainComponent<PlainProjectile>());
+    }
+    if(dt::SlabPool::getBlocksInUse() != blocks) {
+        std::cerr << "Not all blocks have been returned to the pool: " << dt::SlabPool::getBlocksInUse() - blocks
+                  << " still in use." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " Components: " << sizeof(ProjectileComponent) << " bytes each, "
+              << memory / count << " bytes resident each, created in " << create_time * 1000 << " ms" << std::endl;
+    std::cout << count << " PlainComponents: " << sizeof(PlainProjectile) << " bytes each, "
+              << plain_memory / count << " bytes resident each, created in " << plain_create_time * 1000 << " ms" << std::endl;
+    std::cout << "Frame with both: " << update_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString PlainComponentTest::getTestName() {
+    return "PlainComponent";
+}
+
+////////////////////////////////////////////////////////////////
+
+ProjectileComponent::ProjectileComponent(const QString name)
+    : Component(name),
+      mDistance(0) {}
+
+void ProjectileComponent::onUpdate(double time_diff) {
+    mDistance += 100.f * time_diff;
+}
+
+////////////////////////////////////////////////////////////////
+
+uint32_t PlainProjectile::sInitializations = 0;
+uint32_t PlainProjectile::sDeinitializations = 0;
+
+PlainProjectile::PlainProjectile(const dt::Name& name)
+    : PlainComponent(name),
+      mDistance(0),
+      mUpdates(0),
+      mEnables(0),
+      mDisables(0) {}
+
+void PlainProjectile::onInitialize() {
+    ++sInitializations;
+}
+
+void PlainProjectile::onDeinitialize() {
+    ++sDeinitializations;
+}
+
+void PlainProjectile::onEnable() {
+    ++mEnables;
+}
+
+void PlainProjectile::onDisable() {
+    ++mDisables;
+}
+
+void PlainProjectile::onUpdate(double time_diff) {
+    if(time_diff != 0)
+        ++mUpdates;
+    mDistance += 100.f * time_diff;
+}
+
+const char* PlainProjectile::getTypeName() const {
+    return "PlainProjectile";
+}
+
+} // namespace PlainComponentTest
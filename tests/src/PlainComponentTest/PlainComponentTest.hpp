@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_PLAINCOMPONENTTEST
+#define DUCTTAPE_ENGINE_TESTS_PLAINCOMPONENTTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/PlainComponent.hpp>
+#include <Scene/Scene.hpp>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace PlainComponentTest {
+
+class PlainComponentTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class ProjectileComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    ProjectileComponent(const QString name = "");
+    void onUpdate(double time_diff);
+
+    float mDistance;    //!< The distance travelled.
+};
+
+////////////////////////////////////////////////////////////////
+
+class PlainProjectile : public dt::PlainComponent {
+public:
+    PlainProjectile(const dt::Name& name = dt::Name());
+    void onInitialize();
+    void onDeinitialize();
+    void onEnable();
+    void onDisable();
+    void onUpdate(double time_diff);
+    const char* getTypeName() const;
+
+    float mDistance;    //!< The distance travelled.
+    uint32_t mUpdates;  //!< The number of per-frame updates.
+    uint32_t mEnables;  //!< The number of onEnable() calls.
+    uint32_t mDisables; //!< The number of onDisable() calls.
+
+    static uint32_t sInitializations;   //!< The number of onInitialize() calls of all instances.
+    static uint32_t sDeinitializations; //!< The number of onDeinitialize() calls of all instances.
+};
+
+} // namespace PlainComponentTest
+
+#endif
@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "PrefabTest/PrefabTest.hpp"
+
+#include <Logic/TriggerComponent.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+
+namespace PrefabTest {
+
+bool PrefabTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t count = 10000;
+    dt::Scene scene("PrefabTest");
+
+    // a crate with a lid
+    dt::Prefab crate("crate");
+    ConfigComponent* prototype = crate.addComponent(new ConfigComponent("config"));
+    prototype->mConfig.edit().mValues.assign(1000, 1.f);
+    crate.addComponent(new dt::TriggerComponent("trigger"));
+    dt::Prefab* lid = crate.addChild(new dt::Prefab("lid"));
+    lid->setTransform(dt::Prefab::Transform(Ogre::Vector3(0, 1, 0)));
+    lid->addComponent(new ConfigComponent("lid_config"));
+
+    if(crate.getNodeCount() != 2) {
+        std::cerr << "The prefab has " << crate.getNodeCount() << " instead of 2 nodes." << std::endl;
+        return false;
+    }
+
+    std::vector<dt::Prefab::Transform> transforms;
+    for(uint32_t i = 0; i < count; ++i) {
+        transforms.push_back(dt::Prefab::Transform(Ogre::Vector3(i, 0, 0)));
+    }
+
+    sf::Clock clock;
+    std::vector<dt::Node*> crates = crate.instantiate(&scene, transforms);
+    double prefab_time = clock.getElapsedTime().asSeconds();
+
+    if(crates.size() != count) {
+        std::cerr << "Only " << crates.size() << " of " << count << " crates have been instantiated." << std::endl;
+        return false;
+    }
+
+    // the instances are complete and share the configuration of the prototype
+    dt::Node* first = crates.front();
+    dt::Node* last = crates.back();
+    auto first_config = first->findComponent<ConfigComponent>("config");
+    auto last_config = last->findComponent<ConfigComponent>("config");
+    dt::Node::NodeSP last_lid = last->findChildNode("lid", false);
+    if(first_config == nullptr || last->findComponent<dt::TriggerComponent>("trigger") == nullptr
+            || last_lid == nullptr || last_lid->findComponent<ConfigComponent>("lid_config") == nullptr) {
+        std::cerr << "The instances are missing components or children." << std::endl;
+        return false;
+    }
+    if(last->getPosition() != Ogre::Vector3(count - 1, 0, 0) || last_lid->getPosition() != Ogre::Vector3(0, 1, 0)) {
+        std::cerr << "The instances have not been placed correctly." << std::endl;
+        return false;
+    }
+    if(!first_config->mConfig.isSharedWith(prototype->mConfig) || !last_config->mConfig.isSharedWith(prototype->mConfig)) {
+        std::cerr << "The configuration has been copied on instantiation." << std::endl;
+        return false;
+    }
+
+    // changing one instance does not change the others
+    first_config->mConfig.edit().mValues[0] = 2.f;
+    if(first_config->mConfig.isSharedWith(prototype->mConfig) || !last_config->mConfig.isSharedWith(prototype->mConfig)
+            || last_config->mConfig->mValues[0] != 1.f) {
+        std::cerr << "Changing the configuration of one instance has changed the others." << std::endl;
+        return false;
+    }
+
+    // a prefab can be made from an existing subtree
+    dt::Prefab copy(first);
+    if(copy.getName() != first->getName() || copy.getNodeCount() != 2) {
+        std::cerr << "The subtree has not been captured correctly." << std::endl;
+        return false;
+    }
+    dt::Node::NodeSP copied = copy.instantiate(&scene);
+    auto copied_config = copied->findComponent<ConfigComponent>("config");
+    if(copied_config == nullptr || !copied_config->mConfig.isSharedWith(first_config->mConfig)) {
+        std::cerr << "The captured subtree has not been instantiated correctly." << std::endl;
+        return false;
+    }
+    if(copy.instantiate(&scene, dt::Prefab::Transform(), copied->getName()) != nullptr) {
+        std::cerr << "An instance with a duplicate name has been created." << std::endl;
+        return false;
+    }
+
+    // compare with building the same subtrees by hand
+    std::vector<float> values(1000, 1.f);
+    clock.restart();
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node::NodeSP node = scene.addChildNode(new dt::Node("manual" + dt::Utils::toString(i)));
+        node->setPosition(i, 0, 0);
+        node->addComponent(new ConfigComponent("config"))->mConfig.edit().mValues = values;
+        node->addComponent(new dt::TriggerComponent("trigger"));
+        dt::Node::NodeSP child = node->addChildNode(new dt::Node("lid"));
+        child->setPosition(0, 1, 0);
+        child->addComponent(new ConfigComponent("lid_config"));
+    }
+    double manual_time = clock.getElapsedTime().asSeconds();
+
+    std::cout << count << " subtrees: built by hand in " << manual_time * 1000 << " ms, instantiated in "
+              << prefab_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString PrefabTest::getTestName() {
+    return "Prefab";
+}
+
+////////////////////////////////////////////////////////////////
+
+ConfigComponent::ConfigComponent(const QString name)
+    : Component(name) {}
+
+dt::Component* ConfigComponent::clone() {
+    ConfigComponent* component = new ConfigComponent(getName());
+    component->mConfig = mConfig;
+    return component;
+}
+
+} // namespace PrefabTest
@@ -0,0 +1,52 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_PREFABTEST
+#define DUCTTAPE_ENGINE_TESTS_PREFABTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Prefab.hpp>
+#include <Scene/Scene.hpp>
+#include <Utils/CopyOnWrite.hpp>
+
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace PrefabTest {
+
+class PrefabTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class ConfigComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    struct Config {
+        std::vector<float> mValues; //!< Stands in for a large configuration, e.g. a path or an animation table.
+    };
+
+    ConfigComponent(const QString name = "");
+    dt::Component* clone();
+
+    dt::CopyOnWrite<Config> mConfig;    //!< The configuration, shared between clones.
+};
+
+} // namespace PrefabTest
+
+#endif
@@ -0,0 +1,121 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "ProfilerTest/ProfilerTest.hpp"
+
+#include <QFile>
+
+#include <SFML/System/Sleep.hpp>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ProfilerTest {
+
+bool ProfilerTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+    dt::JobSystem* jobs = dt::JobSystem::get();
+
+    auto find_stats = [] (const std::vector<dt::ProfileZoneStats>& stats, const char* name) -> dt::ProfileZoneStats {
+        for(auto iter = stats.begin(); iter != stats.end(); ++iter) {
+            if(std::strcmp(iter->mName, name) == 0)
+                return *iter;
+        }
+        dt::ProfileZoneStats none = {name, 0, 0.0, 0.0, 0.0};
+        return none;
+    };
+
+    // nothing is recorded while the profiler is disabled
+    dt::Profiler::clear();
+    dt::Profiler::beginFrame();
+    {
+        DUCTTAPE_PROFILE_ZONE("Disabled");
+    }
+    dt::Profiler::beginFrame();
+    if(dt::Profiler::getFrameCount() != 0) {
+        std::cerr << "Frames have been recorded while the profiler was disabled." << std::endl;
+        return false;
+    }
+
+    // nested zones on the main thread and the workers
+    dt::Profiler::setEnabled(true);
+    dt::Profiler::beginFrame();
+    {
+        DUCTTAPE_PROFILE_ZONE("Outer");
+        for(uint32_t i = 0; i < 3; ++i) {
+            DUCTTAPE_PROFILE_ZONE("Inner");
+            sf::sleep(sf::milliseconds(2));
+        }
+        jobs->parallelFor(0, 64, 1, [] (uint32_t) {
+            DUCTTAPE_PROFILE_ZONE("Job");
+        });
+    }
+    dt::Profiler::beginFrame();
+
+    if(dt::Profiler::getFrameCount() != 1 || dt::Profiler::getFrameTime() <= 0.0) {
+        std::cerr << "Expected one frame, got " << dt::Profiler::getFrameCount() << "." << std::endl;
+        return false;
+    }
+    std::vector<dt::ProfileZoneStats> stats = dt::Profiler::getFrameStats();
+    dt::ProfileZoneStats outer = find_stats(stats, "Outer");
+    dt::ProfileZoneStats inner = find_stats(stats, "Inner");
+    dt::ProfileZoneStats job = find_stats(stats, "Job");
+    if(outer.mCalls != 1 || inner.mCalls != 3 || job.mCalls != 64) {
+        std::cerr << "Wrong zone counts: " << outer.mCalls << " outer, " << inner.mCalls << " inner, "
+                  << job.mCalls << " jobs." << std::endl;
+        return false;
+    }
+    if(inner.mTotalTime < 0.006 || outer.mTotalTime < inner.mTotalTime
+            || outer.mSelfTime > outer.mTotalTime - inner.mTotalTime + 0.000001) {
+        std::cerr << "The time of the nested zones has not been subtracted from the outer zone." << std::endl;
+        return false;
+    }
+    if(stats.front().mTotalTime < outer.mTotalTime) {
+        std::cerr << "The stats are not sorted by their total time." << std::endl;
+        return false;
+    }
+
+    // the trace
+    std::string trace = dt::Profiler::toChromeTrace().toStdString();
+    if(trace.find("\"traceEvents\"") == std::string::npos || trace.find("\"name\":\"Inner\"") == std::string::npos
+            || trace.find("\"ph\":\"X\"") == std::string::npos) {
+        std::cerr << "The Chrome trace is incomplete:" << std::endl << trace << std::endl;
+        return false;
+    }
+    if(!dt::Profiler::writeChromeTrace("ProfilerTest.json") || !QFile::exists("ProfilerTest.json")) {
+        std::cerr << "The Chrome trace has not been written." << std::endl;
+        return false;
+    }
+    QFile::remove("ProfilerTest.json");
+
+    // only the last frames are kept
+    dt::Profiler::setFrameCapacity(2);
+    for(uint32_t i = 0; i < 4; ++i) {
+        DUCTTAPE_PROFILE_ZONE("Frame content");
+        dt::Profiler::beginFrame();
+    }
+    if(dt::Profiler::getFrameCount() != 2) {
+        std::cerr << "Expected 2 frames to be kept, got " << dt::Profiler::getFrameCount() << "." << std::endl;
+        return false;
+    }
+
+    std::cout << "Frame time: " << dt::Profiler::getFrameTime() * 1000 << " ms" << std::endl;
+
+    dt::Profiler::setEnabled(false);
+    dt::Profiler::setFrameCapacity(dt::Profiler::DEFAULT_FRAME_CAPACITY);
+    dt::Profiler::clear();
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString ProfilerTest::getTestName() {
+    return "Profiler";
+}
+
+} // namespace ProfilerTest
@@ -0,0 +1,96 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "SceneIndexTest/SceneIndexTest.hpp"
+
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace SceneIndexTest {
+
+bool SceneIndexTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    // 100 branches of 100 nodes each, once in a Scene and once below a plain Node, which is not indexed
+    const uint32_t branches = 100;
+    const uint32_t depth = 100;
+    dt::Scene scene("SceneIndexTest");
+    dt::Node unindexed("SceneIndexTestUnindexed");
+    std::vector<dt::Node*> leaves;
+    for(uint32_t b = 0; b < branches; ++b) {
+        dt::Node* node = &scene;
+        dt::Node* unindexed_node = &unindexed;
+        for(uint32_t d = 0; d < depth; ++d) {
+            QString name = "node" + dt::Utils::toString(b * depth + d);
+            node = node->addChildNode(new dt::Node(name)).get();
+            unindexed_node = unindexed_node->addChildNode(new dt::Node(name)).get();
+        }
+        leaves.push_back(node);
+    }
+
+    const uint32_t lookups = 1000;
+    sf::Clock clock;
+    for(uint32_t i = 0; i < lookups; ++i) {
+        QString name = "node" + dt::Utils::toString(i * 7 % (branches * depth));
+        if(scene.findChildNode(name) == nullptr) {
+            std::cerr << "Node " << dt::Utils::toStdString(name) << " was not found in the index." << std::endl;
+            return false;
+        }
+    }
+    double index_time = clock.getElapsedTime().asSeconds();
+
+    clock.restart();
+    for(uint32_t i = 0; i < lookups; ++i) {
+        unindexed.findChildNode("node" + dt::Utils::toString(i * 7 % (branches * depth)));
+    }
+    double walk_time = clock.getElapsedTime().asSeconds();
+
+    // lookup by id
+    dt::Node::NodeSP by_id = scene.findNode(leaves[0]->getId());
+    if(by_id.get() != leaves[0]) {
+        std::cerr << "The node was not found by its id." << std::endl;
+        return false;
+    }
+
+    // the lookup from a node only finds nodes below it
+    dt::Node::NodeSP branch = scene.findChildNode("node" + dt::Utils::toString(depth));
+    if(branch->findChildNode(leaves[0]->getName()) != nullptr || branch->findChildNode(leaves[1]->getName()) == nullptr) {
+        std::cerr << "The lookup below a node returned a wrong result." << std::endl;
+        return false;
+    }
+
+    // reparented and removed nodes
+    dt::Scene other("SceneIndexTestOther");
+    branch->setParent(&other);
+    if(scene.findChildNode(leaves[1]->getName()) != nullptr || other.findChildNode(leaves[1]->getName()) == nullptr
+            || other.findNode(leaves[1]->getId()) == nullptr) {
+        std::cerr << "The index was not updated when a subtree was moved to another scene." << std::endl;
+        return false;
+    }
+    QUuid removed_id = leaves[1]->getId();
+    other.removeChildNode(branch->getName());
+    if(other.findNode(removed_id) != nullptr || !other.findNodes(dt::Name::find("node" + dt::Utils::toString(depth + 1))).empty()) {
+        std::cerr << "Removed nodes are still in the index." << std::endl;
+        return false;
+    }
+
+    std::cout << lookups << " lookups among " << branches * depth << " nodes: index " << index_time * 1000
+              << " ms, tree walk " << walk_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString SceneIndexTest::getTestName() {
+    return "SceneIndex";
+}
+
+} // namespace SceneIndexTest
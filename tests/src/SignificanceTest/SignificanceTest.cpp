@@ -0,0 +1,128 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "SignificanceTest/SignificanceTest.hpp"
+
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace SignificanceTest {
+
+/**
+  * Runs a number of frames and returns the time per frame.
+  */
+double runFrames(dt::Scene& scene, uint32_t frames) {
+    sf::Clock clock;
+    for(uint32_t i = 0; i < frames; ++i) {
+        scene.updateFrame(0.01);
+    }
+    return clock.getElapsedTime().asSeconds() / frames;
+}
+
+bool SignificanceTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t count = 5000;
+    const uint32_t frames = 64;
+    dt::Scene scene("SignificanceTest");
+    dt::Node::NodeSP camera = scene.addChildNode(new dt::Node("camera"));
+
+    // units in a line, the first one right in front of the camera
+    std::vector<UnitComponent*> units;
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node::NodeSP node = scene.addChildNode(new dt::Node("unit" + dt::Utils::toString(i)));
+        node->setPosition(0, 0, -5.f - i);
+        units.push_back(node->addComponent(new UnitComponent("unit")).get());
+    }
+    double full_time = runFrames(scene, frames);
+
+    dt::SignificanceManager* significance = scene.getSignificanceManager();
+    significance->setViewpoint(camera.get());
+    significance->setBudget(50, 200);
+    // units farther away than about 1700 are DORMANT
+    significance->setDormantScreenSize(0.001f);
+    for(auto iter = units.begin(); iter != units.end(); ++iter) {
+        (*iter)->setSignificanceEnabled(true);
+        (*iter)->mUpdates = 0;
+    }
+    if(significance->getNodeCount() != count) {
+        std::cerr << "Only " << significance->getNodeCount() << " of " << count << " nodes are scored." << std::endl;
+        return false;
+    }
+
+    double reduced_time = runFrames(scene, frames);
+
+    // the nearest units are updated every frame, the farthest ones rarely
+    if(units.front()->getSignificance() != dt::SignificanceManager::HIGH || units[100]->getSignificance() != dt::SignificanceManager::MEDIUM
+            || units.back()->getSignificance() != dt::SignificanceManager::DORMANT) {
+        std::cerr << "The units have not been scored by distance." << std::endl;
+        return false;
+    }
+    if(significance->getNodeCount(dt::SignificanceManager::HIGH) != 50 || significance->getNodeCount(dt::SignificanceManager::MEDIUM) != 200) {
+        std::cerr << "The budget has not been kept: " << significance->getNodeCount(dt::SignificanceManager::HIGH) << " HIGH, "
+                  << significance->getNodeCount(dt::SignificanceManager::MEDIUM) << " MEDIUM." << std::endl;
+        return false;
+    }
+    if(units.front()->mUpdates != frames || units.back()->mUpdates > frames / 16 + 1 || units.back()->mChanges != 1) {
+        std::cerr << "Expected " << frames << " updates of the nearest and at most " << frames / 16 + 1 << " of the farthest unit, got "
+                  << units.front()->mUpdates << " and " << units.back()->mUpdates << "." << std::endl;
+        return false;
+    }
+
+    // moving the camera changes the order
+    camera->setPosition(0, 0, -5.f - count);
+    scene.updateFrame(0.01);
+    if(units.front()->getSignificance() != dt::SignificanceManager::DORMANT || units.back()->getSignificance() != dt::SignificanceManager::HIGH) {
+        std::cerr << "The units have not been scored again after the camera moved." << std::endl;
+        return false;
+    }
+
+    // opting out restores the full rate
+    units.front()->setSignificanceEnabled(false);
+    units.front()->mUpdates = 0;
+    runFrames(scene, 4);
+    if(units.front()->getSignificance() != dt::SignificanceManager::HIGH || units.front()->mUpdates != 4) {
+        std::cerr << "The unit has not returned to full detail after opting out." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " units: " << full_time * 1000 << " ms per frame at full detail, "
+              << reduced_time * 1000 << " ms per frame with significance" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString SignificanceTest::getTestName() {
+    return "Significance";
+}
+
+////////////////////////////////////////////////////////////////
+
+UnitComponent::UnitComponent(const QString name)
+    : Component(name),
+      mUpdates(0),
+      mChanges(0),
+      mState(0) {}
+
+void UnitComponent::onUpdate(double time_diff) {
+    ++mUpdates;
+    for(uint32_t i = 0; i < 200; ++i) {
+        mState = std::sin(mState + static_cast<float>(time_diff));
+    }
+}
+
+void UnitComponent::onSignificanceChanged(dt::SignificanceManager::Level level) {
+    ++mChanges;
+}
+
+} // namespace SignificanceTest
@@ -0,0 +1,49 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_SIGNIFICANCETEST
+#define DUCTTAPE_ENGINE_TESTS_SIGNIFICANCETEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Scene.hpp>
+#include <Scene/SignificanceManager.hpp>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace SignificanceTest {
+
+class SignificanceTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class UnitComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    UnitComponent(const QString name = "");
+    void onUpdate(double time_diff);
+    void onSignificanceChanged(dt::SignificanceManager::Level level);
+
+    uint32_t mUpdates;  //!< The number of updates.
+    uint32_t mChanges;  //!< The number of significance changes.
+    float mState;       //!< Stands in for the work of an AI or animation update.
+};
+
+} // namespace SignificanceTest
+
+#endif
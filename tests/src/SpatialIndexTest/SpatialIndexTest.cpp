@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "SpatialIndexTest/SpatialIndexTest.hpp"
+
+#include <Utils/Random.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+namespace SpatialIndexTest {
+
+bool SpatialIndexTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t counts[] = {1000, 10000, 100000};
+    for(uint32_t c = 0; c < 3; ++c) {
+        dt::Scene scene("SpatialIndexTest" + dt::Utils::toString(counts[c]));
+        std::vector<dt::Node*> nodes;
+        for(uint32_t i = 0; i < counts[c]; ++i) {
+            dt::Node* node = scene.addChildNode(new dt::Node()).get();
+            node->setPosition(dt::Random::get(-1000.f, 1000.f), dt::Random::get(-50.f, 50.f), dt::Random::get(-1000.f, 1000.f));
+            nodes.push_back(node);
+        }
+
+        std::cout << counts[c] << " nodes:" << std::endl;
+        if(!_testIndex(scene, nodes, dt::SpatialIndex::LOOSE_OCTREE) || !_testIndex(scene, nodes, dt::SpatialIndex::AABB_TREE))
+            return false;
+    }
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString SpatialIndexTest::getTestName() {
+    return "SpatialIndex";
+}
+
+bool SpatialIndexTest::_testIndex(dt::Scene& scene, const std::vector<dt::Node*>& nodes, dt::SpatialIndex::Type type) {
+    QString name = (type == dt::SpatialIndex::LOOSE_OCTREE) ? "loose octree" : "AABB tree";
+
+    sf::Clock clock;
+    scene.setSpatialIndex(type);
+    double build_time = clock.getElapsedTime().asSeconds();
+
+    // the index follows moved nodes at the end of the frame
+    for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        (*iter)->setPosition((*iter)->getPosition() + Ogre::Vector3(dt::Random::get(-5.f, 5.f), 0, dt::Random::get(-5.f, 5.f)));
+    }
+    nodes[0]->setPosition(5000, 0, 5000);
+    dt::Node* added = scene.addChildNode(new dt::Node()).get();
+    added->setPosition(-5000, 0, -5000);
+    clock.restart();
+    scene.updateFrame(0.01);
+    double update_time = clock.getElapsedTime().asSeconds();
+
+    dt::SpatialIndex* index = scene.getSpatialIndex();
+    if(index == nullptr || index->getSize() != nodes.size() + 1) {
+        std::cerr << "The " << dt::Utils::toStdString(name) << " does not contain all nodes." << std::endl;
+        return false;
+    }
+
+    const uint32_t queries = 1000;
+    const float radius = 20;
+    const uint32_t neighbours = 8;
+    std::vector<Ogre::Vector3> centers;
+    for(uint32_t i = 0; i < queries; ++i) {
+        centers.push_back(Ogre::Vector3(dt::Random::get(-1000.f, 1000.f), 0, dt::Random::get(-1000.f, 1000.f)));
+    }
+
+    std::vector<std::vector<dt::Node*> > radius_results;
+    clock.restart();
+    index->queryRadius(centers, radius, radius_results);
+    double radius_time = clock.getElapsedTime().asSeconds();
+
+    std::vector<std::vector<dt::Node*> > nearest_results;
+    clock.restart();
+    index->queryNearest(centers, neighbours, nearest_results);
+    double nearest_time = clock.getElapsedTime().asSeconds();
+
+    // brute force for comparison
+    std::vector<dt::Node*> expected;
+    clock.restart();
+    for(uint32_t i = 0; i < queries; ++i) {
+        expected.clear();
+        for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+            if((*iter)->getPosition(dt::Node::SCENE).squaredDistance(centers[i]) <= radius * radius)
+                expected.push_back(*iter);
+        }
+
+        std::vector<dt::Node*> result = radius_results[i];
+        std::sort(result.begin(), result.end());
+        std::sort(expected.begin(), expected.end());
+        if(result != expected) {
+            std::cerr << "The " << dt::Utils::toStdString(name) << " returned wrong nodes for a radius query." << std::endl;
+            return false;
+        }
+    }
+    double brute_force_time = clock.getElapsedTime().asSeconds();
+
+    for(uint32_t i = 0; i < queries; i += 50) {
+        std::vector<float> distances;
+        for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+            distances.push_back((*iter)->getPosition(dt::Node::SCENE).squaredDistance(centers[i]));
+        }
+        std::sort(distances.begin(), distances.end());
+        for(uint32_t k = 0; k < neighbours; ++k) {
+            if(nearest_results[i][k]->getPosition(dt::Node::SCENE).squaredDistance(centers[i]) != distances[k]) {
+                std::cerr << "The " << dt::Utils::toStdString(name) << " returned wrong nearest neighbours." << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // a wedge standing in for a camera frustum, and a box
+    Ogre::PlaneBoundedVolume volume;
+    volume.planes.push_back(Ogre::Plane(Ogre::Vector3(1, 0, 0), Ogre::Vector3(0, 0, 0)));
+    volume.planes.push_back(Ogre::Plane(Ogre::Vector3(0, 0, 1), Ogre::Vector3(0, 0, 0)));
+    volume.planes.push_back(Ogre::Plane(Ogre::Vector3(-1, 0, -1), Ogre::Vector3(200, 0, 0)));
+    Ogre::AxisAlignedBox box(Ogre::Vector3(-100, -10, -100), Ogre::Vector3(100, 10, 100));
+    std::vector<dt::Node*> in_volume;
+    std::vector<dt::Node*> in_box;
+    clock.restart();
+    index->queryVolume(volume, in_volume);
+    index->queryBox(box, in_box);
+    double volume_time = clock.getElapsedTime().asSeconds();
+
+    uint32_t expected_in_volume = 0;
+    uint32_t expected_in_box = 0;
+    for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        Ogre::Vector3 position = (*iter)->getPosition(dt::Node::SCENE);
+        if(position.x >= 0 && position.z >= 0 && position.x + position.z <= 200)
+            ++expected_in_volume;
+        if(box.intersects(position))
+            ++expected_in_box;
+    }
+    if(in_volume.size() != expected_in_volume || in_box.size() != expected_in_box) {
+        std::cerr << "The " << dt::Utils::toStdString(name) << " returned wrong nodes for a volume or box query." << std::endl;
+        return false;
+    }
+
+    // moved and added nodes are found, removed nodes are not
+    std::vector<dt::Node*> result;
+    index->queryNearest(Ogre::Vector3(4000, 0, 4000), 1, result);
+    if(result.size() != 1 || result[0] != nodes[0]) {
+        std::cerr << "The " << dt::Utils::toStdString(name) << " did not follow a moved node." << std::endl;
+        return false;
+    }
+    index->queryNearest(Ogre::Vector3(-4000, 0, -4000), 1, result);
+    if(result.size() != 1 || result[0] != added) {
+        std::cerr << "The " << dt::Utils::toStdString(name) << " does not contain an added node." << std::endl;
+        return false;
+    }
+    scene.removeChildNode(added->getName());
+    index->queryRadius(Ogre::Vector3(-5000, 0, -5000), 1, result);
+    if(!result.empty() || index->getSize() != nodes.size()) {
+        std::cerr << "The " << dt::Utils::toStdString(name) << " still contains a removed node." << std::endl;
+        return false;
+    }
+
+    std::cout << "  " << dt::Utils::toStdString(name) << ": build " << build_time * 1000 << " ms, update "
+              << update_time * 1000 << " ms, " << queries << " radius queries " << radius_time * 1000 << " ms (brute force "
+              << brute_force_time * 1000 << " ms), " << queries << " nearest " << neighbours << " " << nearest_time * 1000
+              << " ms, volume and box " << volume_time * 1000 << " ms" << std::endl;
+
+    scene.setSpatialIndex(dt::SpatialIndex::NONE);
+    return true;
+}
+
+} // namespace SpatialIndexTest
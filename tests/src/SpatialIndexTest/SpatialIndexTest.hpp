@@ -0,0 +1,45 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_SPATIALINDEXTEST
+#define DUCTTAPE_ENGINE_TESTS_SPATIALINDEXTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
+#include <Scene/SpatialIndex.hpp>
+
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace SpatialIndexTest {
+
+class SpatialIndexTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+
+private:
+    /**
+      * Compares the query results of a spatial index with a brute force search and prints the timings.
+      * @param scene The Scene to test.
+      * @param nodes All Nodes of the Scene.
+      * @param type The spatial index to test.
+      * @returns Whether all results were correct.
+      */
+    bool _testIndex(dt::Scene& scene, const std::vector<dt::Node*>& nodes, dt::SpatialIndex::Type type);
+};
+
+} // namespace SpatialIndexTest
+
+#endif
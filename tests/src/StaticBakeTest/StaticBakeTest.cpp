@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "StaticBakeTest/StaticBakeTest.hpp"
+
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace StaticBakeTest {
+
+/**
+  * Updates the Scene a few times and returns the average frame time.
+  */
+double measureFrames(dt::Scene& scene, uint32_t frames) {
+    sf::Clock clock;
+    for(uint32_t i = 0; i < frames; ++i) {
+        scene.updateFrame(0.01);
+    }
+    return clock.getElapsedTime().asSeconds() / frames;
+}
+
+bool StaticBakeTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    dt::Scene scene("StaticBakeTest");
+    OgreProcedural::Root::getInstance()->sceneManager = scene.getSceneManager();
+    OgreProcedural::SphereGenerator().setRadius(1.f).realizeMesh("Sphere");
+
+    // a level of props that never move
+    const uint32_t count = 2000;
+    const uint32_t frames = 20;
+    dt::Node* level = scene.addChildNode(new dt::Node("level")).get();
+    std::vector<BakeCounter*> counters;
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node* node = level->addChildNode(new dt::Node("prop" + dt::Utils::toString(i))).get();
+        node->setPosition(static_cast<float>(i % 50) * 3, 0, static_cast<float>(i / 50) * 3);
+        node->addComponent(new dt::MeshComponent("Sphere", "", "mesh"));
+        counters.push_back(node->addComponent(new BakeCounter("counter")).get());
+    }
+    dt::Node* wall = level->findChildNode("prop0", false).get();
+    dt::PhysicsBodyComponent* body = wall->addComponent(new dt::PhysicsBodyComponent("mesh", "body",
+                                                        dt::PhysicsBodyComponent::SPHERE, 1.f)).get();
+
+    double dynamic_time = measureFrames(scene, frames);
+
+    // baked
+    level->bake();
+    uint32_t updates = counters.front()->mUpdates;
+    double static_time = measureFrames(scene, frames);
+
+    if(!level->isStatic() || !wall->isStatic() || counters.back()->mBakes != 1) {
+        std::cerr << "The level has not been baked." << std::endl;
+        return false;
+    }
+    if(counters.front()->mUpdates != updates) {
+        std::cerr << "A baked component has been updated " << counters.front()->mUpdates - updates << " times." << std::endl;
+        return false;
+    }
+    if(wall->findComponent<dt::MeshComponent>("mesh")->getOgreEntity()->isVisible()) {
+        std::cerr << "The entity of a baked mesh is still visible." << std::endl;
+        return false;
+    }
+    if(!body->getRigidBody()->isStaticObject() || body->getRigidBody()->getInvMass() != 0) {
+        std::cerr << "The body of a baked node is not static." << std::endl;
+        return false;
+    }
+
+    // static nodes cannot be moved, only their parent can be unbaked
+    wall->setPosition(100, 0, 0);
+    wall->unbake();
+    if(wall->getPosition().x != 0 || !wall->isStatic()) {
+        std::cerr << "A static node has been changed." << std::endl;
+        return false;
+    }
+
+    // children of a static node are baked, too
+    dt::Node* added = level->addChildNode(new dt::Node("added")).get();
+    BakeCounter* added_counter = added->addComponent(new BakeCounter("counter")).get();
+    if(!added->isStatic() || added_counter->mBakes != 1) {
+        std::cerr << "A node added to a static node has not been baked." << std::endl;
+        return false;
+    }
+
+    // unbaked
+    level->unbake();
+    scene.updateFrame(0.01);
+    if(level->isStatic() || counters.back()->mUnbakes != 1 || counters.back()->mUpdates != updates + 1) {
+        std::cerr << "The level has not been unbaked." << std::endl;
+        return false;
+    }
+    if(!wall->findComponent<dt::MeshComponent>("mesh")->getOgreEntity()->isVisible()
+            || body->getRigidBody()->isStaticObject() || body->getRigidBody()->getInvMass() != 1.f) {
+        std::cerr << "The mesh and body have not been restored." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " dynamic nodes: " << dynamic_time * 1000 << " ms per frame" << std::endl;
+    std::cout << count << " baked nodes: " << static_time * 1000 << " ms per frame" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString StaticBakeTest::getTestName() {
+    return "StaticBake";
+}
+
+////////////////////////////////////////////////////////////////
+
+BakeCounter::BakeCounter(const QString name)
+    : Component(name),
+      mUpdates(0),
+      mBakes(0),
+      mUnbakes(0) {}
+
+void BakeCounter::onUpdate(double time_diff) {
+    if(time_diff != 0)
+        ++mUpdates;
+}
+
+void BakeCounter::onBake() {
+    ++mBakes;
+}
+
+void BakeCounter::onUnbake() {
+    ++mUnbakes;
+}
+
+} // namespace StaticBakeTest
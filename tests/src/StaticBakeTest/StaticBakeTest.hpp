@@ -0,0 +1,54 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_STATICBAKETEST
+#define DUCTTAPE_ENGINE_TESTS_STATICBAKETEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Graphics/MeshComponent.hpp>
+#include <Physics/PhysicsBodyComponent.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
+
+#include <OgreProcedural.h>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace StaticBakeTest {
+
+class StaticBakeTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class BakeCounter : public dt::Component {
+    Q_OBJECT
+
+public:
+    BakeCounter(const QString name = "");
+    void onUpdate(double time_diff);
+    void onBake();
+    void onUnbake();
+
+    uint32_t mUpdates;  //!< The number of per-frame updates.
+    uint32_t mBakes;    //!< The number of onBake() calls.
+    uint32_t mUnbakes;  //!< The number of onUnbake() calls.
+};
+
+} // namespace StaticBakeTest
+
+#endif
@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "StreamingTest/StreamingTest.hpp"
+
+#include <Logic/TriggerComponent.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <QDir>
+#include <QFile>
+
+#include <algorithm>
+#include <iostream>
+
+namespace StreamingTest {
+
+bool StreamingTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const float cell_size = 100.f;
+    const int32_t cells = 20;
+    const uint32_t nodes_per_cell = 10;
+    const QString directory = "streaming_test";
+    QDir().mkpath(directory);
+
+    // a 2 km x 2 km world with a few nodes in every cell
+    {
+        dt::Scene world("StreamingTestWorld");
+        for(int32_t x = 0; x < cells; ++x) {
+            for(int32_t z = 0; z < cells; ++z) {
+                for(uint32_t i = 0; i < nodes_per_cell; ++i) {
+                    QString name = "tree_" + dt::Utils::toString(x) + "_" + dt::Utils::toString(z) + "_" + dt::Utils::toString(i);
+                    dt::Node::NodeSP tree = world.addChildNode(new dt::Node(name));
+                    tree->setPosition(x * cell_size + i * 10 + 5, 0, z * cell_size + 50);
+                    tree->addComponent(new dt::TriggerComponent("trigger"));
+                }
+            }
+        }
+
+        uint32_t written = dt::StreamingComponent::saveCells(&world, directory, cell_size);
+        if(written != cells * cells) {
+            std::cerr << "Only " << written << " of " << cells * cells << " cells have been saved." << std::endl;
+            return false;
+        }
+    }
+
+    dt::Scene scene("StreamingTest");
+    dt::Node::NodeSP player = scene.addChildNode(new dt::Node("player"));
+    player->setPosition(50, 0, 50);
+    auto streamer = scene.addComponent(new dt::StreamingComponent(directory, cell_size, "streamer"));
+    streamer->setLoadRadius(150.f);
+    streamer->setUnloadRadius(250.f);
+    streamer->addFocus(player.get());
+
+    // the cells around the player are attached at the end of the frame
+    streamer->flush();
+    scene.updateFrame(0.01);
+    dt::Node::NodeSP cell = scene.findChildNode("cell_0_0", false);
+    if(cell == nullptr || cell->findChildNode("tree_0_0_9", false) == nullptr
+            || cell->findChildNode("tree_0_0_9", false)->findComponent<dt::TriggerComponent>("trigger") == nullptr) {
+        std::cerr << "The cell of the player has not been attached." << std::endl;
+        return false;
+    }
+    if(cell->findChildNode("tree_0_0_9", false)->getPosition(dt::Node::SCENE) != Ogre::Vector3(95, 0, 50)) {
+        std::cerr << "The streamed nodes have been moved." << std::endl;
+        return false;
+    }
+    if(streamer->getCellState(2, 0) != dt::StreamingComponent::ATTACHED || streamer->getCellState(3, 0) != dt::StreamingComponent::UNLOADED) {
+        std::cerr << "The wrong cells have been loaded." << std::endl;
+        return false;
+    }
+
+    // cells are kept until they are beyond the unload radius
+    player->setPosition(-40, 0, 50);
+    scene.updateFrame(0.01);
+    if(streamer->getCellState(2, 0) != dt::StreamingComponent::ATTACHED) {
+        std::cerr << "A cell within the unload radius has been unloaded." << std::endl;
+        return false;
+    }
+    player->setPosition(-60, 0, 50);
+    scene.updateFrame(0.01);
+    if(streamer->getCellState(2, 0) != dt::StreamingComponent::UNLOADED || scene.findChildNode("cell_2_0", false) != nullptr) {
+        std::cerr << "A cell beyond the unload radius has not been unloaded." << std::endl;
+        return false;
+    }
+
+    // cross the world on a limited budget
+    const uint64_t cell_bytes = QFile(directory + "/cell_0_0.dtcell").size();
+    streamer->setFileSizeBudget(cell_bytes * 16);
+    player->setPosition(50, 0, 1000);
+    streamer->flush();
+    scene.updateFrame(0.01);
+
+    uint64_t peak_usage = 0;
+    double max_frame_time = 0;
+    sf::Clock total;
+    uint32_t frames = 0;
+    for(float x = 50; x < cells * cell_size - 50; x += 5, ++frames) {
+        player->setPosition(x, 0, 1000);
+        sf::Clock frame;
+        scene.updateFrame(0.016);
+        max_frame_time = std::max<double>(max_frame_time, frame.getElapsedTime().asSeconds());
+        peak_usage = std::max(peak_usage, streamer->getLoadedFileSize());
+    }
+    double total_time = total.getElapsedTime().asSeconds();
+
+    streamer->flush();
+    scene.updateFrame(0.01);
+    if(scene.findChildNode("cell_19_10", false) == nullptr || streamer->getCellState(0, 10) != dt::StreamingComponent::UNLOADED) {
+        std::cerr << "The cells have not followed the player." << std::endl;
+        return false;
+    }
+    // the requests in flight may exceed the budget a little
+    if(peak_usage > cell_bytes * (16 + 4)) {
+        std::cerr << "The file size budget of " << cell_bytes * 16 << " bytes has been exceeded: " << peak_usage << " bytes." << std::endl;
+        return false;
+    }
+
+    std::cout << "Crossed " << cells << " cells in " << frames << " frames: " << total_time / frames * 1000 << " ms per frame, at most "
+              << max_frame_time * 1000 << " ms, peak file size " << peak_usage << " bytes" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString StreamingTest::getTestName() {
+    return "Streaming";
+}
+
+} // namespace StreamingTest
@@ -0,0 +1,142 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "TagIndexTest/TagIndexTest.hpp"
+
+#include <Utils/Random.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+namespace TagIndexTest {
+
+bool TagIndexTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint64_t enemy = dt::TagIndex::getTag("enemy");
+    const uint64_t interactable = dt::TagIndex::getTag("interactable");
+    const uint64_t dead = dt::TagIndex::getTag("dead");
+    if(enemy == 0 || dt::TagIndex::getTag("enemy") != enemy || dt::TagIndex::getTagName(dead) != "dead"
+            || dt::TagIndex::findTag("unknown") != 0) {
+        std::cerr << "The tags have not been registered." << std::endl;
+        return false;
+    }
+
+    dt::Scene scene("TagIndexTest");
+    const uint32_t count = 20000;
+    std::vector<dt::Node*> nodes;
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node* node = new dt::Node("node" + dt::Utils::toString(i));
+        // tagged before and after joining the Scene
+        if(i % 10 == 0)
+            node->addTags(enemy);
+        scene.addChildNode(node);
+        node->setPosition(dt::Random::get(-500.f, 500.f), 0, dt::Random::get(-500.f, 500.f));
+        if(i % 20 == 0)
+            node->addTag("interactable");
+        if(i % 30 == 0)
+            node->addTags(dead);
+        nodes.push_back(node);
+    }
+    if(!nodes[60]->hasTag("dead") || !nodes[60]->hasTags(enemy | interactable) || nodes[1]->getTags() != 0) {
+        std::cerr << "The tags of a node are wrong." << std::endl;
+        return false;
+    }
+
+    // no tag at all, which must not be mistaken for the first bit
+    if(!scene.getTagIndex().getNodes(0).empty() || scene.getTagIndex().getNodes(enemy).size() != count / 10) {
+        std::cerr << "The nodes without a tag have been found." << std::endl;
+        return false;
+    }
+
+    // AND, OR and NOT
+    if(!_testQuery(scene, nodes, dt::TagIndex::Query(enemy), "enemy")
+            || !_testQuery(scene, nodes, dt::TagIndex::Query(enemy, 0, dead), "enemy and not dead")
+            || !_testQuery(scene, nodes, dt::TagIndex::Query(enemy | interactable), "enemy and interactable")
+            || !_testQuery(scene, nodes, dt::TagIndex::Query(0, enemy | interactable, dead), "enemy or interactable, not dead")
+            || !_testQuery(scene, nodes, dt::TagIndex::Query(0, 0, enemy | interactable), "neither enemy nor interactable"))
+        return false;
+
+    // untagging and removing
+    nodes[10]->removeTags(enemy);
+    scene.removeChildNode("node20");
+    nodes.erase(nodes.begin() + 20);
+    if(!_testQuery(scene, nodes, dt::TagIndex::Query(enemy), "enemy after removing")
+            || !_testQuery(scene, nodes, dt::TagIndex::Query(0, enemy | interactable), "enemy or interactable after removing"))
+        return false;
+
+    // walking the tree, as before
+    sf::Clock clock;
+    std::vector<dt::Node*> walked;
+    for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        if((*iter)->getName().startsWith("node") && (*iter)->hasTags(enemy) && !(*iter)->hasTags(dead))
+            walked.push_back(*iter);
+    }
+    double walk_time = clock.getElapsedTime().asSeconds();
+    clock.restart();
+    std::vector<dt::Node*> found;
+    scene.findNodes(dt::TagIndex::Query(enemy, 0, dead), found);
+    double query_time = clock.getElapsedTime().asSeconds();
+
+    // enemies within 50 m, with and without the spatial index
+    const Ogre::Vector3 center(0, 0, 0);
+    const float radius = 50.f;
+    std::vector<dt::Node*> expected;
+    for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        if((*iter)->hasTags(enemy) && (*iter)->getPosition(dt::Node::SCENE).squaredDistance(center) <= radius * radius)
+            expected.push_back(*iter);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    scene.findNodes(dt::TagIndex::Query(enemy), center, radius, found);
+    std::sort(found.begin(), found.end());
+    scene.setSpatialIndex(dt::SpatialIndex::LOOSE_OCTREE);
+    clock.restart();
+    std::vector<dt::Node*> indexed;
+    scene.findNodes(dt::TagIndex::Query(enemy), center, radius, indexed);
+    double radius_time = clock.getElapsedTime().asSeconds();
+    std::sort(indexed.begin(), indexed.end());
+    if(found != expected || indexed != expected) {
+        std::cerr << "Expected " << expected.size() << " enemies within " << radius << " m, got " << found.size()
+                  << " without and " << indexed.size() << " with the spatial index." << std::endl;
+        return false;
+    }
+
+    std::cout << "Alive enemies of " << count << " nodes: walking " << walk_time * 1000 << " ms, tag query "
+              << query_time * 1000 << " ms" << std::endl;
+    std::cout << "Enemies within " << radius << " m: " << radius_time * 1000 << " ms" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString TagIndexTest::getTestName() {
+    return "TagIndex";
+}
+
+bool TagIndexTest::_testQuery(dt::Scene& scene, const std::vector<dt::Node*>& nodes, const dt::TagIndex::Query& query, const char* name) {
+    std::vector<dt::Node*> expected;
+    for(auto iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        if(query.matches((*iter)->getTags()))
+            expected.push_back(*iter);
+    }
+
+    std::vector<dt::Node*> found;
+    scene.findNodes(query, found);
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    if(found != expected) {
+        std::cerr << "Query " << name << ": expected " << expected.size() << " nodes, got " << found.size() << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace TagIndexTest
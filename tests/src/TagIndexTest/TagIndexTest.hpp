@@ -0,0 +1,40 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_TAGINDEXTEST
+#define DUCTTAPE_ENGINE_TESTS_TAGINDEXTEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
+#include <Scene/TagIndex.hpp>
+
+#include <QString>
+
+#include <vector>
+
+namespace TagIndexTest {
+
+class TagIndexTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+
+private:
+    /**
+      * Compares a query of the Scene with checking every Node.
+      */
+    bool _testQuery(dt::Scene& scene, const std::vector<dt::Node*>& nodes, const dt::TagIndex::Query& query, const char* name);
+};
+
+} // namespace TagIndexTest
+
+#endif
@@ -9,24 +9,40 @@
 #include "TestFramework.hpp"
 
 #include "CamerasTest/CamerasTest.hpp"
+#include "CommandBufferTest/CommandBufferTest.hpp"
+#include "ComponentStorageTest/ComponentStorageTest.hpp"
 #include "ConnectionsTest/ConnectionsTest.hpp"
+#include "DedicatedServerTest/DedicatedServerTest.hpp"
+#include "DeferredTransformTest/DeferredTransformTest.hpp"
 #include "DisplayTest/DisplayTest.hpp"
 #include "FollowPathTest/FollowPathTest.hpp"
+#include "FramePacingTest/FramePacingTest.hpp"
 #include "GuiTest/GuiTest.hpp"
+#include "HandleTest/HandleTest.hpp"
 #include "InputTest/InputTest.hpp"
+#include "InternedNamesTest/InternedNamesTest.hpp"
+#include "JobSystemTest/JobSystemTest.hpp"
+#include "LifecycleBatchTest/LifecycleBatchTest.hpp"
 #include "LoggerTest/LoggerTest.hpp"
 #include "MouseCursorTest/MouseCursorTest.hpp"
 #include "MusicFadeTest/MusicFadeTest.hpp"
 #include "MusicTest/MusicTest.hpp"
 #include "NamesTest/NamesTest.hpp"
 #include "NetworkTest/NetworkTest.hpp"
+#include "NodeCreationTest/NodeCreationTest.hpp"
+#include "ParallelUpdateTest/ParallelUpdateTest.hpp"
 #include "ParticlesTest/ParticlesTest.hpp"
 #include "PhysicsSimpleTest/PhysicsSimpleTest.hpp"
 #include "PhysicsStressTest/PhysicsStressTest.hpp"
+#include "PipelinedRenderingTest/PipelinedRenderingTest.hpp"
+#include "PlainComponentTest/PlainComponentTest.hpp"
+#include "PrefabTest/PrefabTest.hpp"
 #include "PrimitivesTest/PrimitivesTest.hpp"
+#include "ProfilerTest/ProfilerTest.hpp"
 #include "QObjectTest/QObjectTest.hpp"
 #include "RandomTest/RandomTest.hpp"
 #include "ResourceManagerTest/ResourceManagerTest.hpp"
+#include "SceneIndexTest/SceneIndexTest.hpp"
 #include "SerializationBinaryTest/SerializationBinaryTest.hpp"
 #include "SerializationYamlTest/SerializationYamlTest.hpp"
 #include "ScriptComponentTest/ScriptComponentTest.hpp"
@@ -34,10 +50,19 @@
 #include "ScriptingTest/ScriptingTest.hpp"
 #include "ShadowsTest/ShadowsTest.hpp"
 #include "SignalsTest/SignalsTest.hpp"
+#include "SignificanceTest/SignificanceTest.hpp"
+#include "SpatialIndexTest/SpatialIndexTest.hpp"
 #include "SoundTest/SoundTest.hpp"
 #include "StatesTest/StatesTest.hpp"
+#include "StaticBakeTest/StaticBakeTest.hpp"
+#include "StreamingTest/StreamingTest.hpp"
+#include "TagIndexTest/TagIndexTest.hpp"
 #include "TextTest/TextTest.hpp"
+#include "TickRateTest/TickRateTest.hpp"
 #include "TimerTest/TimerTest.hpp"
+#include "TransformCacheTest/TransformCacheTest.hpp"
+#include "TransformJournalTest/TransformJournalTest.hpp"
+#include "TransformPoolTest/TransformPoolTest.hpp"
 #include "TerrainTest/TerrainTest.hpp"
 #include "Utils/Utils.hpp"
 #include "BillboardTest/BillboardTest.hpp"
@@ -66,34 +91,59 @@ int main(int argc, char** argv) {
 
     // add all tests
     addTest(new CamerasTest::CamerasTest);
+    addTest(new CommandBufferTest::CommandBufferTest);
+    addTest(new ComponentStorageTest::ComponentStorageTest);
     addTest(new ConnectionsTest::ConnectionsTest);
+    addTest(new DedicatedServerTest::DedicatedServerTest);
+    addTest(new DeferredTransformTest::DeferredTransformTest);
     addTest(new DisplayTest::DisplayTest);
     addTest(new FollowPathTest::FollowPathTest);
+    addTest(new FramePacingTest::FramePacingTest);
     addTest(new GuiTest::GuiTest);
+    addTest(new HandleTest::HandleTest);
     addTest(new InputTest::InputTest);
+    addTest(new InternedNamesTest::InternedNamesTest);
+    addTest(new JobSystemTest::JobSystemTest);
+    addTest(new LifecycleBatchTest::LifecycleBatchTest);
     addTest(new LoggerTest::LoggerTest);
     addTest(new MouseCursorTest::MouseCursorTest);
     addTest(new MusicFadeTest::MusicFadeTest);
     addTest(new MusicTest::MusicTest);
     addTest(new NamesTest::NamesTest);
     addTest(new NetworkTest::NetworkTest);
+    addTest(new NodeCreationTest::NodeCreationTest);
+    addTest(new ParallelUpdateTest::ParallelUpdateTest);
     addTest(new ParticlesTest::ParticlesTest);
     addTest(new PhysicsSimpleTest::PhysicsSimpleTest);
     addTest(new PhysicsStressTest::PhysicsStressTest);
+    addTest(new PipelinedRenderingTest::PipelinedRenderingTest);
+    addTest(new PlainComponentTest::PlainComponentTest);
+    addTest(new PrefabTest::PrefabTest);
     addTest(new PrimitivesTest::PrimitivesTest);
+    addTest(new ProfilerTest::ProfilerTest);
     addTest(new QObjectTest::QObjectTest);
     addTest(new RandomTest::RandomTest);
     addTest(new ResourceManagerTest::ResourceManagerTest);
+    addTest(new SceneIndexTest::SceneIndexTest);
     addTest(new SerializationBinaryTest::SerializationBinaryTest);
     addTest(new SerializationYamlTest::SerializationYamlTest);
     addTest(new ScriptComponentTest::ScriptComponentTest);
     addTest(new ScriptingTest::ScriptingTest);
     addTest(new ShadowsTest::ShadowsTest);
     addTest(new SignalsTest::SignalsTest);
+    addTest(new SignificanceTest::SignificanceTest);
+    addTest(new SpatialIndexTest::SpatialIndexTest);
     addTest(new SoundTest::SoundTest);
     addTest(new StatesTest::StatesTest);
+    addTest(new StaticBakeTest::StaticBakeTest);
+    addTest(new StreamingTest::StreamingTest);
+    addTest(new TagIndexTest::TagIndexTest);
     addTest(new TextTest::TextTest);
+    addTest(new TickRateTest::TickRateTest);
     addTest(new TimerTest::TimerTest);
+    addTest(new TransformCacheTest::TransformCacheTest);
+    addTest(new TransformJournalTest::TransformJournalTest);
+    addTest(new TransformPoolTest::TransformPoolTest);
     addTest(new TerrainTest::TerrainTest);
     addTest(new BillboardTest::BillboardTest);
     addTest(new GuiStateTest::GuiStateTest);
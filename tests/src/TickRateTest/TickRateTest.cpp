@@ -0,0 +1,108 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "TickRateTest/TickRateTest.hpp"
+
+#include <Logic/TriggerComponent.hpp>
+#include <Utils/Utils.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace TickRateTest {
+
+bool checkUpdates(const QString& name, TickCounterComponent* component, uint32_t expected) {
+    if(component->mUpdates != expected) {
+        std::cerr << dt::Utils::toStdString(name) << ": expected " << expected << " updates, got "
+                  << component->mUpdates << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TickRateTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t ticks = 100;
+    const uint32_t slow_count = 1000;
+    dt::Scene scene("TickRateTest");
+    dt::Node::NodeSP node = scene.addChildNode(new dt::Node("node"));
+
+    TickCounterComponent* every = node->addComponent(new TickCounterComponent(dt::Component::EVERY_TICK, "every")).get();
+    TickCounterComponent* demand = node->addComponent(new TickCounterComponent(dt::Component::ON_DEMAND, "demand")).get();
+    TickCounterComponent* never = node->addComponent(new TickCounterComponent(dt::Component::NEVER, "never")).get();
+    TickCounterComponent* sleeper = node->addComponent(new TickCounterComponent(dt::Component::EVERY_TICK, "sleeper")).get();
+    std::vector<TickCounterComponent*> slow;
+    for(uint32_t i = 0; i < slow_count; ++i) {
+        dt::Node::NodeSP slow_node = scene.addChildNode(new dt::Node("slow" + dt::Utils::toString(i)));
+        slow.push_back(slow_node->addComponent(new TickCounterComponent(4, "slow")).get());
+    }
+
+    // the sleeper is woken up by an event
+    sleeper->sleep();
+    dt::TriggerComponent* alarm = node->addComponent(new dt::TriggerComponent("alarm")).get();
+    QObject::connect(alarm, SIGNAL(componentDisabled()), sleeper, SLOT(wake()));
+
+    for(uint32_t i = 1; i <= ticks; ++i) {
+        scene.updateFrame(0.01);
+        if(i == 10) {
+            demand->requestUpdate();
+            never->requestUpdate();
+        }
+        if(i == ticks / 2)
+            alarm->disable();
+    }
+
+    if(!checkUpdates("every", every, ticks) || !checkUpdates("demand", demand, 1) || !checkUpdates("never", never, 0)
+            || !checkUpdates("sleeper", sleeper, ticks / 2))
+        return false;
+
+    // the slow components are spread over the ticks, and get the time since their last update
+    for(auto iter = slow.begin(); iter != slow.end(); ++iter) {
+        if(!checkUpdates("slow", *iter, ticks / 4))
+            return false;
+        if(std::fabs((*iter)->mTime - 0.04 * (*iter)->mUpdates) > 0.031) {
+            std::cerr << "A slow component got a wrong time: " << (*iter)->mTime << std::endl;
+            return false;
+        }
+    }
+
+    uint64_t executed = scene.getExecutedUpdateCount();
+    uint64_t skipped = scene.getSkippedUpdateCount();
+    if(executed != slow_count * ticks / 4 + 1 || skipped < executed * 3) {
+        std::cerr << "Wrong update counters: " << executed << " executed, " << skipped << " skipped." << std::endl;
+        return false;
+    }
+
+    std::cout << "Scheduled updates: " << executed << " executed, " << skipped << " skipped" << std::endl;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString TickRateTest::getTestName() {
+    return "TickRate";
+}
+
+////////////////////////////////////////////////////////////////
+
+TickCounterComponent::TickCounterComponent(uint32_t interval, const QString name)
+    : dt::Component(name),
+      mUpdates(0),
+      mTime(0) {
+    setTickInterval(interval);
+}
+
+void TickCounterComponent::onUpdate(double time_diff) {
+    if(time_diff > 0) {
+        ++mUpdates;
+        mTime += time_diff;
+    }
+}
+
+} // namespace TickRateTest
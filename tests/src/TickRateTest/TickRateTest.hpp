@@ -0,0 +1,46 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_TICKRATETEST
+#define DUCTTAPE_ENGINE_TESTS_TICKRATETEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Component.hpp>
+#include <Scene/Scene.hpp>
+
+#include <QString>
+
+#include <cstdint>
+
+namespace TickRateTest {
+
+class TickRateTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+////////////////////////////////////////////////////////////////
+
+class TickCounterComponent : public dt::Component {
+    Q_OBJECT
+
+public:
+    TickCounterComponent(uint32_t interval, const QString name = "");
+    void onUpdate(double time_diff);
+
+    uint32_t mUpdates;  //!< The number of per-frame updates.
+    double mTime;       //!< The sum of the time passed to the per-frame updates.
+};
+
+} // namespace TickRateTest
+
+#endif
@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "TransformCacheTest/TransformCacheTest.hpp"
+
+#include <Utils/Logger.hpp>
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace TransformCacheTest {
+
+bool TransformCacheTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    const uint32_t iterations = 100000;
+    if(!benchmarkDepth(1, iterations) || !benchmarkDepth(4, iterations) || !benchmarkDepth(16, iterations))
+        return false;
+    if(!checkPooled())
+        return false;
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString TransformCacheTest::getTestName() {
+    return "TransformCache";
+}
+
+Ogre::Vector3 uncachedPosition(dt::Node* node) {
+    if(node->getParent() == nullptr)
+        return node->getPosition();
+    return uncachedPosition(node->getParent()) + node->getParent()->getRotation() * node->getPosition();
+}
+
+Ogre::Quaternion uncachedRotation(dt::Node* node) {
+    if(node->getParent() == nullptr)
+        return node->getRotation();
+    return uncachedRotation(node->getParent()) * node->getRotation();
+}
+
+bool benchmarkDepth(uint32_t depth, uint32_t iterations) {
+    dt::Node root("root");
+    dt::Node* leaf = &root;
+    for(uint32_t i = 0; i < depth; ++i) {
+        leaf = leaf->addChildNode(new dt::Node("chain-" + dt::Utils::toString(i))).get();
+        leaf->setPosition(Ogre::Vector3(1, 0.5f * i, -2));
+        leaf->setRotation(Ogre::Quaternion(Ogre::Degree(10), Ogre::Vector3::UNIT_Y));
+    }
+
+    // move the root to make sure the change reaches the leaf
+    root.setPosition(Ogre::Vector3(10, 20, 30));
+
+    if(!leaf->getPosition(dt::Node::SCENE).positionEquals(uncachedPosition(leaf), 0.001f) ||
+       !leaf->getRotation(dt::Node::SCENE).equals(uncachedRotation(leaf), Ogre::Degree(0.01f))) {
+        dt::Logger::get().error("Cached world transform differs at depth " + dt::Utils::toString(depth) + ".");
+        return false;
+    }
+
+    Ogre::Vector3 sum(Ogre::Vector3::ZERO);
+    sf::Clock clock;
+    for(uint32_t i = 0; i < iterations; ++i) {
+        sum += uncachedPosition(leaf);
+    }
+    double uncached_time = clock.getElapsedTime().asSeconds();
+
+    clock.restart();
+    for(uint32_t i = 0; i < iterations; ++i) {
+        sum += leaf->getPosition(dt::Node::SCENE);
+    }
+    double cached_time = clock.getElapsedTime().asSeconds();
+
+    std::cout << "Depth " << depth << ": uncached " << uncached_time * 1000 << " ms, cached "
+              << cached_time * 1000 << " ms for " << iterations << " lookups (checksum " << sum.x << ")" << std::endl;
+
+    root.deinitialize();
+    return true;
+}
+
+bool checkPooled() {
+    dt::Scene scene("TransformCacheTest");
+    dt::Node* root = scene.addChildNode(new dt::Node("root")).get();
+    dt::Node* leaf = root;
+    for(uint32_t i = 0; i < 8; ++i) {
+        leaf = leaf->addChildNode(new dt::Node("chain-" + dt::Utils::toString(i))).get();
+        leaf->setPosition(Ogre::Vector3(1, 0.5f * i, -2));
+        leaf->setRotation(Ogre::Quaternion(Ogre::Degree(10), Ogre::Vector3::UNIT_Y));
+    }
+    dt::TransformPool* pool = scene.getTransformPool();
+    pool->updateWorldTransforms();
+
+    // moved, but not batch updated yet: read from the cache of the Nodes
+    root->setPosition(Ogre::Vector3(10, 20, 30));
+    if(!pool->isDirty(leaf->getTransformHandle())
+            || !leaf->getPosition(dt::Node::SCENE).positionEquals(uncachedPosition(leaf), 0.001f)
+            || !leaf->getRotation(dt::Node::SCENE).equals(uncachedRotation(leaf), Ogre::Degree(0.01f))) {
+        dt::Logger::get().error("Cached world transform differs while the pool is outdated.");
+        return false;
+    }
+
+    // the bulk setters do not invalidate the Nodes
+    std::vector<uint32_t> handles(1, root->getTransformHandle());
+    std::vector<Ogre::Vector3> positions(1, Ogre::Vector3(-10, 0, 0));
+    pool->setPositions(handles, positions);
+    if(!leaf->getPosition(dt::Node::SCENE).positionEquals(uncachedPosition(leaf), 0.001f)) {
+        dt::Logger::get().error("Cached world transform differs after a bulk change.");
+        return false;
+    }
+
+    pool->updateWorldTransforms();
+    if(!leaf->getPosition(dt::Node::SCENE).positionEquals(uncachedPosition(leaf), 0.001f)) {
+        dt::Logger::get().error("Pool world transform differs after the batch pass.");
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,60 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#ifndef DUCTTAPE_ENGINE_TESTS_TRANSFORMCACHETEST
+#define DUCTTAPE_ENGINE_TESTS_TRANSFORMCACHETEST
+
+#include <Config.hpp>
+
+#include "Test.hpp"
+
+#include <Core/Root.hpp>
+#include <Scene/Node.hpp>
+#include <Scene/Scene.hpp>
+
+#include <OgreQuaternion.h>
+#include <OgreVector3.h>
+
+#include <cstdint>
+
+namespace TransformCacheTest {
+
+class TransformCacheTest : public Test {
+public:
+    bool run(int argc, char** argv);
+    QString getTestName();
+};
+
+/**
+  * Calculates the scene position the way it was done before the world transform was cached
+  * (walking up the whole parent chain).
+  */
+Ogre::Vector3 uncachedPosition(dt::Node* node);
+
+/**
+  * Calculates the scene rotation by walking up the whole parent chain.
+  */
+Ogre::Quaternion uncachedRotation(dt::Node* node);
+
+/**
+  * Builds a chain of the given depth below the root and compares cached and uncached lookups.
+  * @param depth The number of nodes in the chain.
+  * @param iterations How many lookups to time.
+  * @returns Whether the cached transforms match the uncached ones.
+  */
+bool benchmarkDepth(uint32_t depth, uint32_t iterations);
+
+/**
+  * Builds a chain in a Scene and checks that the cache is used while the TransformPool is outdated,
+  * also after a change made with the bulk setters of the pool.
+  * @returns Whether the world transforms match the uncached ones.
+  */
+bool checkPooled();
+
+} // namespace TransformCacheTest
+
+#endif
@@ -0,0 +1,127 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "TransformJournalTest/TransformJournalTest.hpp"
+
+#include <Utils/Utils.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+namespace TransformJournalTest {
+
+/**
+  * Returns whether a Node is in a list of changed Nodes.
+  */
+bool contains(const std::vector<dt::Node*>& nodes, dt::Node* node) {
+    return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+}
+
+bool TransformJournalTest::run(int argc, char** argv) {
+    dt::Root::getInstance().initialize(argc, argv);
+
+    dt::Scene scene("TransformJournalTest");
+    dt::TransformJournal& journal = scene.getTransformJournal();
+
+    const uint32_t count = 10000;
+    std::vector<dt::Node*> nodes;
+    for(uint32_t i = 0; i < count; ++i) {
+        dt::Node* node = scene.addChildNode(new dt::Node("node" + dt::Utils::toString(i))).get();
+        node->setPosition(static_cast<float>(i % 100), 0, static_cast<float>(i / 100));
+        nodes.push_back(node);
+    }
+    dt::Node* group = scene.addChildNode(new dt::Node("group")).get();
+    dt::Node* member = group->addChildNode(new dt::Node("member")).get();
+
+    // new nodes are recorded once
+    scene.updateFrame(0.01);
+    if(!contains(journal.getChangedNodes(), nodes.back()) || !contains(journal.getChangedNodes(), member)
+            || !journal.getRecordedNodes().empty()) {
+        std::cerr << "The new nodes have not been recorded." << std::endl;
+        return false;
+    }
+
+    // a quiet frame has no changes
+    scene.updateFrame(0.01);
+    if(!journal.getChangedNodes().empty() || nodes[0]->hasTransformChanged()) {
+        std::cerr << "A frame without changes recorded " << journal.getChangedNodes().size() << " nodes." << std::endl;
+        return false;
+    }
+
+    // moving a parent changes its children, moving twice records once
+    group->setPosition(10, 0, 0);
+    nodes[1]->setPosition(5, 0, 5);
+    nodes[1]->setPosition(6, 0, 6);
+    nodes[2]->setPosition(7, 0, 7);
+    if(!member->hasTransformChanged() || journal.getRecordedNodes().size() != 4) {
+        std::cerr << "Expected 4 recorded nodes, got " << journal.getRecordedNodes().size() << "." << std::endl;
+        return false;
+    }
+    scene.removeChildNode("node2");
+    scene.updateFrame(0.01);
+    const std::vector<dt::Node*>& changed = journal.getChangedNodes();
+    if(changed.size() != 3 || !contains(changed, group) || !contains(changed, member) || !contains(changed, nodes[1])) {
+        std::cerr << "The changed nodes of the frame are wrong." << std::endl;
+        return false;
+    }
+
+    // the spatial index only looks at the moved nodes
+    scene.setSpatialIndex(dt::SpatialIndex::LOOSE_OCTREE);
+    scene.updateFrame(0.01);
+    const uint32_t moved = count / 100;
+    for(uint32_t i = 0; i < moved; ++i) {
+        nodes[i * 100]->setPosition(nodes[i * 100]->getPosition() + Ogre::Vector3(0, 1, 0));
+    }
+    sf::Clock clock;
+    scene.updateFrame(0.01);
+    double journal_time = clock.getElapsedTime().asSeconds();
+    clock.restart();
+    scene.getSpatialIndex()->update();
+    double scan_time = clock.getElapsedTime().asSeconds();
+
+    std::vector<dt::Node*> found;
+    scene.getSpatialIndex()->queryRadius(nodes[100]->getPosition(dt::Node::SCENE), 0.1f, found);
+    if(!contains(found, nodes[100])) {
+        std::cerr << "The spatial index did not follow a moved node." << std::endl;
+        return false;
+    }
+
+    std::cout << "Frame with " << moved << " of " << count << " nodes moved: " << journal_time * 1000
+              << " ms, full spatial index scan: " << scan_time * 1000 << " ms" << std::endl;
+
+    // the bulk setters of the pool record the changed nodes and their children
+    std::vector<uint32_t> handles;
+    handles.push_back(group->getTransformHandle());
+    handles.push_back(nodes[3]->getTransformHandle());
+    std::vector<Ogre::Vector3> positions;
+    positions.push_back(Ogre::Vector3(20, 0, 0));
+    positions.push_back(Ogre::Vector3(30, 0, 30));
+    scene.getTransformPool()->setPositions(handles, positions);
+    scene.updateFrame(0.01);
+    if(!contains(changed, group) || !contains(changed, member) || !contains(changed, nodes[3])
+            || !member->hasTransformChanged()) {
+        std::cerr << "The nodes moved by the bulk setters have not been recorded." << std::endl;
+        return false;
+    }
+    found.clear();
+    scene.getSpatialIndex()->queryRadius(Ogre::Vector3(30, 0, 30), 0.1f, found);
+    if(!contains(found, nodes[3])) {
+        std::cerr << "The spatial index did not follow a node moved by the bulk setters." << std::endl;
+        return false;
+    }
+
+    dt::Root::getInstance().deinitialize();
+    return true;
+}
+
+QString TransformJournalTest::getTestName() {
+    return "TransformJournal";
+}
+
+} // namespace TransformJournalTest
@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// This file is part of the Ducttape Project (http://ducttape-dev.org) and is
+// licensed under the GNU LESSER PUBLIC LICENSE version 3. For the full license
+// text, please see the LICENSE file in the root of this project or at
+// http://www.gnu.org/licenses/lgpl.html
+// ----------------------------------------------------------------------------
+
+#include "TransformPoolTest/TransformPoolTest.hpp"
+
+#include <Utils/Random.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace TransformPoolTest {
+
+bool TransformPoolTest::run(int argc, char** argv) {
+    dt::Random::initialize();
+
+    const uint32_t count = 50000;
+    dt::TransformPool pool;
+    std::vector<uint32_t> handles;
+    handles.push_back(pool.create());
+
+    // random hierarchy, every node gets a parent that already exists
+    for(uint32_t i = 1; i < count; ++i) {
+        uint32_t parent = handles[dt::Random::get(0, static_cast<int32_t>(i) - 1)];
+        uint32_t handle = pool.create(parent);
+        pool.setPosition(handle, Ogre::Vector3(dt::Random::get(-5.f, 5.f), dt::Random::get(-5.f, 5.f), dt::Random::get(-5.f, 5.f)));
+        pool.setRotation(handle, Ogre::Quaternion(Ogre::Degree(dt::Random::get(0.f, 360.f)), Ogre::Vector3::UNIT_Y));
+        pool.setScale(handle, Ogre::Vector3(1.01f, 0.99f, 1.f));
+        handles.push_back(handle);
+    }
+
+    // per-entry calculation (walks up the parents)
+    sf::Clock clock;
+    std::vector<Ogre::Vector3> expected(count);
+    for(uint32_t i = 0; i < count; ++i) {
+        expected[i] = pool.getWorldPosition(handles[i]);
+    }
+    double single_time = clock.getElapsedTime().asSeconds();
+
+    // the getters do not store anything
+    if(!pool.isDirty(handles[count - 1])) {
+        std::cerr << "Reading the world position has changed the pool." << std::endl;
+        return false;
+    }
+
+    // batch calculation
+    for(uint32_t i = 0; i < count; ++i) {
+        pool.invalidate(handles[i]);
+    }
+    clock.restart();
+    pool.updateWorldTransforms(); // includes sorting by depth
+    double first_batch_time = clock.getElapsedTime().asSeconds();
+    for(uint32_t i = 0; i < count; ++i) {
+        pool.invalidate(handles[i]);
+    }
+    clock.restart();
+    pool.updateWorldTransforms();
+    double batch_time = clock.getElapsedTime().asSeconds();
+
+    for(uint32_t i = 0; i < count; ++i) {
+        if(!pool.getWorldPosition(handles[i]).positionEquals(expected[i], 0.01f)) {
+            std::cerr << "Batch world position of entry " << i << " differs from the single calculation." << std::endl;
+            return false;
+        }
+    }
+
+    // bulk setter, the change has to reach the children
+    std::vector<uint32_t> roots(1, handles[0]);
+    std::vector<Ogre::Vector3> offsets(1, Ogre::Vector3(100, 0, 0));
+    pool.setPositions(roots, offsets);
+    if(!pool.getWorldPosition(handles[count - 1]).positionEquals(expected[count - 1] + Ogre::Vector3(100, 0, 0), 0.01f)) {
+        std::cerr << "The bulk position change did not reach the children." << std::endl;
+        return false;
+    }
+    pool.updateWorldTransforms();
+    if(pool.hasUnpropagatedChanges() || pool.isDirty(handles[0])
+            || !pool.getWorldPosition(handles[count - 1]).positionEquals(expected[count - 1] + Ogre::Vector3(100, 0, 0), 0.01f)) {
+        std::cerr << "The bulk position change has not been propagated by the batch pass." << std::endl;
+        return false;
+    }
+
+    std::cout << count << " transforms: single " << single_time * 1000 << " ms, first batch (with sorting) "
+              << first_batch_time * 1000 << " ms, batch " << batch_time * 1000 << " ms" << std::endl;
+
+    return true;
+}
+
+QString TransformPoolTest::getTestName() {
+    return "TransformPool";
+}
+
+}